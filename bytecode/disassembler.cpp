@@ -23,6 +23,9 @@ String Disassembler::instructions_as_string() const
         ++instruction_pointer;
     }
 
+    for (usize entry_index = 0; entry_index < m_package.jump_table_entry_count(); ++entry_index)
+        builder.append("[jump table {}] {}\n"sv, entry_index, m_package.fetch_jump_table_entry(entry_index));
+
     return builder.release_string();
 }
 
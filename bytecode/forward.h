@@ -9,9 +9,12 @@
 
 namespace Arc::Bytecode {
 
+enum class OpCode : u8;
 enum class Register : u8;
 
 class Instruction;
+class InstructionRecord;
+class OpcodeProfile;
 class Package;
 
 }
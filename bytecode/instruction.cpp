@@ -8,26 +8,198 @@
 
 namespace Arc::Bytecode {
 
+StringView opcode_to_string_view(OpCode opcode)
+{
+    switch (opcode) {
+#define _ARC_CASE(x) \
+    case OpCode::x:  \
+        return #x##sv;
+
+        ARC_ENUMERATE_BYTECODE_OPCODES(_ARC_CASE)
+#undef _ARC_CASE
+
+        default:
+            ARC_ASSERT_NOT_REACHED;
+    }
+}
+
+String Instruction::to_string() const
+{
+    switch (m_opcode) {
+#define _ARC_INSTRUCTION_TO_STRING(x) \
+    case OpCode::x:                   \
+        return as<x##Instruction>().to_string();
+        ARC_ENUMERATE_BYTECODE_OPCODES(_ARC_INSTRUCTION_TO_STRING)
+#undef _ARC_INSTRUCTION_TO_STRING
+
+        default:
+            break;
+    }
+
+    ARC_ASSERT_NOT_REACHED;
+}
+
 String AddInstruction::to_string() const
 {
     return StringBuilder::formatted("AddInstruction dst:{}, lhs:{}, rhs:{}"sv, m_dst_register, m_lhs_register, m_rhs_register);
 }
 
+String AddImmediateInstruction::to_string() const
+{
+    return StringBuilder::formatted("AddImmediate dst:{}, lhs:{}, value:{}"sv, m_dst_register, m_lhs_register, m_immediate_value);
+}
+
+String BitwiseANDInstruction::to_string() const
+{
+    return StringBuilder::formatted("BitwiseAND dst:{}, lhs:{}, rhs:{}"sv, m_dst_register, m_lhs_register, m_rhs_register);
+}
+
+String BitwiseLeftShiftInstruction::to_string() const
+{
+    return StringBuilder::formatted("BitwiseLeftShift dst:{}, lhs:{}, rhs:{}"sv, m_dst_register, m_lhs_register, m_rhs_register);
+}
+
+String BitwiseNOTInstruction::to_string() const
+{
+    return StringBuilder::formatted("BitwiseNOT dst:{}, src:{}"sv, m_dst_register, m_src_register);
+}
+
+String BitwiseORInstruction::to_string() const
+{
+    return StringBuilder::formatted("BitwiseOR dst:{}, lhs:{}, rhs:{}"sv, m_dst_register, m_lhs_register, m_rhs_register);
+}
+
+String BitwiseRightShiftInstruction::to_string() const
+{
+    return StringBuilder::formatted("BitwiseRightShift dst:{}, lhs:{}, rhs:{}"sv, m_dst_register, m_lhs_register, m_rhs_register);
+}
+
+String BitwiseRightShiftSignedInstruction::to_string() const
+{
+    return StringBuilder::formatted("BitwiseRightShiftSigned dst:{}, lhs:{}, rhs:{}"sv, m_dst_register, m_lhs_register, m_rhs_register);
+}
+
+String BitwiseXORInstruction::to_string() const
+{
+    return StringBuilder::formatted("BitwiseXOR dst:{}, lhs:{}, rhs:{}"sv, m_dst_register, m_lhs_register, m_rhs_register);
+}
+
 String CallInstruction::to_string() const
 {
     return StringBuilder::formatted("Call callee:{}, parameters:{}"sv, m_callee_address, m_parameters_byte_count);
 }
 
+String CallWithArgumentsInstruction::to_string() const
+{
+    return StringBuilder::formatted("CallWithArguments callee:{}, arguments:{}..+{}, return:{}, parameters:{}"sv, m_callee_address,
+                                    m_first_argument_register, m_argument_count, m_return_value_register, m_parameters_byte_count);
+}
+
+String CompareEqualInstruction::to_string() const
+{
+    return StringBuilder::formatted("CompareEqual dst:{}, lhs:{}, rhs:{}"sv, m_dst_register, m_lhs_register, m_rhs_register);
+}
+
 String CompareGreaterInstruction::to_string() const
 {
     return StringBuilder::formatted("CompareGreater dst:{}, lhs:{}, rhs:{}"sv, m_dst_register, m_lhs_register, m_rhs_register);
 }
 
+String CompareGreaterImmediateInstruction::to_string() const
+{
+    return StringBuilder::formatted("CompareGreaterImmediate dst:{}, lhs:{}, value:{}"sv, m_dst_register, m_lhs_register, m_immediate_value);
+}
+
+String CompareGreaterOrEqualInstruction::to_string() const
+{
+    return StringBuilder::formatted("CompareGreaterOrEqual dst:{}, lhs:{}, rhs:{}"sv, m_dst_register, m_lhs_register, m_rhs_register);
+}
+
+String CompareGreaterOrEqualSignedInstruction::to_string() const
+{
+    return StringBuilder::formatted("CompareGreaterOrEqualSigned dst:{}, lhs:{}, rhs:{}"sv, m_dst_register, m_lhs_register, m_rhs_register);
+}
+
+String CompareGreaterSignedInstruction::to_string() const
+{
+    return StringBuilder::formatted("CompareGreaterSigned dst:{}, lhs:{}, rhs:{}"sv, m_dst_register, m_lhs_register, m_rhs_register);
+}
+
+String CompareLessInstruction::to_string() const
+{
+    return StringBuilder::formatted("CompareLess dst:{}, lhs:{}, rhs:{}"sv, m_dst_register, m_lhs_register, m_rhs_register);
+}
+
+String CompareLessOrEqualInstruction::to_string() const
+{
+    return StringBuilder::formatted("CompareLessOrEqual dst:{}, lhs:{}, rhs:{}"sv, m_dst_register, m_lhs_register, m_rhs_register);
+}
+
+String CompareLessOrEqualSignedInstruction::to_string() const
+{
+    return StringBuilder::formatted("CompareLessOrEqualSigned dst:{}, lhs:{}, rhs:{}"sv, m_dst_register, m_lhs_register, m_rhs_register);
+}
+
+String CompareLessSignedInstruction::to_string() const
+{
+    return StringBuilder::formatted("CompareLessSigned dst:{}, lhs:{}, rhs:{}"sv, m_dst_register, m_lhs_register, m_rhs_register);
+}
+
+String CompareNotEqualInstruction::to_string() const
+{
+    return StringBuilder::formatted("CompareNotEqual dst:{}, lhs:{}, rhs:{}"sv, m_dst_register, m_lhs_register, m_rhs_register);
+}
+
 String DecrementInstruction::to_string() const
 {
     return StringBuilder::formatted("Decrement dst:{}"sv, m_dst_register);
 }
 
+String DivideInstruction::to_string() const
+{
+    return StringBuilder::formatted("Divide dst:{}, lhs:{}, rhs:{}"sv, m_dst_register, m_lhs_register, m_rhs_register);
+}
+
+String DivideSignedInstruction::to_string() const
+{
+    return StringBuilder::formatted("DivideSigned dst:{}, lhs:{}, rhs:{}"sv, m_dst_register, m_lhs_register, m_rhs_register);
+}
+
+String FusedCompareGreaterJumpIfInstruction::to_string() const
+{
+    return StringBuilder::formatted("FusedCompareGreaterJumpIf dst:{}, lhs:{}, rhs:{}, address:{}"sv, m_dst_register, m_lhs_register,
+                                    m_rhs_register, m_jump_address);
+}
+
+String FusedCompareGreaterImmediateJumpIfInstruction::to_string() const
+{
+    return StringBuilder::formatted("FusedCompareGreaterImmediateJumpIf dst:{}, lhs:{}, value:{}, address:{}"sv, m_dst_register,
+                                    m_lhs_register, m_immediate_value, m_jump_address);
+}
+
+String FusedLoadAddStoreInstruction::to_string() const
+{
+    return StringBuilder::formatted("FusedLoadAddStore dst:{}, loaded:{}, other:{}, src:{}, dst_offset:{}"sv, m_dst_register,
+                                    m_loaded_register, m_other_register, m_src_stack_offset, m_dst_stack_offset);
+}
+
+String FusedLoadIncrementStoreInstruction::to_string() const
+{
+    return StringBuilder::formatted("FusedLoadIncrementStore dst:{}, offset:{}"sv, m_dst_register, m_stack_offset);
+}
+
+String FusedLoadPairInstruction::to_string() const
+{
+    return StringBuilder::formatted("FusedLoadPair dst:{}, src:{}, dst:{}, src:{}"sv, m_first_dst_register, m_first_src_stack_offset,
+                                    m_second_dst_register, m_second_src_stack_offset);
+}
+
+String FusedLoadStoreInstruction::to_string() const
+{
+    return StringBuilder::formatted("FusedLoadStore dst:{}, src:{}, dst_offset:{}"sv, m_dst_register, m_src_stack_offset,
+                                    m_dst_stack_offset);
+}
+
 String IncrementInstruction::to_string() const
 {
     return StringBuilder::formatted("Increment dst:{}"sv, m_dst_register);
@@ -43,6 +215,17 @@ String JumpIfInstruction::to_string() const
     return StringBuilder::formatted("JumpIf condition:{}, address:{}"sv, m_condition_register, m_jump_address);
 }
 
+String JumpTableInstruction::to_string() const
+{
+    return StringBuilder::formatted("JumpTable index:{}, first_entry:{}, entry_count:{}, default:{}"sv, m_index_register,
+                                    m_first_entry_index, m_entry_count, m_default_address);
+}
+
+String LoadFromFrameInstruction::to_string() const
+{
+    return StringBuilder::formatted("LoadFromFrame dst:{}, src:{}"sv, m_dst_register, m_src_frame_offset);
+}
+
 String LoadFromStackInstruction::to_string() const
 {
     return StringBuilder::formatted("LoadFromStack dst:{}, src:{}"sv, m_dst_register, m_src_stack_offset);
@@ -68,6 +251,56 @@ String LoadImmediate8Instruction::to_string() const
     return StringBuilder::formatted("LoadImmediate8 dst:{}, value:{}"sv, m_dst_register, m_immediate_value);
 }
 
+String LoadImmediate16Instruction::to_string() const
+{
+    return StringBuilder::formatted("LoadImmediate16 dst:{}, value:{}"sv, m_dst_register, m_immediate_value);
+}
+
+String LoadImmediate32Instruction::to_string() const
+{
+    return StringBuilder::formatted("LoadImmediate32 dst:{}, value:{}"sv, m_dst_register, m_immediate_value);
+}
+
+String LoadImmediate64Instruction::to_string() const
+{
+    return StringBuilder::formatted("LoadImmediate64 dst:{}, value:{}"sv, m_dst_register, m_immediate_value);
+}
+
+String LogicalANDInstruction::to_string() const
+{
+    return StringBuilder::formatted("LogicalAND dst:{}, lhs:{}, rhs:{}"sv, m_dst_register, m_lhs_register, m_rhs_register);
+}
+
+String LogicalNOTInstruction::to_string() const
+{
+    return StringBuilder::formatted("LogicalNOT dst:{}, src:{}"sv, m_dst_register, m_src_register);
+}
+
+String LogicalORInstruction::to_string() const
+{
+    return StringBuilder::formatted("LogicalOR dst:{}, lhs:{}, rhs:{}"sv, m_dst_register, m_lhs_register, m_rhs_register);
+}
+
+String LogicalXORInstruction::to_string() const
+{
+    return StringBuilder::formatted("LogicalXOR dst:{}, lhs:{}, rhs:{}"sv, m_dst_register, m_lhs_register, m_rhs_register);
+}
+
+String MoveInstruction::to_string() const
+{
+    return StringBuilder::formatted("Move dst:{}, src:{}"sv, m_dst_register, m_src_register);
+}
+
+String MultiplyInstruction::to_string() const
+{
+    return StringBuilder::formatted("Multiply dst:{}, lhs:{}, rhs:{}"sv, m_dst_register, m_lhs_register, m_rhs_register);
+}
+
+String NegateInstruction::to_string() const
+{
+    return StringBuilder::formatted("Negate dst:{}, src:{}"sv, m_dst_register, m_src_register);
+}
+
 String PopInstruction::to_string() const
 {
     return StringBuilder::formatted("Pop byte_count:{}"sv, m_pop_byte_count);
@@ -78,6 +311,11 @@ String PopRegisterInstruction::to_string() const
     return StringBuilder::formatted("PopRegister"sv);
 }
 
+String PureFunctionEntryInstruction::to_string() const
+{
+    return StringBuilder::formatted("PureFunctionEntry"sv);
+}
+
 String PushInstruction::to_string() const
 {
     return StringBuilder::formatted("Push byte_count:{}"sv, m_push_byte_count);
@@ -113,6 +351,31 @@ String ReturnInstruction::to_string() const
     return StringBuilder::formatted("Return"sv);
 }
 
+String ReturnValueInstruction::to_string() const
+{
+    return StringBuilder::formatted("ReturnValue src:{}"sv, m_src_register);
+}
+
+String SignExtend8Instruction::to_string() const
+{
+    return StringBuilder::formatted("SignExtend8 dst:{}, src:{}"sv, m_dst_register, m_src_register);
+}
+
+String SignExtend16Instruction::to_string() const
+{
+    return StringBuilder::formatted("SignExtend16 dst:{}, src:{}"sv, m_dst_register, m_src_register);
+}
+
+String SignExtend32Instruction::to_string() const
+{
+    return StringBuilder::formatted("SignExtend32 dst:{}, src:{}"sv, m_dst_register, m_src_register);
+}
+
+String StoreToFrameInstruction::to_string() const
+{
+    return StringBuilder::formatted("StoreToFrame dst:{}, src:{}"sv, m_dst_frame_offset, m_src_register);
+}
+
 String StoreToStackInstruction::to_string() const
 {
     return StringBuilder::formatted("StoreToStack dst:{}, src:{}"sv, m_dst_stack_offset, m_src_register);
@@ -138,4 +401,20 @@ String SubInstruction::to_string() const
     return StringBuilder::formatted("Sub dst:{}, lhs:{}, rhs:{}"sv, m_dst_register, m_lhs_register, m_rhs_register);
 }
 
+String SubImmediateInstruction::to_string() const
+{
+    return StringBuilder::formatted("SubImmediate dst:{}, lhs:{}, value:{}"sv, m_dst_register, m_lhs_register, m_immediate_value);
+}
+
+String TailCallInstruction::to_string() const
+{
+    return StringBuilder::formatted("TailCall callee:{}, parameters:{}"sv, m_callee_address, m_parameters_byte_count);
+}
+
+String TailCallWithArgumentsInstruction::to_string() const
+{
+    return StringBuilder::formatted("TailCallWithArguments callee:{}, arguments:{}..+{}, parameters:{}"sv, m_callee_address,
+                                    m_first_argument_register, m_argument_count, m_parameters_byte_count);
+}
+
 }
@@ -12,230 +12,1388 @@
 
 namespace Arc::Bytecode {
 
+enum class OpCode : u8 {
+// clang-format off
+#define ARC_ENUMERATE_BYTECODE_OPCODES(x)   \
+    x(Add)                                  \
+    x(AddImmediate)                         \
+    x(BitwiseAND)                           \
+    x(BitwiseLeftShift)                     \
+    x(BitwiseNOT)                           \
+    x(BitwiseOR)                            \
+    x(BitwiseRightShift)                    \
+    x(BitwiseRightShiftSigned)              \
+    x(BitwiseXOR)                           \
+    x(Call)                                 \
+    x(CallWithArguments)                    \
+    x(CompareEqual)                         \
+    x(CompareGreater)                       \
+    x(CompareGreaterImmediate)              \
+    x(CompareGreaterOrEqual)                \
+    x(CompareGreaterOrEqualSigned)          \
+    x(CompareGreaterSigned)                 \
+    x(CompareLess)                          \
+    x(CompareLessOrEqual)                   \
+    x(CompareLessOrEqualSigned)             \
+    x(CompareLessSigned)                    \
+    x(CompareNotEqual)                      \
+    x(Decrement)                            \
+    x(Divide)                               \
+    x(DivideSigned)                         \
+    x(FusedCompareGreaterJumpIf)            \
+    x(FusedCompareGreaterImmediateJumpIf)   \
+    x(FusedLoadAddStore)                    \
+    x(FusedLoadIncrementStore)              \
+    x(FusedLoadPair)                        \
+    x(FusedLoadStore)                       \
+    x(Increment)                            \
+    x(Jump)                                 \
+    x(JumpIf)                               \
+    x(JumpTable)                            \
+    x(LoadFromFrame)                        \
+    x(LoadFromStack)                        \
+    x(Load8FromStack)                       \
+    x(Load16FromStack)                      \
+    x(Load32FromStack)                      \
+    x(LoadImmediate8)                       \
+    x(LoadImmediate16)                      \
+    x(LoadImmediate32)                      \
+    x(LoadImmediate64)                      \
+    x(LogicalAND)                           \
+    x(LogicalNOT)                           \
+    x(LogicalOR)                            \
+    x(LogicalXOR)                           \
+    x(Move)                                 \
+    x(Multiply)                             \
+    x(Negate)                               \
+    x(Pop)                                  \
+    x(PopRegister)                          \
+    x(PureFunctionEntry)                    \
+    x(Push)                                 \
+    x(PushImmediate8)                       \
+    x(PushImmediate16)                      \
+    x(PushImmediate32)                      \
+    x(PushImmediate64)                      \
+    x(PushRegister)                         \
+    x(Return)                               \
+    x(ReturnValue)                          \
+    x(SignExtend8)                          \
+    x(SignExtend16)                         \
+    x(SignExtend32)                         \
+    x(StoreToFrame)                         \
+    x(StoreToStack)                         \
+    x(Store8ToStack)                        \
+    x(Store16ToStack)                       \
+    x(Store32ToStack)                       \
+    x(Sub)                                  \
+    x(SubImmediate)                         \
+    x(TailCall)                             \
+    x(TailCallWithArguments)
+// clang-format on
+
+#define _ARC_ENUM_MEMBER(x) x,
+    ARC_ENUMERATE_BYTECODE_OPCODES(_ARC_ENUM_MEMBER)
+#undef _ARC_ENUM_MEMBER
+    Count,
+};
+
+StringView opcode_to_string_view(OpCode opcode);
+
+// Instructions of the form `dst = lhs <operation> rhs`, where all operands are registers. They all share the layout
+// of `AddInstruction`.
+// clang-format off
+#define ARC_ENUMERATE_BYTECODE_BINARY_REGISTER_OPCODES(x) \
+    x(Add)                                                \
+    x(BitwiseAND)                                         \
+    x(BitwiseLeftShift)                                   \
+    x(BitwiseOR)                                          \
+    x(BitwiseRightShift)                                  \
+    x(BitwiseRightShiftSigned)                            \
+    x(BitwiseXOR)                                         \
+    x(CompareEqual)                                       \
+    x(CompareGreater)                                     \
+    x(CompareGreaterOrEqual)                              \
+    x(CompareGreaterOrEqualSigned)                        \
+    x(CompareGreaterSigned)                               \
+    x(CompareLess)                                        \
+    x(CompareLessOrEqual)                                 \
+    x(CompareLessOrEqualSigned)                           \
+    x(CompareLessSigned)                                  \
+    x(CompareNotEqual)                                    \
+    x(Divide)                                             \
+    x(DivideSigned)                                       \
+    x(LogicalAND)                                         \
+    x(LogicalOR)                                          \
+    x(LogicalXOR)                                         \
+    x(Multiply)                                           \
+    x(Sub)
+// clang-format on
+
+// Instructions of the form `dst = <operation> src`, where both operands are registers. They all share the layout
+// of `MoveInstruction`.
+// clang-format off
+#define ARC_ENUMERATE_BYTECODE_UNARY_REGISTER_OPCODES(x) \
+    x(BitwiseNOT)                                        \
+    x(LogicalNOT)                                        \
+    x(Move)                                              \
+    x(Negate)                                            \
+    x(SignExtend8)                                       \
+    x(SignExtend16)                                      \
+    x(SignExtend32)
+// clang-format on
+
+// NOTE: Instructions don't have a virtual table. Each instruction type is a plain, trivially copyable
+//       record that starts with its opcode, which is used by the generic `execute` and `to_string`
+//       functions to dispatch to the concrete instruction type.
 class Instruction {
-    ARC_MAKE_NONCOPYABLE(Instruction);
-    ARC_MAKE_NONMOVABLE(Instruction);
+public:
+    NODISCARD ALWAYS_INLINE OpCode opcode() const { return m_opcode; }
+
+    template<typename InstructionType>
+    NODISCARD ALWAYS_INLINE const InstructionType& as() const
+    {
+        ARC_ASSERT_DEBUG(m_opcode == InstructionType::opcode_value);
+        return static_cast<const InstructionType&>(*this);
+    }
+
+    void execute(Runtime::Interpreter&) const;
+    String to_string() const;
+
+protected:
+    ALWAYS_INLINE explicit Instruction(OpCode opcode)
+        : m_opcode(opcode)
+    {}
+
+private:
+    OpCode m_opcode;
+};
+
+class AddInstruction : public Instruction {
+public:
+    static constexpr OpCode opcode_value = OpCode::Add;
+
+    ALWAYS_INLINE AddInstruction(Register dst_register, Register lhs_register, Register rhs_register)
+        : Instruction(opcode_value)
+        , m_dst_register(dst_register)
+        , m_lhs_register(lhs_register)
+        , m_rhs_register(rhs_register)
+    {}
+
+    void execute(Runtime::Interpreter&) const;
+    String to_string() const;
+
+    NODISCARD ALWAYS_INLINE Register dst_register() const { return m_dst_register; }
+    NODISCARD ALWAYS_INLINE Register lhs_register() const { return m_lhs_register; }
+    NODISCARD ALWAYS_INLINE Register rhs_register() const { return m_rhs_register; }
+
+private:
+    Register m_dst_register;
+    Register m_lhs_register;
+    Register m_rhs_register;
+};
+
+class AddImmediateInstruction : public Instruction {
+public:
+    static constexpr OpCode opcode_value = OpCode::AddImmediate;
+
+    ALWAYS_INLINE AddImmediateInstruction(Register dst_register, Register lhs_register, u64 immediate_value)
+        : Instruction(opcode_value)
+        , m_dst_register(dst_register)
+        , m_lhs_register(lhs_register)
+        , m_immediate_value(immediate_value)
+    {}
+
+    void execute(Runtime::Interpreter&) const;
+    String to_string() const;
+
+    NODISCARD ALWAYS_INLINE Register dst_register() const { return m_dst_register; }
+    NODISCARD ALWAYS_INLINE Register lhs_register() const { return m_lhs_register; }
+    NODISCARD ALWAYS_INLINE u64 immediate_value() const { return m_immediate_value; }
+
+private:
+    Register m_dst_register;
+    Register m_lhs_register;
+    u64 m_immediate_value;
+};
+
+class BitwiseANDInstruction : public Instruction {
+public:
+    static constexpr OpCode opcode_value = OpCode::BitwiseAND;
+
+    ALWAYS_INLINE BitwiseANDInstruction(Register dst_register, Register lhs_register, Register rhs_register)
+        : Instruction(opcode_value)
+        , m_dst_register(dst_register)
+        , m_lhs_register(lhs_register)
+        , m_rhs_register(rhs_register)
+    {}
+
+    void execute(Runtime::Interpreter&) const;
+    String to_string() const;
+
+    NODISCARD ALWAYS_INLINE Register dst_register() const { return m_dst_register; }
+    NODISCARD ALWAYS_INLINE Register lhs_register() const { return m_lhs_register; }
+    NODISCARD ALWAYS_INLINE Register rhs_register() const { return m_rhs_register; }
+
+private:
+    Register m_dst_register;
+    Register m_lhs_register;
+    Register m_rhs_register;
+};
+
+class BitwiseLeftShiftInstruction : public Instruction {
+public:
+    static constexpr OpCode opcode_value = OpCode::BitwiseLeftShift;
+
+    ALWAYS_INLINE BitwiseLeftShiftInstruction(Register dst_register, Register lhs_register, Register rhs_register)
+        : Instruction(opcode_value)
+        , m_dst_register(dst_register)
+        , m_lhs_register(lhs_register)
+        , m_rhs_register(rhs_register)
+    {}
+
+    void execute(Runtime::Interpreter&) const;
+    String to_string() const;
+
+    NODISCARD ALWAYS_INLINE Register dst_register() const { return m_dst_register; }
+    NODISCARD ALWAYS_INLINE Register lhs_register() const { return m_lhs_register; }
+    NODISCARD ALWAYS_INLINE Register rhs_register() const { return m_rhs_register; }
+
+private:
+    Register m_dst_register;
+    Register m_lhs_register;
+    Register m_rhs_register;
+};
+
+class BitwiseNOTInstruction : public Instruction {
+public:
+    static constexpr OpCode opcode_value = OpCode::BitwiseNOT;
+
+    ALWAYS_INLINE BitwiseNOTInstruction(Register dst_register, Register src_register)
+        : Instruction(opcode_value)
+        , m_dst_register(dst_register)
+        , m_src_register(src_register)
+    {}
+
+    void execute(Runtime::Interpreter&) const;
+    String to_string() const;
+
+    NODISCARD ALWAYS_INLINE Register dst_register() const { return m_dst_register; }
+    NODISCARD ALWAYS_INLINE Register src_register() const { return m_src_register; }
+
+private:
+    Register m_dst_register;
+    Register m_src_register;
+};
+
+class BitwiseORInstruction : public Instruction {
+public:
+    static constexpr OpCode opcode_value = OpCode::BitwiseOR;
+
+    ALWAYS_INLINE BitwiseORInstruction(Register dst_register, Register lhs_register, Register rhs_register)
+        : Instruction(opcode_value)
+        , m_dst_register(dst_register)
+        , m_lhs_register(lhs_register)
+        , m_rhs_register(rhs_register)
+    {}
+
+    void execute(Runtime::Interpreter&) const;
+    String to_string() const;
+
+    NODISCARD ALWAYS_INLINE Register dst_register() const { return m_dst_register; }
+    NODISCARD ALWAYS_INLINE Register lhs_register() const { return m_lhs_register; }
+    NODISCARD ALWAYS_INLINE Register rhs_register() const { return m_rhs_register; }
+
+private:
+    Register m_dst_register;
+    Register m_lhs_register;
+    Register m_rhs_register;
+};
+
+class BitwiseRightShiftInstruction : public Instruction {
+public:
+    static constexpr OpCode opcode_value = OpCode::BitwiseRightShift;
+
+    ALWAYS_INLINE BitwiseRightShiftInstruction(Register dst_register, Register lhs_register, Register rhs_register)
+        : Instruction(opcode_value)
+        , m_dst_register(dst_register)
+        , m_lhs_register(lhs_register)
+        , m_rhs_register(rhs_register)
+    {}
+
+    void execute(Runtime::Interpreter&) const;
+    String to_string() const;
+
+    NODISCARD ALWAYS_INLINE Register dst_register() const { return m_dst_register; }
+    NODISCARD ALWAYS_INLINE Register lhs_register() const { return m_lhs_register; }
+    NODISCARD ALWAYS_INLINE Register rhs_register() const { return m_rhs_register; }
+
+private:
+    Register m_dst_register;
+    Register m_lhs_register;
+    Register m_rhs_register;
+};
+
+class BitwiseRightShiftSignedInstruction : public Instruction {
+public:
+    static constexpr OpCode opcode_value = OpCode::BitwiseRightShiftSigned;
+
+    ALWAYS_INLINE BitwiseRightShiftSignedInstruction(Register dst_register, Register lhs_register, Register rhs_register)
+        : Instruction(opcode_value)
+        , m_dst_register(dst_register)
+        , m_lhs_register(lhs_register)
+        , m_rhs_register(rhs_register)
+    {}
+
+    void execute(Runtime::Interpreter&) const;
+    String to_string() const;
+
+    NODISCARD ALWAYS_INLINE Register dst_register() const { return m_dst_register; }
+    NODISCARD ALWAYS_INLINE Register lhs_register() const { return m_lhs_register; }
+    NODISCARD ALWAYS_INLINE Register rhs_register() const { return m_rhs_register; }
+
+private:
+    Register m_dst_register;
+    Register m_lhs_register;
+    Register m_rhs_register;
+};
+
+class BitwiseXORInstruction : public Instruction {
+public:
+    static constexpr OpCode opcode_value = OpCode::BitwiseXOR;
+
+    ALWAYS_INLINE BitwiseXORInstruction(Register dst_register, Register lhs_register, Register rhs_register)
+        : Instruction(opcode_value)
+        , m_dst_register(dst_register)
+        , m_lhs_register(lhs_register)
+        , m_rhs_register(rhs_register)
+    {}
+
+    void execute(Runtime::Interpreter&) const;
+    String to_string() const;
+
+    NODISCARD ALWAYS_INLINE Register dst_register() const { return m_dst_register; }
+    NODISCARD ALWAYS_INLINE Register lhs_register() const { return m_lhs_register; }
+    NODISCARD ALWAYS_INLINE Register rhs_register() const { return m_rhs_register; }
+
+private:
+    Register m_dst_register;
+    Register m_lhs_register;
+    Register m_rhs_register;
+};
+
+// NOTE: Every call pushes a header of this size on top of the parameters, which holds the state required to return to
+//       the caller. The frame pointer of the callee points at the header, so the parameters start at the frame offset
+//       `call_frame_header_byte_count`.
+static constexpr u64 call_frame_header_byte_count = 32;
+
+class CallInstruction : public Instruction {
+public:
+    static constexpr OpCode opcode_value = OpCode::Call;
+
+    explicit CallInstruction(JumpAddress callee_address, u64 parameters_byte_count)
+        : Instruction(opcode_value)
+        , m_callee_address(callee_address)
+        , m_parameters_byte_count(parameters_byte_count)
+    {}
+
+    void execute(Runtime::Interpreter&) const;
+    String to_string() const;
+
+    NODISCARD ALWAYS_INLINE JumpAddress callee_address() const { return m_callee_address; }
+    NODISCARD ALWAYS_INLINE u64 parameters_byte_count() const { return m_parameters_byte_count; }
+
+private:
+    JumpAddress m_callee_address;
+    u64 m_parameters_byte_count;
+};
+
+// NOTE: Calls the function using the register calling convention. The first `argument_count` registers of the callee
+//       window are initialized with the caller registers starting at `first_argument_register`, while the remaining
+//       arguments (if any) are passed on the stack. When the callee returns using `ReturnValue`, the returned value
+//       is written to `return_value_register` in the caller window.
+class CallWithArgumentsInstruction : public Instruction {
+public:
+    static constexpr OpCode opcode_value = OpCode::CallWithArguments;
+
+    explicit CallWithArgumentsInstruction(JumpAddress callee_address, Register first_argument_register, u8 argument_count,
+                                          Register return_value_register, u64 parameters_byte_count)
+        : Instruction(opcode_value)
+        , m_first_argument_register(first_argument_register)
+        , m_argument_count(argument_count)
+        , m_return_value_register(return_value_register)
+        , m_callee_address(callee_address)
+        , m_parameters_byte_count(parameters_byte_count)
+    {}
+
+    void execute(Runtime::Interpreter&) const;
+    String to_string() const;
+
+    NODISCARD ALWAYS_INLINE JumpAddress callee_address() const { return m_callee_address; }
+    NODISCARD ALWAYS_INLINE Register first_argument_register() const { return m_first_argument_register; }
+    NODISCARD ALWAYS_INLINE u8 argument_count() const { return m_argument_count; }
+    NODISCARD ALWAYS_INLINE Register return_value_register() const { return m_return_value_register; }
+    NODISCARD ALWAYS_INLINE u64 parameters_byte_count() const { return m_parameters_byte_count; }
+
+private:
+    // NOTE: The register operands are declared first so they are packed right after the opcode.
+    Register m_first_argument_register;
+    u8 m_argument_count;
+    Register m_return_value_register;
+    JumpAddress m_callee_address;
+    u64 m_parameters_byte_count;
+};
+
+class CompareEqualInstruction : public Instruction {
+public:
+    static constexpr OpCode opcode_value = OpCode::CompareEqual;
+
+    ALWAYS_INLINE CompareEqualInstruction(Register dst_register, Register lhs_register, Register rhs_register)
+        : Instruction(opcode_value)
+        , m_dst_register(dst_register)
+        , m_lhs_register(lhs_register)
+        , m_rhs_register(rhs_register)
+    {}
+
+    void execute(Runtime::Interpreter&) const;
+    String to_string() const;
+
+    NODISCARD ALWAYS_INLINE Register dst_register() const { return m_dst_register; }
+    NODISCARD ALWAYS_INLINE Register lhs_register() const { return m_lhs_register; }
+    NODISCARD ALWAYS_INLINE Register rhs_register() const { return m_rhs_register; }
+
+private:
+    Register m_dst_register;
+    Register m_lhs_register;
+    Register m_rhs_register;
+};
+
+class CompareGreaterInstruction : public Instruction {
+public:
+    static constexpr OpCode opcode_value = OpCode::CompareGreater;
+
+    ALWAYS_INLINE CompareGreaterInstruction(Register dst_register, Register lhs_register, Register rhs_register)
+        : Instruction(opcode_value)
+        , m_dst_register(dst_register)
+        , m_lhs_register(lhs_register)
+        , m_rhs_register(rhs_register)
+    {}
+
+    void execute(Runtime::Interpreter&) const;
+    String to_string() const;
+
+    NODISCARD ALWAYS_INLINE Register dst_register() const { return m_dst_register; }
+    NODISCARD ALWAYS_INLINE Register lhs_register() const { return m_lhs_register; }
+    NODISCARD ALWAYS_INLINE Register rhs_register() const { return m_rhs_register; }
+
+private:
+    Register m_dst_register;
+    Register m_lhs_register;
+    Register m_rhs_register;
+};
+
+class CompareGreaterImmediateInstruction : public Instruction {
+public:
+    static constexpr OpCode opcode_value = OpCode::CompareGreaterImmediate;
+
+    ALWAYS_INLINE CompareGreaterImmediateInstruction(Register dst_register, Register lhs_register, u64 immediate_value)
+        : Instruction(opcode_value)
+        , m_dst_register(dst_register)
+        , m_lhs_register(lhs_register)
+        , m_immediate_value(immediate_value)
+    {}
+
+    void execute(Runtime::Interpreter&) const;
+    String to_string() const;
+
+    NODISCARD ALWAYS_INLINE Register dst_register() const { return m_dst_register; }
+    NODISCARD ALWAYS_INLINE Register lhs_register() const { return m_lhs_register; }
+    NODISCARD ALWAYS_INLINE u64 immediate_value() const { return m_immediate_value; }
+
+private:
+    Register m_dst_register;
+    Register m_lhs_register;
+    u64 m_immediate_value;
+};
+
+class CompareGreaterOrEqualInstruction : public Instruction {
+public:
+    static constexpr OpCode opcode_value = OpCode::CompareGreaterOrEqual;
+
+    ALWAYS_INLINE CompareGreaterOrEqualInstruction(Register dst_register, Register lhs_register, Register rhs_register)
+        : Instruction(opcode_value)
+        , m_dst_register(dst_register)
+        , m_lhs_register(lhs_register)
+        , m_rhs_register(rhs_register)
+    {}
+
+    void execute(Runtime::Interpreter&) const;
+    String to_string() const;
+
+    NODISCARD ALWAYS_INLINE Register dst_register() const { return m_dst_register; }
+    NODISCARD ALWAYS_INLINE Register lhs_register() const { return m_lhs_register; }
+    NODISCARD ALWAYS_INLINE Register rhs_register() const { return m_rhs_register; }
+
+private:
+    Register m_dst_register;
+    Register m_lhs_register;
+    Register m_rhs_register;
+};
+
+class CompareGreaterOrEqualSignedInstruction : public Instruction {
+public:
+    static constexpr OpCode opcode_value = OpCode::CompareGreaterOrEqualSigned;
+
+    ALWAYS_INLINE CompareGreaterOrEqualSignedInstruction(Register dst_register, Register lhs_register, Register rhs_register)
+        : Instruction(opcode_value)
+        , m_dst_register(dst_register)
+        , m_lhs_register(lhs_register)
+        , m_rhs_register(rhs_register)
+    {}
+
+    void execute(Runtime::Interpreter&) const;
+    String to_string() const;
+
+    NODISCARD ALWAYS_INLINE Register dst_register() const { return m_dst_register; }
+    NODISCARD ALWAYS_INLINE Register lhs_register() const { return m_lhs_register; }
+    NODISCARD ALWAYS_INLINE Register rhs_register() const { return m_rhs_register; }
+
+private:
+    Register m_dst_register;
+    Register m_lhs_register;
+    Register m_rhs_register;
+};
+
+class CompareGreaterSignedInstruction : public Instruction {
+public:
+    static constexpr OpCode opcode_value = OpCode::CompareGreaterSigned;
+
+    ALWAYS_INLINE CompareGreaterSignedInstruction(Register dst_register, Register lhs_register, Register rhs_register)
+        : Instruction(opcode_value)
+        , m_dst_register(dst_register)
+        , m_lhs_register(lhs_register)
+        , m_rhs_register(rhs_register)
+    {}
+
+    void execute(Runtime::Interpreter&) const;
+    String to_string() const;
+
+    NODISCARD ALWAYS_INLINE Register dst_register() const { return m_dst_register; }
+    NODISCARD ALWAYS_INLINE Register lhs_register() const { return m_lhs_register; }
+    NODISCARD ALWAYS_INLINE Register rhs_register() const { return m_rhs_register; }
+
+private:
+    Register m_dst_register;
+    Register m_lhs_register;
+    Register m_rhs_register;
+};
+
+class CompareLessInstruction : public Instruction {
+public:
+    static constexpr OpCode opcode_value = OpCode::CompareLess;
+
+    ALWAYS_INLINE CompareLessInstruction(Register dst_register, Register lhs_register, Register rhs_register)
+        : Instruction(opcode_value)
+        , m_dst_register(dst_register)
+        , m_lhs_register(lhs_register)
+        , m_rhs_register(rhs_register)
+    {}
+
+    void execute(Runtime::Interpreter&) const;
+    String to_string() const;
+
+    NODISCARD ALWAYS_INLINE Register dst_register() const { return m_dst_register; }
+    NODISCARD ALWAYS_INLINE Register lhs_register() const { return m_lhs_register; }
+    NODISCARD ALWAYS_INLINE Register rhs_register() const { return m_rhs_register; }
+
+private:
+    Register m_dst_register;
+    Register m_lhs_register;
+    Register m_rhs_register;
+};
+
+class CompareLessOrEqualInstruction : public Instruction {
+public:
+    static constexpr OpCode opcode_value = OpCode::CompareLessOrEqual;
+
+    ALWAYS_INLINE CompareLessOrEqualInstruction(Register dst_register, Register lhs_register, Register rhs_register)
+        : Instruction(opcode_value)
+        , m_dst_register(dst_register)
+        , m_lhs_register(lhs_register)
+        , m_rhs_register(rhs_register)
+    {}
+
+    void execute(Runtime::Interpreter&) const;
+    String to_string() const;
+
+    NODISCARD ALWAYS_INLINE Register dst_register() const { return m_dst_register; }
+    NODISCARD ALWAYS_INLINE Register lhs_register() const { return m_lhs_register; }
+    NODISCARD ALWAYS_INLINE Register rhs_register() const { return m_rhs_register; }
+
+private:
+    Register m_dst_register;
+    Register m_lhs_register;
+    Register m_rhs_register;
+};
+
+class CompareLessOrEqualSignedInstruction : public Instruction {
+public:
+    static constexpr OpCode opcode_value = OpCode::CompareLessOrEqualSigned;
+
+    ALWAYS_INLINE CompareLessOrEqualSignedInstruction(Register dst_register, Register lhs_register, Register rhs_register)
+        : Instruction(opcode_value)
+        , m_dst_register(dst_register)
+        , m_lhs_register(lhs_register)
+        , m_rhs_register(rhs_register)
+    {}
+
+    void execute(Runtime::Interpreter&) const;
+    String to_string() const;
+
+    NODISCARD ALWAYS_INLINE Register dst_register() const { return m_dst_register; }
+    NODISCARD ALWAYS_INLINE Register lhs_register() const { return m_lhs_register; }
+    NODISCARD ALWAYS_INLINE Register rhs_register() const { return m_rhs_register; }
+
+private:
+    Register m_dst_register;
+    Register m_lhs_register;
+    Register m_rhs_register;
+};
+
+class CompareLessSignedInstruction : public Instruction {
+public:
+    static constexpr OpCode opcode_value = OpCode::CompareLessSigned;
+
+    ALWAYS_INLINE CompareLessSignedInstruction(Register dst_register, Register lhs_register, Register rhs_register)
+        : Instruction(opcode_value)
+        , m_dst_register(dst_register)
+        , m_lhs_register(lhs_register)
+        , m_rhs_register(rhs_register)
+    {}
+
+    void execute(Runtime::Interpreter&) const;
+    String to_string() const;
+
+    NODISCARD ALWAYS_INLINE Register dst_register() const { return m_dst_register; }
+    NODISCARD ALWAYS_INLINE Register lhs_register() const { return m_lhs_register; }
+    NODISCARD ALWAYS_INLINE Register rhs_register() const { return m_rhs_register; }
+
+private:
+    Register m_dst_register;
+    Register m_lhs_register;
+    Register m_rhs_register;
+};
+
+class CompareNotEqualInstruction : public Instruction {
+public:
+    static constexpr OpCode opcode_value = OpCode::CompareNotEqual;
+
+    ALWAYS_INLINE CompareNotEqualInstruction(Register dst_register, Register lhs_register, Register rhs_register)
+        : Instruction(opcode_value)
+        , m_dst_register(dst_register)
+        , m_lhs_register(lhs_register)
+        , m_rhs_register(rhs_register)
+    {}
+
+    void execute(Runtime::Interpreter&) const;
+    String to_string() const;
+
+    NODISCARD ALWAYS_INLINE Register dst_register() const { return m_dst_register; }
+    NODISCARD ALWAYS_INLINE Register lhs_register() const { return m_lhs_register; }
+    NODISCARD ALWAYS_INLINE Register rhs_register() const { return m_rhs_register; }
+
+private:
+    Register m_dst_register;
+    Register m_lhs_register;
+    Register m_rhs_register;
+};
+
+class DecrementInstruction : public Instruction {
+public:
+    static constexpr OpCode opcode_value = OpCode::Decrement;
+
+    ALWAYS_INLINE explicit DecrementInstruction(Register dst_register)
+        : Instruction(opcode_value)
+        , m_dst_register(dst_register)
+    {}
+
+    void execute(Runtime::Interpreter&) const;
+    String to_string() const;
+
+    NODISCARD ALWAYS_INLINE Register dst_register() const { return m_dst_register; }
+
+private:
+    Register m_dst_register;
+};
+
+//
+// Superinstructions. Each of them has exactly the same effect as the sequence of instructions it replaces, but
+// requires a single dispatch. They are only emitted by the optimizer, based on the opcode sequences that are
+// frequently executed (see `bytecode/superinstructions.h`).
+//
+
+class DivideInstruction : public Instruction {
+public:
+    static constexpr OpCode opcode_value = OpCode::Divide;
+
+    ALWAYS_INLINE DivideInstruction(Register dst_register, Register lhs_register, Register rhs_register)
+        : Instruction(opcode_value)
+        , m_dst_register(dst_register)
+        , m_lhs_register(lhs_register)
+        , m_rhs_register(rhs_register)
+    {}
+
+    void execute(Runtime::Interpreter&) const;
+    String to_string() const;
+
+    NODISCARD ALWAYS_INLINE Register dst_register() const { return m_dst_register; }
+    NODISCARD ALWAYS_INLINE Register lhs_register() const { return m_lhs_register; }
+    NODISCARD ALWAYS_INLINE Register rhs_register() const { return m_rhs_register; }
+
+private:
+    Register m_dst_register;
+    Register m_lhs_register;
+    Register m_rhs_register;
+};
+
+class DivideSignedInstruction : public Instruction {
+public:
+    static constexpr OpCode opcode_value = OpCode::DivideSigned;
+
+    ALWAYS_INLINE DivideSignedInstruction(Register dst_register, Register lhs_register, Register rhs_register)
+        : Instruction(opcode_value)
+        , m_dst_register(dst_register)
+        , m_lhs_register(lhs_register)
+        , m_rhs_register(rhs_register)
+    {}
+
+    void execute(Runtime::Interpreter&) const;
+    String to_string() const;
+
+    NODISCARD ALWAYS_INLINE Register dst_register() const { return m_dst_register; }
+    NODISCARD ALWAYS_INLINE Register lhs_register() const { return m_lhs_register; }
+    NODISCARD ALWAYS_INLINE Register rhs_register() const { return m_rhs_register; }
+
+private:
+    Register m_dst_register;
+    Register m_lhs_register;
+    Register m_rhs_register;
+};
+
+// CompareGreater dst, lhs, rhs + JumpIf dst, address
+class FusedCompareGreaterJumpIfInstruction : public Instruction {
+public:
+    static constexpr OpCode opcode_value = OpCode::FusedCompareGreaterJumpIf;
+
+    ALWAYS_INLINE FusedCompareGreaterJumpIfInstruction(Register dst_register, Register lhs_register, Register rhs_register,
+                                                       JumpAddress jump_address)
+        : Instruction(opcode_value)
+        , m_dst_register(dst_register)
+        , m_lhs_register(lhs_register)
+        , m_rhs_register(rhs_register)
+        , m_jump_address(jump_address)
+    {}
+
+    void execute(Runtime::Interpreter&) const;
+    String to_string() const;
+
+    NODISCARD ALWAYS_INLINE Register dst_register() const { return m_dst_register; }
+    NODISCARD ALWAYS_INLINE Register lhs_register() const { return m_lhs_register; }
+    NODISCARD ALWAYS_INLINE Register rhs_register() const { return m_rhs_register; }
+    NODISCARD ALWAYS_INLINE JumpAddress jump_address() const { return m_jump_address; }
+
+private:
+    Register m_dst_register;
+    Register m_lhs_register;
+    Register m_rhs_register;
+    JumpAddress m_jump_address;
+};
+
+// CompareGreaterImmediate dst, lhs, value + JumpIf dst, address
+class FusedCompareGreaterImmediateJumpIfInstruction : public Instruction {
+public:
+    static constexpr OpCode opcode_value = OpCode::FusedCompareGreaterImmediateJumpIf;
+
+    ALWAYS_INLINE FusedCompareGreaterImmediateJumpIfInstruction(Register dst_register, Register lhs_register, u64 immediate_value,
+                                                                JumpAddress jump_address)
+        : Instruction(opcode_value)
+        , m_dst_register(dst_register)
+        , m_lhs_register(lhs_register)
+        , m_immediate_value(immediate_value)
+        , m_jump_address(jump_address)
+    {}
+
+    void execute(Runtime::Interpreter&) const;
+    String to_string() const;
+
+    NODISCARD ALWAYS_INLINE Register dst_register() const { return m_dst_register; }
+    NODISCARD ALWAYS_INLINE Register lhs_register() const { return m_lhs_register; }
+    NODISCARD ALWAYS_INLINE u64 immediate_value() const { return m_immediate_value; }
+    NODISCARD ALWAYS_INLINE JumpAddress jump_address() const { return m_jump_address; }
+
+private:
+    Register m_dst_register;
+    Register m_lhs_register;
+    u64 m_immediate_value;
+    JumpAddress m_jump_address;
+};
+
+// LoadFromStack loaded, src + Add dst, loaded, other (in any operand order) + StoreToStack dst_offset, dst
+class FusedLoadAddStoreInstruction : public Instruction {
+public:
+    static constexpr OpCode opcode_value = OpCode::FusedLoadAddStore;
+
+    ALWAYS_INLINE FusedLoadAddStoreInstruction(Register dst_register, Register loaded_register, Register other_register,
+                                               u64 src_stack_offset, u64 dst_stack_offset)
+        : Instruction(opcode_value)
+        , m_dst_register(dst_register)
+        , m_loaded_register(loaded_register)
+        , m_other_register(other_register)
+        , m_src_stack_offset(src_stack_offset)
+        , m_dst_stack_offset(dst_stack_offset)
+    {}
+
+    void execute(Runtime::Interpreter&) const;
+    String to_string() const;
+
+    NODISCARD ALWAYS_INLINE Register dst_register() const { return m_dst_register; }
+    NODISCARD ALWAYS_INLINE Register loaded_register() const { return m_loaded_register; }
+    NODISCARD ALWAYS_INLINE Register other_register() const { return m_other_register; }
+    NODISCARD ALWAYS_INLINE u64 src_stack_offset() const { return m_src_stack_offset; }
+    NODISCARD ALWAYS_INLINE u64 dst_stack_offset() const { return m_dst_stack_offset; }
+
+private:
+    Register m_dst_register;
+    Register m_loaded_register;
+    Register m_other_register;
+    u64 m_src_stack_offset;
+    u64 m_dst_stack_offset;
+};
+
+// LoadFromStack dst, offset + Increment dst + StoreToStack offset, dst
+class FusedLoadIncrementStoreInstruction : public Instruction {
+public:
+    static constexpr OpCode opcode_value = OpCode::FusedLoadIncrementStore;
+
+    ALWAYS_INLINE FusedLoadIncrementStoreInstruction(Register dst_register, u64 stack_offset)
+        : Instruction(opcode_value)
+        , m_dst_register(dst_register)
+        , m_stack_offset(stack_offset)
+    {}
+
+    void execute(Runtime::Interpreter&) const;
+    String to_string() const;
+
+    NODISCARD ALWAYS_INLINE Register dst_register() const { return m_dst_register; }
+    NODISCARD ALWAYS_INLINE u64 stack_offset() const { return m_stack_offset; }
+
+private:
+    Register m_dst_register;
+    u64 m_stack_offset;
+};
+
+// LoadFromStack first_dst, first_src + LoadFromStack second_dst, second_src
+class FusedLoadPairInstruction : public Instruction {
+public:
+    static constexpr OpCode opcode_value = OpCode::FusedLoadPair;
+
+    ALWAYS_INLINE FusedLoadPairInstruction(Register first_dst_register, u64 first_src_stack_offset, Register second_dst_register,
+                                           u64 second_src_stack_offset)
+        : Instruction(opcode_value)
+        , m_first_dst_register(first_dst_register)
+        , m_second_dst_register(second_dst_register)
+        , m_first_src_stack_offset(first_src_stack_offset)
+        , m_second_src_stack_offset(second_src_stack_offset)
+    {}
+
+    void execute(Runtime::Interpreter&) const;
+    String to_string() const;
+
+    NODISCARD ALWAYS_INLINE Register first_dst_register() const { return m_first_dst_register; }
+    NODISCARD ALWAYS_INLINE Register second_dst_register() const { return m_second_dst_register; }
+    NODISCARD ALWAYS_INLINE u64 first_src_stack_offset() const { return m_first_src_stack_offset; }
+    NODISCARD ALWAYS_INLINE u64 second_src_stack_offset() const { return m_second_src_stack_offset; }
+
+private:
+    Register m_first_dst_register;
+    Register m_second_dst_register;
+    u64 m_first_src_stack_offset;
+    u64 m_second_src_stack_offset;
+};
+
+// LoadFromStack dst, src + StoreToStack dst_offset, dst
+class FusedLoadStoreInstruction : public Instruction {
+public:
+    static constexpr OpCode opcode_value = OpCode::FusedLoadStore;
+
+    ALWAYS_INLINE FusedLoadStoreInstruction(Register dst_register, u64 src_stack_offset, u64 dst_stack_offset)
+        : Instruction(opcode_value)
+        , m_dst_register(dst_register)
+        , m_src_stack_offset(src_stack_offset)
+        , m_dst_stack_offset(dst_stack_offset)
+    {}
+
+    void execute(Runtime::Interpreter&) const;
+    String to_string() const;
+
+    NODISCARD ALWAYS_INLINE Register dst_register() const { return m_dst_register; }
+    NODISCARD ALWAYS_INLINE u64 src_stack_offset() const { return m_src_stack_offset; }
+    NODISCARD ALWAYS_INLINE u64 dst_stack_offset() const { return m_dst_stack_offset; }
+
+private:
+    Register m_dst_register;
+    u64 m_src_stack_offset;
+    u64 m_dst_stack_offset;
+};
+
+class IncrementInstruction : public Instruction {
+public:
+    static constexpr OpCode opcode_value = OpCode::Increment;
+
+    ALWAYS_INLINE explicit IncrementInstruction(Register dst_register)
+        : Instruction(opcode_value)
+        , m_dst_register(dst_register)
+    {}
+
+    void execute(Runtime::Interpreter&) const;
+    String to_string() const;
+
+    NODISCARD ALWAYS_INLINE Register dst_register() const { return m_dst_register; }
+
+private:
+    Register m_dst_register;
+};
+
+class JumpInstruction : public Instruction {
+public:
+    static constexpr OpCode opcode_value = OpCode::Jump;
+
+    ALWAYS_INLINE explicit JumpInstruction(JumpAddress jump_address)
+        : Instruction(opcode_value)
+        , m_jump_address(jump_address)
+    {}
+
+    void execute(Runtime::Interpreter&) const;
+    String to_string() const;
+
+    NODISCARD ALWAYS_INLINE JumpAddress jump_address() const { return m_jump_address; }
+
+private:
+    JumpAddress m_jump_address;
+};
+
+class JumpIfInstruction : public Instruction {
+public:
+    static constexpr OpCode opcode_value = OpCode::JumpIf;
+
+    ALWAYS_INLINE JumpIfInstruction(Register condition_register, JumpAddress jump_address)
+        : Instruction(opcode_value)
+        , m_condition_register(condition_register)
+        , m_jump_address(jump_address)
+    {}
+
+    void execute(Runtime::Interpreter&) const;
+    String to_string() const;
+
+    NODISCARD ALWAYS_INLINE Register condition_register() const { return m_condition_register; }
+    NODISCARD ALWAYS_INLINE JumpAddress jump_address() const { return m_jump_address; }
+
+private:
+    Register m_condition_register;
+    JumpAddress m_jump_address;
+};
+
+// NOTE: Jumps to the target stored in the entry of the jump table selected by the index register. The entries of a
+//       jump table are stored in the package (see `Package::add_jump_table`) and are referenced by the index of their
+//       first entry. Indices that are outside the table jump to the default address instead.
+class JumpTableInstruction : public Instruction {
+public:
+    static constexpr OpCode opcode_value = OpCode::JumpTable;
+
+    ALWAYS_INLINE JumpTableInstruction(Register index_register, u32 first_entry_index, u32 entry_count, JumpAddress default_address)
+        : Instruction(opcode_value)
+        , m_index_register(index_register)
+        , m_first_entry_index(first_entry_index)
+        , m_entry_count(entry_count)
+        , m_default_address(default_address)
+    {}
+
+    void execute(Runtime::Interpreter&) const;
+    String to_string() const;
+
+    NODISCARD ALWAYS_INLINE Register index_register() const { return m_index_register; }
+    NODISCARD ALWAYS_INLINE u32 first_entry_index() const { return m_first_entry_index; }
+    NODISCARD ALWAYS_INLINE u32 entry_count() const { return m_entry_count; }
+    NODISCARD ALWAYS_INLINE JumpAddress default_address() const { return m_default_address; }
+
+private:
+    Register m_index_register;
+    u32 m_first_entry_index;
+    u32 m_entry_count;
+    JumpAddress m_default_address;
+};
+
+// NOTE: The frame offset is relative to the frame pointer of the current function. See `VirtualStack::at_frame_offset`.
+class LoadFromFrameInstruction : public Instruction {
+public:
+    static constexpr OpCode opcode_value = OpCode::LoadFromFrame;
+
+    ALWAYS_INLINE LoadFromFrameInstruction(Register dst_register, s64 src_frame_offset)
+        : Instruction(opcode_value)
+        , m_dst_register(dst_register)
+        , m_src_frame_offset(src_frame_offset)
+    {}
+
+    void execute(Runtime::Interpreter&) const;
+    String to_string() const;
+
+    NODISCARD ALWAYS_INLINE Register dst_register() const { return m_dst_register; }
+    NODISCARD ALWAYS_INLINE s64 src_frame_offset() const { return m_src_frame_offset; }
+
+private:
+    Register m_dst_register;
+    s64 m_src_frame_offset;
+};
+
+class LoadFromStackInstruction : public Instruction {
+public:
+    static constexpr OpCode opcode_value = OpCode::LoadFromStack;
+
+    ALWAYS_INLINE LoadFromStackInstruction(Register dst_register, u64 src_stack_offset)
+        : Instruction(opcode_value)
+        , m_dst_register(dst_register)
+        , m_src_stack_offset(src_stack_offset)
+    {}
+
+    void execute(Runtime::Interpreter&) const;
+    String to_string() const;
+
+    NODISCARD ALWAYS_INLINE Register dst_register() const { return m_dst_register; }
+    NODISCARD ALWAYS_INLINE u64 src_stack_offset() const { return m_src_stack_offset; }
+
+private:
+    Register m_dst_register;
+    u64 m_src_stack_offset;
+};
 
+class Load8FromStackInstruction : public Instruction {
 public:
-    Instruction() = default;
-    virtual ~Instruction() = default;
+    static constexpr OpCode opcode_value = OpCode::Load8FromStack;
+
+    ALWAYS_INLINE Load8FromStackInstruction(Register dst_register, u64 src_stack_offset)
+        : Instruction(opcode_value)
+        , m_dst_register(dst_register)
+        , m_src_stack_offset(src_stack_offset)
+    {}
+
+    void execute(Runtime::Interpreter&) const;
+    String to_string() const;
 
-    virtual void execute(Runtime::Interpreter&) const = 0;
-    virtual String to_string() const = 0;
+    NODISCARD ALWAYS_INLINE Register dst_register() const { return m_dst_register; }
+    NODISCARD ALWAYS_INLINE u64 src_stack_offset() const { return m_src_stack_offset; }
+
+private:
+    Register m_dst_register;
+    u64 m_src_stack_offset;
 };
 
-class AddInstruction : public Instruction {
+class Load16FromStackInstruction : public Instruction {
 public:
-    ALWAYS_INLINE AddInstruction(Register dst_register, Register lhs_register, Register rhs_register)
-        : m_dst_register(dst_register)
-        , m_lhs_register(lhs_register)
-        , m_rhs_register(rhs_register)
+    static constexpr OpCode opcode_value = OpCode::Load16FromStack;
+
+    ALWAYS_INLINE Load16FromStackInstruction(Register dst_register, u64 src_stack_offset)
+        : Instruction(opcode_value)
+        , m_dst_register(dst_register)
+        , m_src_stack_offset(src_stack_offset)
     {}
 
-    virtual ~AddInstruction() override = default;
+    void execute(Runtime::Interpreter&) const;
+    String to_string() const;
 
-    virtual void execute(Runtime::Interpreter&) const override;
-    virtual String to_string() const override;
+    NODISCARD ALWAYS_INLINE Register dst_register() const { return m_dst_register; }
+    NODISCARD ALWAYS_INLINE u64 src_stack_offset() const { return m_src_stack_offset; }
 
 private:
     Register m_dst_register;
-    Register m_lhs_register;
-    Register m_rhs_register;
+    u64 m_src_stack_offset;
 };
 
-class CallInstruction : public Instruction {
+class Load32FromStackInstruction : public Instruction {
 public:
-    explicit CallInstruction(JumpAddress callee_address, u64 parameters_byte_count)
-        : m_callee_address(callee_address)
-        , m_parameters_byte_count(parameters_byte_count)
+    static constexpr OpCode opcode_value = OpCode::Load32FromStack;
+
+    ALWAYS_INLINE Load32FromStackInstruction(Register dst_register, u64 src_stack_offset)
+        : Instruction(opcode_value)
+        , m_dst_register(dst_register)
+        , m_src_stack_offset(src_stack_offset)
     {}
 
-    virtual ~CallInstruction() override = default;
+    void execute(Runtime::Interpreter&) const;
+    String to_string() const;
 
-    virtual void execute(Runtime::Interpreter&) const override;
-    virtual String to_string() const override;
+    NODISCARD ALWAYS_INLINE Register dst_register() const { return m_dst_register; }
+    NODISCARD ALWAYS_INLINE u64 src_stack_offset() const { return m_src_stack_offset; }
 
 private:
-    JumpAddress m_callee_address;
-    u64 m_parameters_byte_count;
+    Register m_dst_register;
+    u64 m_src_stack_offset;
 };
 
-class CompareGreaterInstruction : public Instruction {
+class LoadImmediate8Instruction : public Instruction {
 public:
-    ALWAYS_INLINE CompareGreaterInstruction(Register dst_register, Register lhs_register, Register rhs_register)
-        : m_dst_register(dst_register)
-        , m_lhs_register(lhs_register)
-        , m_rhs_register(rhs_register)
+    static constexpr OpCode opcode_value = OpCode::LoadImmediate8;
+
+    ALWAYS_INLINE LoadImmediate8Instruction(Register dst_register, u8 immediate_value)
+        : Instruction(opcode_value)
+        , m_dst_register(dst_register)
+        , m_immediate_value(immediate_value)
     {}
 
-    virtual ~CompareGreaterInstruction() override = default;
+    void execute(Runtime::Interpreter&) const;
+    String to_string() const;
 
-    virtual void execute(Runtime::Interpreter&) const override;
-    virtual String to_string() const override;
+    NODISCARD ALWAYS_INLINE Register dst_register() const { return m_dst_register; }
+    NODISCARD ALWAYS_INLINE u8 immediate_value() const { return m_immediate_value; }
 
 private:
     Register m_dst_register;
-    Register m_lhs_register;
-    Register m_rhs_register;
+    u8 m_immediate_value;
 };
 
-class DecrementInstruction : public Instruction {
+class LoadImmediate16Instruction : public Instruction {
 public:
-    ALWAYS_INLINE explicit DecrementInstruction(Register dst_register)
-        : m_dst_register(dst_register)
+    static constexpr OpCode opcode_value = OpCode::LoadImmediate16;
+
+    ALWAYS_INLINE LoadImmediate16Instruction(Register dst_register, u16 immediate_value)
+        : Instruction(opcode_value)
+        , m_dst_register(dst_register)
+        , m_immediate_value(immediate_value)
     {}
 
-    virtual ~DecrementInstruction() override = default;
+    void execute(Runtime::Interpreter&) const;
+    String to_string() const;
 
-    virtual void execute(Runtime::Interpreter&) const override;
-    virtual String to_string() const override;
+    NODISCARD ALWAYS_INLINE Register dst_register() const { return m_dst_register; }
+    NODISCARD ALWAYS_INLINE u16 immediate_value() const { return m_immediate_value; }
 
 private:
     Register m_dst_register;
+    u16 m_immediate_value;
 };
 
-class IncrementInstruction : public Instruction {
+class LoadImmediate32Instruction : public Instruction {
 public:
-    ALWAYS_INLINE explicit IncrementInstruction(Register dst_register)
-        : m_dst_register(dst_register)
+    static constexpr OpCode opcode_value = OpCode::LoadImmediate32;
+
+    ALWAYS_INLINE LoadImmediate32Instruction(Register dst_register, u32 immediate_value)
+        : Instruction(opcode_value)
+        , m_dst_register(dst_register)
+        , m_immediate_value(immediate_value)
     {}
 
-    virtual ~IncrementInstruction() override = default;
+    void execute(Runtime::Interpreter&) const;
+    String to_string() const;
 
-    virtual void execute(Runtime::Interpreter&) const override;
-    virtual String to_string() const override;
+    NODISCARD ALWAYS_INLINE Register dst_register() const { return m_dst_register; }
+    NODISCARD ALWAYS_INLINE u32 immediate_value() const { return m_immediate_value; }
 
 private:
     Register m_dst_register;
+    u32 m_immediate_value;
 };
 
-class JumpInstruction : public Instruction {
+class LoadImmediate64Instruction : public Instruction {
 public:
-    ALWAYS_INLINE explicit JumpInstruction(JumpAddress jump_address)
-        : m_jump_address(jump_address)
+    static constexpr OpCode opcode_value = OpCode::LoadImmediate64;
+
+    ALWAYS_INLINE LoadImmediate64Instruction(Register dst_register, u64 immediate_value)
+        : Instruction(opcode_value)
+        , m_dst_register(dst_register)
+        , m_immediate_value(immediate_value)
     {}
 
-    virtual ~JumpInstruction() override = default;
+    void execute(Runtime::Interpreter&) const;
+    String to_string() const;
 
-    virtual void execute(Runtime::Interpreter&) const override;
-    virtual String to_string() const override;
+    NODISCARD ALWAYS_INLINE Register dst_register() const { return m_dst_register; }
+    NODISCARD ALWAYS_INLINE u64 immediate_value() const { return m_immediate_value; }
 
 private:
-    JumpAddress m_jump_address;
+    Register m_dst_register;
+    u64 m_immediate_value;
 };
 
-class JumpIfInstruction : public Instruction {
+class LogicalANDInstruction : public Instruction {
 public:
-    ALWAYS_INLINE JumpIfInstruction(Register condition_register, JumpAddress jump_address)
-        : m_condition_register(condition_register)
-        , m_jump_address(jump_address)
+    static constexpr OpCode opcode_value = OpCode::LogicalAND;
+
+    ALWAYS_INLINE LogicalANDInstruction(Register dst_register, Register lhs_register, Register rhs_register)
+        : Instruction(opcode_value)
+        , m_dst_register(dst_register)
+        , m_lhs_register(lhs_register)
+        , m_rhs_register(rhs_register)
     {}
 
-    virtual ~JumpIfInstruction() override = default;
+    void execute(Runtime::Interpreter&) const;
+    String to_string() const;
 
-    virtual void execute(Runtime::Interpreter&) const override;
-    virtual String to_string() const override;
+    NODISCARD ALWAYS_INLINE Register dst_register() const { return m_dst_register; }
+    NODISCARD ALWAYS_INLINE Register lhs_register() const { return m_lhs_register; }
+    NODISCARD ALWAYS_INLINE Register rhs_register() const { return m_rhs_register; }
 
 private:
-    Register m_condition_register;
-    JumpAddress m_jump_address;
+    Register m_dst_register;
+    Register m_lhs_register;
+    Register m_rhs_register;
 };
 
-class LoadFromStackInstruction : public Instruction {
+class LogicalNOTInstruction : public Instruction {
 public:
-    ALWAYS_INLINE LoadFromStackInstruction(Register dst_register, u64 src_stack_offset)
-        : m_dst_register(dst_register)
-        , m_src_stack_offset(src_stack_offset)
+    static constexpr OpCode opcode_value = OpCode::LogicalNOT;
+
+    ALWAYS_INLINE LogicalNOTInstruction(Register dst_register, Register src_register)
+        : Instruction(opcode_value)
+        , m_dst_register(dst_register)
+        , m_src_register(src_register)
     {}
 
-    virtual ~LoadFromStackInstruction() override = default;
+    void execute(Runtime::Interpreter&) const;
+    String to_string() const;
 
-    virtual void execute(Runtime::Interpreter&) const override;
-    virtual String to_string() const override;
+    NODISCARD ALWAYS_INLINE Register dst_register() const { return m_dst_register; }
+    NODISCARD ALWAYS_INLINE Register src_register() const { return m_src_register; }
 
 private:
     Register m_dst_register;
-    u64 m_src_stack_offset;
+    Register m_src_register;
 };
 
-class Load8FromStackInstruction : public Instruction {
+class LogicalORInstruction : public Instruction {
 public:
-    ALWAYS_INLINE Load8FromStackInstruction(Register dst_register, u64 src_stack_offset)
-        : m_dst_register(dst_register)
-        , m_src_stack_offset(src_stack_offset)
+    static constexpr OpCode opcode_value = OpCode::LogicalOR;
+
+    ALWAYS_INLINE LogicalORInstruction(Register dst_register, Register lhs_register, Register rhs_register)
+        : Instruction(opcode_value)
+        , m_dst_register(dst_register)
+        , m_lhs_register(lhs_register)
+        , m_rhs_register(rhs_register)
     {}
 
-    virtual ~Load8FromStackInstruction() override = default;
+    void execute(Runtime::Interpreter&) const;
+    String to_string() const;
 
-    virtual void execute(Runtime::Interpreter&) const override;
-    virtual String to_string() const override;
+    NODISCARD ALWAYS_INLINE Register dst_register() const { return m_dst_register; }
+    NODISCARD ALWAYS_INLINE Register lhs_register() const { return m_lhs_register; }
+    NODISCARD ALWAYS_INLINE Register rhs_register() const { return m_rhs_register; }
 
 private:
     Register m_dst_register;
-    u64 m_src_stack_offset;
+    Register m_lhs_register;
+    Register m_rhs_register;
 };
 
-class Load16FromStackInstruction : public Instruction {
+class LogicalXORInstruction : public Instruction {
 public:
-    ALWAYS_INLINE Load16FromStackInstruction(Register dst_register, u64 src_stack_offset)
-        : m_dst_register(dst_register)
-        , m_src_stack_offset(src_stack_offset)
+    static constexpr OpCode opcode_value = OpCode::LogicalXOR;
+
+    ALWAYS_INLINE LogicalXORInstruction(Register dst_register, Register lhs_register, Register rhs_register)
+        : Instruction(opcode_value)
+        , m_dst_register(dst_register)
+        , m_lhs_register(lhs_register)
+        , m_rhs_register(rhs_register)
     {}
 
-    virtual ~Load16FromStackInstruction() override = default;
+    void execute(Runtime::Interpreter&) const;
+    String to_string() const;
 
-    virtual void execute(Runtime::Interpreter&) const override;
-    virtual String to_string() const override;
+    NODISCARD ALWAYS_INLINE Register dst_register() const { return m_dst_register; }
+    NODISCARD ALWAYS_INLINE Register lhs_register() const { return m_lhs_register; }
+    NODISCARD ALWAYS_INLINE Register rhs_register() const { return m_rhs_register; }
 
 private:
     Register m_dst_register;
-    u64 m_src_stack_offset;
+    Register m_lhs_register;
+    Register m_rhs_register;
 };
 
-class Load32FromStackInstruction : public Instruction {
+class MoveInstruction : public Instruction {
 public:
-    ALWAYS_INLINE Load32FromStackInstruction(Register dst_register, u64 src_stack_offset)
-        : m_dst_register(dst_register)
-        , m_src_stack_offset(src_stack_offset)
+    static constexpr OpCode opcode_value = OpCode::Move;
+
+    ALWAYS_INLINE MoveInstruction(Register dst_register, Register src_register)
+        : Instruction(opcode_value)
+        , m_dst_register(dst_register)
+        , m_src_register(src_register)
     {}
 
-    virtual ~Load32FromStackInstruction() override = default;
+    void execute(Runtime::Interpreter&) const;
+    String to_string() const;
 
-    virtual void execute(Runtime::Interpreter&) const override;
-    virtual String to_string() const override;
+    NODISCARD ALWAYS_INLINE Register dst_register() const { return m_dst_register; }
+    NODISCARD ALWAYS_INLINE Register src_register() const { return m_src_register; }
 
 private:
     Register m_dst_register;
-    u64 m_src_stack_offset;
+    Register m_src_register;
 };
 
-class LoadImmediate8Instruction : public Instruction {
+class MultiplyInstruction : public Instruction {
 public:
-    ALWAYS_INLINE LoadImmediate8Instruction(Register dst_register, u8 immediate_value)
-        : m_dst_register(dst_register)
-        , m_immediate_value(immediate_value)
+    static constexpr OpCode opcode_value = OpCode::Multiply;
+
+    ALWAYS_INLINE MultiplyInstruction(Register dst_register, Register lhs_register, Register rhs_register)
+        : Instruction(opcode_value)
+        , m_dst_register(dst_register)
+        , m_lhs_register(lhs_register)
+        , m_rhs_register(rhs_register)
     {}
 
-    virtual ~LoadImmediate8Instruction() override = default;
+    void execute(Runtime::Interpreter&) const;
+    String to_string() const;
 
-    virtual void execute(Runtime::Interpreter&) const override;
-    virtual String to_string() const override;
+    NODISCARD ALWAYS_INLINE Register dst_register() const { return m_dst_register; }
+    NODISCARD ALWAYS_INLINE Register lhs_register() const { return m_lhs_register; }
+    NODISCARD ALWAYS_INLINE Register rhs_register() const { return m_rhs_register; }
 
 private:
     Register m_dst_register;
-    u8 m_immediate_value;
+    Register m_lhs_register;
+    Register m_rhs_register;
+};
+
+class NegateInstruction : public Instruction {
+public:
+    static constexpr OpCode opcode_value = OpCode::Negate;
+
+    ALWAYS_INLINE NegateInstruction(Register dst_register, Register src_register)
+        : Instruction(opcode_value)
+        , m_dst_register(dst_register)
+        , m_src_register(src_register)
+    {}
+
+    void execute(Runtime::Interpreter&) const;
+    String to_string() const;
+
+    NODISCARD ALWAYS_INLINE Register dst_register() const { return m_dst_register; }
+    NODISCARD ALWAYS_INLINE Register src_register() const { return m_src_register; }
+
+private:
+    Register m_dst_register;
+    Register m_src_register;
 };
 
 class PopInstruction : public Instruction {
 public:
+    static constexpr OpCode opcode_value = OpCode::Pop;
+
     ALWAYS_INLINE explicit PopInstruction(u64 pop_byte_count)
-        : m_pop_byte_count(pop_byte_count)
+        : Instruction(opcode_value)
+        , m_pop_byte_count(pop_byte_count)
     {}
 
-    virtual ~PopInstruction() override = default;
+    void execute(Runtime::Interpreter&) const;
+    String to_string() const;
 
-    virtual void execute(Runtime::Interpreter&) const override;
-    virtual String to_string() const override;
+    NODISCARD ALWAYS_INLINE u64 pop_byte_count() const { return m_pop_byte_count; }
 
 private:
     u64 m_pop_byte_count;
@@ -243,23 +1401,44 @@ private:
 
 class PopRegisterInstruction : public Instruction {
 public:
-    PopRegisterInstruction() = default;
-    virtual ~PopRegisterInstruction() override = default;
+    static constexpr OpCode opcode_value = OpCode::PopRegister;
+
+    ALWAYS_INLINE PopRegisterInstruction()
+        : Instruction(opcode_value)
+    {}
+
+    void execute(Runtime::Interpreter&) const;
+    String to_string() const;
+};
+
+// NOTE: Marks the function that starts at this instruction as pure, which means that its result only depends on its
+//       register arguments and that it has no other observable effects. Calls to pure functions can be answered from
+//       the memoization cache of the virtual machine. Executing the instruction itself has no effect.
+class PureFunctionEntryInstruction : public Instruction {
+public:
+    static constexpr OpCode opcode_value = OpCode::PureFunctionEntry;
+
+    ALWAYS_INLINE PureFunctionEntryInstruction()
+        : Instruction(opcode_value)
+    {}
 
-    virtual void execute(Runtime::Interpreter&) const override;
-    virtual String to_string() const override;
+    void execute(Runtime::Interpreter&) const;
+    String to_string() const;
 };
 
 class PushInstruction : public Instruction {
 public:
+    static constexpr OpCode opcode_value = OpCode::Push;
+
     ALWAYS_INLINE explicit PushInstruction(u64 push_byte_count)
-        : m_push_byte_count(push_byte_count)
+        : Instruction(opcode_value)
+        , m_push_byte_count(push_byte_count)
     {}
 
-    virtual ~PushInstruction() override = default;
+    void execute(Runtime::Interpreter&) const;
+    String to_string() const;
 
-    virtual void execute(Runtime::Interpreter&) const override;
-    virtual String to_string() const override;
+    NODISCARD ALWAYS_INLINE u64 push_byte_count() const { return m_push_byte_count; }
 
 private:
     u64 m_push_byte_count;
@@ -267,14 +1446,17 @@ private:
 
 class PushImmediate8Instruction : public Instruction {
 public:
+    static constexpr OpCode opcode_value = OpCode::PushImmediate8;
+
     ALWAYS_INLINE explicit PushImmediate8Instruction(u8 immediate_value)
-        : m_immediate_value(immediate_value)
+        : Instruction(opcode_value)
+        , m_immediate_value(immediate_value)
     {}
 
-    virtual ~PushImmediate8Instruction() override = default;
+    void execute(Runtime::Interpreter&) const;
+    String to_string() const;
 
-    virtual void execute(Runtime::Interpreter&) const override;
-    virtual String to_string() const override;
+    NODISCARD ALWAYS_INLINE u8 immediate_value() const { return m_immediate_value; }
 
 private:
     u8 m_immediate_value;
@@ -282,14 +1464,17 @@ private:
 
 class PushImmediate16Instruction : public Instruction {
 public:
+    static constexpr OpCode opcode_value = OpCode::PushImmediate16;
+
     ALWAYS_INLINE explicit PushImmediate16Instruction(u16 immediate_value)
-        : m_immediate_value(immediate_value)
+        : Instruction(opcode_value)
+        , m_immediate_value(immediate_value)
     {}
 
-    virtual ~PushImmediate16Instruction() override = default;
+    void execute(Runtime::Interpreter&) const;
+    String to_string() const;
 
-    virtual void execute(Runtime::Interpreter&) const override;
-    virtual String to_string() const override;
+    NODISCARD ALWAYS_INLINE u16 immediate_value() const { return m_immediate_value; }
 
 private:
     u16 m_immediate_value;
@@ -297,14 +1482,17 @@ private:
 
 class PushImmediate32Instruction : public Instruction {
 public:
+    static constexpr OpCode opcode_value = OpCode::PushImmediate32;
+
     ALWAYS_INLINE explicit PushImmediate32Instruction(u32 immediate_value)
-        : m_immediate_value(immediate_value)
+        : Instruction(opcode_value)
+        , m_immediate_value(immediate_value)
     {}
 
-    virtual ~PushImmediate32Instruction() override = default;
+    void execute(Runtime::Interpreter&) const;
+    String to_string() const;
 
-    virtual void execute(Runtime::Interpreter&) const override;
-    virtual String to_string() const override;
+    NODISCARD ALWAYS_INLINE u32 immediate_value() const { return m_immediate_value; }
 
 private:
     u32 m_immediate_value;
@@ -312,14 +1500,17 @@ private:
 
 class PushImmediate64Instruction : public Instruction {
 public:
+    static constexpr OpCode opcode_value = OpCode::PushImmediate64;
+
     ALWAYS_INLINE explicit PushImmediate64Instruction(u64 immediate_value)
-        : m_immediate_value(immediate_value)
+        : Instruction(opcode_value)
+        , m_immediate_value(immediate_value)
     {}
 
-    virtual ~PushImmediate64Instruction() override = default;
+    void execute(Runtime::Interpreter&) const;
+    String to_string() const;
 
-    virtual void execute(Runtime::Interpreter&) const override;
-    virtual String to_string() const override;
+    NODISCARD ALWAYS_INLINE u64 immediate_value() const { return m_immediate_value; }
 
 private:
     u64 m_immediate_value;
@@ -327,14 +1518,17 @@ private:
 
 class PushRegisterInstruction : public Instruction {
 public:
+    static constexpr OpCode opcode_value = OpCode::PushRegister;
+
     ALWAYS_INLINE explicit PushRegisterInstruction(Register src_register)
-        : m_src_register(src_register)
+        : Instruction(opcode_value)
+        , m_src_register(src_register)
     {}
 
-    virtual ~PushRegisterInstruction() override = default;
+    void execute(Runtime::Interpreter&) const;
+    String to_string() const;
 
-    virtual void execute(Runtime::Interpreter&) const override;
-    virtual String to_string() const override;
+    NODISCARD ALWAYS_INLINE Register src_register() const { return m_src_register; }
 
 private:
     Register m_src_register;
@@ -342,24 +1536,134 @@ private:
 
 class ReturnInstruction : public Instruction {
 public:
-    ALWAYS_INLINE ReturnInstruction() {}
-    virtual ~ReturnInstruction() override = default;
+    static constexpr OpCode opcode_value = OpCode::Return;
+
+    ALWAYS_INLINE ReturnInstruction()
+        : Instruction(opcode_value)
+    {}
+
+    void execute(Runtime::Interpreter&) const;
+    String to_string() const;
+};
+
+class ReturnValueInstruction : public Instruction {
+public:
+    static constexpr OpCode opcode_value = OpCode::ReturnValue;
+
+    ALWAYS_INLINE ReturnValueInstruction(Register src_register)
+        : Instruction(opcode_value)
+        , m_src_register(src_register)
+    {}
+
+    void execute(Runtime::Interpreter&) const;
+    String to_string() const;
+
+    NODISCARD ALWAYS_INLINE Register src_register() const { return m_src_register; }
+
+private:
+    Register m_src_register;
+};
+
+class SignExtend8Instruction : public Instruction {
+public:
+    static constexpr OpCode opcode_value = OpCode::SignExtend8;
+
+    ALWAYS_INLINE SignExtend8Instruction(Register dst_register, Register src_register)
+        : Instruction(opcode_value)
+        , m_dst_register(dst_register)
+        , m_src_register(src_register)
+    {}
+
+    void execute(Runtime::Interpreter&) const;
+    String to_string() const;
+
+    NODISCARD ALWAYS_INLINE Register dst_register() const { return m_dst_register; }
+    NODISCARD ALWAYS_INLINE Register src_register() const { return m_src_register; }
+
+private:
+    Register m_dst_register;
+    Register m_src_register;
+};
+
+class SignExtend16Instruction : public Instruction {
+public:
+    static constexpr OpCode opcode_value = OpCode::SignExtend16;
+
+    ALWAYS_INLINE SignExtend16Instruction(Register dst_register, Register src_register)
+        : Instruction(opcode_value)
+        , m_dst_register(dst_register)
+        , m_src_register(src_register)
+    {}
+
+    void execute(Runtime::Interpreter&) const;
+    String to_string() const;
+
+    NODISCARD ALWAYS_INLINE Register dst_register() const { return m_dst_register; }
+    NODISCARD ALWAYS_INLINE Register src_register() const { return m_src_register; }
+
+private:
+    Register m_dst_register;
+    Register m_src_register;
+};
+
+class SignExtend32Instruction : public Instruction {
+public:
+    static constexpr OpCode opcode_value = OpCode::SignExtend32;
+
+    ALWAYS_INLINE SignExtend32Instruction(Register dst_register, Register src_register)
+        : Instruction(opcode_value)
+        , m_dst_register(dst_register)
+        , m_src_register(src_register)
+    {}
+
+    void execute(Runtime::Interpreter&) const;
+    String to_string() const;
+
+    NODISCARD ALWAYS_INLINE Register dst_register() const { return m_dst_register; }
+    NODISCARD ALWAYS_INLINE Register src_register() const { return m_src_register; }
+
+private:
+    Register m_dst_register;
+    Register m_src_register;
+};
+
+// NOTE: The frame offset is relative to the frame pointer of the current function. See `VirtualStack::at_frame_offset`.
+class StoreToFrameInstruction : public Instruction {
+public:
+    static constexpr OpCode opcode_value = OpCode::StoreToFrame;
+
+    ALWAYS_INLINE StoreToFrameInstruction(s64 dst_frame_offset, Register src_register)
+        : Instruction(opcode_value)
+        , m_dst_frame_offset(dst_frame_offset)
+        , m_src_register(src_register)
+    {}
+
+    void execute(Runtime::Interpreter&) const;
+    String to_string() const;
+
+    NODISCARD ALWAYS_INLINE s64 dst_frame_offset() const { return m_dst_frame_offset; }
+    NODISCARD ALWAYS_INLINE Register src_register() const { return m_src_register; }
 
-    virtual void execute(Runtime::Interpreter&) const override;
-    virtual String to_string() const override;
+private:
+    s64 m_dst_frame_offset;
+    Register m_src_register;
 };
 
 class StoreToStackInstruction : public Instruction {
 public:
+    static constexpr OpCode opcode_value = OpCode::StoreToStack;
+
     ALWAYS_INLINE StoreToStackInstruction(u64 dst_stack_offset, Register src_register)
-        : m_dst_stack_offset(dst_stack_offset)
+        : Instruction(opcode_value)
+        , m_dst_stack_offset(dst_stack_offset)
         , m_src_register(src_register)
     {}
 
-    virtual ~StoreToStackInstruction() override = default;
+    void execute(Runtime::Interpreter&) const;
+    String to_string() const;
 
-    virtual void execute(Runtime::Interpreter&) const override;
-    virtual String to_string() const override;
+    NODISCARD ALWAYS_INLINE u64 dst_stack_offset() const { return m_dst_stack_offset; }
+    NODISCARD ALWAYS_INLINE Register src_register() const { return m_src_register; }
 
 private:
     u64 m_dst_stack_offset;
@@ -368,15 +1672,19 @@ private:
 
 class Store8ToStackInstruction : public Instruction {
 public:
+    static constexpr OpCode opcode_value = OpCode::Store8ToStack;
+
     ALWAYS_INLINE Store8ToStackInstruction(u64 dst_stack_offset, Register src_register)
-        : m_dst_stack_offset(dst_stack_offset)
+        : Instruction(opcode_value)
+        , m_dst_stack_offset(dst_stack_offset)
         , m_src_register(src_register)
     {}
 
-    virtual ~Store8ToStackInstruction() override = default;
+    void execute(Runtime::Interpreter&) const;
+    String to_string() const;
 
-    virtual void execute(Runtime::Interpreter&) const override;
-    virtual String to_string() const override;
+    NODISCARD ALWAYS_INLINE u64 dst_stack_offset() const { return m_dst_stack_offset; }
+    NODISCARD ALWAYS_INLINE Register src_register() const { return m_src_register; }
 
 private:
     u64 m_dst_stack_offset;
@@ -385,15 +1693,19 @@ private:
 
 class Store16ToStackInstruction : public Instruction {
 public:
+    static constexpr OpCode opcode_value = OpCode::Store16ToStack;
+
     ALWAYS_INLINE Store16ToStackInstruction(u64 dst_stack_offset, Register src_register)
-        : m_dst_stack_offset(dst_stack_offset)
+        : Instruction(opcode_value)
+        , m_dst_stack_offset(dst_stack_offset)
         , m_src_register(src_register)
     {}
 
-    virtual ~Store16ToStackInstruction() override = default;
+    void execute(Runtime::Interpreter&) const;
+    String to_string() const;
 
-    virtual void execute(Runtime::Interpreter&) const override;
-    virtual String to_string() const override;
+    NODISCARD ALWAYS_INLINE u64 dst_stack_offset() const { return m_dst_stack_offset; }
+    NODISCARD ALWAYS_INLINE Register src_register() const { return m_src_register; }
 
 private:
     u64 m_dst_stack_offset;
@@ -402,15 +1714,19 @@ private:
 
 class Store32ToStackInstruction : public Instruction {
 public:
+    static constexpr OpCode opcode_value = OpCode::Store32ToStack;
+
     ALWAYS_INLINE Store32ToStackInstruction(u64 dst_stack_offset, Register src_register)
-        : m_dst_stack_offset(dst_stack_offset)
+        : Instruction(opcode_value)
+        , m_dst_stack_offset(dst_stack_offset)
         , m_src_register(src_register)
     {}
 
-    virtual ~Store32ToStackInstruction() override = default;
+    void execute(Runtime::Interpreter&) const;
+    String to_string() const;
 
-    virtual void execute(Runtime::Interpreter&) const override;
-    virtual String to_string() const override;
+    NODISCARD ALWAYS_INLINE u64 dst_stack_offset() const { return m_dst_stack_offset; }
+    NODISCARD ALWAYS_INLINE Register src_register() const { return m_src_register; }
 
 private:
     u64 m_dst_stack_offset;
@@ -419,16 +1735,21 @@ private:
 
 class SubInstruction : public Instruction {
 public:
+    static constexpr OpCode opcode_value = OpCode::Sub;
+
     ALWAYS_INLINE SubInstruction(Register dst_register, Register lhs_register, Register rhs_register)
-        : m_dst_register(dst_register)
+        : Instruction(opcode_value)
+        , m_dst_register(dst_register)
         , m_lhs_register(lhs_register)
         , m_rhs_register(rhs_register)
     {}
 
-    virtual ~SubInstruction() override = default;
+    void execute(Runtime::Interpreter&) const;
+    String to_string() const;
 
-    virtual void execute(Runtime::Interpreter&) const override;
-    virtual String to_string() const override;
+    NODISCARD ALWAYS_INLINE Register dst_register() const { return m_dst_register; }
+    NODISCARD ALWAYS_INLINE Register lhs_register() const { return m_lhs_register; }
+    NODISCARD ALWAYS_INLINE Register rhs_register() const { return m_rhs_register; }
 
 private:
     Register m_dst_register;
@@ -436,4 +1757,121 @@ private:
     Register m_rhs_register;
 };
 
+class SubImmediateInstruction : public Instruction {
+public:
+    static constexpr OpCode opcode_value = OpCode::SubImmediate;
+
+    ALWAYS_INLINE SubImmediateInstruction(Register dst_register, Register lhs_register, u64 immediate_value)
+        : Instruction(opcode_value)
+        , m_dst_register(dst_register)
+        , m_lhs_register(lhs_register)
+        , m_immediate_value(immediate_value)
+    {}
+
+    void execute(Runtime::Interpreter&) const;
+    String to_string() const;
+
+    NODISCARD ALWAYS_INLINE Register dst_register() const { return m_dst_register; }
+    NODISCARD ALWAYS_INLINE Register lhs_register() const { return m_lhs_register; }
+    NODISCARD ALWAYS_INLINE u64 immediate_value() const { return m_immediate_value; }
+
+private:
+    Register m_dst_register;
+    Register m_lhs_register;
+    u64 m_immediate_value;
+};
+
+// NOTE: Calls the function by reusing the frame of the current function, which must have pushed exactly the
+//       `parameters_byte_count` bytes of parameters. The callee returns directly to the caller of the current
+//       function, so the value returned by it (if any) is discarded.
+class TailCallInstruction : public Instruction {
+public:
+    static constexpr OpCode opcode_value = OpCode::TailCall;
+
+    explicit TailCallInstruction(JumpAddress callee_address, u64 parameters_byte_count)
+        : Instruction(opcode_value)
+        , m_callee_address(callee_address)
+        , m_parameters_byte_count(parameters_byte_count)
+    {}
+
+    void execute(Runtime::Interpreter&) const;
+    String to_string() const;
+
+    NODISCARD ALWAYS_INLINE JumpAddress callee_address() const { return m_callee_address; }
+    NODISCARD ALWAYS_INLINE u64 parameters_byte_count() const { return m_parameters_byte_count; }
+
+private:
+    JumpAddress m_callee_address;
+    u64 m_parameters_byte_count;
+};
+
+// NOTE: Like `TailCall`, but the callee is called using the register calling convention. The register window of the
+//       current function is reused, and the value returned by the callee is written to the register that was chosen
+//       by the caller of the current function.
+class TailCallWithArgumentsInstruction : public Instruction {
+public:
+    static constexpr OpCode opcode_value = OpCode::TailCallWithArguments;
+
+    explicit TailCallWithArgumentsInstruction(JumpAddress callee_address, Register first_argument_register, u8 argument_count,
+                                              u64 parameters_byte_count)
+        : Instruction(opcode_value)
+        , m_first_argument_register(first_argument_register)
+        , m_argument_count(argument_count)
+        , m_callee_address(callee_address)
+        , m_parameters_byte_count(parameters_byte_count)
+    {}
+
+    void execute(Runtime::Interpreter&) const;
+    String to_string() const;
+
+    NODISCARD ALWAYS_INLINE JumpAddress callee_address() const { return m_callee_address; }
+    NODISCARD ALWAYS_INLINE Register first_argument_register() const { return m_first_argument_register; }
+    NODISCARD ALWAYS_INLINE u8 argument_count() const { return m_argument_count; }
+    NODISCARD ALWAYS_INLINE u64 parameters_byte_count() const { return m_parameters_byte_count; }
+
+private:
+    // NOTE: The register operands are declared first so they are packed right after the opcode.
+    Register m_first_argument_register;
+    u8 m_argument_count;
+    JumpAddress m_callee_address;
+    u64 m_parameters_byte_count;
+};
+
+// The number of bytes occupied by a single instruction inside the instruction stream of a package.
+// All instruction types are stored in fixed-size records, which means that the instruction stream is
+// one contiguous allocation and that an instruction pointer is simply an index into it.
+constexpr usize instruction_record_byte_count = 24;
+constexpr usize instruction_record_alignment = 8;
+
+#define _ARC_VALIDATE_INSTRUCTION_TYPE(x)                                                                                  \
+    static_assert(sizeof(x##Instruction) <= instruction_record_byte_count, #x "Instruction doesn't fit in a record!");     \
+    static_assert(alignof(x##Instruction) <= instruction_record_alignment, #x "Instruction is over-aligned!");             \
+    static_assert(is_trivially_copyable<x##Instruction>, #x "Instruction must be trivially copyable!");                    \
+    static_assert(is_trivially_destructible<x##Instruction>, #x "Instruction must be trivially destructible!");
+ARC_ENUMERATE_BYTECODE_OPCODES(_ARC_VALIDATE_INSTRUCTION_TYPE)
+#undef _ARC_VALIDATE_INSTRUCTION_TYPE
+
+class alignas(instruction_record_alignment) InstructionRecord {
+public:
+    template<typename InstructionType, typename... Args>
+    requires (is_derived_from<InstructionType, Instruction>)
+    NODISCARD ALWAYS_INLINE static InstructionRecord create(Args&&... args)
+    {
+        // NOTE: The record is zero-initialized before the instruction is constructed inside it, so that the
+        //       padding bytes never contain garbage. This keeps the instruction stream bitwise deterministic.
+        InstructionRecord record = {};
+        new (record.m_bytes) InstructionType(forward<Args>(args)...);
+        return record;
+    }
+
+public:
+    NODISCARD ALWAYS_INLINE const Instruction& instruction() const { return *reinterpret_cast<const Instruction*>(m_bytes); }
+    NODISCARD ALWAYS_INLINE OpCode opcode() const { return instruction().opcode(); }
+
+private:
+    u8 m_bytes[instruction_record_byte_count];
+};
+
+static_assert(sizeof(InstructionRecord) == instruction_record_byte_count);
+
 }
@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause.
+ */
+
+#include <bytecode/opcode_profile.h>
+#include <core/containers/string_builder.h>
+
+namespace Arc::Bytecode {
+
+OpcodeProfile::OpcodeProfile()
+    : m_total_instruction_count(0)
+    , m_previous_opcodes { OpCode::Count, OpCode::Count }
+    , m_sequence_length(0)
+{
+    m_opcode_counts.set_count(opcode_count_value, 0);
+    m_pair_counts.set_count(opcode_count_value * opcode_count_value, 0);
+    m_triple_counts.set_count(opcode_count_value * opcode_count_value * opcode_count_value, 0);
+}
+
+void OpcodeProfile::record_instruction(OpCode opcode, bool follows_previous_instruction)
+{
+    const usize opcode_index = static_cast<usize>(opcode);
+    ARC_ASSERT(opcode_index < opcode_count_value);
+
+    ++m_total_instruction_count;
+    ++m_opcode_counts[opcode_index];
+
+    if (!follows_previous_instruction)
+        m_sequence_length = 0;
+
+    const usize previous_index = static_cast<usize>(m_previous_opcodes[1]);
+    const usize second_previous_index = static_cast<usize>(m_previous_opcodes[0]);
+    if (m_sequence_length >= 1)
+        ++m_pair_counts[previous_index * opcode_count_value + opcode_index];
+    if (m_sequence_length >= 2)
+        ++m_triple_counts[(second_previous_index * opcode_count_value + previous_index) * opcode_count_value + opcode_index];
+
+    m_previous_opcodes[0] = m_previous_opcodes[1];
+    m_previous_opcodes[1] = opcode;
+    if (m_sequence_length < 2)
+        ++m_sequence_length;
+}
+
+void OpcodeProfile::break_sequence()
+{
+    m_sequence_length = 0;
+}
+
+u64 OpcodeProfile::opcode_count(OpCode opcode) const
+{
+    return m_opcode_counts[static_cast<usize>(opcode)];
+}
+
+u64 OpcodeProfile::pair_count(OpCode first, OpCode second) const
+{
+    return m_pair_counts[static_cast<usize>(first) * opcode_count_value + static_cast<usize>(second)];
+}
+
+u64 OpcodeProfile::triple_count(OpCode first, OpCode second, OpCode third) const
+{
+    const usize pair_index = static_cast<usize>(first) * opcode_count_value + static_cast<usize>(second);
+    return m_triple_counts[pair_index * opcode_count_value + static_cast<usize>(third)];
+}
+
+Vector<OpcodeProfile::Sequence> OpcodeProfile::most_frequent_sequences(u8 sequence_length, usize max_sequence_count) const
+{
+    ARC_ASSERT(sequence_length == 2 || sequence_length == 3);
+    const Vector<u64>& counts = sequence_length == 2 ? m_pair_counts : m_triple_counts;
+
+    // NOTE: The result is kept sorted by insertion, as the number of requested sequences is always small.
+    Vector<Sequence> sequences;
+    for (usize sequence_index = 0; sequence_index < counts.count(); ++sequence_index) {
+        if (counts[sequence_index] == 0)
+            continue;
+        if (sequences.count() == max_sequence_count && counts[sequence_index] <= sequences.last().execution_count)
+            continue;
+
+        Sequence sequence = {};
+        sequence.length = sequence_length;
+        sequence.execution_count = counts[sequence_index];
+        usize remaining_index = sequence_index;
+        for (usize opcode_position = sequence_length; opcode_position > 0; --opcode_position) {
+            sequence.opcodes[opcode_position - 1] = static_cast<OpCode>(remaining_index % opcode_count_value);
+            remaining_index /= opcode_count_value;
+        }
+
+        if (sequences.count() == max_sequence_count)
+            sequences.pop_back();
+        sequences.push_back(sequence);
+        for (usize position = sequences.count() - 1; position > 0; --position) {
+            if (sequences[position - 1].execution_count >= sequences[position].execution_count)
+                break;
+            const Sequence temporary = sequences[position - 1];
+            sequences[position - 1] = sequences[position];
+            sequences[position] = temporary;
+        }
+    }
+
+    return sequences;
+}
+
+String OpcodeProfile::to_string(usize max_sequence_count) const
+{
+    StringBuilder builder;
+    builder.append("Executed instructions: {}"sv, m_total_instruction_count);
+    builder.append_newline();
+
+    for (u8 sequence_length = 2; sequence_length <= 3; ++sequence_length) {
+        for (const Sequence& sequence : most_frequent_sequences(sequence_length, max_sequence_count)) {
+            builder.append("    {}"sv, sequence.execution_count);
+            for (u8 opcode_index = 0; opcode_index < sequence.length; ++opcode_index)
+                builder.append(" {}"sv, opcode_to_string_view(sequence.opcodes[opcode_index]));
+            builder.append_newline();
+        }
+    }
+
+    return builder.release_string();
+}
+
+}
@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause.
+ */
+
+#pragma once
+
+#include <bytecode/instruction.h>
+#include <core/containers/vector.h>
+
+namespace Arc::Bytecode {
+
+//
+// Records how many times each opcode, and each sequence of two and three opcodes, has been executed. Only
+// sequences of instructions that are executed one after another (without a jump between them) are recorded,
+// as those are the only sequences that can be replaced by a superinstruction.
+//
+class OpcodeProfile {
+    ARC_MAKE_NONCOPYABLE(OpcodeProfile);
+    ARC_MAKE_NONMOVABLE(OpcodeProfile);
+
+public:
+    struct Sequence {
+        OpCode opcodes[3] { OpCode::Count, OpCode::Count, OpCode::Count };
+        u8 length { 0 };
+        u64 execution_count { 0 };
+    };
+
+public:
+    OpcodeProfile();
+
+    // Must be invoked for every executed instruction. The `follows_previous_instruction` parameter is true when the
+    // instruction is located right after the previously recorded instruction in the package.
+    void record_instruction(OpCode opcode, bool follows_previous_instruction);
+
+    // Starts a new sequence, for example when the execution of a new entry point begins.
+    void break_sequence();
+
+    NODISCARD ALWAYS_INLINE u64 total_instruction_count() const { return m_total_instruction_count; }
+    NODISCARD u64 opcode_count(OpCode opcode) const;
+    NODISCARD u64 pair_count(OpCode first, OpCode second) const;
+    NODISCARD u64 triple_count(OpCode first, OpCode second, OpCode third) const;
+
+    // Returns the most frequently executed sequences of the given length (two or three), sorted by execution count.
+    NODISCARD Vector<Sequence> most_frequent_sequences(u8 sequence_length, usize max_sequence_count) const;
+
+    String to_string(usize max_sequence_count) const;
+
+private:
+    static constexpr usize opcode_count_value = static_cast<usize>(OpCode::Count);
+
+    Vector<u64> m_opcode_counts;
+    Vector<u64> m_pair_counts;
+    Vector<u64> m_triple_counts;
+    u64 m_total_instruction_count;
+
+    OpCode m_previous_opcodes[2];
+    u8 m_sequence_length;
+};
+
+}
@@ -0,0 +1,844 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause.
+ */
+
+#include <bytecode/optimizer.h>
+#include <bytecode/package.h>
+#include <bytecode/superinstructions.h>
+#include <core/containers/optional.h>
+
+namespace Arc::Bytecode {
+
+// Returns true if the instruction might read the given register. Instructions that transfer control to another
+// function are assumed to read all registers.
+NODISCARD static bool instruction_reads_register(const Instruction& instruction, Register reg)
+{
+    switch (instruction.opcode()) {
+#define _ARC_CASE(x)                                                                                                   \
+    case OpCode::x: {                                                                                                  \
+        const auto& typed_instruction = instruction.as<x##Instruction>();                                              \
+        return typed_instruction.lhs_register() == reg || typed_instruction.rhs_register() == reg;                     \
+    }
+        ARC_ENUMERATE_BYTECODE_BINARY_REGISTER_OPCODES(_ARC_CASE)
+#undef _ARC_CASE
+#define _ARC_CASE(x) \
+    case OpCode::x:  \
+        return instruction.as<x##Instruction>().src_register() == reg;
+        ARC_ENUMERATE_BYTECODE_UNARY_REGISTER_OPCODES(_ARC_CASE)
+#undef _ARC_CASE
+
+        case OpCode::AddImmediate:
+            return instruction.as<AddImmediateInstruction>().lhs_register() == reg;
+        case OpCode::CompareGreaterImmediate:
+            return instruction.as<CompareGreaterImmediateInstruction>().lhs_register() == reg;
+        case OpCode::SubImmediate:
+            return instruction.as<SubImmediateInstruction>().lhs_register() == reg;
+        case OpCode::Decrement:
+            return instruction.as<DecrementInstruction>().dst_register() == reg;
+        case OpCode::Increment:
+            return instruction.as<IncrementInstruction>().dst_register() == reg;
+        case OpCode::JumpIf:
+            return instruction.as<JumpIfInstruction>().condition_register() == reg;
+        case OpCode::JumpTable:
+            return instruction.as<JumpTableInstruction>().index_register() == reg;
+        case OpCode::PushRegister:
+            return instruction.as<PushRegisterInstruction>().src_register() == reg;
+        case OpCode::StoreToFrame:
+            return instruction.as<StoreToFrameInstruction>().src_register() == reg;
+        case OpCode::StoreToStack:
+            return instruction.as<StoreToStackInstruction>().src_register() == reg;
+        case OpCode::Store8ToStack:
+            return instruction.as<Store8ToStackInstruction>().src_register() == reg;
+        case OpCode::Store16ToStack:
+            return instruction.as<Store16ToStackInstruction>().src_register() == reg;
+        case OpCode::Store32ToStack:
+            return instruction.as<Store32ToStackInstruction>().src_register() == reg;
+
+        case OpCode::Jump:
+        case OpCode::LoadFromFrame:
+        case OpCode::LoadFromStack:
+        case OpCode::Load8FromStack:
+        case OpCode::Load16FromStack:
+        case OpCode::Load32FromStack:
+        case OpCode::LoadImmediate8:
+        case OpCode::LoadImmediate16:
+        case OpCode::LoadImmediate32:
+        case OpCode::LoadImmediate64:
+        case OpCode::Pop:
+        case OpCode::PopRegister:
+        case OpCode::PureFunctionEntry:
+        case OpCode::Push:
+        case OpCode::PushImmediate8:
+        case OpCode::PushImmediate16:
+        case OpCode::PushImmediate32:
+        case OpCode::PushImmediate64:
+            return false;
+
+        default:
+            return true;
+    }
+}
+
+// Returns the register whose value is completely replaced by the instruction, if any.
+NODISCARD static Optional<Register> instruction_written_register(const Instruction& instruction)
+{
+    switch (instruction.opcode()) {
+#define _ARC_CASE(x) \
+    case OpCode::x:  \
+        return instruction.as<x##Instruction>().dst_register();
+        ARC_ENUMERATE_BYTECODE_BINARY_REGISTER_OPCODES(_ARC_CASE)
+        ARC_ENUMERATE_BYTECODE_UNARY_REGISTER_OPCODES(_ARC_CASE)
+#undef _ARC_CASE
+
+        case OpCode::AddImmediate:
+            return instruction.as<AddImmediateInstruction>().dst_register();
+        case OpCode::CompareGreaterImmediate:
+            return instruction.as<CompareGreaterImmediateInstruction>().dst_register();
+        case OpCode::SubImmediate:
+            return instruction.as<SubImmediateInstruction>().dst_register();
+        case OpCode::LoadFromFrame:
+            return instruction.as<LoadFromFrameInstruction>().dst_register();
+        case OpCode::LoadFromStack:
+            return instruction.as<LoadFromStackInstruction>().dst_register();
+        case OpCode::Load8FromStack:
+            return instruction.as<Load8FromStackInstruction>().dst_register();
+        case OpCode::Load16FromStack:
+            return instruction.as<Load16FromStackInstruction>().dst_register();
+        case OpCode::Load32FromStack:
+            return instruction.as<Load32FromStackInstruction>().dst_register();
+        case OpCode::LoadImmediate8:
+            return instruction.as<LoadImmediate8Instruction>().dst_register();
+        case OpCode::LoadImmediate16:
+            return instruction.as<LoadImmediate16Instruction>().dst_register();
+        case OpCode::LoadImmediate32:
+            return instruction.as<LoadImmediate32Instruction>().dst_register();
+        case OpCode::LoadImmediate64:
+            return instruction.as<LoadImmediate64Instruction>().dst_register();
+        default:
+            return {};
+    }
+}
+
+// Describes an instruction that copies a register to or from a 64-bit stack slot.
+struct StackSlotAccess {
+    Register reg;
+    bool is_load;
+    bool is_frame_relative;
+    // NOTE: Frame offsets are stored as their two's complement representation.
+    u64 offset;
+};
+
+NODISCARD static Optional<StackSlotAccess> stack_slot_access(const Instruction& instruction)
+{
+    switch (instruction.opcode()) {
+        case OpCode::LoadFromFrame: {
+            const auto& typed_instruction = instruction.as<LoadFromFrameInstruction>();
+            const u64 frame_offset = static_cast<u64>(typed_instruction.src_frame_offset());
+            return StackSlotAccess { typed_instruction.dst_register(), true, true, frame_offset };
+        }
+        case OpCode::LoadFromStack: {
+            const auto& typed_instruction = instruction.as<LoadFromStackInstruction>();
+            return StackSlotAccess { typed_instruction.dst_register(), true, false, typed_instruction.src_stack_offset() };
+        }
+        case OpCode::StoreToFrame: {
+            const auto& typed_instruction = instruction.as<StoreToFrameInstruction>();
+            const u64 frame_offset = static_cast<u64>(typed_instruction.dst_frame_offset());
+            return StackSlotAccess { typed_instruction.src_register(), false, true, frame_offset };
+        }
+        case OpCode::StoreToStack: {
+            const auto& typed_instruction = instruction.as<StoreToStackInstruction>();
+            return StackSlotAccess { typed_instruction.src_register(), false, false, typed_instruction.dst_stack_offset() };
+        }
+        default:
+            return {};
+    }
+}
+
+NODISCARD static bool instruction_transfers_control(const Instruction& instruction)
+{
+    switch (instruction.opcode()) {
+        case OpCode::Call:
+        case OpCode::CallWithArguments:
+        case OpCode::FusedCompareGreaterJumpIf:
+        case OpCode::FusedCompareGreaterImmediateJumpIf:
+        case OpCode::Jump:
+        case OpCode::JumpIf:
+        case OpCode::JumpTable:
+        case OpCode::Return:
+        case OpCode::ReturnValue:
+        case OpCode::TailCall:
+        case OpCode::TailCallWithArguments:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Returns the jump or call target of the instruction, if any.
+// NOTE: For jump tables this is the default address. The targets stored in the table itself are visited separately,
+//       through `OptimizationContext::for_each_jump_table_target`.
+NODISCARD static Optional<JumpAddress> instruction_branch_target(const Instruction& instruction)
+{
+    switch (instruction.opcode()) {
+        case OpCode::Call:
+            return instruction.as<CallInstruction>().callee_address();
+        case OpCode::CallWithArguments:
+            return instruction.as<CallWithArgumentsInstruction>().callee_address();
+        case OpCode::FusedCompareGreaterJumpIf:
+            return instruction.as<FusedCompareGreaterJumpIfInstruction>().jump_address();
+        case OpCode::FusedCompareGreaterImmediateJumpIf:
+            return instruction.as<FusedCompareGreaterImmediateJumpIfInstruction>().jump_address();
+        case OpCode::Jump:
+            return instruction.as<JumpInstruction>().jump_address();
+        case OpCode::JumpIf:
+            return instruction.as<JumpIfInstruction>().jump_address();
+        case OpCode::JumpTable:
+            return instruction.as<JumpTableInstruction>().default_address();
+        case OpCode::TailCall:
+            return instruction.as<TailCallInstruction>().callee_address();
+        case OpCode::TailCallWithArguments:
+            return instruction.as<TailCallWithArgumentsInstruction>().callee_address();
+        default:
+            return {};
+    }
+}
+
+NODISCARD static InstructionRecord instruction_with_branch_target(const Instruction& instruction, JumpAddress branch_target)
+{
+    switch (instruction.opcode()) {
+        case OpCode::Call:
+            return InstructionRecord::create<CallInstruction>(branch_target, instruction.as<CallInstruction>().parameters_byte_count());
+        case OpCode::CallWithArguments: {
+            const auto& typed_instruction = instruction.as<CallWithArgumentsInstruction>();
+            return InstructionRecord::create<CallWithArgumentsInstruction>(
+                branch_target, typed_instruction.first_argument_register(), typed_instruction.argument_count(),
+                typed_instruction.return_value_register(), typed_instruction.parameters_byte_count());
+        }
+        case OpCode::FusedCompareGreaterJumpIf: {
+            const auto& typed_instruction = instruction.as<FusedCompareGreaterJumpIfInstruction>();
+            return InstructionRecord::create<FusedCompareGreaterJumpIfInstruction>(
+                typed_instruction.dst_register(), typed_instruction.lhs_register(), typed_instruction.rhs_register(), branch_target);
+        }
+        case OpCode::FusedCompareGreaterImmediateJumpIf: {
+            const auto& typed_instruction = instruction.as<FusedCompareGreaterImmediateJumpIfInstruction>();
+            return InstructionRecord::create<FusedCompareGreaterImmediateJumpIfInstruction>(
+                typed_instruction.dst_register(), typed_instruction.lhs_register(), typed_instruction.immediate_value(), branch_target);
+        }
+        case OpCode::Jump:
+            return InstructionRecord::create<JumpInstruction>(branch_target);
+        case OpCode::JumpIf:
+            return InstructionRecord::create<JumpIfInstruction>(instruction.as<JumpIfInstruction>().condition_register(), branch_target);
+        case OpCode::JumpTable: {
+            const auto& typed_instruction = instruction.as<JumpTableInstruction>();
+            return InstructionRecord::create<JumpTableInstruction>(
+                typed_instruction.index_register(), typed_instruction.first_entry_index(), typed_instruction.entry_count(), branch_target);
+        }
+        case OpCode::TailCall: {
+            const auto& typed_instruction = instruction.as<TailCallInstruction>();
+            return InstructionRecord::create<TailCallInstruction>(branch_target, typed_instruction.parameters_byte_count());
+        }
+        case OpCode::TailCallWithArguments: {
+            const auto& typed_instruction = instruction.as<TailCallWithArgumentsInstruction>();
+            return InstructionRecord::create<TailCallWithArgumentsInstruction>(branch_target, typed_instruction.first_argument_register(),
+                                                                               typed_instruction.argument_count(),
+                                                                               typed_instruction.parameters_byte_count());
+        }
+        default:
+            ARC_ASSERT_NOT_REACHED;
+    }
+}
+
+// Returns the number of bytes pushed on the stack by the instruction, or zero if it isn't a push instruction.
+NODISCARD static u64 instruction_push_byte_count(const Instruction& instruction)
+{
+    switch (instruction.opcode()) {
+        case OpCode::Push:
+            return instruction.as<PushInstruction>().push_byte_count();
+        case OpCode::PushImmediate8:
+            return sizeof(u8);
+        case OpCode::PushImmediate16:
+            return sizeof(u16);
+        case OpCode::PushImmediate32:
+            return sizeof(u32);
+        case OpCode::PushImmediate64:
+        case OpCode::PushRegister:
+            return sizeof(u64);
+        default:
+            return 0;
+    }
+}
+
+// Returns the number of bytes popped from the stack by the instruction, or zero if it isn't a pop instruction.
+NODISCARD static u64 instruction_pop_byte_count(const Instruction& instruction)
+{
+    switch (instruction.opcode()) {
+        case OpCode::Pop:
+            return instruction.as<PopInstruction>().pop_byte_count();
+        case OpCode::PopRegister:
+            return sizeof(u64);
+        default:
+            return 0;
+    }
+}
+
+class OptimizationContext {
+public:
+    explicit OptimizationContext(const Package& package);
+
+    // Returns the number of instructions that were removed.
+    usize optimize();
+    usize fuse_superinstructions(const Vector<OpCode>& superinstruction_opcodes);
+
+    NODISCARD ALWAYS_INLINE Vector<InstructionRecord>& instructions() { return m_instructions; }
+    NODISCARD ALWAYS_INLINE Vector<JumpAddress>& jump_table_entries() { return m_jump_table_entries; }
+    NODISCARD ALWAYS_INLINE const Vector<JumpAddress>& entry_point_addresses() const { return m_entry_point_addresses; }
+
+private:
+    bool thread_jumps();
+    bool convert_tail_calls();
+    void find_branch_destinations();
+
+    void remove_jumps_to_next_instruction();
+    void remove_unreachable_instructions();
+    void remove_redundant_stack_accesses();
+    void remove_dead_loads();
+    void remove_push_pop_pairs();
+
+    NODISCARD Optional<InstructionRecord> try_create_superinstruction(usize instruction_index,
+                                                                      const SuperinstructionPattern& pattern) const;
+
+    NODISCARD bool function_always_returns_value(JumpAddress entry_address) const;
+    NODISCARD bool can_fuse_with_previous(usize instruction_index) const;
+    usize compact_instructions();
+
+    NODISCARD ALWAYS_INLINE const Instruction& instruction_at(usize instruction_index) const
+    {
+        return m_instructions[instruction_index].instruction();
+    }
+
+    // Invokes the callback for every target stored in the table of a `JumpTable` instruction. Tables that aren't
+    // entirely contained in the jump table entries of the package are rejected by the verifier, and are skipped here.
+    template<typename Callback>
+    void for_each_jump_table_target(const Instruction& instruction, Callback callback) const
+    {
+        if (instruction.opcode() != OpCode::JumpTable)
+            return;
+        const auto& typed_instruction = instruction.as<JumpTableInstruction>();
+        const u64 first_entry_index = typed_instruction.first_entry_index();
+        if (first_entry_index + typed_instruction.entry_count() > m_jump_table_entries.count())
+            return;
+        for (u64 entry_index = first_entry_index; entry_index < first_entry_index + typed_instruction.entry_count(); ++entry_index)
+            callback(m_jump_table_entries[entry_index]);
+    }
+
+private:
+    Vector<InstructionRecord> m_instructions;
+    Vector<JumpAddress> m_jump_table_entries;
+    Vector<JumpAddress> m_entry_point_addresses;
+    Vector<bool> m_is_removed;
+    Vector<bool> m_is_branch_destination;
+};
+
+OptimizationContext::OptimizationContext(const Package& package)
+{
+    m_instructions.ensure_capacity(package.instruction_count());
+    for (usize instruction_index = 0; instruction_index < package.instruction_count(); ++instruction_index)
+        m_instructions.push_back(package.instruction_records()[instruction_index]);
+
+    m_jump_table_entries.ensure_capacity(package.jump_table_entry_count());
+    for (usize entry_index = 0; entry_index < package.jump_table_entry_count(); ++entry_index)
+        m_jump_table_entries.push_back(package.jump_table_entries()[entry_index]);
+
+    for (const Package::EntryPoint& entry_point : package.entry_points())
+        m_entry_point_addresses.push_back(entry_point.address);
+}
+
+bool OptimizationContext::thread_jumps()
+{
+    bool has_changed = false;
+    for (usize instruction_index = 0; instruction_index < m_instructions.count(); ++instruction_index) {
+        const Instruction& instruction = instruction_at(instruction_index);
+        if (instruction.opcode() != OpCode::Jump && instruction.opcode() != OpCode::JumpIf)
+            continue;
+
+        u64 target = instruction_branch_target(instruction).value().address();
+        bool is_cycle = false;
+        for (usize step_count = 0; target < m_instructions.count() && instruction_at(target).opcode() == OpCode::Jump; ++step_count) {
+            // NOTE: Chains that form a cycle are infinite loops, and are left untouched.
+            if (target == instruction_index || step_count == m_instructions.count()) {
+                is_cycle = true;
+                break;
+            }
+            target = instruction_at(target).as<JumpInstruction>().jump_address().address();
+        }
+
+        if (is_cycle || target == instruction_branch_target(instruction).value().address())
+            continue;
+
+        m_instructions[instruction_index] = instruction_with_branch_target(instruction, JumpAddress(target));
+        has_changed = true;
+    }
+
+    return has_changed;
+}
+
+bool OptimizationContext::convert_tail_calls()
+{
+    bool has_changed = false;
+    for (usize instruction_index = 0; instruction_index + 1 < m_instructions.count(); ++instruction_index) {
+        const Instruction& instruction = instruction_at(instruction_index);
+        const Instruction& next_instruction = instruction_at(instruction_index + 1);
+
+        // NOTE: The value returned by the callee of a `Call` is discarded, exactly like for a tail call.
+        if (instruction.opcode() == OpCode::Call && next_instruction.opcode() == OpCode::Return) {
+            const auto& call_instruction = instruction.as<CallInstruction>();
+            m_instructions[instruction_index] =
+                InstructionRecord::create<TailCallInstruction>(call_instruction.callee_address(), call_instruction.parameters_byte_count());
+            has_changed = true;
+            continue;
+        }
+
+        if (instruction.opcode() != OpCode::CallWithArguments || next_instruction.opcode() != OpCode::ReturnValue)
+            continue;
+
+        const auto& call_instruction = instruction.as<CallWithArgumentsInstruction>();
+        if (next_instruction.as<ReturnValueInstruction>().src_register() != call_instruction.return_value_register())
+            continue;
+
+        // NOTE: A callee that returns using `Return` leaves the return value register of the call untouched, which
+        //       would then be returned to the caller. Once the call is a tail call the caller register itself would
+        //       be left untouched instead, so such calls are never converted.
+        if (!function_always_returns_value(call_instruction.callee_address()))
+            continue;
+
+        m_instructions[instruction_index] = InstructionRecord::create<TailCallWithArgumentsInstruction>(
+            call_instruction.callee_address(), call_instruction.first_argument_register(), call_instruction.argument_count(),
+            call_instruction.parameters_byte_count());
+        has_changed = true;
+    }
+
+    return has_changed;
+}
+
+bool OptimizationContext::function_always_returns_value(JumpAddress entry_address) const
+{
+    Vector<bool> is_visited;
+    is_visited.set_count(m_instructions.count(), false);
+
+    Vector<usize> worklist;
+    bool reaches_outside_package = false;
+    const auto schedule = [&](u64 instruction_index) {
+        if (instruction_index >= m_instructions.count()) {
+            reaches_outside_package = true;
+            return;
+        }
+        if (!is_visited[instruction_index]) {
+            is_visited[instruction_index] = true;
+            worklist.push_back(instruction_index);
+        }
+    };
+
+    // Walk all the instructions that can be executed before the function returns to its caller. The callees of
+    // regular calls return to the function, so only the callees of tail calls are walked.
+    schedule(entry_address.address());
+    while (worklist.has_elements() && !reaches_outside_package) {
+        const usize instruction_index = worklist.last();
+        worklist.pop_back();
+
+        const Instruction& instruction = instruction_at(instruction_index);
+        const OpCode opcode = instruction.opcode();
+        if (opcode == OpCode::Return || opcode == OpCode::TailCall)
+            return false;
+        if (opcode == OpCode::ReturnValue)
+            continue;
+
+        const bool is_call = opcode == OpCode::Call || opcode == OpCode::CallWithArguments;
+        const Optional<JumpAddress> branch_target = instruction_branch_target(instruction);
+        if (branch_target.has_value() && !is_call)
+            schedule(branch_target.value().address());
+        for_each_jump_table_target(instruction, [&](JumpAddress target) { schedule(target.address()); });
+        if (opcode != OpCode::Jump && opcode != OpCode::JumpTable && opcode != OpCode::TailCallWithArguments)
+            schedule(instruction_index + 1);
+    }
+
+    return !reaches_outside_package;
+}
+
+void OptimizationContext::find_branch_destinations()
+{
+    m_is_branch_destination.clear();
+    m_is_branch_destination.set_count(m_instructions.count(), false);
+
+    for (const JumpAddress entry_point_address : m_entry_point_addresses) {
+        if (entry_point_address.address() < m_instructions.count())
+            m_is_branch_destination[entry_point_address.address()] = true;
+    }
+
+    for (usize instruction_index = 0; instruction_index < m_instructions.count(); ++instruction_index) {
+        const Instruction& instruction = instruction_at(instruction_index);
+        const Optional<JumpAddress> branch_target = instruction_branch_target(instruction);
+        if (branch_target.has_value() && branch_target.value().address() < m_instructions.count())
+            m_is_branch_destination[branch_target.value().address()] = true;
+        for_each_jump_table_target(instruction, [&](JumpAddress target) {
+            if (target.address() < m_instructions.count())
+                m_is_branch_destination[target.address()] = true;
+        });
+
+        // NOTE: The instruction that follows a call is reached when the callee returns.
+        const bool is_call = instruction.opcode() == OpCode::Call || instruction.opcode() == OpCode::CallWithArguments;
+        if (is_call && instruction_index + 1 < m_instructions.count())
+            m_is_branch_destination[instruction_index + 1] = true;
+    }
+}
+
+bool OptimizationContext::can_fuse_with_previous(usize instruction_index) const
+{
+    return instruction_index > 0 && instruction_index < m_instructions.count() && !m_is_branch_destination[instruction_index] &&
+           !m_is_removed[instruction_index] && !m_is_removed[instruction_index - 1];
+}
+
+void OptimizationContext::remove_jumps_to_next_instruction()
+{
+    for (usize instruction_index = 0; instruction_index < m_instructions.count(); ++instruction_index) {
+        const Instruction& instruction = instruction_at(instruction_index);
+        if (instruction.opcode() != OpCode::Jump && instruction.opcode() != OpCode::JumpIf)
+            continue;
+        if (instruction_branch_target(instruction).value().address() == instruction_index + 1)
+            m_is_removed[instruction_index] = true;
+    }
+}
+
+void OptimizationContext::remove_unreachable_instructions()
+{
+    // NOTE: Without any entry points it is impossible to know where the execution starts.
+    if (m_entry_point_addresses.is_empty())
+        return;
+
+    Vector<bool> is_reachable;
+    is_reachable.set_count(m_instructions.count(), false);
+
+    Vector<usize> worklist;
+    const auto schedule = [&](u64 instruction_index) {
+        if (instruction_index < m_instructions.count() && !is_reachable[instruction_index]) {
+            is_reachable[instruction_index] = true;
+            worklist.push_back(instruction_index);
+        }
+    };
+
+    for (const JumpAddress entry_point_address : m_entry_point_addresses)
+        schedule(entry_point_address.address());
+
+    while (worklist.has_elements()) {
+        const usize instruction_index = worklist.last();
+        worklist.pop_back();
+
+        const Instruction& instruction = instruction_at(instruction_index);
+        const Optional<JumpAddress> branch_target = instruction_branch_target(instruction);
+        if (branch_target.has_value())
+            schedule(branch_target.value().address());
+        for_each_jump_table_target(instruction, [&](JumpAddress target) { schedule(target.address()); });
+        const OpCode opcode = instruction.opcode();
+        if (opcode != OpCode::Jump && opcode != OpCode::JumpTable && opcode != OpCode::Return && opcode != OpCode::ReturnValue &&
+            opcode != OpCode::TailCall && opcode != OpCode::TailCallWithArguments) {
+            schedule(instruction_index + 1);
+        }
+    }
+
+    for (usize instruction_index = 0; instruction_index < m_instructions.count(); ++instruction_index) {
+        if (!is_reachable[instruction_index])
+            m_is_removed[instruction_index] = true;
+    }
+}
+
+void OptimizationContext::remove_redundant_stack_accesses()
+{
+    for (usize instruction_index = 1; instruction_index < m_instructions.count(); ++instruction_index) {
+        if (!can_fuse_with_previous(instruction_index))
+            continue;
+
+        const Optional<StackSlotAccess> previous_access = stack_slot_access(instruction_at(instruction_index - 1));
+        const Optional<StackSlotAccess> access = stack_slot_access(instruction_at(instruction_index));
+        if (!previous_access.has_value() || !access.has_value())
+            continue;
+
+        const StackSlotAccess& previous = previous_access.value();
+        const StackSlotAccess& current = access.value();
+        if (previous.reg != current.reg || previous.is_frame_relative != current.is_frame_relative || previous.offset != current.offset)
+            continue;
+
+        // After the previous instruction the register and the stack slot hold the same value, so loading the slot
+        // into the register (or storing the register into the slot) has no effect.
+        if (current.is_load || previous.is_load)
+            m_is_removed[instruction_index] = true;
+    }
+}
+
+void OptimizationContext::remove_dead_loads()
+{
+    for (usize instruction_index = 0; instruction_index < m_instructions.count(); ++instruction_index) {
+        if (m_is_removed[instruction_index])
+            continue;
+
+        // NOTE: Only instructions whose sole effect is writing a register can be removed.
+        const Instruction& instruction = instruction_at(instruction_index);
+        const OpCode opcode = instruction.opcode();
+        if (opcode != OpCode::LoadFromFrame && opcode != OpCode::LoadFromStack && opcode != OpCode::Load8FromStack &&
+            opcode != OpCode::Load16FromStack && opcode != OpCode::Load32FromStack && opcode != OpCode::LoadImmediate8 &&
+            opcode != OpCode::LoadImmediate16 && opcode != OpCode::LoadImmediate32 && opcode != OpCode::LoadImmediate64) {
+            continue;
+        }
+        const Register dst_register = instruction_written_register(instruction).value();
+
+        // Scan forward, within the same basic block, for the next instruction that uses the register. The register
+        // values are observable when the execution finishes, so reaching the end of the package keeps the load.
+        for (usize next_index = instruction_index + 1; next_index < m_instructions.count(); ++next_index) {
+            if (m_is_removed[next_index])
+                continue;
+            if (m_is_branch_destination[next_index])
+                break;
+
+            const Instruction& next_instruction = instruction_at(next_index);
+            if (instruction_reads_register(next_instruction, dst_register) || instruction_transfers_control(next_instruction))
+                break;
+
+            const Optional<Register> written_register = instruction_written_register(next_instruction);
+            if (written_register.has_value() && written_register.value() == dst_register) {
+                m_is_removed[instruction_index] = true;
+                break;
+            }
+        }
+    }
+}
+
+void OptimizationContext::remove_push_pop_pairs()
+{
+    for (usize instruction_index = 1; instruction_index < m_instructions.count(); ++instruction_index) {
+        if (!can_fuse_with_previous(instruction_index))
+            continue;
+
+        const u64 push_byte_count = instruction_push_byte_count(instruction_at(instruction_index - 1));
+        const u64 pop_byte_count = instruction_pop_byte_count(instruction_at(instruction_index));
+        if (push_byte_count > 0 && push_byte_count == pop_byte_count) {
+            m_is_removed[instruction_index - 1] = true;
+            m_is_removed[instruction_index] = true;
+        }
+    }
+}
+
+usize OptimizationContext::compact_instructions()
+{
+    // Compute the new address of every instruction. Removed instructions map to the next instruction that is kept,
+    // which is where the execution continues after the removed instruction.
+    Vector<u64> relocated_addresses;
+    relocated_addresses.ensure_capacity(m_instructions.count() + 1);
+    u64 kept_instruction_count = 0;
+    for (usize instruction_index = 0; instruction_index < m_instructions.count(); ++instruction_index) {
+        relocated_addresses.push_back(kept_instruction_count);
+        if (!m_is_removed[instruction_index])
+            ++kept_instruction_count;
+    }
+    relocated_addresses.push_back(kept_instruction_count);
+
+    const auto relocate = [&](JumpAddress address) -> JumpAddress {
+        // NOTE: Addresses past the end of the package are kept at the same distance from the end.
+        if (address.address() >= m_instructions.count())
+            return JumpAddress(kept_instruction_count + (address.address() - m_instructions.count()));
+        return JumpAddress(relocated_addresses[address.address()]);
+    };
+
+    Vector<InstructionRecord> compacted_instructions;
+    compacted_instructions.ensure_capacity(kept_instruction_count);
+    for (usize instruction_index = 0; instruction_index < m_instructions.count(); ++instruction_index) {
+        if (m_is_removed[instruction_index])
+            continue;
+
+        const Instruction& instruction = instruction_at(instruction_index);
+        const Optional<JumpAddress> branch_target = instruction_branch_target(instruction);
+        if (branch_target.has_value())
+            compacted_instructions.push_back(instruction_with_branch_target(instruction, relocate(branch_target.value())));
+        else
+            compacted_instructions.push_back(m_instructions[instruction_index]);
+    }
+
+    for (JumpAddress& jump_table_entry : m_jump_table_entries)
+        jump_table_entry = relocate(jump_table_entry);
+    for (JumpAddress& entry_point_address : m_entry_point_addresses)
+        entry_point_address = relocate(entry_point_address);
+
+    const usize removed_instruction_count = m_instructions.count() - kept_instruction_count;
+    m_instructions = move(compacted_instructions);
+    return removed_instruction_count;
+}
+
+Optional<InstructionRecord> OptimizationContext::try_create_superinstruction(usize instruction_index,
+                                                                             const SuperinstructionPattern& pattern) const
+{
+    if (instruction_index + pattern.sequence_length > m_instructions.count() || m_is_removed[instruction_index])
+        return {};
+    for (usize sequence_index = 0; sequence_index < pattern.sequence_length; ++sequence_index) {
+        if (instruction_at(instruction_index + sequence_index).opcode() != pattern.sequence[sequence_index])
+            return {};
+        if (sequence_index > 0 && !can_fuse_with_previous(instruction_index + sequence_index))
+            return {};
+    }
+
+    const Instruction& first = instruction_at(instruction_index);
+    const Instruction& second = instruction_at(instruction_index + 1);
+
+    switch (pattern.superinstruction_opcode) {
+        case OpCode::FusedCompareGreaterJumpIf: {
+            const auto& compare_instruction = first.as<CompareGreaterInstruction>();
+            const auto& jump_instruction = second.as<JumpIfInstruction>();
+            if (jump_instruction.condition_register() != compare_instruction.dst_register())
+                return {};
+            return InstructionRecord::create<FusedCompareGreaterJumpIfInstruction>(
+                compare_instruction.dst_register(), compare_instruction.lhs_register(), compare_instruction.rhs_register(),
+                jump_instruction.jump_address());
+        }
+
+        case OpCode::FusedCompareGreaterImmediateJumpIf: {
+            const auto& compare_instruction = first.as<CompareGreaterImmediateInstruction>();
+            const auto& jump_instruction = second.as<JumpIfInstruction>();
+            if (jump_instruction.condition_register() != compare_instruction.dst_register())
+                return {};
+            return InstructionRecord::create<FusedCompareGreaterImmediateJumpIfInstruction>(
+                compare_instruction.dst_register(), compare_instruction.lhs_register(), compare_instruction.immediate_value(),
+                jump_instruction.jump_address());
+        }
+
+        case OpCode::FusedLoadAddStore: {
+            const auto& load_instruction = first.as<LoadFromStackInstruction>();
+            const auto& add_instruction = second.as<AddInstruction>();
+            const auto& store_instruction = instruction_at(instruction_index + 2).as<StoreToStackInstruction>();
+            if (store_instruction.src_register() != add_instruction.dst_register())
+                return {};
+
+            // NOTE: Addition is commutative, so the loaded register can be either of the operands.
+            Register other_register = add_instruction.rhs_register();
+            if (add_instruction.lhs_register() != load_instruction.dst_register()) {
+                if (add_instruction.rhs_register() != load_instruction.dst_register())
+                    return {};
+                other_register = add_instruction.lhs_register();
+            }
+
+            return InstructionRecord::create<FusedLoadAddStoreInstruction>(add_instruction.dst_register(), load_instruction.dst_register(),
+                                                                          other_register, load_instruction.src_stack_offset(),
+                                                                          store_instruction.dst_stack_offset());
+        }
+
+        case OpCode::FusedLoadIncrementStore: {
+            const auto& load_instruction = first.as<LoadFromStackInstruction>();
+            const auto& increment_instruction = second.as<IncrementInstruction>();
+            const auto& store_instruction = instruction_at(instruction_index + 2).as<StoreToStackInstruction>();
+            if (increment_instruction.dst_register() != load_instruction.dst_register() ||
+                store_instruction.src_register() != load_instruction.dst_register() ||
+                store_instruction.dst_stack_offset() != load_instruction.src_stack_offset()) {
+                return {};
+            }
+            return InstructionRecord::create<FusedLoadIncrementStoreInstruction>(load_instruction.dst_register(),
+                                                                                 load_instruction.src_stack_offset());
+        }
+
+        case OpCode::FusedLoadPair: {
+            const auto& first_load_instruction = first.as<LoadFromStackInstruction>();
+            const auto& second_load_instruction = second.as<LoadFromStackInstruction>();
+            return InstructionRecord::create<FusedLoadPairInstruction>(
+                first_load_instruction.dst_register(), first_load_instruction.src_stack_offset(), second_load_instruction.dst_register(),
+                second_load_instruction.src_stack_offset());
+        }
+
+        case OpCode::FusedLoadStore: {
+            const auto& load_instruction = first.as<LoadFromStackInstruction>();
+            const auto& store_instruction = second.as<StoreToStackInstruction>();
+            if (store_instruction.src_register() != load_instruction.dst_register())
+                return {};
+            return InstructionRecord::create<FusedLoadStoreInstruction>(
+                load_instruction.dst_register(), load_instruction.src_stack_offset(), store_instruction.dst_stack_offset());
+        }
+
+        default:
+            ARC_ASSERT_NOT_REACHED;
+    }
+}
+
+usize OptimizationContext::fuse_superinstructions(const Vector<OpCode>& superinstruction_opcodes)
+{
+    m_is_removed.clear();
+    m_is_removed.set_count(m_instructions.count(), false);
+    find_branch_destinations();
+
+    for (usize instruction_index = 0; instruction_index < m_instructions.count(); ++instruction_index) {
+        for (const OpCode superinstruction_opcode : superinstruction_opcodes) {
+            const SuperinstructionPattern* pattern = nullptr;
+            for (const SuperinstructionPattern& candidate_pattern : Superinstructions::patterns()) {
+                if (candidate_pattern.superinstruction_opcode == superinstruction_opcode)
+                    pattern = &candidate_pattern;
+            }
+            ARC_ASSERT(pattern != nullptr);
+
+            const Optional<InstructionRecord> superinstruction = try_create_superinstruction(instruction_index, *pattern);
+            if (!superinstruction.has_value())
+                continue;
+
+            // The superinstruction replaces the first instruction of the sequence, and the others are removed.
+            m_instructions[instruction_index] = superinstruction.value();
+            for (usize sequence_index = 1; sequence_index < pattern->sequence_length; ++sequence_index)
+                m_is_removed[instruction_index + sequence_index] = true;
+            instruction_index += pattern->sequence_length - 1;
+            break;
+        }
+    }
+
+    return compact_instructions();
+}
+
+usize OptimizationContext::optimize()
+{
+    usize removed_instruction_count = 0;
+    while (true) {
+        const bool has_threaded_jumps = thread_jumps();
+        const bool has_converted_tail_calls = convert_tail_calls();
+
+        m_is_removed.clear();
+        m_is_removed.set_count(m_instructions.count(), false);
+        find_branch_destinations();
+
+        remove_jumps_to_next_instruction();
+        remove_unreachable_instructions();
+        remove_redundant_stack_accesses();
+        remove_push_pop_pairs();
+        remove_dead_loads();
+
+        const usize pass_removed_instruction_count = compact_instructions();
+        removed_instruction_count += pass_removed_instruction_count;
+        if (!has_threaded_jumps && !has_converted_tail_calls && pass_removed_instruction_count == 0)
+            break;
+    }
+
+    return removed_instruction_count;
+}
+
+usize Optimizer::optimize(Package& package)
+{
+    OptimizationContext context(package);
+    const usize removed_instruction_count = context.optimize();
+
+    for (usize entry_point_index = 0; entry_point_index < context.entry_point_addresses().count(); ++entry_point_index)
+        package.set_entry_point_address({}, entry_point_index, context.entry_point_addresses()[entry_point_index]);
+    package.replace_instructions({}, move(context.instructions()), move(context.jump_table_entries()));
+    return removed_instruction_count;
+}
+
+usize Optimizer::fuse_superinstructions(Package& package, const Vector<OpCode>& superinstruction_opcodes)
+{
+    OptimizationContext context(package);
+    const usize removed_instruction_count = context.fuse_superinstructions(superinstruction_opcodes);
+
+    for (usize entry_point_index = 0; entry_point_index < context.entry_point_addresses().count(); ++entry_point_index)
+        package.set_entry_point_address({}, entry_point_index, context.entry_point_addresses()[entry_point_index]);
+    package.replace_instructions({}, move(context.instructions()), move(context.jump_table_entries()));
+    return removed_instruction_count;
+}
+
+}
@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause.
+ */
+
+#pragma once
+
+#include <bytecode/forward.h>
+#include <core/containers/vector.h>
+
+namespace Arc::Bytecode {
+
+//
+// Peephole optimizer that rewrites the instructions of a package in place. The following transformations are
+// applied repeatedly, until none of them changes the package anymore:
+//   - Jumps whose target is another unconditional jump are redirected to the final target of the chain.
+//   - Jumps to the instruction that immediately follows them are removed.
+//   - Instructions that can't be reached from any entry point of the package are removed.
+//   - Loads of a stack slot into the register that was just stored into (or loaded from) the same slot are removed.
+//   - Stores of a register into the stack slot it was just loaded from are removed.
+//   - Loads into a register that is overwritten before being read are removed.
+//   - Pushes that are immediately followed by a pop of the same size are removed.
+//   - Calls that are immediately followed by a return of their result are replaced by tail calls, which reuse the
+//     frame of the current function instead of pushing a new one.
+//
+// All jump targets, call targets and entry points are relocated after instructions are removed. Patterns that span
+// multiple instructions are never applied when any instruction (except the first) is the target of a jump or a call,
+// or the return address of a call, as the instruction could then be reached without executing the previous ones.
+//
+class Optimizer {
+    ARC_MAKE_NAMESPACE_CLASS(Optimizer)
+
+public:
+    // Returns the number of instructions that were removed from the package.
+    static usize optimize(Package&);
+
+    // Replaces all sequences of instructions that match one of the given superinstructions. When multiple
+    // superinstructions match at the same location, the one that appears first in the list is used.
+    // Returns the number of instructions that were removed from the package.
+    static usize fuse_superinstructions(Package&, const Vector<OpCode>& superinstruction_opcodes);
+};
+
+}
@@ -4,22 +4,109 @@
  */
 
 #include <bytecode/package.h>
+#include <core/numeric_limits.h>
 
 namespace Arc::Bytecode {
 
 Package::Package()
+    : m_instruction_records(nullptr)
+    , m_instruction_count(0)
+    , m_jump_table_entries(nullptr)
+    , m_jump_table_entry_count(0)
+    , m_is_verified(false)
+    , m_modification_count(0)
 {}
 
 bool Package::instruction_pointer_is_valid(usize instruction_pointer) const
 {
-    const bool instruction_pointer_is_in_range = instruction_pointer < m_instructions.count();
+    const bool instruction_pointer_is_in_range = instruction_pointer < m_instruction_count;
     return instruction_pointer_is_in_range;
 }
 
 const Instruction& Package::fetch_instruction(usize instruction_pointer) const
 {
     ARC_ASSERT(instruction_pointer_is_valid(instruction_pointer));
-    return m_instructions.at(instruction_pointer).dereference();
+    return m_instruction_records[instruction_pointer].instruction();
+}
+
+u32 Package::add_jump_table(const Vector<JumpAddress>& targets)
+{
+    // NOTE: Jump tables can't be added to a package whose jump table entries are mapped from a file.
+    ARC_ASSERT(!m_file_mapping.is_mapped());
+    ARC_ASSERT(m_owned_jump_table_entries.count() + targets.count() <= NumericLimits<u32>::max());
+
+    const u32 first_entry_index = static_cast<u32>(m_owned_jump_table_entries.count());
+    for (const JumpAddress target : targets)
+        m_owned_jump_table_entries.push_back(target);
+    m_jump_table_entries = m_owned_jump_table_entries.elements();
+    m_jump_table_entry_count = m_owned_jump_table_entries.count();
+    mark_as_modified();
+    return first_entry_index;
+}
+
+bool Package::jump_table_is_valid(u64 first_entry_index, u64 entry_count) const
+{
+    return first_entry_index <= m_jump_table_entry_count && entry_count <= m_jump_table_entry_count - first_entry_index;
+}
+
+JumpAddress Package::fetch_jump_table_entry(u64 entry_index) const
+{
+    ARC_ASSERT(entry_index < m_jump_table_entry_count);
+    return m_jump_table_entries[entry_index];
+}
+
+void Package::add_entry_point(StringView name, JumpAddress address)
+{
+    // NOTE: Entry point names must be unique within a package.
+    ARC_ASSERT(!find_entry_point(name).has_value());
+    m_entry_points.push_back({ String(name), address });
+    mark_as_modified();
+}
+
+Optional<JumpAddress> Package::find_entry_point(StringView name) const
+{
+    for (const EntryPoint& entry_point : m_entry_points) {
+        if (StringView(entry_point.name) == name)
+            return entry_point.address;
+    }
+
+    return {};
+}
+
+void Package::adopt_file_mapping(Badge<PackageLoader>, FileMapping file_mapping, const InstructionRecord* instruction_records,
+                                 usize instruction_count, const JumpAddress* jump_table_entries, usize jump_table_entry_count)
+{
+    m_instructions.clear_and_shrink();
+    m_owned_jump_table_entries.clear_and_shrink();
+    m_file_mapping = move(file_mapping);
+    m_instruction_records = instruction_records;
+    m_instruction_count = instruction_count;
+    m_jump_table_entries = jump_table_entries;
+    m_jump_table_entry_count = jump_table_entry_count;
+    mark_as_modified();
+}
+
+void Package::replace_instructions(Badge<Optimizer>, Vector<InstructionRecord> instructions, Vector<JumpAddress> jump_table_entries)
+{
+    m_instructions = move(instructions);
+    m_owned_jump_table_entries = move(jump_table_entries);
+    m_file_mapping.unmap();
+    m_instruction_records = m_instructions.elements();
+    m_instruction_count = m_instructions.count();
+    m_jump_table_entries = m_owned_jump_table_entries.elements();
+    m_jump_table_entry_count = m_owned_jump_table_entries.count();
+    mark_as_modified();
+}
+
+void Package::set_entry_point_address(Badge<Optimizer>, usize entry_point_index, JumpAddress address)
+{
+    m_entry_points[entry_point_index].address = address;
+    mark_as_modified();
+}
+
+void Package::mark_as_verified(Badge<Verifier>)
+{
+    m_is_verified = true;
 }
 
 }
@@ -6,30 +6,111 @@
 #pragma once
 
 #include <bytecode/instruction.h>
-#include <core/containers/own_ptr.h>
+#include <core/badge.h>
 #include <core/containers/vector.h>
+#include <core/memory/file_mapping.h>
 
 namespace Arc::Bytecode {
 
+class Optimizer;
+class PackageLoader;
+class Verifier;
+
+// NOTE: Reading a package never modifies it, so a single package can be executed by many threads at the same time,
+//       each with its own virtual machine and interpreter, as long as no thread modifies it in the meantime. See
+//       `Runtime::VirtualMachinePool::execute_batch`.
 class Package {
     ARC_MAKE_NONCOPYABLE(Package);
     ARC_MAKE_NONMOVABLE(Package);
 
+public:
+    struct EntryPoint {
+        String name;
+        JumpAddress address { 0 };
+    };
+
 public:
     Package();
 
     template<typename InstructionType, typename... Args>
     void emit_instruction(Args&&... args)
     {
-        // Create the instruction and push it to the instruction list.
-        m_instructions.push_back(create_own<InstructionType>(forward<Args>(args)...));
+        // NOTE: Instructions can't be emitted into a package whose instructions are mapped from a file.
+        ARC_ASSERT(!m_file_mapping.is_mapped());
+
+        // Construct the instruction in-place, inside a new record at the end of the instruction stream.
+        m_instructions.push_back(InstructionRecord::create<InstructionType>(forward<Args>(args)...));
+        m_instruction_records = m_instructions.elements();
+        m_instruction_count = m_instructions.count();
+        mark_as_modified();
     }
 
+    NODISCARD ALWAYS_INLINE usize instruction_count() const { return m_instruction_count; }
+    NODISCARD ALWAYS_INLINE const InstructionRecord* instruction_records() const { return m_instruction_records; }
+
     bool instruction_pointer_is_valid(usize instruction_pointer) const;
     const Instruction& fetch_instruction(usize instruction_pointer) const;
 
+public:
+    // Appends the given targets to the jump table entries of the package and returns the index of the first one, which
+    // is how `JumpTableInstruction`s reference the table.
+    u32 add_jump_table(const Vector<JumpAddress>& targets);
+
+    NODISCARD ALWAYS_INLINE usize jump_table_entry_count() const { return m_jump_table_entry_count; }
+    NODISCARD ALWAYS_INLINE const JumpAddress* jump_table_entries() const { return m_jump_table_entries; }
+
+    bool jump_table_is_valid(u64 first_entry_index, u64 entry_count) const;
+    JumpAddress fetch_jump_table_entry(u64 entry_index) const;
+
+public:
+    void add_entry_point(StringView name, JumpAddress address);
+    NODISCARD Optional<JumpAddress> find_entry_point(StringView name) const;
+    NODISCARD ALWAYS_INLINE const Vector<EntryPoint>& entry_points() const { return m_entry_points; }
+
+    // Makes the package execute directly out of the instruction records and jump table entries stored in the given
+    // file mapping.
+    void adopt_file_mapping(Badge<PackageLoader>, FileMapping file_mapping, const InstructionRecord* instruction_records,
+                            usize instruction_count, const JumpAddress* jump_table_entries, usize jump_table_entry_count);
+
+    // Replaces all the instructions and jump table entries of the package. If the package was mapped from a file, the
+    // mapping is released.
+    void replace_instructions(Badge<Optimizer>, Vector<InstructionRecord> instructions, Vector<JumpAddress> jump_table_entries);
+    void set_entry_point_address(Badge<Optimizer>, usize entry_point_index, JumpAddress address);
+
+public:
+    // Verified packages can be executed by the interpreter without any per-instruction safety checks.
+    // Modifying the package in any way invalidates the verification.
+    NODISCARD ALWAYS_INLINE bool is_verified() const { return m_is_verified; }
+    void mark_as_verified(Badge<Verifier>);
+
+    // Incremented every time the package is modified, so that anything derived from its instructions, jump table
+    // entries or entry points can detect that it is stale.
+    NODISCARD ALWAYS_INLINE u64 modification_count() const { return m_modification_count; }
+
 private:
-    Vector<OwnPtr<Bytecode::Instruction>> m_instructions;
+    ALWAYS_INLINE void mark_as_modified()
+    {
+        m_is_verified = false;
+        ++m_modification_count;
+    }
+
+private:
+    // NOTE: The instruction records are either owned by the package (when they are emitted) or are stored inside
+    //       the file mapping (when the package is loaded from disk). In both cases all accesses go through the
+    //       `m_instruction_records` view, which always points to the active storage.
+    Vector<InstructionRecord> m_instructions;
+    FileMapping m_file_mapping;
+    const InstructionRecord* m_instruction_records;
+    usize m_instruction_count;
+
+    // NOTE: The jump table entries follow the same storage model as the instruction records.
+    Vector<JumpAddress> m_owned_jump_table_entries;
+    const JumpAddress* m_jump_table_entries;
+    usize m_jump_table_entry_count;
+
+    Vector<EntryPoint> m_entry_points;
+    bool m_is_verified;
+    u64 m_modification_count;
 };
 
 }
@@ -0,0 +1,198 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause.
+ */
+
+#include <bytecode/package.h>
+#include <bytecode/package_file.h>
+#include <core/memory/file_mapping.h>
+#include <core/memory/memory_operations.h>
+
+#include <cstdio>
+
+namespace Arc::Bytecode {
+
+static constexpr u8 package_file_signature[8] = { 'A', 'R', 'C', 'P', 'K', 'G', 0, 0 };
+
+static_assert(package_file_section_alignment % instruction_record_alignment == 0);
+static_assert(sizeof(PackageFileHeader) % 8 == 0);
+static_assert(package_file_section_alignment % alignof(JumpAddress) == 0);
+static_assert(sizeof(JumpAddress) == sizeof(u64));
+
+NODISCARD ALWAYS_INLINE static u64 align_up(u64 value, u64 alignment)
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+ByteBuffer PackageWriter::serialize(const Package& package)
+{
+    PackageFileHeader header = {};
+    copy_memory(header.signature, package_file_signature, sizeof(header.signature));
+    header.format_version = package_file_format_version;
+    header.byte_order_mark = package_file_byte_order_mark;
+    header.instruction_record_byte_count = instruction_record_byte_count;
+
+    // Compute the layout of the file sections.
+    header.code_section_offset = align_up(sizeof(PackageFileHeader), package_file_section_alignment);
+    header.instruction_count = package.instruction_count();
+
+    const u64 code_section_byte_count = header.instruction_count * instruction_record_byte_count;
+    header.jump_table_section_offset = align_up(header.code_section_offset + code_section_byte_count, package_file_section_alignment);
+    header.jump_table_entry_count = package.jump_table_entry_count();
+
+    const u64 jump_table_section_byte_count = header.jump_table_entry_count * sizeof(JumpAddress);
+    header.entry_point_table_offset =
+        align_up(header.jump_table_section_offset + jump_table_section_byte_count, package_file_section_alignment);
+    header.entry_point_count = package.entry_points().count();
+
+    const u64 entry_point_table_byte_count = header.entry_point_count * sizeof(PackageFileEntryPoint);
+    header.string_table_offset = align_up(header.entry_point_table_offset + entry_point_table_byte_count, package_file_section_alignment);
+    for (const Package::EntryPoint& entry_point : package.entry_points())
+        header.string_table_byte_count += entry_point.name.byte_count();
+
+    header.file_byte_count = header.string_table_offset + header.string_table_byte_count;
+
+    // NOTE: The buffer is zeroed so that the padding between sections is deterministic.
+    ByteBuffer file_buffer = ByteBuffer::allocate(header.file_byte_count);
+    zero_memory(file_buffer.bytes(), file_buffer.byte_count());
+
+    copy_memory(file_buffer.bytes(), &header, sizeof(PackageFileHeader));
+    copy_memory(file_buffer.bytes() + header.code_section_offset, package.instruction_records(), code_section_byte_count);
+    copy_memory(file_buffer.bytes() + header.jump_table_section_offset, package.jump_table_entries(), jump_table_section_byte_count);
+
+    u64 name_offset = 0;
+    auto* entry_point_table = reinterpret_cast<PackageFileEntryPoint*>(file_buffer.bytes() + header.entry_point_table_offset);
+    for (usize entry_point_index = 0; entry_point_index < package.entry_points().count(); ++entry_point_index) {
+        const Package::EntryPoint& entry_point = package.entry_points()[entry_point_index];
+
+        PackageFileEntryPoint& file_entry_point = entry_point_table[entry_point_index];
+        file_entry_point.instruction_offset = entry_point.address.address();
+        file_entry_point.name_offset = name_offset;
+        file_entry_point.name_byte_count = entry_point.name.byte_count();
+
+        copy_memory(file_buffer.bytes() + header.string_table_offset + name_offset, entry_point.name.characters(),
+                    entry_point.name.byte_count());
+        name_offset += entry_point.name.byte_count();
+    }
+
+    return file_buffer;
+}
+
+ErrorOr<void> PackageWriter::write_to_file(const Package& package, StringView filepath)
+{
+    const ByteBuffer file_buffer = serialize(package);
+
+    const String null_terminated_filepath = String(filepath);
+    FILE* file_handle = fopen(null_terminated_filepath.characters(), "wb");
+    if (file_handle == nullptr)
+        return ARC_INTERNAL_ERROR_WITH_MESSAGE("Failed to open the package file for writing"sv);
+
+    const usize written_byte_count = fwrite(file_buffer.bytes(), 1, file_buffer.byte_count(), file_handle);
+    const bool closed_successfully = fclose(file_handle) == 0;
+    if (written_byte_count != file_buffer.byte_count() || !closed_successfully)
+        return ARC_INTERNAL_ERROR_WITH_MESSAGE("Failed to write the package file"sv);
+
+    return {};
+}
+
+// Returns true if the region [offset, offset + byte_count) is entirely contained within a buffer of the given size.
+NODISCARD ALWAYS_INLINE static bool region_is_in_bounds(u64 offset, u64 byte_count, u64 buffer_byte_count)
+{
+    return offset <= buffer_byte_count && byte_count <= buffer_byte_count - offset;
+}
+
+ErrorOr<void> PackageLoader::load_from_file(Package& package, StringView filepath)
+{
+    // NOTE: Only empty packages can be loaded from a file.
+    ARC_ASSERT(package.instruction_count() == 0 && package.entry_points().is_empty());
+
+    TRY_ASSIGN(FileMapping file_mapping, FileMapping::map_readonly(filepath));
+    const ReadonlyBytes file_bytes = file_mapping.bytes();
+    const usize file_byte_count = file_mapping.byte_count();
+
+    if (file_byte_count < sizeof(PackageFileHeader))
+        return ARC_INTERNAL_ERROR_WITH_MESSAGE("The package file is too small to contain a header"sv);
+
+    // NOTE: Mappings always start at a page boundary, so the header is suitably aligned.
+    const auto& header = *reinterpret_cast<const PackageFileHeader*>(file_bytes);
+    for (usize byte_index = 0; byte_index < sizeof(package_file_signature); ++byte_index) {
+        if (header.signature[byte_index] != package_file_signature[byte_index])
+            return ARC_INTERNAL_ERROR_WITH_MESSAGE("The file is not an ARC package"sv);
+    }
+
+    if (header.format_version != package_file_format_version)
+        return ARC_INTERNAL_ERROR_WITH_MESSAGE("Unsupported package file format version"sv);
+    if (header.byte_order_mark != package_file_byte_order_mark)
+        return ARC_INTERNAL_ERROR_WITH_MESSAGE("The package file was written by a machine with a different byte order"sv);
+    if (header.instruction_record_byte_count != instruction_record_byte_count)
+        return ARC_INTERNAL_ERROR_WITH_MESSAGE("The package file uses a different instruction record size"sv);
+    if (header.file_byte_count != file_byte_count)
+        return ARC_INTERNAL_ERROR_WITH_MESSAGE("The package file is truncated or has trailing data"sv);
+
+    // Validate the code section.
+    if (header.code_section_offset % package_file_section_alignment != 0)
+        return ARC_INTERNAL_ERROR_WITH_MESSAGE("The code section is not correctly aligned"sv);
+    if (header.instruction_count > file_byte_count / instruction_record_byte_count ||
+        !region_is_in_bounds(header.code_section_offset, header.instruction_count * instruction_record_byte_count, file_byte_count)) {
+        return ARC_INTERNAL_ERROR_WITH_MESSAGE("The code section is out of bounds"sv);
+    }
+
+    const auto* instruction_records = reinterpret_cast<const InstructionRecord*>(file_bytes + header.code_section_offset);
+    for (usize instruction_index = 0; instruction_index < header.instruction_count; ++instruction_index) {
+        // NOTE: Unknown opcodes would make the interpreter index past the end of its dispatch table.
+        if (static_cast<u8>(instruction_records[instruction_index].opcode()) >= static_cast<u8>(OpCode::Count))
+            return ARC_INTERNAL_ERROR_WITH_MESSAGE("The code section contains an unknown opcode"sv);
+    }
+
+    // Validate the jump table section. The jump targets themselves are validated by the verifier, like all the other
+    // jump addresses.
+    if (header.jump_table_section_offset % package_file_section_alignment != 0)
+        return ARC_INTERNAL_ERROR_WITH_MESSAGE("The jump table section is not correctly aligned"sv);
+    if (header.jump_table_entry_count > file_byte_count / sizeof(JumpAddress) ||
+        !region_is_in_bounds(header.jump_table_section_offset, header.jump_table_entry_count * sizeof(JumpAddress), file_byte_count)) {
+        return ARC_INTERNAL_ERROR_WITH_MESSAGE("The jump table section is out of bounds"sv);
+    }
+    const auto* jump_table_entries = reinterpret_cast<const JumpAddress*>(file_bytes + header.jump_table_section_offset);
+
+    // Validate the entry point and string tables.
+    if (header.entry_point_table_offset % package_file_section_alignment != 0)
+        return ARC_INTERNAL_ERROR_WITH_MESSAGE("The entry point table is not correctly aligned"sv);
+    if (header.entry_point_count > file_byte_count / sizeof(PackageFileEntryPoint) ||
+        !region_is_in_bounds(header.entry_point_table_offset, header.entry_point_count * sizeof(PackageFileEntryPoint), file_byte_count)) {
+        return ARC_INTERNAL_ERROR_WITH_MESSAGE("The entry point table is out of bounds"sv);
+    }
+    if (!region_is_in_bounds(header.string_table_offset, header.string_table_byte_count, file_byte_count))
+        return ARC_INTERNAL_ERROR_WITH_MESSAGE("The string table is out of bounds"sv);
+
+    const auto* entry_point_table = reinterpret_cast<const PackageFileEntryPoint*>(file_bytes + header.entry_point_table_offset);
+    const auto* string_table = reinterpret_cast<const char*>(file_bytes + header.string_table_offset);
+    for (usize entry_point_index = 0; entry_point_index < header.entry_point_count; ++entry_point_index) {
+        const PackageFileEntryPoint& file_entry_point = entry_point_table[entry_point_index];
+        if (!region_is_in_bounds(file_entry_point.name_offset, file_entry_point.name_byte_count, header.string_table_byte_count))
+            return ARC_INTERNAL_ERROR_WITH_MESSAGE("An entry point name is out of bounds"sv);
+        if (file_entry_point.instruction_offset >= header.instruction_count)
+            return ARC_INTERNAL_ERROR_WITH_MESSAGE("An entry point is outside the code section"sv);
+
+        const StringView name = StringView::from_utf8(string_table + file_entry_point.name_offset, file_entry_point.name_byte_count);
+        for (usize previous_index = 0; previous_index < entry_point_index; ++previous_index) {
+            const PackageFileEntryPoint& previous_entry_point = entry_point_table[previous_index];
+            const StringView previous_name =
+                StringView::from_utf8(string_table + previous_entry_point.name_offset, previous_entry_point.name_byte_count);
+            if (name == previous_name)
+                return ARC_INTERNAL_ERROR_WITH_MESSAGE("The package file contains duplicated entry points"sv);
+        }
+    }
+
+    // NOTE: The package is only modified after the whole file has been validated.
+    for (usize entry_point_index = 0; entry_point_index < header.entry_point_count; ++entry_point_index) {
+        const PackageFileEntryPoint& file_entry_point = entry_point_table[entry_point_index];
+        const StringView name = StringView::from_utf8(string_table + file_entry_point.name_offset, file_entry_point.name_byte_count);
+        package.add_entry_point(name, JumpAddress(file_entry_point.instruction_offset));
+    }
+
+    package.adopt_file_mapping({}, move(file_mapping), instruction_records, header.instruction_count, jump_table_entries,
+                               header.jump_table_entry_count);
+    return {};
+}
+
+}
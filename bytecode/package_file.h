@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause.
+ */
+
+#pragma once
+
+#include <bytecode/forward.h>
+#include <core/error.h>
+#include <core/memory/byte_buffer.h>
+
+namespace Arc::Bytecode {
+
+//
+// Layout of an `.arcpkg` file. All integers are stored in the byte order of the machine that wrote the file, which
+// is validated through the `byte_order_mark` field when loading. Every section starts at an offset that is aligned
+// to `package_file_section_alignment`, so that the instruction records can be used directly from the mapped file.
+//
+//   [PackageFileHeader]
+//   [code section]              - `instruction_count` instruction records, exactly as they are stored in memory.
+//   [jump table section]        - `jump_table_entry_count` jump addresses, referenced by the `JumpTable` instructions.
+//   [entry point table]         - `entry_point_count` entries of type `PackageFileEntryPoint`.
+//   [string table]              - The (not null-terminated) names of the entry points.
+//
+
+// NOTE: The code section stores the raw instruction records, so the version must be incremented whenever opcodes are
+//       added, removed or reordered, and whenever the semantics of an existing instruction change.
+constexpr u32 package_file_format_version = 9;
+constexpr u32 package_file_byte_order_mark = 0x01020304;
+constexpr usize package_file_section_alignment = 64;
+
+struct PackageFileHeader {
+    u8 signature[8];
+    u32 format_version;
+    u32 byte_order_mark;
+    u32 instruction_record_byte_count;
+    u32 reserved;
+    u64 file_byte_count;
+
+    u64 code_section_offset;
+    u64 instruction_count;
+
+    u64 jump_table_section_offset;
+    u64 jump_table_entry_count;
+
+    u64 entry_point_table_offset;
+    u64 entry_point_count;
+
+    u64 string_table_offset;
+    u64 string_table_byte_count;
+};
+
+struct PackageFileEntryPoint {
+    u64 instruction_offset;
+    u64 name_offset;
+    u64 name_byte_count;
+};
+
+class PackageWriter {
+    ARC_MAKE_NAMESPACE_CLASS(PackageWriter)
+
+public:
+    NODISCARD static ByteBuffer serialize(const Package&);
+    NODISCARD static ErrorOr<void> write_to_file(const Package&, StringView filepath);
+};
+
+class PackageLoader {
+    ARC_MAKE_NAMESPACE_CLASS(PackageLoader)
+
+public:
+    // Maps the given file into memory and makes the package execute directly out of the mapping. The instruction
+    // records and jump table entries are never copied, and the only per-instruction work is validating that each opcode is known.
+    NODISCARD static ErrorOr<void> load_from_file(Package&, StringView filepath);
+};
+
+}
@@ -10,11 +10,25 @@
 
 namespace Arc::Bytecode {
 
+// NOTE: Registers are not shared between functions. Each call frame owns a window of `Register::Count` registers
+//       in the register file of the virtual machine, so a callee can never clobber the registers of its caller.
 enum class Register : u8 {
     GPR0 = 0,
     GPR1,
     GPR2,
     GPR3,
+    GPR4,
+    GPR5,
+    GPR6,
+    GPR7,
+    GPR8,
+    GPR9,
+    GPR10,
+    GPR11,
+    GPR12,
+    GPR13,
+    GPR14,
+    GPR15,
     Count,
 };
 
@@ -27,16 +41,13 @@ public:
     ALWAYS_INLINE static void format(FormatStream& stream, const Bytecode::Register& value)
     {
         stream.push_codepoint('$');
-        // clang-format off
-        switch (value) {
-            case Bytecode::Register::GPR0: stream.push_string("GPR0"sv); break;
-            case Bytecode::Register::GPR1: stream.push_string("GPR1"sv); break;
-            case Bytecode::Register::GPR2: stream.push_string("GPR2"sv); break;
-            case Bytecode::Register::GPR3: stream.push_string("GPR3"sv); break;
-
-            default: stream.push_codepoint('?');
+        if (static_cast<u8>(value) < static_cast<u8>(Bytecode::Register::Count)) {
+            stream.push_string("GPR"sv);
+            stream.push_unsigned_integer(static_cast<u8>(value));
+        }
+        else {
+            stream.push_codepoint('?');
         }
-        // clang-format on
     }
 };
 }
@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause.
+ */
+
+#include <bytecode/opcode_profile.h>
+#include <bytecode/superinstructions.h>
+
+namespace Arc::Bytecode {
+
+// clang-format off
+static constexpr SuperinstructionPattern superinstruction_patterns[] = {
+    { OpCode::FusedCompareGreaterJumpIf, { OpCode::CompareGreater, OpCode::JumpIf, OpCode::Count }, 2 },
+    { OpCode::FusedCompareGreaterImmediateJumpIf, { OpCode::CompareGreaterImmediate, OpCode::JumpIf, OpCode::Count }, 2 },
+    { OpCode::FusedLoadAddStore, { OpCode::LoadFromStack, OpCode::Add, OpCode::StoreToStack }, 3 },
+    { OpCode::FusedLoadIncrementStore, { OpCode::LoadFromStack, OpCode::Increment, OpCode::StoreToStack }, 3 },
+    { OpCode::FusedLoadPair, { OpCode::LoadFromStack, OpCode::LoadFromStack, OpCode::Count }, 2 },
+    { OpCode::FusedLoadStore, { OpCode::LoadFromStack, OpCode::StoreToStack, OpCode::Count }, 2 },
+};
+// clang-format on
+
+Span<const SuperinstructionPattern> Superinstructions::patterns()
+{
+    constexpr usize pattern_count = sizeof(superinstruction_patterns) / sizeof(superinstruction_patterns[0]);
+    return Span<const SuperinstructionPattern>(superinstruction_patterns, pattern_count);
+}
+
+Vector<OpCode> Superinstructions::select_from_profile(const OpcodeProfile& profile, usize max_superinstruction_count,
+                                                      u64 minimum_execution_count)
+{
+    struct Candidate {
+        OpCode superinstruction_opcode;
+        u64 execution_count;
+    };
+
+    Vector<Candidate> candidates;
+    for (const SuperinstructionPattern& pattern : patterns()) {
+        u64 execution_count = 0;
+        if (pattern.sequence_length == 2)
+            execution_count = profile.pair_count(pattern.sequence[0], pattern.sequence[1]);
+        else
+            execution_count = profile.triple_count(pattern.sequence[0], pattern.sequence[1], pattern.sequence[2]);
+
+        // NOTE: Replacing a sequence of N instructions saves N - 1 dispatches each time it is executed.
+        execution_count *= pattern.sequence_length - 1;
+        if (execution_count == 0 || execution_count < minimum_execution_count)
+            continue;
+
+        // Insert the candidate while keeping the list sorted in descending order of the execution count.
+        candidates.push_back({ pattern.superinstruction_opcode, execution_count });
+        for (usize position = candidates.count() - 1; position > 0; --position) {
+            if (candidates[position - 1].execution_count >= candidates[position].execution_count)
+                break;
+            const Candidate temporary = candidates[position - 1];
+            candidates[position - 1] = candidates[position];
+            candidates[position] = temporary;
+        }
+    }
+
+    Vector<OpCode> selected_opcodes;
+    for (usize candidate_index = 0; candidate_index < candidates.count() && candidate_index < max_superinstruction_count; ++candidate_index)
+        selected_opcodes.push_back(candidates[candidate_index].superinstruction_opcode);
+    return selected_opcodes;
+}
+
+}
@@ -0,0 +1,35 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause.
+ */
+
+#pragma once
+
+#include <bytecode/instruction.h>
+#include <core/containers/span.h>
+#include <core/containers/vector.h>
+
+namespace Arc::Bytecode {
+
+// Describes the sequence of opcodes that is replaced by a superinstruction. Besides matching the opcodes, the
+// operands of the instructions must also satisfy some constraints, which are checked by the optimizer.
+struct SuperinstructionPattern {
+    OpCode superinstruction_opcode;
+    OpCode sequence[3];
+    u8 sequence_length;
+};
+
+class Superinstructions {
+    ARC_MAKE_NAMESPACE_CLASS(Superinstructions)
+
+public:
+    // Returns the catalog of all superinstructions that the interpreter implements.
+    NODISCARD static Span<const SuperinstructionPattern> patterns();
+
+    // Returns the superinstructions whose opcode sequences are the most frequently executed ones in the profile,
+    // sorted by their execution count. Sequences executed less than `minimum_execution_count` times are ignored.
+    NODISCARD static Vector<OpCode> select_from_profile(const OpcodeProfile& profile, usize max_superinstruction_count,
+                                                        u64 minimum_execution_count);
+};
+
+}
@@ -0,0 +1,540 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause.
+ */
+
+#include <bytecode/package.h>
+#include <bytecode/verifier.h>
+#include <core/numeric_limits.h>
+
+namespace Arc::Bytecode {
+
+static const usize invalid_function_index = NumericLimits<usize>::max();
+
+struct InstructionState {
+    usize function_index { invalid_function_index };
+    u64 stack_depth { 0 };
+};
+
+struct FunctionState {
+    usize entry_instruction_pointer { 0 };
+    bool is_entry_point { false };
+
+    // The number of bytes, above the call frame header that is pushed when the function is entered, that are
+    // guaranteed to be live. Only known after all call sites have been discovered.
+    u64 accessible_byte_count { NumericLimits<u64>::max() };
+    // The number of bytes above the call frame header that the function needs to access.
+    u64 required_byte_count { 0 };
+};
+
+struct CallSite {
+    usize callee_function_index;
+    u64 stack_depth;
+};
+
+class VerificationContext {
+public:
+    explicit VerificationContext(const Package& package)
+        : m_package(package)
+    {
+        m_instruction_states.set_count_defaulted(package.instruction_count());
+    }
+
+    ErrorOr<void> verify();
+
+private:
+    usize function_index_for_entry(usize entry_instruction_pointer);
+    ErrorOr<void> schedule(usize instruction_pointer, usize function_index, u64 stack_depth);
+    ErrorOr<void> verify_instruction(usize instruction_pointer);
+    ErrorOr<void> verify_stack_access(usize instruction_pointer, u64 stack_offset, u64 byte_count);
+    ErrorOr<void> verify_frame_access(usize instruction_pointer, s64 frame_offset, u64 byte_count);
+
+    ErrorOr<void> push(usize instruction_pointer, u64 byte_count);
+    ErrorOr<void> pop(usize instruction_pointer, u64 byte_count);
+    ErrorOr<void> fall_through(usize instruction_pointer, u64 stack_depth);
+    ErrorOr<void> jump(usize instruction_pointer, JumpAddress jump_address);
+
+private:
+    const Package& m_package;
+    Vector<InstructionState> m_instruction_states;
+    Vector<FunctionState> m_functions;
+    Vector<CallSite> m_call_sites;
+    Vector<usize> m_worklist;
+};
+
+NODISCARD ALWAYS_INLINE static bool register_is_valid(Register reg)
+{
+    return static_cast<u8>(reg) < static_cast<u8>(Register::Count);
+}
+
+usize VerificationContext::function_index_for_entry(usize entry_instruction_pointer)
+{
+    for (usize function_index = 0; function_index < m_functions.count(); ++function_index) {
+        if (m_functions[function_index].entry_instruction_pointer == entry_instruction_pointer)
+            return function_index;
+    }
+
+    FunctionState function = {};
+    function.entry_instruction_pointer = entry_instruction_pointer;
+    m_functions.push_back(function);
+    return m_functions.count() - 1;
+}
+
+ErrorOr<void> VerificationContext::schedule(usize instruction_pointer, usize function_index, u64 stack_depth)
+{
+    if (instruction_pointer >= m_package.instruction_count())
+        return ARC_INTERNAL_ERROR_WITH_MESSAGE("Control flow leaves the package"sv);
+
+    InstructionState& state = m_instruction_states[instruction_pointer];
+    if (state.function_index == invalid_function_index) {
+        state.function_index = function_index;
+        state.stack_depth = stack_depth;
+        m_worklist.push_back(instruction_pointer);
+        return {};
+    }
+
+    if (state.function_index != function_index)
+        return ARC_INTERNAL_ERROR_WITH_MESSAGE("An instruction is reachable from more than one function"sv);
+    if (state.stack_depth != stack_depth)
+        return ARC_INTERNAL_ERROR_WITH_MESSAGE("Inconsistent stack depth at a control flow merge point"sv);
+    return {};
+}
+
+ErrorOr<void> VerificationContext::verify_stack_access(usize instruction_pointer, u64 stack_offset, u64 byte_count)
+{
+    const InstructionState& state = m_instruction_states[instruction_pointer];
+    if (stack_offset > NumericLimits<u64>::max() - byte_count)
+        return ARC_INTERNAL_ERROR_WITH_MESSAGE("A stack access overflows the address space"sv);
+
+    // NOTE: Accesses that don't exceed the bytes pushed by the current function are always valid. Anything beyond
+    //       that must be provided by all the callers, which is validated after all call sites are known.
+    const u64 access_end = stack_offset + byte_count;
+    if (access_end > state.stack_depth) {
+        // NOTE: The call frame header lies between the bytes pushed by the function and the bytes of its caller. It's
+        //       owned by the runtime, so the function must never access it.
+        if (stack_offset < state.stack_depth + call_frame_header_byte_count)
+            return ARC_INTERNAL_ERROR_WITH_MESSAGE("A stack access overlaps the call frame header"sv);
+
+        FunctionState& function = m_functions[state.function_index];
+        const u64 required_byte_count = access_end - state.stack_depth - call_frame_header_byte_count;
+        if (required_byte_count > function.required_byte_count)
+            function.required_byte_count = required_byte_count;
+    }
+
+    return {};
+}
+
+ErrorOr<void> VerificationContext::verify_frame_access(usize instruction_pointer, s64 frame_offset, u64 byte_count)
+{
+    // NOTE: The frame pointer is the stack pointer at function entry, so relative to the current stack pointer the
+    //       frame offset is shifted by the number of bytes pushed since then.
+    const InstructionState& state = m_instruction_states[instruction_pointer];
+    if (frame_offset < 0) {
+        const u64 frame_offset_magnitude = 0 - static_cast<u64>(frame_offset);
+        if (frame_offset_magnitude > state.stack_depth)
+            return ARC_INTERNAL_ERROR_WITH_MESSAGE("A frame access is below the stack pointer"sv);
+        return verify_stack_access(instruction_pointer, state.stack_depth - frame_offset_magnitude, byte_count);
+    }
+
+    if (static_cast<u64>(frame_offset) > NumericLimits<u64>::max() - state.stack_depth)
+        return ARC_INTERNAL_ERROR_WITH_MESSAGE("A stack access overflows the address space"sv);
+    return verify_stack_access(instruction_pointer, state.stack_depth + static_cast<u64>(frame_offset), byte_count);
+}
+
+ErrorOr<void> VerificationContext::push(usize instruction_pointer, u64 byte_count)
+{
+    const InstructionState& state = m_instruction_states[instruction_pointer];
+    if (state.stack_depth > NumericLimits<u64>::max() - byte_count)
+        return ARC_INTERNAL_ERROR_WITH_MESSAGE("The stack depth overflows"sv);
+    return fall_through(instruction_pointer, state.stack_depth + byte_count);
+}
+
+ErrorOr<void> VerificationContext::pop(usize instruction_pointer, u64 byte_count)
+{
+    const InstructionState& state = m_instruction_states[instruction_pointer];
+    if (byte_count > state.stack_depth)
+        return ARC_INTERNAL_ERROR_WITH_MESSAGE("A pop releases more bytes than the function has pushed"sv);
+    return fall_through(instruction_pointer, state.stack_depth - byte_count);
+}
+
+ErrorOr<void> VerificationContext::fall_through(usize instruction_pointer, u64 stack_depth)
+{
+    // NOTE: Falling through the last instruction of the package is how execution finishes.
+    if (instruction_pointer + 1 == m_package.instruction_count())
+        return {};
+
+    const usize function_index = m_instruction_states[instruction_pointer].function_index;
+    return schedule(instruction_pointer + 1, function_index, stack_depth);
+}
+
+ErrorOr<void> VerificationContext::jump(usize instruction_pointer, JumpAddress jump_address)
+{
+    const InstructionState& state = m_instruction_states[instruction_pointer];
+    if (jump_address.address() >= m_package.instruction_count())
+        return ARC_INTERNAL_ERROR_WITH_MESSAGE("A jump target is outside the package"sv);
+    return schedule(jump_address.address(), state.function_index, state.stack_depth);
+}
+
+ErrorOr<void> VerificationContext::verify_instruction(usize instruction_pointer)
+{
+    const Instruction& instruction = m_package.fetch_instruction(instruction_pointer);
+    const InstructionState state = m_instruction_states[instruction_pointer];
+
+    switch (instruction.opcode()) {
+#define _ARC_CASE(x) case OpCode::x:
+        ARC_ENUMERATE_BYTECODE_BINARY_REGISTER_OPCODES(_ARC_CASE)
+#undef _ARC_CASE
+        {
+            // NOTE: All three-register instructions share the same layout.
+            const auto& typed_instruction = static_cast<const AddInstruction&>(instruction);
+            if (!register_is_valid(typed_instruction.dst_register()) || !register_is_valid(typed_instruction.lhs_register()) ||
+                !register_is_valid(typed_instruction.rhs_register())) {
+                return ARC_INTERNAL_ERROR_WITH_MESSAGE("Invalid register operand"sv);
+            }
+            return fall_through(instruction_pointer, state.stack_depth);
+        }
+
+        case OpCode::AddImmediate:
+        case OpCode::CompareGreaterImmediate:
+        case OpCode::SubImmediate: {
+            // NOTE: All register-immediate arithmetic instructions share the same layout.
+            const auto& typed_instruction = static_cast<const AddImmediateInstruction&>(instruction);
+            if (!register_is_valid(typed_instruction.dst_register()) || !register_is_valid(typed_instruction.lhs_register()))
+                return ARC_INTERNAL_ERROR_WITH_MESSAGE("Invalid register operand"sv);
+            return fall_through(instruction_pointer, state.stack_depth);
+        }
+
+#define _ARC_CASE(x) case OpCode::x:
+        ARC_ENUMERATE_BYTECODE_UNARY_REGISTER_OPCODES(_ARC_CASE)
+#undef _ARC_CASE
+        {
+            // NOTE: All two-register instructions share the same layout.
+            const auto& typed_instruction = static_cast<const MoveInstruction&>(instruction);
+            if (!register_is_valid(typed_instruction.dst_register()) || !register_is_valid(typed_instruction.src_register()))
+                return ARC_INTERNAL_ERROR_WITH_MESSAGE("Invalid register operand"sv);
+            return fall_through(instruction_pointer, state.stack_depth);
+        }
+
+        case OpCode::Decrement:
+        case OpCode::Increment: {
+            const auto& typed_instruction = static_cast<const IncrementInstruction&>(instruction);
+            if (!register_is_valid(typed_instruction.dst_register()))
+                return ARC_INTERNAL_ERROR_WITH_MESSAGE("Invalid register operand"sv);
+            return fall_through(instruction_pointer, state.stack_depth);
+        }
+
+        case OpCode::FusedCompareGreaterJumpIf: {
+            const auto& typed_instruction = instruction.as<FusedCompareGreaterJumpIfInstruction>();
+            if (!register_is_valid(typed_instruction.dst_register()) || !register_is_valid(typed_instruction.lhs_register()) ||
+                !register_is_valid(typed_instruction.rhs_register())) {
+                return ARC_INTERNAL_ERROR_WITH_MESSAGE("Invalid register operand"sv);
+            }
+            TRY(jump(instruction_pointer, typed_instruction.jump_address()));
+            return fall_through(instruction_pointer, state.stack_depth);
+        }
+
+        case OpCode::FusedCompareGreaterImmediateJumpIf: {
+            const auto& typed_instruction = instruction.as<FusedCompareGreaterImmediateJumpIfInstruction>();
+            if (!register_is_valid(typed_instruction.dst_register()) || !register_is_valid(typed_instruction.lhs_register()))
+                return ARC_INTERNAL_ERROR_WITH_MESSAGE("Invalid register operand"sv);
+            TRY(jump(instruction_pointer, typed_instruction.jump_address()));
+            return fall_through(instruction_pointer, state.stack_depth);
+        }
+
+        case OpCode::FusedLoadAddStore: {
+            const auto& typed_instruction = instruction.as<FusedLoadAddStoreInstruction>();
+            if (!register_is_valid(typed_instruction.dst_register()) || !register_is_valid(typed_instruction.loaded_register()) ||
+                !register_is_valid(typed_instruction.other_register())) {
+                return ARC_INTERNAL_ERROR_WITH_MESSAGE("Invalid register operand"sv);
+            }
+            TRY(verify_stack_access(instruction_pointer, typed_instruction.src_stack_offset(), sizeof(u64)));
+            TRY(verify_stack_access(instruction_pointer, typed_instruction.dst_stack_offset(), sizeof(u64)));
+            return fall_through(instruction_pointer, state.stack_depth);
+        }
+
+        case OpCode::FusedLoadIncrementStore: {
+            const auto& typed_instruction = instruction.as<FusedLoadIncrementStoreInstruction>();
+            if (!register_is_valid(typed_instruction.dst_register()))
+                return ARC_INTERNAL_ERROR_WITH_MESSAGE("Invalid register operand"sv);
+            TRY(verify_stack_access(instruction_pointer, typed_instruction.stack_offset(), sizeof(u64)));
+            return fall_through(instruction_pointer, state.stack_depth);
+        }
+
+        case OpCode::FusedLoadPair: {
+            const auto& typed_instruction = instruction.as<FusedLoadPairInstruction>();
+            if (!register_is_valid(typed_instruction.first_dst_register()) || !register_is_valid(typed_instruction.second_dst_register()))
+                return ARC_INTERNAL_ERROR_WITH_MESSAGE("Invalid register operand"sv);
+            TRY(verify_stack_access(instruction_pointer, typed_instruction.first_src_stack_offset(), sizeof(u64)));
+            TRY(verify_stack_access(instruction_pointer, typed_instruction.second_src_stack_offset(), sizeof(u64)));
+            return fall_through(instruction_pointer, state.stack_depth);
+        }
+
+        case OpCode::FusedLoadStore: {
+            const auto& typed_instruction = instruction.as<FusedLoadStoreInstruction>();
+            if (!register_is_valid(typed_instruction.dst_register()))
+                return ARC_INTERNAL_ERROR_WITH_MESSAGE("Invalid register operand"sv);
+            TRY(verify_stack_access(instruction_pointer, typed_instruction.src_stack_offset(), sizeof(u64)));
+            TRY(verify_stack_access(instruction_pointer, typed_instruction.dst_stack_offset(), sizeof(u64)));
+            return fall_through(instruction_pointer, state.stack_depth);
+        }
+
+        case OpCode::LoadImmediate8:
+        case OpCode::LoadImmediate16:
+        case OpCode::LoadImmediate32:
+        case OpCode::LoadImmediate64: {
+            // NOTE: The destination register is always the first operand of the load immediate instructions.
+            const auto& typed_instruction = static_cast<const LoadImmediate8Instruction&>(instruction);
+            if (!register_is_valid(typed_instruction.dst_register()))
+                return ARC_INTERNAL_ERROR_WITH_MESSAGE("Invalid register operand"sv);
+            return fall_through(instruction_pointer, state.stack_depth);
+        }
+
+        case OpCode::Call: {
+            const auto& typed_instruction = instruction.as<CallInstruction>();
+            if (typed_instruction.callee_address().address() >= m_package.instruction_count())
+                return ARC_INTERNAL_ERROR_WITH_MESSAGE("A call target is outside the package"sv);
+            if (typed_instruction.parameters_byte_count() > state.stack_depth)
+                return ARC_INTERNAL_ERROR_WITH_MESSAGE("A call has more parameter bytes than the caller has pushed"sv);
+
+            const usize callee_function_index = function_index_for_entry(typed_instruction.callee_address().address());
+            m_call_sites.push_back({ callee_function_index, state.stack_depth });
+            TRY(schedule(typed_instruction.callee_address().address(), callee_function_index, 0));
+
+            // NOTE: The callee pops the parameters when it returns.
+            return fall_through(instruction_pointer, state.stack_depth - typed_instruction.parameters_byte_count());
+        }
+
+        case OpCode::CallWithArguments: {
+            const auto& typed_instruction = instruction.as<CallWithArgumentsInstruction>();
+            if (typed_instruction.callee_address().address() >= m_package.instruction_count())
+                return ARC_INTERNAL_ERROR_WITH_MESSAGE("A call target is outside the package"sv);
+            if (typed_instruction.parameters_byte_count() > state.stack_depth)
+                return ARC_INTERNAL_ERROR_WITH_MESSAGE("A call has more parameter bytes than the caller has pushed"sv);
+            if (static_cast<u8>(typed_instruction.first_argument_register()) + typed_instruction.argument_count() >
+                    static_cast<u8>(Register::Count) ||
+                !register_is_valid(typed_instruction.return_value_register())) {
+                return ARC_INTERNAL_ERROR_WITH_MESSAGE("Invalid register operand"sv);
+            }
+
+            const usize callee_function_index = function_index_for_entry(typed_instruction.callee_address().address());
+            m_call_sites.push_back({ callee_function_index, state.stack_depth });
+            TRY(schedule(typed_instruction.callee_address().address(), callee_function_index, 0));
+            return fall_through(instruction_pointer, state.stack_depth - typed_instruction.parameters_byte_count());
+        }
+
+        case OpCode::Jump: {
+            return jump(instruction_pointer, instruction.as<JumpInstruction>().jump_address());
+        }
+
+        case OpCode::JumpIf: {
+            const auto& typed_instruction = instruction.as<JumpIfInstruction>();
+            if (!register_is_valid(typed_instruction.condition_register()))
+                return ARC_INTERNAL_ERROR_WITH_MESSAGE("Invalid register operand"sv);
+            TRY(jump(instruction_pointer, typed_instruction.jump_address()));
+            return fall_through(instruction_pointer, state.stack_depth);
+        }
+
+        case OpCode::JumpTable: {
+            const auto& typed_instruction = instruction.as<JumpTableInstruction>();
+            if (!register_is_valid(typed_instruction.index_register()))
+                return ARC_INTERNAL_ERROR_WITH_MESSAGE("Invalid register operand"sv);
+            if (!m_package.jump_table_is_valid(typed_instruction.first_entry_index(), typed_instruction.entry_count()))
+                return ARC_INTERNAL_ERROR_WITH_MESSAGE("A jump table is outside the jump table entries of the package"sv);
+
+            for (u32 entry_offset = 0; entry_offset < typed_instruction.entry_count(); ++entry_offset) {
+                const JumpAddress target = m_package.fetch_jump_table_entry(typed_instruction.first_entry_index() + entry_offset);
+                TRY(jump(instruction_pointer, target));
+            }
+            return jump(instruction_pointer, typed_instruction.default_address());
+        }
+
+        case OpCode::LoadFromFrame: {
+            const auto& typed_instruction = instruction.as<LoadFromFrameInstruction>();
+            if (!register_is_valid(typed_instruction.dst_register()))
+                return ARC_INTERNAL_ERROR_WITH_MESSAGE("Invalid register operand"sv);
+            TRY(verify_frame_access(instruction_pointer, typed_instruction.src_frame_offset(), sizeof(u64)));
+            return fall_through(instruction_pointer, state.stack_depth);
+        }
+
+        case OpCode::StoreToFrame: {
+            const auto& typed_instruction = instruction.as<StoreToFrameInstruction>();
+            if (!register_is_valid(typed_instruction.src_register()))
+                return ARC_INTERNAL_ERROR_WITH_MESSAGE("Invalid register operand"sv);
+            TRY(verify_frame_access(instruction_pointer, typed_instruction.dst_frame_offset(), sizeof(u64)));
+            return fall_through(instruction_pointer, state.stack_depth);
+        }
+
+        case OpCode::LoadFromStack:
+        case OpCode::Load8FromStack:
+        case OpCode::Load16FromStack:
+        case OpCode::Load32FromStack: {
+            // NOTE: All load instructions share the same layout.
+            const auto& typed_instruction = static_cast<const LoadFromStackInstruction&>(instruction);
+            if (!register_is_valid(typed_instruction.dst_register()))
+                return ARC_INTERNAL_ERROR_WITH_MESSAGE("Invalid register operand"sv);
+
+            u64 byte_count = sizeof(u64);
+            if (instruction.opcode() == OpCode::Load8FromStack)
+                byte_count = sizeof(u8);
+            else if (instruction.opcode() == OpCode::Load16FromStack)
+                byte_count = sizeof(u16);
+            else if (instruction.opcode() == OpCode::Load32FromStack)
+                byte_count = sizeof(u32);
+
+            TRY(verify_stack_access(instruction_pointer, typed_instruction.src_stack_offset(), byte_count));
+            return fall_through(instruction_pointer, state.stack_depth);
+        }
+
+        case OpCode::StoreToStack:
+        case OpCode::Store8ToStack:
+        case OpCode::Store16ToStack:
+        case OpCode::Store32ToStack: {
+            // NOTE: All store instructions share the same layout.
+            const auto& typed_instruction = static_cast<const StoreToStackInstruction&>(instruction);
+            if (!register_is_valid(typed_instruction.src_register()))
+                return ARC_INTERNAL_ERROR_WITH_MESSAGE("Invalid register operand"sv);
+
+            u64 byte_count = sizeof(u64);
+            if (instruction.opcode() == OpCode::Store8ToStack)
+                byte_count = sizeof(u8);
+            else if (instruction.opcode() == OpCode::Store16ToStack)
+                byte_count = sizeof(u16);
+            else if (instruction.opcode() == OpCode::Store32ToStack)
+                byte_count = sizeof(u32);
+
+            TRY(verify_stack_access(instruction_pointer, typed_instruction.dst_stack_offset(), byte_count));
+            return fall_through(instruction_pointer, state.stack_depth);
+        }
+
+        case OpCode::Pop: {
+            return pop(instruction_pointer, instruction.as<PopInstruction>().pop_byte_count());
+        }
+
+        case OpCode::PureFunctionEntry:
+            return fall_through(instruction_pointer, state.stack_depth);
+
+        case OpCode::PopRegister: {
+            return pop(instruction_pointer, sizeof(u64));
+        }
+
+        case OpCode::Push: {
+            return push(instruction_pointer, instruction.as<PushInstruction>().push_byte_count());
+        }
+
+        case OpCode::PushImmediate8: {
+            return push(instruction_pointer, sizeof(u8));
+        }
+
+        case OpCode::PushImmediate16: {
+            return push(instruction_pointer, sizeof(u16));
+        }
+
+        case OpCode::PushImmediate32: {
+            return push(instruction_pointer, sizeof(u32));
+        }
+
+        case OpCode::PushImmediate64: {
+            return push(instruction_pointer, sizeof(u64));
+        }
+
+        case OpCode::PushRegister: {
+            if (!register_is_valid(instruction.as<PushRegisterInstruction>().src_register()))
+                return ARC_INTERNAL_ERROR_WITH_MESSAGE("Invalid register operand"sv);
+            return push(instruction_pointer, sizeof(u64));
+        }
+
+        case OpCode::TailCall:
+        case OpCode::TailCallWithArguments: {
+            // NOTE: Both tail call instructions have the same layout for the callee and the parameters byte count.
+            JumpAddress callee_address = JumpAddress(0);
+            u64 parameters_byte_count = 0;
+            if (instruction.opcode() == OpCode::TailCall) {
+                const auto& typed_instruction = instruction.as<TailCallInstruction>();
+                callee_address = typed_instruction.callee_address();
+                parameters_byte_count = typed_instruction.parameters_byte_count();
+            }
+            else {
+                const auto& typed_instruction = instruction.as<TailCallWithArgumentsInstruction>();
+                if (static_cast<u8>(typed_instruction.first_argument_register()) + typed_instruction.argument_count() >
+                    static_cast<u8>(Register::Count)) {
+                    return ARC_INTERNAL_ERROR_WITH_MESSAGE("Invalid register operand"sv);
+                }
+                callee_address = typed_instruction.callee_address();
+                parameters_byte_count = typed_instruction.parameters_byte_count();
+            }
+
+            if (callee_address.address() >= m_package.instruction_count())
+                return ARC_INTERNAL_ERROR_WITH_MESSAGE("A call target is outside the package"sv);
+            // NOTE: A tail call returns from the current function, so it's subject to the same rules as a return.
+            if (m_functions[state.function_index].is_entry_point)
+                return ARC_INTERNAL_ERROR_WITH_MESSAGE("An entry point function can't return"sv);
+            if (parameters_byte_count != state.stack_depth)
+                return ARC_INTERNAL_ERROR_WITH_MESSAGE("A tail call doesn't pass everything the function has pushed as parameters"sv);
+
+            const usize callee_function_index = function_index_for_entry(callee_address.address());
+            m_call_sites.push_back({ callee_function_index, state.stack_depth });
+            return schedule(callee_address.address(), callee_function_index, 0);
+        }
+
+        case OpCode::Return:
+        case OpCode::ReturnValue: {
+            if (instruction.opcode() == OpCode::ReturnValue && !register_is_valid(instruction.as<ReturnValueInstruction>().src_register()))
+                return ARC_INTERNAL_ERROR_WITH_MESSAGE("Invalid register operand"sv);
+            if (m_functions[state.function_index].is_entry_point)
+                return ARC_INTERNAL_ERROR_WITH_MESSAGE("An entry point function can't return"sv);
+            if (state.stack_depth != 0)
+                return ARC_INTERNAL_ERROR_WITH_MESSAGE("A function returns without popping everything it has pushed"sv);
+            return {};
+        }
+
+        default:
+            break;
+    }
+
+    return ARC_INTERNAL_ERROR_WITH_MESSAGE("Unknown opcode"sv);
+}
+
+ErrorOr<void> VerificationContext::verify()
+{
+    if (m_package.entry_points().is_empty())
+        return ARC_INTERNAL_ERROR_WITH_MESSAGE("The package has no entry points"sv);
+
+    for (const Package::EntryPoint& entry_point : m_package.entry_points()) {
+        const usize function_index = function_index_for_entry(entry_point.address.address());
+        m_functions[function_index].is_entry_point = true;
+        m_functions[function_index].accessible_byte_count = 0;
+        TRY(schedule(entry_point.address.address(), function_index, 0));
+    }
+
+    // Walk all the instructions that are reachable from the entry points.
+    while (m_worklist.has_elements()) {
+        const usize instruction_pointer = m_worklist.last();
+        m_worklist.pop_back();
+        TRY(verify_instruction(instruction_pointer));
+    }
+
+    // NOTE: The bytes pushed by the caller are followed by the call frame header of the caller itself, so a function
+    //       can only ever access the bytes that were pushed by its direct callers.
+    for (const CallSite& call_site : m_call_sites) {
+        FunctionState& callee = m_functions[call_site.callee_function_index];
+        if (call_site.stack_depth < callee.accessible_byte_count)
+            callee.accessible_byte_count = call_site.stack_depth;
+    }
+
+    for (const FunctionState& function : m_functions) {
+        if (function.required_byte_count > function.accessible_byte_count)
+            return ARC_INTERNAL_ERROR_WITH_MESSAGE("A function accesses stack memory that isn't guaranteed to be live"sv);
+    }
+
+    return {};
+}
+
+ErrorOr<void> Verifier::verify(Package& package)
+{
+    VerificationContext context(package);
+    TRY(context.verify());
+    package.mark_as_verified({});
+    return {};
+}
+
+}
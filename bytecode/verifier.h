@@ -0,0 +1,35 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause.
+ */
+
+#pragma once
+
+#include <bytecode/forward.h>
+#include <core/error.h>
+
+namespace Arc::Bytecode {
+
+//
+// The verifier walks every function of a package, starting from its entry points and following all call targets,
+// and proves the following properties:
+//   - All register operands are valid registers.
+//   - All jump and call targets are inside the package.
+//   - Every instruction belongs to exactly one function and is always reached with the same stack depth, which
+//     means that the stack depth is consistent at every merge point.
+//   - Pops never release more than the current function has pushed, and returns only happen with an empty frame.
+//   - Loads and stores only access bytes that are live: either pushed by the current function or guaranteed to be
+//     pushed by every caller of the function.
+//   - Entry point functions never return, as there would be no call frame to return to.
+//
+// When a package is successfully verified it is marked as such, and the interpreter is then allowed to execute it
+// without performing the per-instruction register, stack and call stack checks.
+//
+class Verifier {
+    ARC_MAKE_NAMESPACE_CLASS(Verifier)
+
+public:
+    NODISCARD static ErrorOr<void> verify(Package&);
+};
+
+}
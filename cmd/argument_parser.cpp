@@ -5,4 +5,48 @@
 
 #include <cmd/argument_parser.h>
 
-namespace Arc::Cmd {}
+namespace Arc::Cmd {
+
+// Strips the `--` prefix of an argument. Arguments that don't start with the prefix yield an empty view.
+static StringView strip_argument_prefix(StringView argument)
+{
+    if (argument.byte_count() < 2 || argument.characters()[0] != '-' || argument.characters()[1] != '-')
+        return {};
+    return StringView::from_utf8(argument.characters() + 2, argument.byte_count() - 2);
+}
+
+ArgumentParser::ArgumentParser(const CommandLineArguments& arguments)
+    : m_arguments(arguments)
+{}
+
+bool ArgumentParser::has_flag(StringView flag_name) const
+{
+    // NOTE: The first argument is always the path of the executable, so it is skipped.
+    for (u32 argument_index = 1; argument_index < m_arguments.argument_count; ++argument_index) {
+        const StringView argument = strip_argument_prefix(StringView::from_utf8(m_arguments.arguments[argument_index]));
+        if (argument.has_characters() && argument == flag_name)
+            return true;
+    }
+
+    return false;
+}
+
+Optional<StringView> ArgumentParser::option_value(StringView option_name) const
+{
+    for (u32 argument_index = 1; argument_index < m_arguments.argument_count; ++argument_index) {
+        const StringView argument = strip_argument_prefix(StringView::from_utf8(m_arguments.arguments[argument_index]));
+        if (argument.byte_count() <= option_name.byte_count() || argument.characters()[option_name.byte_count()] != '=')
+            continue;
+
+        const StringView argument_name = StringView::from_utf8(argument.characters(), option_name.byte_count());
+        if (argument_name != option_name)
+            continue;
+
+        const usize value_offset = option_name.byte_count() + 1;
+        return StringView::from_utf8(argument.characters() + value_offset, argument.byte_count() - value_offset);
+    }
+
+    return {};
+}
+
+}
@@ -5,6 +5,8 @@
 
 #pragma once
 
+#include <core/containers/optional.h>
+#include <core/containers/string_view.h>
 #include <core/types.h>
 
 namespace Arc::Cmd {
@@ -14,4 +16,21 @@ struct CommandLineArguments {
     u32 argument_count;
 };
 
+class ArgumentParser {
+    ARC_MAKE_NONCOPYABLE(ArgumentParser);
+    ARC_MAKE_NONMOVABLE(ArgumentParser);
+
+public:
+    explicit ArgumentParser(const CommandLineArguments&);
+
+    // Returns true if the exact argument `--<flag_name>` was provided.
+    NODISCARD bool has_flag(StringView flag_name) const;
+
+    // Returns the value of an argument provided as `--<option_name>=<value>`.
+    NODISCARD Optional<StringView> option_value(StringView option_name) const;
+
+private:
+    const CommandLineArguments& m_arguments;
+};
+
 }
@@ -5,12 +5,26 @@
 
 #include <bytecode/disassembler.h>
 #include <bytecode/instruction.h>
+#include <bytecode/opcode_profile.h>
+#include <bytecode/optimizer.h>
 #include <bytecode/package.h>
+#include <bytecode/package_file.h>
+#include <bytecode/superinstructions.h>
+#include <bytecode/verifier.h>
 #include <cmd/argument_parser.h>
 #include <frontend/ast.h>
+#include <runtime/aot/cpp_translator.h>
 #include <runtime/interpreter.h>
+#include <runtime/interpreter_policy.h>
+#include <runtime/jit/differential_tester.h>
+#include <runtime/jit/jit_compiler.h>
+#include <runtime/jit/stencil_compiler.h>
+#include <runtime/jit/tracing_jit.h>
+#include <runtime/virtual_machine_pool.h>
 
 #include <core/containers/string_builder.h>
+#include <core/thread.h>
+#include <cstddef>
 #include <cstdio>
 
 namespace Arc::Cmd {
@@ -19,59 +33,52 @@ using namespace Bytecode;
 using namespace Frontend;
 using namespace Runtime;
 
-MAYBE_UNUSED static Register compile_fibonacci_linear(Package& package, u64& out_entry_point)
+MAYBE_UNUSED static Register compile_fibonacci_linear(Package& package)
 {
+    // NOTE: All variables are addressed relative to the frame pointer, so their offsets never change.
     // int n = 10, a = 0, b = 1;
     // int i = 1;
-    /* [ 0] */ package.emit_instruction<PushImmediate64Instruction>(15); // offset 24 (n)
-    /* [ 1] */ package.emit_instruction<PushImmediate64Instruction>(0); // offset 16 (a)
-    /* [ 2] */ package.emit_instruction<PushImmediate64Instruction>(1); // offset 8 (b)
-    /* [ 3] */ package.emit_instruction<PushImmediate64Instruction>(1); // offset 0 (i)
+    /* [ 0] */ package.emit_instruction<PushImmediate64Instruction>(15); // frame offset -8 (n)
+    /* [ 1] */ package.emit_instruction<PushImmediate64Instruction>(0); // frame offset -16 (a)
+    /* [ 2] */ package.emit_instruction<PushImmediate64Instruction>(1); // frame offset -24 (b)
+    /* [ 3] */ package.emit_instruction<PushImmediate64Instruction>(1); // frame offset -32 (i)
 
     // while (i <= n) {
-    /* [ 4] */ package.emit_instruction<LoadFromStackInstruction>(Register::GPR0, 24); // load n
-    /* [ 5] */ package.emit_instruction<LoadFromStackInstruction>(Register::GPR1, 0); // load i
+    /* [ 4] */ package.emit_instruction<LoadFromFrameInstruction>(Register::GPR0, -8); // load n
+    /* [ 5] */ package.emit_instruction<LoadFromFrameInstruction>(Register::GPR1, -32); // load i
     /* [ 6] */ package.emit_instruction<CompareGreaterInstruction>(Register::GPR0, Register::GPR1, Register::GPR0);
-    /* [ 7] */ package.emit_instruction<JumpIfInstruction>(Register::GPR0, JumpAddress(20));
+    /* [ 7] */ package.emit_instruction<JumpIfInstruction>(Register::GPR0, JumpAddress(17));
 
     // int temp = a;
-    /* [ 8] */ package.emit_instruction<LoadFromStackInstruction>(Register::GPR0, 16); // load a
-    /* [ 9] */ package.emit_instruction<PushRegisterInstruction>(Register::GPR0); // offset 0 (temp)
-
-    // n = offset 32
-    // a = offset 24
-    // b = offset 16
-    // i = offset 8
+    /* [ 8] */ package.emit_instruction<LoadFromFrameInstruction>(Register::GPR2, -16); // load a (temp)
 
     // a = b;
-    /* [10] */ package.emit_instruction<LoadFromStackInstruction>(Register::GPR0, 16); // load b
-    /* [11] */ package.emit_instruction<StoreToStackInstruction>(24, Register::GPR0); // store in a
+    /* [ 9] */ package.emit_instruction<LoadFromFrameInstruction>(Register::GPR0, -24); // load b
+    /* [10] */ package.emit_instruction<StoreToFrameInstruction>(-16, Register::GPR0); // store in a
 
     // b = temp + b;
-    /* [12] */ package.emit_instruction<LoadFromStackInstruction>(Register::GPR1, 0); // load temp
-    /* [13] */ package.emit_instruction<AddInstruction>(Register::GPR0, Register::GPR1, Register::GPR0);
-    /* [14] */ package.emit_instruction<StoreToStackInstruction>(16, Register::GPR0); // store in b
+    /* [11] */ package.emit_instruction<AddInstruction>(Register::GPR0, Register::GPR2, Register::GPR0);
+    /* [12] */ package.emit_instruction<StoreToFrameInstruction>(-24, Register::GPR0); // store in b
 
     // ++i; }
-    /* [15] */ package.emit_instruction<PopRegisterInstruction>(); // pop (temp)
-    /* [16] */ package.emit_instruction<LoadFromStackInstruction>(Register::GPR0, 0); // load i
-    /* [17] */ package.emit_instruction<IncrementInstruction>(Register::GPR0);
-    /* [18] */ package.emit_instruction<StoreToStackInstruction>(0, Register::GPR0); // store in i
-    /* [19] */ package.emit_instruction<JumpInstruction>(JumpAddress(4));
+    /* [13] */ package.emit_instruction<LoadFromFrameInstruction>(Register::GPR0, -32); // load i
+    /* [14] */ package.emit_instruction<IncrementInstruction>(Register::GPR0);
+    /* [15] */ package.emit_instruction<StoreToFrameInstruction>(-32, Register::GPR0); // store in i
+    /* [16] */ package.emit_instruction<JumpInstruction>(JumpAddress(4));
 
     // Load the value of b in GPR0 in order to print it to the console.
-    package.emit_instruction<LoadFromStackInstruction>(Register::GPR0, 8); // load b
+    package.emit_instruction<LoadFromFrameInstruction>(Register::GPR0, -24); // load b
     // Pop the stack.
     package.emit_instruction<PopRegisterInstruction>();
     package.emit_instruction<PopRegisterInstruction>();
     package.emit_instruction<PopRegisterInstruction>();
     package.emit_instruction<PopRegisterInstruction>();
 
-    out_entry_point = 0;
+    package.add_entry_point("main"sv, JumpAddress(0));
     return Register::GPR0;
 }
 
-MAYBE_UNUSED static Register compile_fibonacci_recursive(Package& package, u64& out_entry_point)
+MAYBE_UNUSED static Register compile_fibonacci_recursive(Package& package)
 {
     // u64 fib(u64 k) {
     // if (k == 0 || k == 1)
@@ -80,68 +87,141 @@ MAYBE_UNUSED static Register compile_fibonacci_recursive(Package& package, u64&
     // }
     // u64 result = fib(n);
 
-    // result (offset 8)
-    // k (offset 0)
-
-    // u64 k;
-    package.emit_instruction<LoadFromStackInstruction>(Register::GPR0, 0); // load k
+    // NOTE: The function uses the register calling convention, so `k` is received in GPR0 and the result
+    //       is returned in the register chosen by the caller. The function is pure, so its calls can be memoized.
+    package.emit_instruction<PureFunctionEntryInstruction>();
 
     // if (k > 1) {
-    package.emit_instruction<LoadImmediate8Instruction>(Register::GPR1, 1);
-    package.emit_instruction<CompareGreaterInstruction>(Register::GPR1, Register::GPR0, Register::GPR1);
-    package.emit_instruction<JumpIfInstruction>(Register::GPR1, JumpAddress(6));
+    package.emit_instruction<CompareGreaterImmediateInstruction>(Register::GPR1, Register::GPR0, 1);
+    package.emit_instruction<JumpIfInstruction>(Register::GPR1, JumpAddress(4));
     // return k; }
-    package.emit_instruction<StoreToStackInstruction>(8, Register::GPR0); // store into result
-    package.emit_instruction<ReturnInstruction>();
+    package.emit_instruction<ReturnValueInstruction>(Register::GPR0);
 
     // u64 t1 = fib(--k);
     package.emit_instruction<DecrementInstruction>(Register::GPR0);
+    package.emit_instruction<CallWithArgumentsInstruction>(JumpAddress(0), Register::GPR0, 1, Register::GPR2, 0);
 
-    // Save the GPR0 register as it will be modified during the recursive call.
-    package.emit_instruction<PushRegisterInstruction>(Register::GPR0);
+    // u64 t2 = fib(--k);
+    package.emit_instruction<DecrementInstruction>(Register::GPR0);
+    package.emit_instruction<CallWithArgumentsInstruction>(JumpAddress(0), Register::GPR0, 1, Register::GPR3, 0);
 
-    package.emit_instruction<PushInstruction>(8);
-    package.emit_instruction<PushRegisterInstruction>(Register::GPR0);
-    package.emit_instruction<CallInstruction>(JumpAddress(0), 8);
-    package.emit_instruction<LoadFromStackInstruction>(Register::GPR2, 0);
-    package.emit_instruction<PopInstruction>(8);
+    // return t1 + t2;
+    package.emit_instruction<AddInstruction>(Register::GPR0, Register::GPR2, Register::GPR3);
+    package.emit_instruction<ReturnValueInstruction>(Register::GPR0);
 
-    // Restore the GPR0 register after the recursive call.
-    package.emit_instruction<LoadFromStackInstruction>(Register::GPR0, 0);
-    package.emit_instruction<PopRegisterInstruction>();
+    // u64 result = fib(n)
+    package.emit_instruction<LoadImmediate8Instruction>(Register::GPR0, 11);
+    package.emit_instruction<CallWithArgumentsInstruction>(JumpAddress(0), Register::GPR0, 1, Register::GPR0, 0);
 
-    // u64 t2 = fib(--k);
-    package.emit_instruction<DecrementInstruction>(Register::GPR0);
+    package.add_entry_point("main"sv, JumpAddress(10));
+    return Register::GPR0;
+}
 
-    // Save the GPR0 and GPR2 registers as they will be modified during the recursive call.
-    package.emit_instruction<PushRegisterInstruction>(Register::GPR0);
-    package.emit_instruction<PushRegisterInstruction>(Register::GPR2);
+MAYBE_UNUSED static Register compile_state_machine(Package& package)
+{
+    // u64 sum = 0, state = 0;
+    // for (u64 steps = 20; steps > 0; --steps) {
+    //   switch (state) {
+    //     case 0: sum += 1; state = 1; break;
+    //     case 1: sum += 2; state = 2; break;
+    //     case 2: sum += 3; state = 0; break;
+    //     default: state = 0; break;
+    //   }
+    // }
+    /* [ 0] */ package.emit_instruction<LoadImmediate8Instruction>(Register::GPR0, 0); // sum
+    /* [ 1] */ package.emit_instruction<LoadImmediate8Instruction>(Register::GPR1, 0); // state
+    /* [ 2] */ package.emit_instruction<LoadImmediate8Instruction>(Register::GPR2, 20); // steps
+    /* [ 3] */ package.emit_instruction<JumpInstruction>(JumpAddress(17));
+
+    // switch (state) {
+    Vector<JumpAddress> state_targets;
+    state_targets.push_back(JumpAddress(6));
+    state_targets.push_back(JumpAddress(9));
+    state_targets.push_back(JumpAddress(12));
+    const u32 state_table = package.add_jump_table(state_targets);
+    /* [ 4] */ package.emit_instruction<DecrementInstruction>(Register::GPR2);
+    /* [ 5] */ package.emit_instruction<JumpTableInstruction>(Register::GPR1, state_table, 3, JumpAddress(15));
+
+    // case 0: sum += 1; state = 1; break;
+    /* [ 6] */ package.emit_instruction<AddImmediateInstruction>(Register::GPR0, Register::GPR0, 1);
+    /* [ 7] */ package.emit_instruction<LoadImmediate8Instruction>(Register::GPR1, 1);
+    /* [ 8] */ package.emit_instruction<JumpInstruction>(JumpAddress(17));
+
+    // case 1: sum += 2; state = 2; break;
+    /* [ 9] */ package.emit_instruction<AddImmediateInstruction>(Register::GPR0, Register::GPR0, 2);
+    /* [10] */ package.emit_instruction<LoadImmediate8Instruction>(Register::GPR1, 2);
+    /* [11] */ package.emit_instruction<JumpInstruction>(JumpAddress(17));
+
+    // case 2: sum += 3; state = 0; break;
+    /* [12] */ package.emit_instruction<AddImmediateInstruction>(Register::GPR0, Register::GPR0, 3);
+    /* [13] */ package.emit_instruction<LoadImmediate8Instruction>(Register::GPR1, 0);
+    /* [14] */ package.emit_instruction<JumpInstruction>(JumpAddress(17));
+
+    // default: state = 0; break; }
+    /* [15] */ package.emit_instruction<LoadImmediate8Instruction>(Register::GPR1, 0);
+    /* [16] */ package.emit_instruction<JumpInstruction>(JumpAddress(17));
+
+    // steps > 0
+    /* [17] */ package.emit_instruction<CompareGreaterImmediateInstruction>(Register::GPR3, Register::GPR2, 0);
+    /* [18] */ package.emit_instruction<JumpIfInstruction>(Register::GPR3, JumpAddress(4));
+
+    package.add_entry_point("main"sv, JumpAddress(0));
+    return Register::GPR0;
+}
 
-    package.emit_instruction<PushInstruction>(8);
-    package.emit_instruction<PushRegisterInstruction>(Register::GPR0);
-    package.emit_instruction<CallInstruction>(JumpAddress(0), 8);
-    package.emit_instruction<LoadFromStackInstruction>(Register::GPR3, 0);
-    package.emit_instruction<PopInstruction>(8);
+MAYBE_UNUSED static Register compile_call_frame_header_clobber(Package& package, bool clobbers_caller_header)
+{
+    // NOTE: The package is rejected by the verifier. When it's executed without being verified, the checked accessors
+    //       must abort it with a trap instead of letting it corrupt the call frame headers.
+    // void outer() { inner(); }
+    /* [0] */ package.emit_instruction<CallInstruction>(JumpAddress(2), 0);
+    /* [1] */ package.emit_instruction<ReturnInstruction>();
+
+    // void inner() { overwrite the saved frame pointer with zero; }
+    /* [2] */ package.emit_instruction<LoadImmediate8Instruction>(Register::GPR1, 0);
+    if (clobbers_caller_header) {
+        // The header of `outer` lies right above the header of `inner`, as `outer` pushes nothing.
+        /* [3] */ package.emit_instruction<StoreToStackInstruction>(sizeof(CallFrameHeader) + offsetof(CallFrameHeader, frame_pointer),
+                                                                   Register::GPR1);
+    }
+    else {
+        const s64 frame_pointer_frame_offset = static_cast<s64>(offsetof(CallFrameHeader, frame_pointer));
+        /* [3] */ package.emit_instruction<StoreToFrameInstruction>(frame_pointer_frame_offset, Register::GPR1);
+    }
+    /* [4] */ package.emit_instruction<ReturnInstruction>();
 
-    // Restore the GPR0 and GPR2 registers after the recursive call.
-    package.emit_instruction<LoadFromStackInstruction>(Register::GPR2, 0);
-    package.emit_instruction<LoadFromStackInstruction>(Register::GPR0, 8);
-    package.emit_instruction<PopRegisterInstruction>();
-    package.emit_instruction<PopRegisterInstruction>();
+    // outer(); u64 result = 1;
+    /* [5] */ package.emit_instruction<CallInstruction>(JumpAddress(0), 0);
+    /* [6] */ package.emit_instruction<LoadImmediate8Instruction>(Register::GPR0, 1);
 
-    // return t1 + t2;
-    package.emit_instruction<AddInstruction>(Register::GPR0, Register::GPR2, Register::GPR3);
-    package.emit_instruction<StoreToStackInstruction>(8, Register::GPR0); // store into result
-    package.emit_instruction<ReturnInstruction>();
+    package.add_entry_point("main"sv, JumpAddress(5));
+    return Register::GPR0;
+}
 
-    // u64 result = fib(n)
-    package.emit_instruction<PushInstruction>(8); // push return value space
-    package.emit_instruction<PushImmediate64Instruction>(11); // push n
-    package.emit_instruction<CallInstruction>(JumpAddress(0), 8);
-    package.emit_instruction<LoadFromStackInstruction>(Register::GPR0, 0); // load return value
-    package.emit_instruction<PopInstruction>(8);
+MAYBE_UNUSED static Register compile_division_by_zero(Package& package)
+{
+    // NOTE: The divisor is only known at run time, so the verifier accepts the package and the division must trap.
+    // u64 result = 42 / 0;
+    package.emit_instruction<LoadImmediate8Instruction>(Register::GPR0, 42);
+    package.emit_instruction<LoadImmediate8Instruction>(Register::GPR1, 0);
+    package.emit_instruction<DivideInstruction>(Register::GPR0, Register::GPR0, Register::GPR1);
 
-    out_entry_point = 30;
+    package.add_entry_point("main"sv, JumpAddress(0));
+    return Register::GPR0;
+}
+
+MAYBE_UNUSED static Register compile_unbounded_recursion(Package& package)
+{
+    // NOTE: The recursion never ends, so the call depth must be exceeded before the stack overflows.
+    // u64 recurse(u64 k) { return recurse(k); }
+    // u64 result = recurse(0);
+    package.emit_instruction<CallWithArgumentsInstruction>(JumpAddress(0), Register::GPR0, 1, Register::GPR0, 0);
+    package.emit_instruction<ReturnValueInstruction>(Register::GPR0);
+
+    package.emit_instruction<LoadImmediate8Instruction>(Register::GPR0, 0);
+    package.emit_instruction<CallWithArgumentsInstruction>(JumpAddress(0), Register::GPR0, 1, Register::GPR0, 0);
+
+    package.add_entry_point("main"sv, JumpAddress(2));
     return Register::GPR0;
 }
 
@@ -255,27 +335,311 @@ MAYBE_UNUSED static void generate_fibonacci_ast()
     printf("\n%s\n", builder.release_string().characters());
 }
 
-void entry_point(const CommandLineArguments&)
+// Executes the 'main' entry point of the package on a separate virtual machine, recording all executed opcodes.
+static ErrorOr<void> collect_opcode_profile(const Package& package, OpcodeProfile& opcode_profile)
+{
+    const Optional<JumpAddress> entry_point = package.find_entry_point("main"sv);
+    if (!entry_point.has_value())
+        return ARC_INTERNAL_ERROR_WITH_MESSAGE("The package doesn't contain a 'main' entry point"sv);
+
+    TRY_ASSIGN(OwnPtr<VirtualMachine> virtual_machine, VirtualMachine::create());
+    Interpreter interpreter(*virtual_machine, package);
+    interpreter.set_entry_point(entry_point.value().address());
+    interpreter.set_opcode_profile(&opcode_profile);
+    // NOTE: A trapped profiling run still records the opcodes executed before the trap, which are used as they are.
+    MAYBE_UNUSED ErrorOr<void> execute_result = interpreter.execute();
+    return {};
+}
+
+// Parses a non-empty string of decimal digits. Overflow isn't detected.
+static Optional<u64> parse_decimal_integer(StringView string)
 {
+    if (string.is_empty())
+        return {};
+
+    u64 value = 0;
+    for (usize index = 0; index < string.byte_count(); ++index) {
+        const char character = string.characters()[index];
+        if (character < '0' || character > '9')
+            return {};
+        value = value * 10 + static_cast<u64>(character - '0');
+    }
+    return value;
+}
+
+// Executes the package in slices that consume the given amount of fuel each, resuming it until it finishes.
+static ErrorOr<void> execute_in_slices(Interpreter& interpreter, u64 fuel)
+{
+    u64 slice_count = 0;
+    ExecutionStatus execution_status;
+    do {
+        execution_status = interpreter.execute_for(fuel);
+        ++slice_count;
+    } while (execution_status == ExecutionStatus::BudgetExhausted);
+
+    if (execution_status == ExecutionStatus::Trapped)
+        return ARC_INTERNAL_ERROR_WITH_MESSAGE(trap_to_string_view(interpreter.last_trap().value()));
+    printf("Executed the package in %llu slices.\n", static_cast<unsigned long long>(slice_count));
+    return {};
+}
+
+// Executes the entry point the given number of times, in parallel on one virtual machine per hardware thread. Each
+// execution receives its index in GPR0.
+static ErrorOr<void> execute_in_batch(const Package& package, JumpAddress entry_point, usize execution_count,
+                                      const VirtualMachineConfiguration& virtual_machine_configuration)
+{
+    Vector<u64> argument_sets;
+    argument_sets.set_count_defaulted(execution_count);
+    for (usize execution_index = 0; execution_index < execution_count; ++execution_index)
+        argument_sets[execution_index] = execution_index;
+
+    TRY_ASSIGN(OwnPtr<VirtualMachinePool> virtual_machine_pool,
+               VirtualMachinePool::create(Thread::hardware_thread_count(), virtual_machine_configuration));
+    const Span<const u64> argument_sets_span = Span<const u64>(argument_sets.elements(), argument_sets.count());
+    TRY_ASSIGN(const Vector<BatchExecutionResult> results,
+               virtual_machine_pool->execute_batch(package, entry_point, 1, argument_sets_span));
+
+    usize trapped_execution_count = 0;
+    for (const BatchExecutionResult& result : results) {
+        if (result.trap.has_value())
+            ++trapped_execution_count;
+    }
+
+    printf("Executed the package %zu times on %zu threads, %zu executions trapped.\n", static_cast<size_t>(execution_count),
+           static_cast<size_t>(virtual_machine_pool->virtual_machine_count()), static_cast<size_t>(trapped_execution_count));
+    return {};
+}
+
+void entry_point(const CommandLineArguments& arguments)
+{
+    const ArgumentParser argument_parser(arguments);
+
     Package package;
-    u64 entry_point = 0;
-    // const Register result_register = compile_fibonacci_linear(package, entry_point);
-    const Register result_register = compile_fibonacci_recursive(package, entry_point);
+    // NOTE: All the demo programs leave their result in GPR0, which is also the convention for loaded packages.
+    Register result_register = Register::GPR0;
+    if (const Optional<StringView> package_filepath = argument_parser.option_value("load-package"sv); package_filepath.has_value()) {
+        ErrorOr<void> load_result = PackageLoader::load_from_file(package, package_filepath.value());
+        if (load_result.is_error()) {
+            const InternalError error = load_result.release_error();
+            printf("Failed to load the package: %s\n", error.error_message().value_or(String()).characters());
+            return;
+        }
+    }
+    else if (argument_parser.option_value("program"sv).value_or("recursive"sv) == "linear"sv) {
+        result_register = compile_fibonacci_linear(package);
+    }
+    else if (argument_parser.option_value("program"sv).value_or("recursive"sv) == "state-machine"sv) {
+        result_register = compile_state_machine(package);
+    }
+    else if (argument_parser.option_value("program"sv).value_or("recursive"sv) == "division-by-zero"sv) {
+        result_register = compile_division_by_zero(package);
+    }
+    else if (argument_parser.option_value("program"sv).value_or("recursive"sv) == "unbounded-recursion"sv) {
+        result_register = compile_unbounded_recursion(package);
+    }
+    else if (argument_parser.option_value("program"sv).value_or("recursive"sv) == "clobber-frame-header"sv) {
+        result_register = compile_call_frame_header_clobber(package, false);
+    }
+    else if (argument_parser.option_value("program"sv).value_or("recursive"sv) == "clobber-caller-header"sv) {
+        result_register = compile_call_frame_header_clobber(package, true);
+    }
+    else {
+        result_register = compile_fibonacci_recursive(package);
+    }
+
+    if (argument_parser.has_flag("optimize"sv)) {
+        const usize removed_instruction_count = Optimizer::optimize(package);
+        printf("The optimizer removed %zu instructions.\n", static_cast<size_t>(removed_instruction_count));
+    }
+
+    // NOTE: The superinstructions are selected based on the opcode sequences executed during a profiling run.
+    const bool should_fuse_superinstructions = argument_parser.has_flag("superinstructions"sv);
+    if (argument_parser.has_flag("profile"sv) || should_fuse_superinstructions) {
+        OpcodeProfile opcode_profile;
+        ErrorOr<void> profile_result = collect_opcode_profile(package, opcode_profile);
+        if (profile_result.is_error()) {
+            const InternalError error = profile_result.release_error();
+            printf("Failed to profile the package: %s\n", error.error_message().value_or(String()).characters());
+            return;
+        }
+
+        if (argument_parser.has_flag("profile"sv))
+            printf("%s", opcode_profile.to_string(8).characters());
+
+        if (should_fuse_superinstructions) {
+            const Vector<OpCode> superinstruction_opcodes = Superinstructions::select_from_profile(opcode_profile, 8, 1);
+            const usize removed_instruction_count = Optimizer::fuse_superinstructions(package, superinstruction_opcodes);
+            printf("Fused %zu superinstructions, removing %zu instructions.\n", static_cast<size_t>(superinstruction_opcodes.count()),
+                   static_cast<size_t>(removed_instruction_count));
+        }
+    }
+
+    if (const Optional<StringView> package_filepath = argument_parser.option_value("write-package"sv); package_filepath.has_value()) {
+        ErrorOr<void> write_result = PackageWriter::write_to_file(package, package_filepath.value());
+        if (write_result.is_error()) {
+            const InternalError error = write_result.release_error();
+            printf("Failed to write the package: %s\n", error.error_message().value_or(String()).characters());
+            return;
+        }
+    }
 
     const Disassembler disassembler(package);
     printf("%s", disassembler.instructions_as_string().characters());
 
-    VirtualMachine virtual_machine;
-    Interpreter interpreter(virtual_machine, package);
-    interpreter.set_entry_point(entry_point);
-    interpreter.execute();
+    // NOTE: Verified packages are executed without the per-instruction safety checks.
+    if (!argument_parser.has_flag("no-verify"sv)) {
+        ErrorOr<void> verify_result = Verifier::verify(package);
+        if (verify_result.is_error()) {
+            const InternalError error = verify_result.release_error();
+            printf("Failed to verify the package: %s\n", error.error_message().value_or(String()).characters());
+            return;
+        }
+    }
+
+    const Optional<JumpAddress> entry_point = package.find_entry_point("main"sv);
+    if (!entry_point.has_value()) {
+        printf("The package doesn't contain a 'main' entry point.\n");
+        return;
+    }
+
+    // NOTE: The translated package is compiled by the system compiler, so it isn't executed here.
+    if (const Optional<StringView> source_filepath = argument_parser.option_value("aot"sv); source_filepath.has_value()) {
+        ErrorOr<void> translate_result = CppTranslator::translate_to_file(package, source_filepath.value());
+        if (translate_result.is_error()) {
+            const InternalError error = translate_result.release_error();
+            printf("Failed to translate the package to C++: %s\n", error.error_message().value_or(String()).characters());
+            return;
+        }
+        printf("Translated the package to C++.\n");
+        return;
+    }
+
+    VirtualMachineConfiguration virtual_machine_configuration = {};
+    virtual_machine_configuration.stack.use_huge_pages = argument_parser.has_flag("huge-pages"sv);
+    if (argument_parser.has_flag("memoize"sv))
+        virtual_machine_configuration.memoization_cache.entry_count = 4096;
+
+    // NOTE: The native code is only compiled for verified packages, and must outlive the execution of the interpreter.
+    Optional<NativeCode> native_code;
+    if (argument_parser.has_flag("jit"sv) || argument_parser.has_flag("jit-differential"sv)) {
+        // NOTE: The stencil compiler generates slower code than the baseline JIT compiler, but compiles much faster.
+        ErrorOr<NativeCode> compile_result = argument_parser.option_value("jit-compiler"sv).value_or("baseline"sv) == "stencil"sv
+                                                 ? StencilCompiler::compile(package)
+                                                 : JitCompiler::compile(package);
+        if (compile_result.is_error()) {
+            const InternalError error = compile_result.release_error();
+            printf("Failed to compile the package to native code: %s\n", error.error_message().value_or(String()).characters());
+            return;
+        }
+
+        native_code = compile_result.release_value();
+        printf("Compiled the package to %zu bytes of native code.\n", static_cast<size_t>(native_code.value().code_byte_count()));
+
+        if (argument_parser.has_flag("jit-differential"sv)) {
+            ErrorOr<void> differential_result =
+                DifferentialTester::run(package, native_code.value(), entry_point.value(), virtual_machine_configuration);
+            if (differential_result.is_error()) {
+                const InternalError error = differential_result.release_error();
+                printf("The native code doesn't match the interpreter: %s\n", error.error_message().value_or(String()).characters());
+                return;
+            }
+            printf("The native code matches the interpreter.\n");
+        }
+    }
+
+    const TracingJitConfiguration tracing_jit_configuration = {};
+    const bool should_trace_hot_loops = argument_parser.has_flag("trace-jit"sv) || argument_parser.has_flag("trace-jit-differential"sv);
+    if (argument_parser.has_flag("trace-jit-differential"sv)) {
+        ErrorOr<void> differential_result =
+            DifferentialTester::run(package, tracing_jit_configuration, entry_point.value(), virtual_machine_configuration);
+        if (differential_result.is_error()) {
+            const InternalError error = differential_result.release_error();
+            printf("The traces don't match the interpreter: %s\n", error.error_message().value_or(String()).characters());
+            return;
+        }
+        printf("The traces match the interpreter.\n");
+    }
+
+    // NOTE: The batch executes the package on separate virtual machines, before and independently of the regular execution.
+    if (const Optional<StringView> batch_option = argument_parser.option_value("batch"sv); batch_option.has_value()) {
+        const Optional<u64> execution_count = parse_decimal_integer(batch_option.value());
+        if (!execution_count.has_value() || execution_count.value() == 0) {
+            printf("The batch size must be a positive integer.\n");
+            return;
+        }
 
-    auto dst_register = virtual_machine.register_storage(result_register);
+        ErrorOr<void> batch_result = execute_in_batch(package, entry_point.value(), execution_count.value(), virtual_machine_configuration);
+        if (batch_result.is_error()) {
+            const InternalError error = batch_result.release_error();
+            printf("Failed to execute the batch: %s\n", error.error_message().value_or(String()).characters());
+            return;
+        }
+    }
+
+    ErrorOr<OwnPtr<VirtualMachine>> create_result = VirtualMachine::create(virtual_machine_configuration);
+    if (create_result.is_error()) {
+        const InternalError error = create_result.release_error();
+        printf("Failed to create the virtual machine: %s\n", error.error_message().value_or(String()).characters());
+        return;
+    }
+
+    OwnPtr<VirtualMachine> virtual_machine = create_result.release_value();
+    Interpreter interpreter(*virtual_machine, package);
+    interpreter.set_entry_point(entry_point.value().address());
+    const StringView dispatch_mode = argument_parser.option_value("dispatch"sv).value_or("threaded"sv);
+    if (dispatch_mode == "execute"sv)
+        interpreter.set_dispatch_mode(DispatchMode::InstructionExecute);
+    else if (dispatch_mode == "threaded-code"sv)
+        interpreter.set_dispatch_mode(DispatchMode::ThreadedCode);
+    else if (dispatch_mode == "register-caching"sv)
+        interpreter.set_dispatch_mode(DispatchMode::RegisterCaching);
+    if (native_code.has_value())
+        interpreter.set_native_code(&native_code.value());
+    TracingJit tracing_jit(package, tracing_jit_configuration);
+    if (should_trace_hot_loops)
+        interpreter.set_tracing_jit(&tracing_jit);
+
+    // NOTE: The metered execution is suspended every time it consumes the given amount of fuel, and resumed right away.
+    Optional<u64> fuel;
+    if (const Optional<StringView> fuel_option = argument_parser.option_value("fuel"sv); fuel_option.has_value()) {
+        fuel = parse_decimal_integer(fuel_option.value());
+        if (!fuel.has_value() || fuel.value() == 0) {
+            printf("The fuel must be a positive integer.\n");
+            return;
+        }
+    }
+
+    // NOTE: The instrumented runs always use the checked direct-threaded dispatch, regardless of the other options.
+    const bool should_count_instructions = argument_parser.has_flag("count-instructions"sv);
+    const bool should_trace_execution = argument_parser.has_flag("trace-execution"sv);
+    CountingInterpreterPolicy counting_policy;
+    StringBuilder execution_trace;
+    TracingInterpreterPolicy tracing_policy(execution_trace);
+
+    ErrorOr<void> execute_result = fuel.has_value()           ? execute_in_slices(interpreter, fuel.value())
+                                   : should_count_instructions ? interpreter.execute_with_policy(counting_policy)
+                                   : should_trace_execution    ? interpreter.execute_with_policy(tracing_policy)
+                                                               : interpreter.execute();
+    if (should_trace_execution && !should_count_instructions)
+        printf("%s", execution_trace.release_string().characters());
+    if (execute_result.is_error()) {
+        const InternalError error = execute_result.release_error();
+        printf("The execution was aborted by a trap: %s\n", error.error_message().value_or(String()).characters());
+        return;
+    }
+    if (should_count_instructions) {
+        printf("Executed %llu instructions, %llu calls and %llu returns.\n",
+               static_cast<unsigned long long>(counting_policy.executed_instruction_count),
+               static_cast<unsigned long long>(counting_policy.call_count), static_cast<unsigned long long>(counting_policy.return_count));
+    }
+    if (should_trace_hot_loops)
+        printf("Compiled %zu traces of hot loops.\n", static_cast<size_t>(tracing_jit.compiled_trace_count()));
+
+    auto dst_register = virtual_machine->register_storage(result_register);
     printf("%s", StringBuilder::formatted("{}"sv, dst_register).characters());
 
     generate_fibonacci_ast();
 }
-
 }
 
 int main(int argc, char** argv)
@@ -216,11 +216,11 @@ public:
     {
         ensure_capacity(new_count);
 
-        for (usize index = new_count; index < m_count; ++index) {
+        for (usize index = m_count; index < new_count; ++index) {
             new (m_elements + index) T(template_element);
         }
 
-        for (usize index = m_count; index < new_count; ++index) {
+        for (usize index = new_count; index < m_count; ++index) {
             m_elements[index].~T();
         }
 
@@ -231,11 +231,11 @@ public:
     {
         ensure_capacity(new_count);
 
-        for (usize index = new_count; index < m_count; ++index) {
+        for (usize index = m_count; index < new_count; ++index) {
             new (m_elements + index) T();
         }
 
-        for (usize index = m_count; index < new_count; ++index) {
+        for (usize index = new_count; index < m_count; ++index) {
             m_elements[index].~T();
         }
 
@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause.
+ */
+
+#include <core/memory/executable_memory.h>
+#include <core/memory/guarded_memory_region.h>
+
+#if ARC_PLATFORM_LINUX || ARC_PLATFORM_MACOS
+    #include <sys/mman.h>
+#endif // ARC_PLATFORM_LINUX || ARC_PLATFORM_MACOS
+
+#if ARC_PLATFORM_WINDOWS
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+#endif // ARC_PLATFORM_WINDOWS
+
+namespace Arc {
+
+ErrorOr<ExecutableMemory> ExecutableMemory::allocate(usize byte_count)
+{
+    // NOTE: The protection of the region can only be changed for whole pages.
+    const usize page_byte_count = GuardedMemoryRegion::page_size();
+    byte_count = ((byte_count + page_byte_count - 1) / page_byte_count) * page_byte_count;
+    if (byte_count == 0)
+        return ARC_INTERNAL_ERROR_WITH_MESSAGE("Can't allocate an empty executable memory region"sv);
+
+    ExecutableMemory memory;
+
+#if ARC_PLATFORM_LINUX || ARC_PLATFORM_MACOS
+    void* address = mmap(nullptr, byte_count, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (address == MAP_FAILED)
+        return ARC_INTERNAL_ERROR_WITH_MESSAGE("Failed to allocate the executable memory region"sv);
+#elif ARC_PLATFORM_WINDOWS
+    void* address = VirtualAlloc(nullptr, byte_count, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+    if (address == nullptr)
+        return ARC_INTERNAL_ERROR_WITH_MESSAGE("Failed to allocate the executable memory region"sv);
+#endif // Supported platforms.
+
+    memory.m_bytes = static_cast<ReadWriteBytes>(address);
+    memory.m_byte_count = byte_count;
+    return memory;
+}
+
+ExecutableMemory::ExecutableMemory()
+    : m_bytes(nullptr)
+    , m_byte_count(0)
+    , m_is_sealed(false)
+{}
+
+ExecutableMemory::~ExecutableMemory()
+{
+    release();
+}
+
+ExecutableMemory::ExecutableMemory(ExecutableMemory&& other) noexcept
+    : m_bytes(other.m_bytes)
+    , m_byte_count(other.m_byte_count)
+    , m_is_sealed(other.m_is_sealed)
+{
+    other.m_bytes = nullptr;
+    other.m_byte_count = 0;
+    other.m_is_sealed = false;
+}
+
+ExecutableMemory& ExecutableMemory::operator=(ExecutableMemory&& other) noexcept
+{
+    // Handle self-assignment case.
+    if (this == &other)
+        return *this;
+
+    release();
+    m_bytes = other.m_bytes;
+    m_byte_count = other.m_byte_count;
+    m_is_sealed = other.m_is_sealed;
+    other.m_bytes = nullptr;
+    other.m_byte_count = 0;
+    other.m_is_sealed = false;
+    return *this;
+}
+
+ErrorOr<void> ExecutableMemory::seal()
+{
+    ARC_ASSERT(m_bytes != nullptr && !m_is_sealed);
+
+#if ARC_PLATFORM_LINUX || ARC_PLATFORM_MACOS
+    if (mprotect(m_bytes, m_byte_count, PROT_READ | PROT_EXEC) != 0)
+        return ARC_INTERNAL_ERROR_WITH_MESSAGE("Failed to make the memory region executable"sv);
+#elif ARC_PLATFORM_WINDOWS
+    DWORD old_protection = 0;
+    if (!VirtualProtect(m_bytes, m_byte_count, PAGE_EXECUTE_READ, &old_protection))
+        return ARC_INTERNAL_ERROR_WITH_MESSAGE("Failed to make the memory region executable"sv);
+    FlushInstructionCache(GetCurrentProcess(), m_bytes, m_byte_count);
+#endif // Supported platforms.
+
+    m_is_sealed = true;
+    return {};
+}
+
+void ExecutableMemory::release()
+{
+    if (m_bytes == nullptr)
+        return;
+
+#if ARC_PLATFORM_LINUX || ARC_PLATFORM_MACOS
+    munmap(m_bytes, m_byte_count);
+#elif ARC_PLATFORM_WINDOWS
+    VirtualFree(m_bytes, 0, MEM_RELEASE);
+#endif // Supported platforms.
+
+    m_bytes = nullptr;
+    m_byte_count = 0;
+    m_is_sealed = false;
+}
+
+}
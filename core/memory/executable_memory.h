@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause.
+ */
+
+#pragma once
+
+#include <core/containers/span.h>
+#include <core/error.h>
+
+namespace Arc {
+
+// A region of memory that holds generated machine code. The region is writable until it is sealed, after which it can
+// only be read and executed, so that its pages are never writable and executable at the same time.
+class ExecutableMemory {
+    ARC_MAKE_NONCOPYABLE(ExecutableMemory);
+
+public:
+    NODISCARD static ErrorOr<ExecutableMemory> allocate(usize byte_count);
+
+public:
+    ExecutableMemory();
+    ~ExecutableMemory();
+
+    ExecutableMemory(ExecutableMemory&& other) noexcept;
+    ExecutableMemory& operator=(ExecutableMemory&& other) noexcept;
+
+public:
+    NODISCARD ALWAYS_INLINE ReadonlyBytes bytes() const { return m_bytes; }
+    NODISCARD ALWAYS_INLINE usize byte_count() const { return m_byte_count; }
+
+    NODISCARD ALWAYS_INLINE ReadWriteBytes writable_bytes()
+    {
+        ARC_ASSERT(!m_is_sealed);
+        return m_bytes;
+    }
+
+    NODISCARD ALWAYS_INLINE bool is_sealed() const { return m_is_sealed; }
+
+    // Makes the region executable and read-only. The region can't be written after it has been sealed.
+    NODISCARD ErrorOr<void> seal();
+
+    void release();
+
+private:
+    ReadWriteBytes m_bytes;
+    usize m_byte_count;
+    bool m_is_sealed;
+};
+
+}
@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause.
+ */
+
+#include <core/memory/file_mapping.h>
+
+#if ARC_PLATFORM_LINUX || ARC_PLATFORM_MACOS
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif // ARC_PLATFORM_LINUX || ARC_PLATFORM_MACOS
+
+#if ARC_PLATFORM_WINDOWS
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+#endif // ARC_PLATFORM_WINDOWS
+
+namespace Arc {
+
+ErrorOr<FileMapping> FileMapping::map_readonly(StringView filepath)
+{
+    // NOTE: The operating system APIs expect null-terminated paths.
+    const String null_terminated_filepath = String(filepath);
+    FileMapping file_mapping;
+
+#if ARC_PLATFORM_LINUX || ARC_PLATFORM_MACOS
+    const int file_descriptor = open(null_terminated_filepath.characters(), O_RDONLY);
+    if (file_descriptor < 0)
+        return ARC_INTERNAL_ERROR_WITH_MESSAGE("Failed to open the file for mapping"sv);
+
+    struct stat file_status = {};
+    if (fstat(file_descriptor, &file_status) != 0 || file_status.st_size <= 0) {
+        close(file_descriptor);
+        return ARC_INTERNAL_ERROR_WITH_MESSAGE("Failed to query the size of the file, or the file is empty"sv);
+    }
+
+    const usize byte_count = static_cast<usize>(file_status.st_size);
+    void* mapped_address = mmap(nullptr, byte_count, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+    // NOTE: The mapping keeps its own reference to the file, so the descriptor is no longer needed.
+    close(file_descriptor);
+    if (mapped_address == MAP_FAILED)
+        return ARC_INTERNAL_ERROR_WITH_MESSAGE("Failed to map the file into memory"sv);
+
+    file_mapping.m_bytes = static_cast<ReadonlyBytes>(mapped_address);
+    file_mapping.m_byte_count = byte_count;
+#elif ARC_PLATFORM_WINDOWS
+    HANDLE file_handle = CreateFileA(null_terminated_filepath.characters(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                     FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file_handle == INVALID_HANDLE_VALUE)
+        return ARC_INTERNAL_ERROR_WITH_MESSAGE("Failed to open the file for mapping"sv);
+
+    LARGE_INTEGER file_size = {};
+    if (!GetFileSizeEx(file_handle, &file_size) || file_size.QuadPart <= 0) {
+        CloseHandle(file_handle);
+        return ARC_INTERNAL_ERROR_WITH_MESSAGE("Failed to query the size of the file, or the file is empty"sv);
+    }
+
+    HANDLE mapping_handle = CreateFileMappingA(file_handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping_handle == nullptr) {
+        CloseHandle(file_handle);
+        return ARC_INTERNAL_ERROR_WITH_MESSAGE("Failed to create the file mapping object"sv);
+    }
+
+    void* mapped_address = MapViewOfFile(mapping_handle, FILE_MAP_READ, 0, 0, 0);
+    if (mapped_address == nullptr) {
+        CloseHandle(mapping_handle);
+        CloseHandle(file_handle);
+        return ARC_INTERNAL_ERROR_WITH_MESSAGE("Failed to map the file into memory"sv);
+    }
+
+    file_mapping.m_bytes = static_cast<ReadonlyBytes>(mapped_address);
+    file_mapping.m_byte_count = static_cast<usize>(file_size.QuadPart);
+    file_mapping.m_file_handle = file_handle;
+    file_mapping.m_mapping_handle = mapping_handle;
+#endif // Supported platforms.
+
+    return file_mapping;
+}
+
+FileMapping::FileMapping()
+    : m_bytes(nullptr)
+    , m_byte_count(0)
+#if ARC_PLATFORM_WINDOWS
+    , m_file_handle(nullptr)
+    , m_mapping_handle(nullptr)
+#endif // ARC_PLATFORM_WINDOWS
+{}
+
+FileMapping::~FileMapping()
+{
+    unmap();
+}
+
+FileMapping::FileMapping(FileMapping&& other) noexcept
+    : m_bytes(other.m_bytes)
+    , m_byte_count(other.m_byte_count)
+#if ARC_PLATFORM_WINDOWS
+    , m_file_handle(other.m_file_handle)
+    , m_mapping_handle(other.m_mapping_handle)
+#endif // ARC_PLATFORM_WINDOWS
+{
+    other.m_bytes = nullptr;
+    other.m_byte_count = 0;
+#if ARC_PLATFORM_WINDOWS
+    other.m_file_handle = nullptr;
+    other.m_mapping_handle = nullptr;
+#endif // ARC_PLATFORM_WINDOWS
+}
+
+FileMapping& FileMapping::operator=(FileMapping&& other) noexcept
+{
+    // Handle self-assignment case.
+    if (this == &other)
+        return *this;
+
+    unmap();
+    m_bytes = other.m_bytes;
+    m_byte_count = other.m_byte_count;
+    other.m_bytes = nullptr;
+    other.m_byte_count = 0;
+#if ARC_PLATFORM_WINDOWS
+    m_file_handle = other.m_file_handle;
+    m_mapping_handle = other.m_mapping_handle;
+    other.m_file_handle = nullptr;
+    other.m_mapping_handle = nullptr;
+#endif // ARC_PLATFORM_WINDOWS
+    return *this;
+}
+
+void FileMapping::unmap()
+{
+    if (m_bytes == nullptr)
+        return;
+
+#if ARC_PLATFORM_LINUX || ARC_PLATFORM_MACOS
+    munmap(const_cast<ReadWriteBytes>(m_bytes), m_byte_count);
+#elif ARC_PLATFORM_WINDOWS
+    UnmapViewOfFile(m_bytes);
+    CloseHandle(static_cast<HANDLE>(m_mapping_handle));
+    CloseHandle(static_cast<HANDLE>(m_file_handle));
+    m_file_handle = nullptr;
+    m_mapping_handle = nullptr;
+#endif // Supported platforms.
+
+    m_bytes = nullptr;
+    m_byte_count = 0;
+}
+
+}
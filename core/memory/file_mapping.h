@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause.
+ */
+
+#pragma once
+
+#include <core/containers/span.h>
+#include <core/error.h>
+
+namespace Arc {
+
+// A read-only view of a file's contents, mapped directly into the address space of the process. The pages are
+// loaded lazily by the operating system when they are first accessed, and no copy of the file is ever made.
+class FileMapping {
+    ARC_MAKE_NONCOPYABLE(FileMapping);
+
+public:
+    NODISCARD static ErrorOr<FileMapping> map_readonly(StringView filepath);
+
+public:
+    FileMapping();
+    ~FileMapping();
+
+    FileMapping(FileMapping&& other) noexcept;
+    FileMapping& operator=(FileMapping&& other) noexcept;
+
+public:
+    NODISCARD ALWAYS_INLINE ReadonlyBytes bytes() const { return m_bytes; }
+    NODISCARD ALWAYS_INLINE usize byte_count() const { return m_byte_count; }
+    NODISCARD ALWAYS_INLINE ReadonlyByteSpan byte_span() const { return ReadonlyByteSpan(m_bytes, m_byte_count); }
+
+    NODISCARD ALWAYS_INLINE bool is_mapped() const { return m_bytes != nullptr; }
+
+public:
+    void unmap();
+
+private:
+    ReadonlyBytes m_bytes;
+    usize m_byte_count;
+#if ARC_PLATFORM_WINDOWS
+    void* m_file_handle;
+    void* m_mapping_handle;
+#endif // ARC_PLATFORM_WINDOWS
+};
+
+}
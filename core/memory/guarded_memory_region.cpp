@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause.
+ */
+
+#include <core/memory/guarded_memory_region.h>
+
+#if ARC_PLATFORM_LINUX || ARC_PLATFORM_MACOS
+    #include <sys/mman.h>
+    #include <unistd.h>
+#endif // ARC_PLATFORM_LINUX || ARC_PLATFORM_MACOS
+
+#if ARC_PLATFORM_WINDOWS
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+#endif // ARC_PLATFORM_WINDOWS
+
+namespace Arc {
+
+ErrorOr<GuardedMemoryRegion> GuardedMemoryRegion::reserve(usize byte_count, MAYBE_UNUSED bool use_huge_pages)
+{
+    const usize guard_page_byte_count = page_size();
+    // NOTE: The usable bytes always span a whole number of pages.
+    byte_count = ((byte_count + guard_page_byte_count - 1) / guard_page_byte_count) * guard_page_byte_count;
+    if (byte_count == 0)
+        return ARC_INTERNAL_ERROR_WITH_MESSAGE("Can't reserve an empty memory region"sv);
+
+    const usize reserved_byte_count = guard_page_byte_count + byte_count;
+    GuardedMemoryRegion region;
+
+#if ARC_PLATFORM_LINUX || ARC_PLATFORM_MACOS
+    int mapping_flags = MAP_PRIVATE | MAP_ANONYMOUS;
+    #if ARC_PLATFORM_LINUX
+    // NOTE: Don't account the whole region against the commit limit, as most of it is usually never touched.
+    mapping_flags |= MAP_NORESERVE;
+    #endif // ARC_PLATFORM_LINUX
+
+    void* reserved_address = mmap(nullptr, reserved_byte_count, PROT_READ | PROT_WRITE, mapping_flags, -1, 0);
+    if (reserved_address == MAP_FAILED)
+        return ARC_INTERNAL_ERROR_WITH_MESSAGE("Failed to reserve the memory region"sv);
+
+    if (mprotect(reserved_address, guard_page_byte_count, PROT_NONE) != 0) {
+        munmap(reserved_address, reserved_byte_count);
+        return ARC_INTERNAL_ERROR_WITH_MESSAGE("Failed to protect the guard page of the memory region"sv);
+    }
+
+    #if ARC_PLATFORM_LINUX
+    if (use_huge_pages) {
+        // NOTE: This is only advice, so failing to apply it isn't an error.
+        madvise(static_cast<ReadWriteBytes>(reserved_address) + guard_page_byte_count, byte_count, MADV_HUGEPAGE);
+    }
+    #endif // ARC_PLATFORM_LINUX
+#elif ARC_PLATFORM_WINDOWS
+    // NOTE: Committed pages are only backed by physical memory when they are first accessed. Large pages require
+    //       special privileges and can't be committed lazily, so they are never used.
+    void* reserved_address = VirtualAlloc(nullptr, reserved_byte_count, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+    if (reserved_address == nullptr)
+        return ARC_INTERNAL_ERROR_WITH_MESSAGE("Failed to reserve the memory region"sv);
+
+    DWORD old_protection = 0;
+    if (!VirtualProtect(reserved_address, guard_page_byte_count, PAGE_NOACCESS, &old_protection)) {
+        VirtualFree(reserved_address, 0, MEM_RELEASE);
+        return ARC_INTERNAL_ERROR_WITH_MESSAGE("Failed to protect the guard page of the memory region"sv);
+    }
+#endif // Supported platforms.
+
+    region.m_bytes = static_cast<ReadWriteBytes>(reserved_address) + guard_page_byte_count;
+    region.m_byte_count = byte_count;
+    region.m_guard_page_byte_count = guard_page_byte_count;
+    return region;
+}
+
+usize GuardedMemoryRegion::page_size()
+{
+#if ARC_PLATFORM_LINUX || ARC_PLATFORM_MACOS
+    static const usize s_page_size = static_cast<usize>(sysconf(_SC_PAGESIZE));
+#elif ARC_PLATFORM_WINDOWS
+    SYSTEM_INFO system_info = {};
+    GetSystemInfo(&system_info);
+    static const usize s_page_size = static_cast<usize>(system_info.dwPageSize);
+#endif // Supported platforms.
+    return s_page_size;
+}
+
+GuardedMemoryRegion::GuardedMemoryRegion()
+    : m_bytes(nullptr)
+    , m_byte_count(0)
+    , m_guard_page_byte_count(0)
+{}
+
+GuardedMemoryRegion::~GuardedMemoryRegion()
+{
+    release();
+}
+
+GuardedMemoryRegion::GuardedMemoryRegion(GuardedMemoryRegion&& other) noexcept
+    : m_bytes(other.m_bytes)
+    , m_byte_count(other.m_byte_count)
+    , m_guard_page_byte_count(other.m_guard_page_byte_count)
+{
+    other.m_bytes = nullptr;
+    other.m_byte_count = 0;
+    other.m_guard_page_byte_count = 0;
+}
+
+GuardedMemoryRegion& GuardedMemoryRegion::operator=(GuardedMemoryRegion&& other) noexcept
+{
+    // Handle self-assignment case.
+    if (this == &other)
+        return *this;
+
+    release();
+    m_bytes = other.m_bytes;
+    m_byte_count = other.m_byte_count;
+    m_guard_page_byte_count = other.m_guard_page_byte_count;
+    other.m_bytes = nullptr;
+    other.m_byte_count = 0;
+    other.m_guard_page_byte_count = 0;
+    return *this;
+}
+
+ErrorOr<void> GuardedMemoryRegion::discard()
+{
+    ARC_ASSERT(is_reserved());
+
+#if ARC_PLATFORM_LINUX
+    // NOTE: Discarded pages of private anonymous mappings are zero-filled when they are accessed again.
+    if (madvise(m_bytes, m_byte_count, MADV_DONTNEED) != 0)
+        return ARC_INTERNAL_ERROR_WITH_MESSAGE("Failed to discard the memory region"sv);
+#elif ARC_PLATFORM_MACOS
+    // NOTE: The discarded pages of macOS aren't guaranteed to read as zero, so the usable bytes are mapped again.
+    void* mapped_address = mmap(m_bytes, m_byte_count, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED, -1, 0);
+    if (mapped_address == MAP_FAILED)
+        return ARC_INTERNAL_ERROR_WITH_MESSAGE("Failed to discard the memory region"sv);
+#elif ARC_PLATFORM_WINDOWS
+    if (!VirtualFree(m_bytes, m_byte_count, MEM_DECOMMIT))
+        return ARC_INTERNAL_ERROR_WITH_MESSAGE("Failed to discard the memory region"sv);
+    if (VirtualAlloc(m_bytes, m_byte_count, MEM_COMMIT, PAGE_READWRITE) == nullptr)
+        return ARC_INTERNAL_ERROR_WITH_MESSAGE("Failed to discard the memory region"sv);
+#endif // Supported platforms.
+
+    return {};
+}
+
+void GuardedMemoryRegion::release()
+{
+    if (m_bytes == nullptr)
+        return;
+
+    void* reserved_address = m_bytes - m_guard_page_byte_count;
+#if ARC_PLATFORM_LINUX || ARC_PLATFORM_MACOS
+    munmap(reserved_address, m_guard_page_byte_count + m_byte_count);
+#elif ARC_PLATFORM_WINDOWS
+    VirtualFree(reserved_address, 0, MEM_RELEASE);
+#endif // Supported platforms.
+
+    m_bytes = nullptr;
+    m_byte_count = 0;
+    m_guard_page_byte_count = 0;
+}
+
+}
@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause.
+ */
+
+#pragma once
+
+#include <core/containers/span.h>
+#include <core/error.h>
+
+namespace Arc {
+
+// A read-write region of the address space that is reserved up front but only backed by physical memory when its
+// pages are first accessed. The page right below the usable bytes is an inaccessible guard page, so running past the
+// beginning of the region faults instead of silently overwriting other memory.
+class GuardedMemoryRegion {
+    ARC_MAKE_NONCOPYABLE(GuardedMemoryRegion);
+
+public:
+    // When `use_huge_pages` is set the operating system is advised to back the region with huge pages, which reduces
+    // the TLB pressure of large regions. The advice is ignored on platforms that don't support it.
+    NODISCARD static ErrorOr<GuardedMemoryRegion> reserve(usize byte_count, bool use_huge_pages);
+
+    NODISCARD static usize page_size();
+
+public:
+    GuardedMemoryRegion();
+    ~GuardedMemoryRegion();
+
+    GuardedMemoryRegion(GuardedMemoryRegion&& other) noexcept;
+    GuardedMemoryRegion& operator=(GuardedMemoryRegion&& other) noexcept;
+
+public:
+    NODISCARD ALWAYS_INLINE ReadWriteBytes bytes() { return m_bytes; }
+    NODISCARD ALWAYS_INLINE ReadonlyBytes bytes() const { return m_bytes; }
+    NODISCARD ALWAYS_INLINE usize byte_count() const { return m_byte_count; }
+
+    NODISCARD ALWAYS_INLINE bool is_reserved() const { return m_bytes != nullptr; }
+
+    NODISCARD ALWAYS_INLINE ReadonlyBytes guard_page_bytes() const { return m_bytes - m_guard_page_byte_count; }
+    NODISCARD ALWAYS_INLINE usize guard_page_byte_count() const { return m_guard_page_byte_count; }
+
+    NODISCARD ALWAYS_INLINE bool guard_page_contains(const void* address) const
+    {
+        const ReadonlyBytes byte_address = static_cast<ReadonlyBytes>(address);
+        return byte_address >= guard_page_bytes() && byte_address < m_bytes;
+    }
+
+public:
+    // Replaces the physical memory that backs the region by fresh pages, so that all of its bytes read as zero again
+    // without having to write them. The pages are only backed again when they are next accessed.
+    NODISCARD ErrorOr<void> discard();
+
+    void release();
+
+private:
+    // NOTE: Points to the first usable byte, which is right after the guard page.
+    ReadWriteBytes m_bytes;
+    usize m_byte_count;
+    usize m_guard_page_byte_count;
+};
+
+}
@@ -17,6 +17,25 @@ void copy_memory(void* destination_buffer, const void* source_buffer, usize byte
     }
 }
 
+void move_memory(void* destination_buffer, const void* source_buffer, usize byte_count)
+{
+    const WriteonlyBytes dst_buffer = static_cast<WriteonlyBytes>(destination_buffer);
+    const ReadonlyBytes src_buffer = static_cast<ReadonlyBytes>(source_buffer);
+
+    // NOTE: When the destination is after the source, copying forwards would overwrite source bytes before they
+    //       are read, so the bytes are copied backwards instead.
+    if (dst_buffer <= src_buffer) {
+        for (usize byte_offset = 0; byte_offset < byte_count; ++byte_offset) {
+            dst_buffer[byte_offset] = src_buffer[byte_offset];
+        }
+    }
+    else {
+        for (usize byte_offset = byte_count; byte_offset > 0; --byte_offset) {
+            dst_buffer[byte_offset - 1] = src_buffer[byte_offset - 1];
+        }
+    }
+}
+
 void set_memory(void* destination_buffer, u8 byte_value, usize byte_count)
 {
     const WriteonlyBytes dst_buffer = static_cast<WriteonlyBytes>(destination_buffer);
@@ -10,6 +10,8 @@
 namespace Arc {
 
 void copy_memory(void* destination_buffer, const void* source_buffer, usize byte_count);
+// Like `copy_memory`, but the destination and source buffers are allowed to overlap.
+void move_memory(void* destination_buffer, const void* source_buffer, usize byte_count);
 void set_memory(void* destination_buffer, u8 byte_value, usize byte_count);
 void zero_memory(void* destination_buffer, usize byte_count);
 
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause.
+ */
+
+#include <core/thread.h>
+
+#if ARC_PLATFORM_LINUX || ARC_PLATFORM_MACOS
+    #include <pthread.h>
+    #include <unistd.h>
+#endif // ARC_PLATFORM_LINUX || ARC_PLATFORM_MACOS
+
+#if ARC_PLATFORM_WINDOWS
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+#endif // ARC_PLATFORM_WINDOWS
+
+namespace Arc {
+
+struct Thread::NativeThread {
+#if ARC_PLATFORM_LINUX || ARC_PLATFORM_MACOS
+    static void* run(void* native_thread)
+    {
+        const NativeThread& thread = *static_cast<const NativeThread*>(native_thread);
+        thread.entry_function(thread.user_data);
+        return nullptr;
+    }
+#elif ARC_PLATFORM_WINDOWS
+    static DWORD WINAPI run(LPVOID native_thread)
+    {
+        const NativeThread& thread = *static_cast<const NativeThread*>(native_thread);
+        thread.entry_function(thread.user_data);
+        return 0;
+    }
+#endif // Supported platforms.
+
+    EntryFunction entry_function;
+    void* user_data;
+#if ARC_PLATFORM_LINUX || ARC_PLATFORM_MACOS
+    pthread_t handle;
+#elif ARC_PLATFORM_WINDOWS
+    HANDLE handle;
+#endif // Supported platforms.
+};
+
+ErrorOr<Thread> Thread::spawn(EntryFunction entry_function, void* user_data)
+{
+    NativeThread* native_thread = new NativeThread();
+    native_thread->entry_function = entry_function;
+    native_thread->user_data = user_data;
+
+#if ARC_PLATFORM_LINUX || ARC_PLATFORM_MACOS
+    if (pthread_create(&native_thread->handle, nullptr, NativeThread::run, native_thread) != 0) {
+        delete native_thread;
+        return ARC_INTERNAL_ERROR_WITH_MESSAGE("Failed to create the thread"sv);
+    }
+#elif ARC_PLATFORM_WINDOWS
+    native_thread->handle = CreateThread(nullptr, 0, NativeThread::run, native_thread, 0, nullptr);
+    if (native_thread->handle == nullptr) {
+        delete native_thread;
+        return ARC_INTERNAL_ERROR_WITH_MESSAGE("Failed to create the thread"sv);
+    }
+#endif // Supported platforms.
+
+    Thread thread;
+    thread.m_native_thread = native_thread;
+    return thread;
+}
+
+usize Thread::hardware_thread_count()
+{
+#if ARC_PLATFORM_LINUX || ARC_PLATFORM_MACOS
+    const long online_processor_count = sysconf(_SC_NPROCESSORS_ONLN);
+    return online_processor_count > 0 ? static_cast<usize>(online_processor_count) : 1;
+#elif ARC_PLATFORM_WINDOWS
+    SYSTEM_INFO system_info = {};
+    GetSystemInfo(&system_info);
+    return system_info.dwNumberOfProcessors > 0 ? static_cast<usize>(system_info.dwNumberOfProcessors) : 1;
+#endif // Supported platforms.
+}
+
+Thread::Thread()
+    : m_native_thread(nullptr)
+{}
+
+Thread::~Thread()
+{
+    // NOTE: Destroying a thread that is still running would leave it without anyone to wait for it.
+    ARC_ASSERT(!is_joinable());
+}
+
+Thread::Thread(Thread&& other) noexcept
+    : m_native_thread(other.m_native_thread)
+{
+    other.m_native_thread = nullptr;
+}
+
+Thread& Thread::operator=(Thread&& other) noexcept
+{
+    // Handle self-assignment case.
+    if (this == &other)
+        return *this;
+
+    ARC_ASSERT(!is_joinable());
+    m_native_thread = other.m_native_thread;
+    other.m_native_thread = nullptr;
+    return *this;
+}
+
+void Thread::join()
+{
+    ARC_ASSERT(is_joinable());
+
+#if ARC_PLATFORM_LINUX || ARC_PLATFORM_MACOS
+    pthread_join(m_native_thread->handle, nullptr);
+#elif ARC_PLATFORM_WINDOWS
+    WaitForSingleObject(m_native_thread->handle, INFINITE);
+    CloseHandle(m_native_thread->handle);
+#endif // Supported platforms.
+
+    delete m_native_thread;
+    m_native_thread = nullptr;
+}
+
+}
@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause.
+ */
+
+#pragma once
+
+#include <core/error.h>
+
+namespace Arc {
+
+// A thread of the operating system that runs a single function. The thread must be joined before it is destroyed.
+class Thread {
+    ARC_MAKE_NONCOPYABLE(Thread);
+
+public:
+    using EntryFunction = void (*)(void* user_data);
+
+    NODISCARD static ErrorOr<Thread> spawn(EntryFunction entry_function, void* user_data);
+
+    // The number of threads that the machine can execute in parallel, which is always at least one.
+    NODISCARD static usize hardware_thread_count();
+
+public:
+    Thread();
+    ~Thread();
+
+    Thread(Thread&& other) noexcept;
+    Thread& operator=(Thread&& other) noexcept;
+
+public:
+    NODISCARD ALWAYS_INLINE bool is_joinable() const { return m_native_thread != nullptr; }
+
+    // Blocks until the function of the thread returns.
+    void join();
+
+private:
+    struct NativeThread;
+
+    // NOTE: The native thread is allocated separately, as its address is passed to the new thread and must not change
+    //       when the thread object is moved.
+    NativeThread* m_native_thread;
+};
+
+}
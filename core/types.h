@@ -131,6 +131,9 @@ constexpr bool is_floating_point = impl::IsFloatingPoint<T>::value;
 template<typename DerivedType, typename BaseType>
 constexpr bool is_derived_from = std::is_base_of_v<BaseType, DerivedType>;
 
+template<typename T>
+constexpr bool is_trivially_copyable = std::is_trivially_copyable_v<T>;
+
 template<typename T>
 constexpr bool is_trivially_destructible = std::is_trivially_destructible_v<T>;
 
@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause.
+ */
+
+#include <runtime/aot/aot_runtime.h>
+
+namespace Arc::Runtime {
+
+struct AotExecution {
+    VirtualMachine& virtual_machine;
+    AotFunction entry_point_function;
+};
+
+static void execute_guarded(void* user_data)
+{
+    const AotExecution& execution = *static_cast<const AotExecution*>(user_data);
+    AotContext context(execution.virtual_machine);
+
+    constexpr u8 register_count = static_cast<u8>(Bytecode::Register::Count);
+    for (u8 register_index = 0; register_index < register_count; ++register_index) {
+        const Bytecode::Register reg = static_cast<Bytecode::Register>(register_index);
+        context.argument(register_index) = execution.virtual_machine.register_storage(reg).value;
+    }
+
+    // NOTE: Entry point functions never return, so the execution always finishes by leaving the package.
+    MAYBE_UNUSED const AotReturn result = execution.entry_point_function(context, register_count);
+}
+
+ErrorOr<void> AotRuntime::execute(VirtualMachine& virtual_machine, AotFunction entry_point_function)
+{
+    if (virtual_machine.stack().has_call_frames())
+        return ARC_INTERNAL_ERROR_WITH_MESSAGE("Generated entry points must be executed with an empty call stack"sv);
+
+    AotExecution execution = { virtual_machine, entry_point_function };
+    const Optional<Trap> trap =
+        TrapHandler::run(virtual_machine.stack().memory(), virtual_machine.register_file().memory(), execute_guarded, &execution);
+    if (trap.has_value())
+        return ARC_INTERNAL_ERROR_WITH_MESSAGE(trap_to_string_view(trap.value()));
+    return {};
+}
+
+}
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause.
+ */
+
+#pragma once
+
+#include <bytecode/jump_address.h>
+#include <bytecode/register.h>
+#include <core/error.h>
+#include <runtime/integer_arithmetic.h>
+#include <runtime/trap.h>
+#include <runtime/virtual_machine.h>
+
+namespace Arc::Runtime {
+
+enum class AotReturnKind : u8 {
+    // The function returned without a value, or its caller doesn't expect one.
+    Return,
+    // The function returned a value that must be written to the return value register of its caller.
+    ReturnValue,
+    // The instruction pointer left the package, which finishes the execution of the whole program.
+    Finish,
+};
+
+struct AotReturn {
+    u64 value;
+    AotReturnKind kind;
+};
+
+//
+// The state shared by the C++ functions that the `CppTranslator` generates for the functions of a package. The
+// registers of every function live in local variables of its C++ function, while the stack is the `VirtualStack` of
+// the virtual machine, so the stack contents are identical to the ones produced by the interpreter.
+//
+// NOTE: The generated code is only produced for verified packages, so the stack is accessed without any checks.
+//
+class AotContext {
+    ARC_MAKE_NONCOPYABLE(AotContext);
+    ARC_MAKE_NONMOVABLE(AotContext);
+
+public:
+    explicit AotContext(VirtualMachine& virtual_machine)
+        : m_virtual_machine(virtual_machine)
+        , m_call_depth(0)
+    {}
+
+    NODISCARD ALWAYS_INLINE VirtualStack& stack() { return m_virtual_machine.stack(); }
+
+    // The caller writes the register arguments of a call here, and the callee initializes its registers from them.
+    NODISCARD ALWAYS_INLINE u64& argument(u8 argument_index) { return m_arguments[argument_index]; }
+
+    ALWAYS_INLINE void enter_call(u64 return_address, u64 parameters_byte_count)
+    {
+        stack().push_call_frame(Bytecode::JumpAddress(return_address), parameters_byte_count);
+        enter_register_window();
+    }
+
+    ALWAYS_INLINE void enter_call(u64 return_address, u64 parameters_byte_count, Bytecode::Register return_value_register)
+    {
+        stack().push_call_frame(Bytecode::JumpAddress(return_address), parameters_byte_count, return_value_register,
+                                CallFrameHeader::no_memoization_entry_index);
+        enter_register_window();
+    }
+
+    NODISCARD ALWAYS_INLINE AotReturn return_from_call()
+    {
+        MAYBE_UNUSED const CallFrameHeader call_frame_header = stack().pop_call_frame_unchecked();
+        --m_call_depth;
+        return { 0, AotReturnKind::Return };
+    }
+
+    NODISCARD ALWAYS_INLINE AotReturn return_value_from_call(u64 return_value)
+    {
+        const CallFrameHeader call_frame_header = stack().pop_call_frame_unchecked();
+        --m_call_depth;
+        return { return_value, call_frame_header.has_return_value_register ? AotReturnKind::ReturnValue : AotReturnKind::Return };
+    }
+
+    ALWAYS_INLINE void tail_call(u64 parameters_byte_count, bool discards_return_value)
+    {
+        stack().replace_call_frame_unchecked(parameters_byte_count, discards_return_value);
+    }
+
+    // Writes a register of the function that finishes the execution to the register window of the virtual machine.
+    ALWAYS_INLINE void store_register(u8 register_index, u64 value)
+    {
+        m_virtual_machine.register_storage(static_cast<Bytecode::Register>(register_index)).value = value;
+    }
+
+    NODISCARD ALWAYS_INLINE static AotReturn finish() { return { 0, AotReturnKind::Finish }; }
+
+private:
+    ALWAYS_INLINE void enter_register_window()
+    {
+        // NOTE: The registers live on the host stack, but the call depth is limited exactly like the register windows
+        //       of the interpreter limit it.
+        if (++m_call_depth >= m_virtual_machine.register_file().window_count())
+            TrapHandler::raise(Trap::CallDepthExceeded);
+    }
+
+private:
+    VirtualMachine& m_virtual_machine;
+    usize m_call_depth;
+    u64 m_arguments[static_cast<u8>(Bytecode::Register::Count)];
+};
+
+using AotFunction = AotReturn (*)(AotContext&, u8 argument_count);
+
+class AotRuntime {
+    ARC_MAKE_NAMESPACE_CLASS(AotRuntime)
+
+public:
+    // Executes the generated function of an entry point, which receives the registers of the current window as its
+    // arguments. Like the interpreter, the execution must start with an empty call stack. When the program is aborted
+    // by a trap an error describing the trap is returned, in which case the state of the virtual machine is unspecified.
+    NODISCARD static ErrorOr<void> execute(VirtualMachine&, AotFunction entry_point_function);
+};
+
+}
@@ -0,0 +1,625 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause.
+ */
+
+#include <bytecode/instruction.h>
+#include <bytecode/package.h>
+#include <core/containers/string_builder.h>
+#include <runtime/aot/cpp_translator.h>
+
+#include <cstdio>
+
+namespace Arc::Runtime {
+
+using namespace Arc::Bytecode;
+
+static constexpr usize no_function_index = 0xFFFFFFFFFFFFFFFF;
+static constexpr u8 register_count = static_cast<u8>(Register::Count);
+
+NODISCARD ALWAYS_INLINE static u8 register_index(Register reg)
+{
+    return static_cast<u8>(reg);
+}
+
+// Returns the statement that implements the binary register instruction, given the destination, left-hand side and
+// right-hand side registers as format parameters.
+NODISCARD static StringView binary_operation_format(OpCode opcode)
+{
+    switch (opcode) {
+        case OpCode::Add: return "    r{} = r{} + r{};\n"sv;
+        case OpCode::BitwiseAND: return "    r{} = IntegerArithmetic::bitwise_and(r{}, r{});\n"sv;
+        case OpCode::BitwiseLeftShift: return "    r{} = IntegerArithmetic::bitwise_left_shift(r{}, r{});\n"sv;
+        case OpCode::BitwiseOR: return "    r{} = IntegerArithmetic::bitwise_or(r{}, r{});\n"sv;
+        case OpCode::BitwiseRightShift: return "    r{} = IntegerArithmetic::bitwise_right_shift(r{}, r{});\n"sv;
+        case OpCode::BitwiseRightShiftSigned: return "    r{} = IntegerArithmetic::bitwise_right_shift_signed(r{}, r{});\n"sv;
+        case OpCode::BitwiseXOR: return "    r{} = IntegerArithmetic::bitwise_xor(r{}, r{});\n"sv;
+        case OpCode::CompareEqual: return "    r{} = IntegerArithmetic::compare_equal(r{}, r{});\n"sv;
+        case OpCode::CompareGreater: return "    r{} = IntegerArithmetic::compare_greater(r{}, r{});\n"sv;
+        case OpCode::CompareGreaterOrEqual: return "    r{} = IntegerArithmetic::compare_greater_or_equal(r{}, r{});\n"sv;
+        case OpCode::CompareGreaterOrEqualSigned: return "    r{} = IntegerArithmetic::compare_greater_or_equal_signed(r{}, r{});\n"sv;
+        case OpCode::CompareGreaterSigned: return "    r{} = IntegerArithmetic::compare_greater_signed(r{}, r{});\n"sv;
+        case OpCode::CompareLess: return "    r{} = IntegerArithmetic::compare_less(r{}, r{});\n"sv;
+        case OpCode::CompareLessOrEqual: return "    r{} = IntegerArithmetic::compare_less_or_equal(r{}, r{});\n"sv;
+        case OpCode::CompareLessOrEqualSigned: return "    r{} = IntegerArithmetic::compare_less_or_equal_signed(r{}, r{});\n"sv;
+        case OpCode::CompareLessSigned: return "    r{} = IntegerArithmetic::compare_less_signed(r{}, r{});\n"sv;
+        case OpCode::CompareNotEqual: return "    r{} = IntegerArithmetic::compare_not_equal(r{}, r{});\n"sv;
+        case OpCode::Divide: return "    r{} = IntegerArithmetic::divide(r{}, r{});\n"sv;
+        case OpCode::DivideSigned: return "    r{} = IntegerArithmetic::divide_signed(r{}, r{});\n"sv;
+        case OpCode::LogicalAND: return "    r{} = IntegerArithmetic::logical_and(r{}, r{});\n"sv;
+        case OpCode::LogicalOR: return "    r{} = IntegerArithmetic::logical_or(r{}, r{});\n"sv;
+        case OpCode::LogicalXOR: return "    r{} = IntegerArithmetic::logical_xor(r{}, r{});\n"sv;
+        case OpCode::Multiply: return "    r{} = IntegerArithmetic::multiply(r{}, r{});\n"sv;
+        case OpCode::Sub: return "    r{} = r{} - r{};\n"sv;
+        default: ARC_ASSERT_NOT_REACHED;
+    }
+}
+
+// Returns the statement that implements the unary register instruction, given the destination and source registers
+// as format parameters.
+NODISCARD static StringView unary_operation_format(OpCode opcode)
+{
+    switch (opcode) {
+        case OpCode::BitwiseNOT: return "    r{} = IntegerArithmetic::bitwise_not(r{});\n"sv;
+        case OpCode::LogicalNOT: return "    r{} = IntegerArithmetic::logical_not(r{});\n"sv;
+        case OpCode::Move: return "    r{} = r{};\n"sv;
+        case OpCode::Negate: return "    r{} = IntegerArithmetic::negate(r{});\n"sv;
+        case OpCode::SignExtend8: return "    r{} = IntegerArithmetic::sign_extend_8(r{});\n"sv;
+        case OpCode::SignExtend16: return "    r{} = IntegerArithmetic::sign_extend_16(r{});\n"sv;
+        case OpCode::SignExtend32: return "    r{} = IntegerArithmetic::sign_extend_32(r{});\n"sv;
+        default: ARC_ASSERT_NOT_REACHED;
+    }
+}
+
+// Returns the name of the C++ function that executes the entry point, where the characters of the entry point name
+// that can't appear in an identifier are replaced by underscores.
+NODISCARD static String entry_point_function_name(StringView entry_point_name)
+{
+    StringBuilder builder;
+    builder.append("arc_aot_"sv);
+    for (usize byte_offset = 0; byte_offset < entry_point_name.byte_count(); ++byte_offset) {
+        const char character = entry_point_name.characters()[byte_offset];
+        const bool is_identifier_character = (character >= 'a' && character <= 'z') || (character >= 'A' && character <= 'Z') ||
+                                             (character >= '0' && character <= '9') || character == '_';
+        builder.append_formatted(is_identifier_character ? character : '_');
+    }
+    return builder.release_string();
+}
+
+struct TranslatedFunction {
+    usize entry_instruction_pointer;
+    // The instructions that belong to the function, in ascending order.
+    Vector<usize> instruction_pointers;
+};
+
+class TranslationContext {
+public:
+    explicit TranslationContext(const Package& package)
+        : m_package(package)
+    {
+        m_function_indices.set_count(package.instruction_count(), no_function_index);
+        m_is_function_entry.set_count(package.instruction_count(), false);
+        m_is_jump_target.set_count(package.instruction_count(), false);
+    }
+
+    NODISCARD ErrorOr<String> translate();
+
+private:
+    // Partitions the instructions into functions, by walking the control flow from the entry points. The verifier
+    // guarantees that every reachable instruction belongs to exactly one function.
+    void discover_functions();
+    void discover_function(usize entry_instruction_pointer);
+    void schedule(usize instruction_pointer, usize function_index);
+    void schedule_jump(JumpAddress jump_address, usize function_index);
+
+    void emit_function(const TranslatedFunction& function);
+    void emit_instruction(usize instruction_pointer);
+    void emit_arguments(Register first_argument_register, u8 argument_count);
+    void emit_finish();
+
+private:
+    const Package& m_package;
+    StringBuilder m_builder;
+    Vector<usize> m_function_indices;
+    Vector<bool> m_is_function_entry;
+    Vector<bool> m_is_jump_target;
+    Vector<TranslatedFunction> m_functions;
+    Vector<usize> m_worklist;
+};
+
+void TranslationContext::discover_function(usize entry_instruction_pointer)
+{
+    if (m_is_function_entry[entry_instruction_pointer])
+        return;
+
+    m_is_function_entry[entry_instruction_pointer] = true;
+    m_functions.push_back({ entry_instruction_pointer, {} });
+    schedule(entry_instruction_pointer, m_functions.count() - 1);
+}
+
+void TranslationContext::schedule(usize instruction_pointer, usize function_index)
+{
+    // NOTE: Falling through the last instruction of the package is how execution finishes.
+    if (instruction_pointer >= m_package.instruction_count() || m_function_indices[instruction_pointer] != no_function_index)
+        return;
+
+    m_function_indices[instruction_pointer] = function_index;
+    m_worklist.push_back(instruction_pointer);
+}
+
+void TranslationContext::schedule_jump(JumpAddress jump_address, usize function_index)
+{
+    m_is_jump_target[jump_address.address()] = true;
+    schedule(jump_address.address(), function_index);
+}
+
+void TranslationContext::discover_functions()
+{
+    for (const Package::EntryPoint& entry_point : m_package.entry_points())
+        discover_function(entry_point.address.address());
+
+    while (m_worklist.has_elements()) {
+        const usize instruction_pointer = m_worklist.last();
+        m_worklist.pop_back();
+
+        const Instruction& instruction = m_package.fetch_instruction(instruction_pointer);
+        const usize function_index = m_function_indices[instruction_pointer];
+        switch (instruction.opcode()) {
+            case OpCode::Jump: schedule_jump(instruction.as<JumpInstruction>().jump_address(), function_index); break;
+
+            case OpCode::JumpIf:
+                schedule_jump(instruction.as<JumpIfInstruction>().jump_address(), function_index);
+                schedule(instruction_pointer + 1, function_index);
+                break;
+
+            case OpCode::FusedCompareGreaterJumpIf:
+                schedule_jump(instruction.as<FusedCompareGreaterJumpIfInstruction>().jump_address(), function_index);
+                schedule(instruction_pointer + 1, function_index);
+                break;
+
+            case OpCode::FusedCompareGreaterImmediateJumpIf:
+                schedule_jump(instruction.as<FusedCompareGreaterImmediateJumpIfInstruction>().jump_address(), function_index);
+                schedule(instruction_pointer + 1, function_index);
+                break;
+
+            case OpCode::JumpTable: {
+                const auto& typed_instruction = instruction.as<JumpTableInstruction>();
+                for (u32 entry_index = 0; entry_index < typed_instruction.entry_count(); ++entry_index)
+                    schedule_jump(m_package.fetch_jump_table_entry(typed_instruction.first_entry_index() + entry_index), function_index);
+                schedule_jump(typed_instruction.default_address(), function_index);
+                break;
+            }
+
+            case OpCode::Call:
+                discover_function(instruction.as<CallInstruction>().callee_address().address());
+                schedule(instruction_pointer + 1, function_index);
+                break;
+
+            case OpCode::CallWithArguments:
+                discover_function(instruction.as<CallWithArgumentsInstruction>().callee_address().address());
+                schedule(instruction_pointer + 1, function_index);
+                break;
+
+            case OpCode::TailCall:
+                discover_function(instruction.as<TailCallInstruction>().callee_address().address());
+                break;
+
+            case OpCode::TailCallWithArguments:
+                discover_function(instruction.as<TailCallWithArgumentsInstruction>().callee_address().address());
+                break;
+
+            case OpCode::Return:
+            case OpCode::ReturnValue: break;
+
+            default: schedule(instruction_pointer + 1, function_index); break;
+        }
+    }
+
+    for (usize instruction_pointer = 0; instruction_pointer < m_package.instruction_count(); ++instruction_pointer) {
+        const usize function_index = m_function_indices[instruction_pointer];
+        if (function_index != no_function_index)
+            m_functions[function_index].instruction_pointers.push_back(instruction_pointer);
+    }
+}
+
+ErrorOr<String> TranslationContext::translate()
+{
+    // NOTE: Different entry point names can map to the same function name, which would define that function twice.
+    Vector<String> entry_point_function_names;
+    for (const Package::EntryPoint& entry_point : m_package.entry_points()) {
+        String function_name = entry_point_function_name(entry_point.name);
+        for (const String& other_function_name : entry_point_function_names) {
+            if (StringView(function_name) == StringView(other_function_name)) {
+                return ARC_INTERNAL_ERROR_WITH_MESSAGE(
+                    StringBuilder::formatted("Multiple entry points are translated to the function '{}'"sv, function_name));
+            }
+        }
+        entry_point_function_names.push_back(move(function_name));
+    }
+
+    discover_functions();
+
+    m_builder.append("// Generated by `arc --aot` from a verified package. Do not edit.\n\n"sv);
+    m_builder.append("#include <runtime/aot/aot_runtime.h>\n\n"sv);
+    m_builder.append("using namespace Arc;\nusing namespace Arc::Runtime;\n\n"sv);
+
+    for (const TranslatedFunction& function : m_functions)
+        m_builder.append("static AotReturn arc_function_{}(AotContext& context, u8 argument_count);\n"sv,
+                         function.entry_instruction_pointer);
+    m_builder.append_newline();
+
+    for (const TranslatedFunction& function : m_functions)
+        emit_function(function);
+
+    for (usize entry_point_index = 0; entry_point_index < m_package.entry_points().count(); ++entry_point_index) {
+        const Package::EntryPoint& entry_point = m_package.entry_points()[entry_point_index];
+        m_builder.append("ErrorOr<void> {}(VirtualMachine& virtual_machine)\n"sv, entry_point_function_names[entry_point_index]);
+        m_builder.append("{\n"sv);
+        m_builder.append("    return AotRuntime::execute(virtual_machine, arc_function_{});\n"sv, entry_point.address.address());
+        m_builder.append("}\n\n"sv);
+    }
+
+    return m_builder.release_string();
+}
+
+void TranslationContext::emit_function(const TranslatedFunction& function)
+{
+    m_builder.append("static AotReturn arc_function_{}(AotContext& context, u8 argument_count)\n"sv, function.entry_instruction_pointer);
+    m_builder.append("{\n"sv);
+    for (u8 index = 0; index < register_count; ++index)
+        m_builder.append("    MAYBE_UNUSED u64 r{} = argument_count > {} ? context.argument({}) : 0;\n"sv, index, index, index);
+
+    // NOTE: The instructions are emitted in the order of the package, which doesn't always start with the entry.
+    if (function.instruction_pointers.first() != function.entry_instruction_pointer) {
+        m_is_jump_target[function.entry_instruction_pointer] = true;
+        m_builder.append("    goto instruction_{};\n"sv, function.entry_instruction_pointer);
+    }
+
+    for (const usize instruction_pointer : function.instruction_pointers) {
+        if (m_is_jump_target[instruction_pointer])
+            m_builder.append("instruction_{}:\n"sv, instruction_pointer);
+        emit_instruction(instruction_pointer);
+    }
+
+    m_builder.append("}\n\n"sv);
+}
+
+void TranslationContext::emit_arguments(Register first_argument_register, u8 argument_count)
+{
+    for (u8 argument_index = 0; argument_index < argument_count; ++argument_index)
+        m_builder.append("    context.argument({}) = r{};\n"sv, argument_index, register_index(first_argument_register) + argument_index);
+}
+
+void TranslationContext::emit_finish()
+{
+    // NOTE: The registers of the function that finishes the execution are the ones that the host observes.
+    for (u8 index = 0; index < register_count; ++index)
+        m_builder.append("    context.store_register({}, r{});\n"sv, index, index);
+    m_builder.append("    return AotContext::finish();\n"sv);
+}
+
+void TranslationContext::emit_instruction(usize instruction_pointer)
+{
+    const Instruction& instruction = m_package.fetch_instruction(instruction_pointer);
+    bool falls_through = true;
+
+    switch (instruction.opcode()) {
+#define _ARC_CASE(x) case OpCode::x:
+        ARC_ENUMERATE_BYTECODE_BINARY_REGISTER_OPCODES(_ARC_CASE)
+#undef _ARC_CASE
+        {
+            // NOTE: All three-register instructions share the same layout.
+            const auto& typed_instruction = static_cast<const AddInstruction&>(instruction);
+            m_builder.append(binary_operation_format(instruction.opcode()), register_index(typed_instruction.dst_register()),
+                             register_index(typed_instruction.lhs_register()), register_index(typed_instruction.rhs_register()));
+            break;
+        }
+
+#define _ARC_CASE(x) case OpCode::x:
+        ARC_ENUMERATE_BYTECODE_UNARY_REGISTER_OPCODES(_ARC_CASE)
+#undef _ARC_CASE
+        {
+            const auto& typed_instruction = static_cast<const MoveInstruction&>(instruction);
+            m_builder.append(unary_operation_format(instruction.opcode()), register_index(typed_instruction.dst_register()),
+                             register_index(typed_instruction.src_register()));
+            break;
+        }
+
+        case OpCode::AddImmediate:
+        case OpCode::CompareGreaterImmediate:
+        case OpCode::SubImmediate: {
+            // NOTE: All register-immediate arithmetic instructions share the same layout.
+            const auto& typed_instruction = static_cast<const AddImmediateInstruction&>(instruction);
+            StringView format = "    r{} = r{} + {}ULL;\n"sv;
+            if (instruction.opcode() == OpCode::CompareGreaterImmediate)
+                format = "    r{} = r{} > {}ULL;\n"sv;
+            else if (instruction.opcode() == OpCode::SubImmediate)
+                format = "    r{} = r{} - {}ULL;\n"sv;
+            m_builder.append(format, register_index(typed_instruction.dst_register()), register_index(typed_instruction.lhs_register()),
+                             typed_instruction.immediate_value());
+            break;
+        }
+
+        case OpCode::Decrement:
+            m_builder.append("    --r{};\n"sv, register_index(instruction.as<DecrementInstruction>().dst_register()));
+            break;
+        case OpCode::Increment:
+            m_builder.append("    ++r{};\n"sv, register_index(instruction.as<IncrementInstruction>().dst_register()));
+            break;
+
+        case OpCode::LoadImmediate8: {
+            const auto& typed_instruction = instruction.as<LoadImmediate8Instruction>();
+            m_builder.append("    r{} = {}ULL;\n"sv, register_index(typed_instruction.dst_register()), typed_instruction.immediate_value());
+            break;
+        }
+        case OpCode::LoadImmediate16: {
+            const auto& typed_instruction = instruction.as<LoadImmediate16Instruction>();
+            m_builder.append("    r{} = {}ULL;\n"sv, register_index(typed_instruction.dst_register()), typed_instruction.immediate_value());
+            break;
+        }
+        case OpCode::LoadImmediate32: {
+            const auto& typed_instruction = instruction.as<LoadImmediate32Instruction>();
+            m_builder.append("    r{} = {}ULL;\n"sv, register_index(typed_instruction.dst_register()), typed_instruction.immediate_value());
+            break;
+        }
+        case OpCode::LoadImmediate64: {
+            const auto& typed_instruction = instruction.as<LoadImmediate64Instruction>();
+            m_builder.append("    r{} = {}ULL;\n"sv, register_index(typed_instruction.dst_register()), typed_instruction.immediate_value());
+            break;
+        }
+
+        case OpCode::LoadFromFrame: {
+            const auto& typed_instruction = instruction.as<LoadFromFrameInstruction>();
+            m_builder.append("    r{} = context.stack().at_frame_offset_unchecked<u64>({});\n"sv,
+                             register_index(typed_instruction.dst_register()), typed_instruction.src_frame_offset());
+            break;
+        }
+
+        case OpCode::LoadFromStack:
+        case OpCode::Load8FromStack:
+        case OpCode::Load16FromStack:
+        case OpCode::Load32FromStack: {
+            // NOTE: All the stack load instructions share the same layout.
+            const auto& typed_instruction = static_cast<const LoadFromStackInstruction&>(instruction);
+            StringView format = "    r{} = context.stack().at_offset_unchecked<u64>({}ULL);\n"sv;
+            if (instruction.opcode() == OpCode::Load8FromStack)
+                format = "    r{} = context.stack().at_offset_unchecked<u8>({}ULL);\n"sv;
+            else if (instruction.opcode() == OpCode::Load16FromStack)
+                format = "    r{} = context.stack().at_offset_unchecked<u16>({}ULL);\n"sv;
+            else if (instruction.opcode() == OpCode::Load32FromStack)
+                format = "    r{} = context.stack().at_offset_unchecked<u32>({}ULL);\n"sv;
+            m_builder.append(format, register_index(typed_instruction.dst_register()), typed_instruction.src_stack_offset());
+            break;
+        }
+
+        case OpCode::StoreToFrame: {
+            const auto& typed_instruction = instruction.as<StoreToFrameInstruction>();
+            m_builder.append("    context.stack().at_frame_offset_unchecked<u64>({}) = r{};\n"sv, typed_instruction.dst_frame_offset(),
+                             register_index(typed_instruction.src_register()));
+            break;
+        }
+
+        case OpCode::StoreToStack:
+        case OpCode::Store8ToStack:
+        case OpCode::Store16ToStack:
+        case OpCode::Store32ToStack: {
+            // NOTE: All the stack store instructions share the same layout.
+            const auto& typed_instruction = static_cast<const StoreToStackInstruction&>(instruction);
+            StringView format = "    context.stack().at_offset_unchecked<u64>({}ULL) = r{};\n"sv;
+            if (instruction.opcode() == OpCode::Store8ToStack)
+                format = "    context.stack().at_offset_unchecked<u8>({}ULL) = static_cast<u8>(r{});\n"sv;
+            else if (instruction.opcode() == OpCode::Store16ToStack)
+                format = "    context.stack().at_offset_unchecked<u16>({}ULL) = static_cast<u16>(r{});\n"sv;
+            else if (instruction.opcode() == OpCode::Store32ToStack)
+                format = "    context.stack().at_offset_unchecked<u32>({}ULL) = static_cast<u32>(r{});\n"sv;
+            m_builder.append(format, typed_instruction.dst_stack_offset(), register_index(typed_instruction.src_register()));
+            break;
+        }
+
+        case OpCode::FusedLoadAddStore: {
+            const auto& typed_instruction = instruction.as<FusedLoadAddStoreInstruction>();
+            const u8 loaded_register = register_index(typed_instruction.loaded_register());
+            const u8 dst_register = register_index(typed_instruction.dst_register());
+            m_builder.append("    r{} = context.stack().at_offset_unchecked<u64>({}ULL);\n"sv, loaded_register,
+                             typed_instruction.src_stack_offset());
+            m_builder.append("    r{} = r{} + r{};\n"sv, dst_register, loaded_register, register_index(typed_instruction.other_register()));
+            m_builder.append("    context.stack().at_offset_unchecked<u64>({}ULL) = r{};\n"sv, typed_instruction.dst_stack_offset(),
+                             dst_register);
+            break;
+        }
+
+        case OpCode::FusedLoadIncrementStore: {
+            const auto& typed_instruction = instruction.as<FusedLoadIncrementStoreInstruction>();
+            const u8 dst_register = register_index(typed_instruction.dst_register());
+            m_builder.append("    r{} = context.stack().at_offset_unchecked<u64>({}ULL) + 1;\n"sv, dst_register,
+                             typed_instruction.stack_offset());
+            m_builder.append("    context.stack().at_offset_unchecked<u64>({}ULL) = r{};\n"sv, typed_instruction.stack_offset(),
+                             dst_register);
+            break;
+        }
+
+        case OpCode::FusedLoadPair: {
+            const auto& typed_instruction = instruction.as<FusedLoadPairInstruction>();
+            m_builder.append("    r{} = context.stack().at_offset_unchecked<u64>({}ULL);\n"sv,
+                             register_index(typed_instruction.first_dst_register()), typed_instruction.first_src_stack_offset());
+            m_builder.append("    r{} = context.stack().at_offset_unchecked<u64>({}ULL);\n"sv,
+                             register_index(typed_instruction.second_dst_register()), typed_instruction.second_src_stack_offset());
+            break;
+        }
+
+        case OpCode::FusedLoadStore: {
+            const auto& typed_instruction = instruction.as<FusedLoadStoreInstruction>();
+            const u8 dst_register = register_index(typed_instruction.dst_register());
+            m_builder.append("    r{} = context.stack().at_offset_unchecked<u64>({}ULL);\n"sv, dst_register,
+                             typed_instruction.src_stack_offset());
+            m_builder.append("    context.stack().at_offset_unchecked<u64>({}ULL) = r{};\n"sv, typed_instruction.dst_stack_offset(),
+                             dst_register);
+            break;
+        }
+
+        case OpCode::Jump:
+            m_builder.append("    goto instruction_{};\n"sv, instruction.as<JumpInstruction>().jump_address().address());
+            falls_through = false;
+            break;
+
+        case OpCode::JumpIf: {
+            const auto& typed_instruction = instruction.as<JumpIfInstruction>();
+            m_builder.append("    if (r{}) goto instruction_{};\n"sv, register_index(typed_instruction.condition_register()),
+                             typed_instruction.jump_address().address());
+            break;
+        }
+
+        case OpCode::FusedCompareGreaterJumpIf: {
+            const auto& typed_instruction = instruction.as<FusedCompareGreaterJumpIfInstruction>();
+            const u8 dst_register = register_index(typed_instruction.dst_register());
+            m_builder.append("    r{} = r{} > r{};\n"sv, dst_register, register_index(typed_instruction.lhs_register()),
+                             register_index(typed_instruction.rhs_register()));
+            m_builder.append("    if (r{}) goto instruction_{};\n"sv, dst_register, typed_instruction.jump_address().address());
+            break;
+        }
+
+        case OpCode::FusedCompareGreaterImmediateJumpIf: {
+            const auto& typed_instruction = instruction.as<FusedCompareGreaterImmediateJumpIfInstruction>();
+            const u8 dst_register = register_index(typed_instruction.dst_register());
+            m_builder.append("    r{} = r{} > {}ULL;\n"sv, dst_register, register_index(typed_instruction.lhs_register()),
+                             typed_instruction.immediate_value());
+            m_builder.append("    if (r{}) goto instruction_{};\n"sv, dst_register, typed_instruction.jump_address().address());
+            break;
+        }
+
+        case OpCode::JumpTable: {
+            const auto& typed_instruction = instruction.as<JumpTableInstruction>();
+            m_builder.append("    switch (r{}) "sv, register_index(typed_instruction.index_register()));
+            m_builder.append("{\n"sv);
+            for (u32 entry_index = 0; entry_index < typed_instruction.entry_count(); ++entry_index) {
+                const JumpAddress target = m_package.fetch_jump_table_entry(typed_instruction.first_entry_index() + entry_index);
+                m_builder.append("        case {}: goto instruction_{};\n"sv, entry_index, target.address());
+            }
+            m_builder.append("        default: goto instruction_{};\n"sv, typed_instruction.default_address().address());
+            m_builder.append("    }\n"sv);
+            falls_through = false;
+            break;
+        }
+
+        case OpCode::Pop:
+            m_builder.append("    context.stack().pop_unchecked({}ULL);\n"sv, instruction.as<PopInstruction>().pop_byte_count());
+            break;
+        case OpCode::PopRegister: m_builder.append("    context.stack().pop_unchecked(sizeof(u64));\n"sv); break;
+
+        case OpCode::PureFunctionEntry:
+            // NOTE: Calls to pure functions are never memoized by the generated code.
+            break;
+
+        case OpCode::Push:
+            m_builder.append("    context.stack().push({}ULL);\n"sv, instruction.as<PushInstruction>().push_byte_count());
+            break;
+        case OpCode::PushImmediate8:
+            m_builder.append("    context.stack().push<u8>() = {};\n"sv, instruction.as<PushImmediate8Instruction>().immediate_value());
+            break;
+        case OpCode::PushImmediate16:
+            m_builder.append("    context.stack().push<u16>() = {};\n"sv, instruction.as<PushImmediate16Instruction>().immediate_value());
+            break;
+        case OpCode::PushImmediate32:
+            m_builder.append("    context.stack().push<u32>() = {}U;\n"sv, instruction.as<PushImmediate32Instruction>().immediate_value());
+            break;
+        case OpCode::PushImmediate64:
+            m_builder.append("    context.stack().push<u64>() = {}ULL;\n"sv,
+                             instruction.as<PushImmediate64Instruction>().immediate_value());
+            break;
+        case OpCode::PushRegister:
+            m_builder.append("    context.stack().push<u64>() = r{};\n"sv,
+                             register_index(instruction.as<PushRegisterInstruction>().src_register()));
+            break;
+
+        case OpCode::Call: {
+            const auto& typed_instruction = instruction.as<CallInstruction>();
+            // NOTE: Each call gets its own scope, so that the gotos never jump over the initialization of its result.
+            m_builder.append("    {\n"sv);
+            m_builder.append("    context.enter_call({}ULL, {}ULL);\n"sv, instruction_pointer + 1,
+                             typed_instruction.parameters_byte_count());
+            m_builder.append("    const AotReturn result = arc_function_{}(context, 0);\n"sv, typed_instruction.callee_address().address());
+            m_builder.append("    if (result.kind == AotReturnKind::Finish)\n        return result;\n"sv);
+            m_builder.append("    }\n"sv);
+            break;
+        }
+
+        case OpCode::CallWithArguments: {
+            const auto& typed_instruction = instruction.as<CallWithArgumentsInstruction>();
+            m_builder.append("    {\n"sv);
+            emit_arguments(typed_instruction.first_argument_register(), typed_instruction.argument_count());
+            m_builder.append("    context.enter_call({}ULL, {}ULL, static_cast<Bytecode::Register>({}));\n"sv, instruction_pointer + 1,
+                             typed_instruction.parameters_byte_count(), register_index(typed_instruction.return_value_register()));
+            m_builder.append("    const AotReturn result = arc_function_{}(context, {});\n"sv, typed_instruction.callee_address().address(),
+                             typed_instruction.argument_count());
+            m_builder.append("    if (result.kind == AotReturnKind::Finish)\n        return result;\n"sv);
+            m_builder.append("    if (result.kind == AotReturnKind::ReturnValue)\n        r{} = result.value;\n"sv,
+                             register_index(typed_instruction.return_value_register()));
+            m_builder.append("    }\n"sv);
+            break;
+        }
+
+        case OpCode::TailCall: {
+            const auto& typed_instruction = instruction.as<TailCallInstruction>();
+            m_builder.append("    context.tail_call({}ULL, true);\n"sv, typed_instruction.parameters_byte_count());
+            m_builder.append("    return arc_function_{}(context, 0);\n"sv, typed_instruction.callee_address().address());
+            falls_through = false;
+            break;
+        }
+
+        case OpCode::TailCallWithArguments: {
+            const auto& typed_instruction = instruction.as<TailCallWithArgumentsInstruction>();
+            emit_arguments(typed_instruction.first_argument_register(), typed_instruction.argument_count());
+            m_builder.append("    context.tail_call({}ULL, false);\n"sv, typed_instruction.parameters_byte_count());
+            m_builder.append("    return arc_function_{}(context, {});\n"sv, typed_instruction.callee_address().address(),
+                             typed_instruction.argument_count());
+            falls_through = false;
+            break;
+        }
+
+        case OpCode::Return:
+            m_builder.append("    return context.return_from_call();\n"sv);
+            falls_through = false;
+            break;
+
+        case OpCode::ReturnValue:
+            m_builder.append("    return context.return_value_from_call(r{});\n"sv,
+                             register_index(instruction.as<ReturnValueInstruction>().src_register()));
+            falls_through = false;
+            break;
+
+        default: ARC_ASSERT_NOT_REACHED;
+    }
+
+    // NOTE: The next instruction of the function is always emitted right after this one, except when this is the last
+    //       instruction of the package.
+    if (falls_through && instruction_pointer + 1 == m_package.instruction_count())
+        emit_finish();
+}
+
+ErrorOr<String> CppTranslator::translate(const Package& package)
+{
+    if (!package.is_verified())
+        return ARC_INTERNAL_ERROR_WITH_MESSAGE("Only verified packages can be translated to C++"sv);
+
+    TranslationContext context(package);
+    return context.translate();
+}
+
+ErrorOr<void> CppTranslator::translate_to_file(const Package& package, StringView filepath)
+{
+    TRY_ASSIGN(const String source, translate(package));
+
+    const String null_terminated_filepath = String(filepath);
+    FILE* file_handle = fopen(null_terminated_filepath.characters(), "wb");
+    if (file_handle == nullptr)
+        return ARC_INTERNAL_ERROR_WITH_MESSAGE("Failed to open the C++ source file for writing"sv);
+
+    const usize written_byte_count = fwrite(source.characters(), 1, source.byte_count(), file_handle);
+    const bool closed_successfully = fclose(file_handle) == 0;
+    if (written_byte_count != source.byte_count() || !closed_successfully)
+        return ARC_INTERNAL_ERROR_WITH_MESSAGE("Failed to write the C++ source file"sv);
+
+    return {};
+}
+
+}
@@ -0,0 +1,32 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause.
+ */
+
+#pragma once
+
+#include <bytecode/forward.h>
+#include <core/containers/string.h>
+#include <core/error.h>
+
+namespace Arc::Runtime {
+
+//
+// Translates a verified package ahead of time into a C++ source file, which is compiled by the system compiler and
+// linked against the `arc_aot_runtime` library. Every function of the package becomes a C++ function whose registers
+// are local variables and whose jumps are gotos, so no instruction is interpreted at run time.
+//
+// For every entry point the file defines `ErrorOr<void> arc_aot_<name>(Arc::Runtime::VirtualMachine&)`, where the
+// characters of the name that can't appear in an identifier are replaced by underscores. It executes the entry point
+// exactly like the interpreter does, except that calls to pure functions are never memoized. Packages with entry
+// points whose names only differ in those characters are rejected, as their functions would have the same name.
+//
+class CppTranslator {
+    ARC_MAKE_NAMESPACE_CLASS(CppTranslator)
+
+public:
+    NODISCARD static ErrorOr<String> translate(const Bytecode::Package&);
+    NODISCARD static ErrorOr<void> translate_to_file(const Bytecode::Package&, StringView filepath);
+};
+
+}
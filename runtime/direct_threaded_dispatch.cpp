@@ -0,0 +1,1004 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause.
+ */
+
+#include <bytecode/instruction.h>
+#include <bytecode/package.h>
+#include <runtime/integer_arithmetic.h>
+#include <runtime/interpreter.h>
+#include <runtime/interpreter_policy.h>
+
+// NOTE: The direct-threaded dispatch loop uses the "labels as values" extension when it is available, which allows
+//       each handler to jump straight to the next one. Define this macro to zero in order to force the portable
+//       switch-based fallback, which is useful when comparing the two implementations.
+#ifndef ARC_DIRECT_THREADED_COMPUTED_GOTO
+    #if ARC_COMPILER_CLANG || ARC_COMPILER_GCC
+        #define ARC_DIRECT_THREADED_COMPUTED_GOTO 1
+    #else
+        #define ARC_DIRECT_THREADED_COMPUTED_GOTO 0
+    #endif // ARC_COMPILER_CLANG || ARC_COMPILER_GCC
+#endif // ARC_DIRECT_THREADED_COMPUTED_GOTO
+
+namespace Arc::Runtime {
+
+using namespace Arc::Bytecode;
+
+#if ARC_DIRECT_THREADED_COMPUTED_GOTO
+    #if ARC_COMPILER_CLANG
+        // Temporarily disables the following compiler warning:
+        // warning: use of GNU address-of-label extension [-Wgnu-label-as-value]
+        #pragma clang diagnostic push
+        #pragma clang diagnostic ignored "-Wgnu-label-as-value"
+    #endif // ARC_COMPILER_CLANG
+    #if ARC_COMPILER_GCC
+        // Temporarily disables the following compiler warning:
+        // warning: taking the address of a label is non-standard [-Wpedantic]
+        #pragma GCC diagnostic push
+        #pragma GCC diagnostic ignored "-Wpedantic"
+    #endif // ARC_COMPILER_GCC
+#endif // ARC_DIRECT_THREADED_COMPUTED_GOTO
+
+//
+// The registers of the current window and the stack and frame pointers, kept in local variables of the dispatch loop.
+// As their address never escapes, the compiler doesn't have to assume that the stack accesses alias them and can keep
+// them in host registers. The state is spilled back to the virtual machine before anything else accesses it.
+//
+class CachedMachineState {
+public:
+    ALWAYS_INLINE void load(VirtualMachine& vm)
+    {
+        const VirtualMachine::RegisterStorage* window = vm.register_file().window();
+        for (usize register_index = 0; register_index < VirtualRegisterFile::window_register_count; ++register_index)
+            m_registers[register_index] = window[register_index].value;
+        m_stack_pointer = vm.stack().stack_pointer_address();
+        m_frame_pointer = vm.stack().frame_pointer_address();
+    }
+
+    ALWAYS_INLINE void spill(VirtualMachine& vm)
+    {
+        VirtualMachine::RegisterStorage* window = vm.register_file().window();
+        for (usize register_index = 0; register_index < VirtualRegisterFile::window_register_count; ++register_index)
+            window[register_index].value = m_registers[register_index];
+        spill_stack_pointer(vm.stack());
+    }
+
+    // NOTE: Only the stack pointer has to be spilled when the registers of the current window are discarded.
+    ALWAYS_INLINE void spill_stack_pointer(VirtualStack& stack) { stack.set_stack_pointer_address_unchecked(m_stack_pointer); }
+
+    NODISCARD ALWAYS_INLINE u64& register_value(Register reg) { return m_registers[static_cast<u8>(reg)]; }
+
+    template<typename T>
+    NODISCARD ALWAYS_INLINE T& at_offset(usize offset)
+    {
+        return *reinterpret_cast<T*>(m_stack_pointer + offset);
+    }
+
+    template<typename T>
+    NODISCARD ALWAYS_INLINE T& at_frame_offset(s64 frame_offset)
+    {
+        return *reinterpret_cast<T*>(m_frame_pointer + frame_offset);
+    }
+
+    template<typename T>
+    NODISCARD ALWAYS_INLINE T& push(VirtualStack& stack)
+    {
+        if constexpr (VirtualStack::push_faults_on_overflow<T>) {
+            m_stack_pointer -= sizeof(T);
+            return *reinterpret_cast<T*>(m_stack_pointer);
+        }
+        else {
+            return *reinterpret_cast<T*>(push(stack, sizeof(T)));
+        }
+    }
+
+    ALWAYS_INLINE ReadWriteBytes push(VirtualStack& stack, usize push_byte_count)
+    {
+        // NOTE: The remaining space is only known by the stack itself.
+        spill_stack_pointer(stack);
+        const ReadWriteBytes bytes = stack.push(push_byte_count);
+        m_stack_pointer = stack.stack_pointer_address();
+        return bytes;
+    }
+
+    ALWAYS_INLINE void pop(usize pop_byte_count)
+    {
+        zero_memory(m_stack_pointer, pop_byte_count);
+        m_stack_pointer += pop_byte_count;
+    }
+
+private:
+    u64 m_registers[VirtualRegisterFile::window_register_count];
+    ReadWriteBytes m_stack_pointer;
+    ReadWriteBytes m_frame_pointer;
+};
+
+template<typename Policy>
+void Interpreter::execute_direct_threaded(Policy& policy)
+{
+    static constexpr bool is_checked = Policy::is_checked;
+    static constexpr bool caches_registers = Policy::caches_registers;
+    static_assert(!is_checked || !caches_registers, "Only verified packages can be executed with cached registers");
+    static_assert(!caches_registers || (!Policy::has_instruction_hooks && !Policy::has_call_hooks),
+                  "The hooks can't observe the cached registers");
+
+    const InstructionRecord* const instructions = m_package.instruction_records();
+    const usize instruction_count = m_package.instruction_count();
+    const JumpAddress* const jump_table_entries = m_package.jump_table_entries();
+    usize instruction_pointer = m_instruction_pointer;
+
+    VirtualMachine& vm = m_virtual_machine;
+    VirtualStack& stack = vm.stack();
+
+    MAYBE_UNUSED CachedMachineState cached_state;
+    if constexpr (caches_registers)
+        cached_state.load(vm);
+
+#define ARC_FETCH_INSTRUCTION(x)       static_cast<const x##Instruction&>(instructions[instruction_pointer].instruction())
+#define ARC_REGISTER(reg)                                                                                 \
+    (caches_registers ? cached_state.register_value(reg)                                                   \
+                     : (is_checked ? vm.register_storage(reg) : vm.register_storage_unchecked(reg)).value)
+#define ARC_STACK_AT_OFFSET(T, offset)                                                                  \
+    (caches_registers ? cached_state.at_offset<T>(offset)                                                \
+                     : (is_checked ? stack.at_offset<T>(offset) : stack.at_offset_unchecked<T>(offset)))
+#define ARC_STACK_AT_FRAME_OFFSET(T, frame_offset)                                                                              \
+    (caches_registers ? cached_state.at_frame_offset<T>(frame_offset)                                                            \
+                     : (is_checked ? stack.at_frame_offset<T>(frame_offset) : stack.at_frame_offset_unchecked<T>(frame_offset)))
+#define ARC_STACK_PUSH(T) (caches_registers ? cached_state.push<T>(stack) : stack.push<T>())
+#define ARC_STACK_POP(byte_count)       \
+    if constexpr (caches_registers)      \
+        cached_state.pop(byte_count);   \
+    else if constexpr (is_checked)       \
+        stack.pop(byte_count);          \
+    else                                \
+        stack.pop_unchecked(byte_count)
+// NOTE: Everything that accesses the virtual machine outside of the dispatch loop observes the spilled state, so it
+//       must be spilled before and loaded again after calling into it.
+#define ARC_SPILL_CACHED_STATE()   \
+    if constexpr (caches_registers) \
+        cached_state.spill(vm)
+#define ARC_LOAD_CACHED_STATE()    \
+    if constexpr (caches_registers) \
+        cached_state.load(vm)
+#define ARC_BEFORE_INSTRUCTION()                  \
+    if constexpr (Policy::has_instruction_hooks) \
+        policy.before_instruction(*this, instruction_pointer)
+#define ARC_AFTER_INSTRUCTION()                   \
+    if constexpr (Policy::has_instruction_hooks) \
+        policy.after_instruction(*this, instruction_pointer)
+#define ARC_ON_CALL(callee_address)         \
+    if constexpr (Policy::has_call_hooks) \
+        policy.on_call(*this, callee_address)
+#define ARC_ON_RETURN(return_address)       \
+    if constexpr (Policy::has_call_hooks) \
+        policy.on_return(*this, return_address)
+// NOTE: The fuel is consumed after the control flow instruction completed, so a suspended execution resumes at its
+//       target with the same state as if it had never been suspended.
+#define ARC_CONSUME_FUEL()                 \
+    if constexpr (Policy::consumes_fuel) { \
+        if (!policy.consume_fuel()) {      \
+            ARC_SUSPEND_DISPATCH();        \
+        }                                  \
+    }
+#define ARC_JUMP(target_address)                                          \
+    {                                                                     \
+        const usize jump_target = target_address;                         \
+        const bool is_backward_jump = jump_target <= instruction_pointer; \
+        instruction_pointer = jump_target;                                \
+        if (is_backward_jump) {                                           \
+            ARC_CONSUME_FUEL();                                           \
+        }                                                                 \
+    }
+
+    // NOTE: Pushes always validate that the stack doesn't overflow, even for verified packages, as the maximum
+    //       stack depth of a recursive program can't be determined statically.
+
+#if ARC_DIRECT_THREADED_COMPUTED_GOTO
+    static const void* const dispatch_table[] = {
+    #define _ARC_DISPATCH_TABLE_ENTRY(x) &&handle_##x,
+        ARC_ENUMERATE_BYTECODE_OPCODES(_ARC_DISPATCH_TABLE_ENTRY)
+    #undef _ARC_DISPATCH_TABLE_ENTRY
+    };
+    static_assert(sizeof(dispatch_table) / sizeof(dispatch_table[0]) == static_cast<usize>(OpCode::Count));
+
+    #define ARC_HANDLER(x) handle_##x:
+    #define ARC_DISPATCH_NEXT()                                                                   \
+        if (instruction_pointer >= instruction_count)                                             \
+            goto dispatch_finished;                                                               \
+        ARC_BEFORE_INSTRUCTION();                                                                 \
+        goto* dispatch_table[static_cast<u8>(instructions[instruction_pointer].opcode())]
+    #define ARC_DISPATCH()       \
+        ARC_AFTER_INSTRUCTION(); \
+        ARC_DISPATCH_NEXT()
+    #define ARC_SUSPEND_DISPATCH() goto dispatch_finished
+
+    ARC_DISPATCH_NEXT();
+#else
+    #define ARC_HANDLER(x) case OpCode::x:
+    #define ARC_DISPATCH()       \
+        ARC_AFTER_INSTRUCTION(); \
+        continue
+    #define ARC_SUSPEND_DISPATCH()    \
+        is_dispatch_suspended = true; \
+        continue
+
+    MAYBE_UNUSED bool is_dispatch_suspended = false;
+    while (instruction_pointer < instruction_count && !is_dispatch_suspended) {
+        ARC_BEFORE_INSTRUCTION();
+        switch (instructions[instruction_pointer].opcode()) {
+#endif // ARC_DIRECT_THREADED_COMPUTED_GOTO
+
+    ARC_HANDLER(Add)
+    {
+        const auto& instruction = ARC_FETCH_INSTRUCTION(Add);
+        ARC_REGISTER(instruction.dst_register()) = ARC_REGISTER(instruction.lhs_register()) + ARC_REGISTER(instruction.rhs_register());
+        ++instruction_pointer;
+        ARC_DISPATCH();
+    }
+
+    ARC_HANDLER(AddImmediate)
+    {
+        const auto& instruction = ARC_FETCH_INSTRUCTION(AddImmediate);
+        ARC_REGISTER(instruction.dst_register()) = ARC_REGISTER(instruction.lhs_register()) + instruction.immediate_value();
+        ++instruction_pointer;
+        ARC_DISPATCH();
+    }
+
+    ARC_HANDLER(BitwiseAND)
+    {
+        const auto& instruction = ARC_FETCH_INSTRUCTION(BitwiseAND);
+        const u64 lhs = ARC_REGISTER(instruction.lhs_register());
+        const u64 rhs = ARC_REGISTER(instruction.rhs_register());
+        ARC_REGISTER(instruction.dst_register()) = IntegerArithmetic::bitwise_and(lhs, rhs);
+        ++instruction_pointer;
+        ARC_DISPATCH();
+    }
+
+    ARC_HANDLER(BitwiseLeftShift)
+    {
+        const auto& instruction = ARC_FETCH_INSTRUCTION(BitwiseLeftShift);
+        const u64 lhs = ARC_REGISTER(instruction.lhs_register());
+        const u64 rhs = ARC_REGISTER(instruction.rhs_register());
+        ARC_REGISTER(instruction.dst_register()) = IntegerArithmetic::bitwise_left_shift(lhs, rhs);
+        ++instruction_pointer;
+        ARC_DISPATCH();
+    }
+
+    ARC_HANDLER(BitwiseNOT)
+    {
+        const auto& instruction = ARC_FETCH_INSTRUCTION(BitwiseNOT);
+        ARC_REGISTER(instruction.dst_register()) = IntegerArithmetic::bitwise_not(ARC_REGISTER(instruction.src_register()));
+        ++instruction_pointer;
+        ARC_DISPATCH();
+    }
+
+    ARC_HANDLER(BitwiseOR)
+    {
+        const auto& instruction = ARC_FETCH_INSTRUCTION(BitwiseOR);
+        const u64 lhs = ARC_REGISTER(instruction.lhs_register());
+        const u64 rhs = ARC_REGISTER(instruction.rhs_register());
+        ARC_REGISTER(instruction.dst_register()) = IntegerArithmetic::bitwise_or(lhs, rhs);
+        ++instruction_pointer;
+        ARC_DISPATCH();
+    }
+
+    ARC_HANDLER(BitwiseRightShift)
+    {
+        const auto& instruction = ARC_FETCH_INSTRUCTION(BitwiseRightShift);
+        const u64 lhs = ARC_REGISTER(instruction.lhs_register());
+        const u64 rhs = ARC_REGISTER(instruction.rhs_register());
+        ARC_REGISTER(instruction.dst_register()) = IntegerArithmetic::bitwise_right_shift(lhs, rhs);
+        ++instruction_pointer;
+        ARC_DISPATCH();
+    }
+
+    ARC_HANDLER(BitwiseRightShiftSigned)
+    {
+        const auto& instruction = ARC_FETCH_INSTRUCTION(BitwiseRightShiftSigned);
+        const u64 lhs = ARC_REGISTER(instruction.lhs_register());
+        const u64 rhs = ARC_REGISTER(instruction.rhs_register());
+        ARC_REGISTER(instruction.dst_register()) = IntegerArithmetic::bitwise_right_shift_signed(lhs, rhs);
+        ++instruction_pointer;
+        ARC_DISPATCH();
+    }
+
+    ARC_HANDLER(BitwiseXOR)
+    {
+        const auto& instruction = ARC_FETCH_INSTRUCTION(BitwiseXOR);
+        const u64 lhs = ARC_REGISTER(instruction.lhs_register());
+        const u64 rhs = ARC_REGISTER(instruction.rhs_register());
+        ARC_REGISTER(instruction.dst_register()) = IntegerArithmetic::bitwise_xor(lhs, rhs);
+        ++instruction_pointer;
+        ARC_DISPATCH();
+    }
+
+    ARC_HANDLER(Call)
+    {
+        const auto& instruction = ARC_FETCH_INSTRUCTION(Call);
+        const JumpAddress return_address = JumpAddress(instruction_pointer + 1);
+        ARC_SPILL_CACHED_STATE();
+        stack.push_call_frame(return_address, instruction.parameters_byte_count());
+        // NOTE: The window depth can't be proven by the verifier, so the overflow check is always performed.
+        vm.register_file().push_window();
+        ARC_LOAD_CACHED_STATE();
+        instruction_pointer = instruction.callee_address().address();
+        ARC_ON_CALL(instruction_pointer);
+        ARC_CONSUME_FUEL();
+        ARC_DISPATCH();
+    }
+
+    ARC_HANDLER(CallWithArguments)
+    {
+        const auto& instruction = ARC_FETCH_INSTRUCTION(CallWithArguments);
+        u32 memoization_entry_index = CallFrameHeader::no_memoization_entry_index;
+        ARC_SPILL_CACHED_STATE();
+        if (vm.memoization_cache().is_enabled() &&
+            try_resolve_memoized_call(instruction.callee_address(), instruction.first_argument_register(), instruction.argument_count(),
+                                      instruction.return_value_register(), instruction.parameters_byte_count(),
+                                      memoization_entry_index)) {
+            ARC_LOAD_CACHED_STATE();
+            ++instruction_pointer;
+            ARC_DISPATCH();
+        }
+
+        const JumpAddress return_address = JumpAddress(instruction_pointer + 1);
+        stack.push_call_frame(return_address, instruction.parameters_byte_count(), instruction.return_value_register(),
+                              memoization_entry_index);
+        vm.register_file().push_window_with_arguments(instruction.first_argument_register(), instruction.argument_count());
+        ARC_LOAD_CACHED_STATE();
+        instruction_pointer = instruction.callee_address().address();
+        ARC_ON_CALL(instruction_pointer);
+        ARC_CONSUME_FUEL();
+        ARC_DISPATCH();
+    }
+
+    ARC_HANDLER(CompareEqual)
+    {
+        const auto& instruction = ARC_FETCH_INSTRUCTION(CompareEqual);
+        const u64 lhs = ARC_REGISTER(instruction.lhs_register());
+        const u64 rhs = ARC_REGISTER(instruction.rhs_register());
+        ARC_REGISTER(instruction.dst_register()) = IntegerArithmetic::compare_equal(lhs, rhs);
+        ++instruction_pointer;
+        ARC_DISPATCH();
+    }
+
+    ARC_HANDLER(CompareGreater)
+    {
+        const auto& instruction = ARC_FETCH_INSTRUCTION(CompareGreater);
+        ARC_REGISTER(instruction.dst_register()) = ARC_REGISTER(instruction.lhs_register()) > ARC_REGISTER(instruction.rhs_register());
+        ++instruction_pointer;
+        ARC_DISPATCH();
+    }
+
+    ARC_HANDLER(CompareGreaterImmediate)
+    {
+        const auto& instruction = ARC_FETCH_INSTRUCTION(CompareGreaterImmediate);
+        ARC_REGISTER(instruction.dst_register()) = ARC_REGISTER(instruction.lhs_register()) > instruction.immediate_value();
+        ++instruction_pointer;
+        ARC_DISPATCH();
+    }
+
+    ARC_HANDLER(CompareGreaterOrEqual)
+    {
+        const auto& instruction = ARC_FETCH_INSTRUCTION(CompareGreaterOrEqual);
+        const u64 lhs = ARC_REGISTER(instruction.lhs_register());
+        const u64 rhs = ARC_REGISTER(instruction.rhs_register());
+        ARC_REGISTER(instruction.dst_register()) = IntegerArithmetic::compare_greater_or_equal(lhs, rhs);
+        ++instruction_pointer;
+        ARC_DISPATCH();
+    }
+
+    ARC_HANDLER(CompareGreaterOrEqualSigned)
+    {
+        const auto& instruction = ARC_FETCH_INSTRUCTION(CompareGreaterOrEqualSigned);
+        const u64 lhs = ARC_REGISTER(instruction.lhs_register());
+        const u64 rhs = ARC_REGISTER(instruction.rhs_register());
+        ARC_REGISTER(instruction.dst_register()) = IntegerArithmetic::compare_greater_or_equal_signed(lhs, rhs);
+        ++instruction_pointer;
+        ARC_DISPATCH();
+    }
+
+    ARC_HANDLER(CompareGreaterSigned)
+    {
+        const auto& instruction = ARC_FETCH_INSTRUCTION(CompareGreaterSigned);
+        const u64 lhs = ARC_REGISTER(instruction.lhs_register());
+        const u64 rhs = ARC_REGISTER(instruction.rhs_register());
+        ARC_REGISTER(instruction.dst_register()) = IntegerArithmetic::compare_greater_signed(lhs, rhs);
+        ++instruction_pointer;
+        ARC_DISPATCH();
+    }
+
+    ARC_HANDLER(CompareLess)
+    {
+        const auto& instruction = ARC_FETCH_INSTRUCTION(CompareLess);
+        const u64 lhs = ARC_REGISTER(instruction.lhs_register());
+        const u64 rhs = ARC_REGISTER(instruction.rhs_register());
+        ARC_REGISTER(instruction.dst_register()) = IntegerArithmetic::compare_less(lhs, rhs);
+        ++instruction_pointer;
+        ARC_DISPATCH();
+    }
+
+    ARC_HANDLER(CompareLessOrEqual)
+    {
+        const auto& instruction = ARC_FETCH_INSTRUCTION(CompareLessOrEqual);
+        const u64 lhs = ARC_REGISTER(instruction.lhs_register());
+        const u64 rhs = ARC_REGISTER(instruction.rhs_register());
+        ARC_REGISTER(instruction.dst_register()) = IntegerArithmetic::compare_less_or_equal(lhs, rhs);
+        ++instruction_pointer;
+        ARC_DISPATCH();
+    }
+
+    ARC_HANDLER(CompareLessOrEqualSigned)
+    {
+        const auto& instruction = ARC_FETCH_INSTRUCTION(CompareLessOrEqualSigned);
+        const u64 lhs = ARC_REGISTER(instruction.lhs_register());
+        const u64 rhs = ARC_REGISTER(instruction.rhs_register());
+        ARC_REGISTER(instruction.dst_register()) = IntegerArithmetic::compare_less_or_equal_signed(lhs, rhs);
+        ++instruction_pointer;
+        ARC_DISPATCH();
+    }
+
+    ARC_HANDLER(CompareLessSigned)
+    {
+        const auto& instruction = ARC_FETCH_INSTRUCTION(CompareLessSigned);
+        const u64 lhs = ARC_REGISTER(instruction.lhs_register());
+        const u64 rhs = ARC_REGISTER(instruction.rhs_register());
+        ARC_REGISTER(instruction.dst_register()) = IntegerArithmetic::compare_less_signed(lhs, rhs);
+        ++instruction_pointer;
+        ARC_DISPATCH();
+    }
+
+    ARC_HANDLER(CompareNotEqual)
+    {
+        const auto& instruction = ARC_FETCH_INSTRUCTION(CompareNotEqual);
+        const u64 lhs = ARC_REGISTER(instruction.lhs_register());
+        const u64 rhs = ARC_REGISTER(instruction.rhs_register());
+        ARC_REGISTER(instruction.dst_register()) = IntegerArithmetic::compare_not_equal(lhs, rhs);
+        ++instruction_pointer;
+        ARC_DISPATCH();
+    }
+
+    ARC_HANDLER(Decrement)
+    {
+        const auto& instruction = ARC_FETCH_INSTRUCTION(Decrement);
+        --ARC_REGISTER(instruction.dst_register());
+        ++instruction_pointer;
+        ARC_DISPATCH();
+    }
+
+    ARC_HANDLER(Divide)
+    {
+        const auto& instruction = ARC_FETCH_INSTRUCTION(Divide);
+        const u64 lhs = ARC_REGISTER(instruction.lhs_register());
+        const u64 rhs = ARC_REGISTER(instruction.rhs_register());
+        ARC_REGISTER(instruction.dst_register()) = IntegerArithmetic::divide(lhs, rhs);
+        ++instruction_pointer;
+        ARC_DISPATCH();
+    }
+
+    ARC_HANDLER(DivideSigned)
+    {
+        const auto& instruction = ARC_FETCH_INSTRUCTION(DivideSigned);
+        const u64 lhs = ARC_REGISTER(instruction.lhs_register());
+        const u64 rhs = ARC_REGISTER(instruction.rhs_register());
+        ARC_REGISTER(instruction.dst_register()) = IntegerArithmetic::divide_signed(lhs, rhs);
+        ++instruction_pointer;
+        ARC_DISPATCH();
+    }
+
+    ARC_HANDLER(FusedCompareGreaterJumpIf)
+    {
+        const auto& instruction = ARC_FETCH_INSTRUCTION(FusedCompareGreaterJumpIf);
+        const u64 condition = ARC_REGISTER(instruction.lhs_register()) > ARC_REGISTER(instruction.rhs_register());
+        ARC_REGISTER(instruction.dst_register()) = condition;
+        if (condition) {
+            ARC_JUMP(instruction.jump_address().address());
+        }
+        else {
+            ++instruction_pointer;
+        }
+        ARC_DISPATCH();
+    }
+
+    ARC_HANDLER(FusedCompareGreaterImmediateJumpIf)
+    {
+        const auto& instruction = ARC_FETCH_INSTRUCTION(FusedCompareGreaterImmediateJumpIf);
+        const u64 condition = ARC_REGISTER(instruction.lhs_register()) > instruction.immediate_value();
+        ARC_REGISTER(instruction.dst_register()) = condition;
+        if (condition) {
+            ARC_JUMP(instruction.jump_address().address());
+        }
+        else {
+            ++instruction_pointer;
+        }
+        ARC_DISPATCH();
+    }
+
+    ARC_HANDLER(FusedLoadAddStore)
+    {
+        const auto& instruction = ARC_FETCH_INSTRUCTION(FusedLoadAddStore);
+        ARC_REGISTER(instruction.loaded_register()) = ARC_STACK_AT_OFFSET(u64, instruction.src_stack_offset());
+        const u64 result = ARC_REGISTER(instruction.loaded_register()) + ARC_REGISTER(instruction.other_register());
+        ARC_REGISTER(instruction.dst_register()) = result;
+        ARC_STACK_AT_OFFSET(u64, instruction.dst_stack_offset()) = result;
+        ++instruction_pointer;
+        ARC_DISPATCH();
+    }
+
+    ARC_HANDLER(FusedLoadIncrementStore)
+    {
+        const auto& instruction = ARC_FETCH_INSTRUCTION(FusedLoadIncrementStore);
+        u64& stack_value = ARC_STACK_AT_OFFSET(u64, instruction.stack_offset());
+        ARC_REGISTER(instruction.dst_register()) = ++stack_value;
+        ++instruction_pointer;
+        ARC_DISPATCH();
+    }
+
+    ARC_HANDLER(FusedLoadPair)
+    {
+        const auto& instruction = ARC_FETCH_INSTRUCTION(FusedLoadPair);
+        ARC_REGISTER(instruction.first_dst_register()) = ARC_STACK_AT_OFFSET(u64, instruction.first_src_stack_offset());
+        ARC_REGISTER(instruction.second_dst_register()) = ARC_STACK_AT_OFFSET(u64, instruction.second_src_stack_offset());
+        ++instruction_pointer;
+        ARC_DISPATCH();
+    }
+
+    ARC_HANDLER(FusedLoadStore)
+    {
+        const auto& instruction = ARC_FETCH_INSTRUCTION(FusedLoadStore);
+        const u64 value = ARC_STACK_AT_OFFSET(u64, instruction.src_stack_offset());
+        ARC_REGISTER(instruction.dst_register()) = value;
+        ARC_STACK_AT_OFFSET(u64, instruction.dst_stack_offset()) = value;
+        ++instruction_pointer;
+        ARC_DISPATCH();
+    }
+
+    ARC_HANDLER(Increment)
+    {
+        const auto& instruction = ARC_FETCH_INSTRUCTION(Increment);
+        ++ARC_REGISTER(instruction.dst_register());
+        ++instruction_pointer;
+        ARC_DISPATCH();
+    }
+
+    ARC_HANDLER(Jump)
+    {
+        const auto& instruction = ARC_FETCH_INSTRUCTION(Jump);
+        ARC_JUMP(instruction.jump_address().address());
+        ARC_DISPATCH();
+    }
+
+    ARC_HANDLER(JumpIf)
+    {
+        const auto& instruction = ARC_FETCH_INSTRUCTION(JumpIf);
+        if (ARC_REGISTER(instruction.condition_register())) {
+            ARC_JUMP(instruction.jump_address().address());
+        }
+        else {
+            ++instruction_pointer;
+        }
+        ARC_DISPATCH();
+    }
+
+    ARC_HANDLER(JumpTable)
+    {
+        const auto& instruction = ARC_FETCH_INSTRUCTION(JumpTable);
+        const u64 index = ARC_REGISTER(instruction.index_register());
+        if (index < instruction.entry_count()) {
+            const u64 entry_index = instruction.first_entry_index() + index;
+            ARC_JUMP((is_checked ? m_package.fetch_jump_table_entry(entry_index) : jump_table_entries[entry_index]).address());
+        }
+        else {
+            ARC_JUMP(instruction.default_address().address());
+        }
+        ARC_DISPATCH();
+    }
+
+    ARC_HANDLER(LoadFromFrame)
+    {
+        const auto& instruction = ARC_FETCH_INSTRUCTION(LoadFromFrame);
+        ARC_REGISTER(instruction.dst_register()) = ARC_STACK_AT_FRAME_OFFSET(u64, instruction.src_frame_offset());
+        ++instruction_pointer;
+        ARC_DISPATCH();
+    }
+
+    ARC_HANDLER(LoadFromStack)
+    {
+        const auto& instruction = ARC_FETCH_INSTRUCTION(LoadFromStack);
+        ARC_REGISTER(instruction.dst_register()) = ARC_STACK_AT_OFFSET(u64, instruction.src_stack_offset());
+        ++instruction_pointer;
+        ARC_DISPATCH();
+    }
+
+    ARC_HANDLER(Load8FromStack)
+    {
+        const auto& instruction = ARC_FETCH_INSTRUCTION(Load8FromStack);
+        ARC_REGISTER(instruction.dst_register()) = static_cast<u64>(ARC_STACK_AT_OFFSET(u8, instruction.src_stack_offset()));
+        ++instruction_pointer;
+        ARC_DISPATCH();
+    }
+
+    ARC_HANDLER(Load16FromStack)
+    {
+        const auto& instruction = ARC_FETCH_INSTRUCTION(Load16FromStack);
+        ARC_REGISTER(instruction.dst_register()) = static_cast<u64>(ARC_STACK_AT_OFFSET(u16, instruction.src_stack_offset()));
+        ++instruction_pointer;
+        ARC_DISPATCH();
+    }
+
+    ARC_HANDLER(Load32FromStack)
+    {
+        const auto& instruction = ARC_FETCH_INSTRUCTION(Load32FromStack);
+        ARC_REGISTER(instruction.dst_register()) = static_cast<u64>(ARC_STACK_AT_OFFSET(u32, instruction.src_stack_offset()));
+        ++instruction_pointer;
+        ARC_DISPATCH();
+    }
+
+    ARC_HANDLER(LoadImmediate8)
+    {
+        const auto& instruction = ARC_FETCH_INSTRUCTION(LoadImmediate8);
+        ARC_REGISTER(instruction.dst_register()) = static_cast<u64>(instruction.immediate_value());
+        ++instruction_pointer;
+        ARC_DISPATCH();
+    }
+
+    ARC_HANDLER(LoadImmediate16)
+    {
+        const auto& instruction = ARC_FETCH_INSTRUCTION(LoadImmediate16);
+        ARC_REGISTER(instruction.dst_register()) = static_cast<u64>(instruction.immediate_value());
+        ++instruction_pointer;
+        ARC_DISPATCH();
+    }
+
+    ARC_HANDLER(LoadImmediate32)
+    {
+        const auto& instruction = ARC_FETCH_INSTRUCTION(LoadImmediate32);
+        ARC_REGISTER(instruction.dst_register()) = static_cast<u64>(instruction.immediate_value());
+        ++instruction_pointer;
+        ARC_DISPATCH();
+    }
+
+    ARC_HANDLER(LoadImmediate64)
+    {
+        const auto& instruction = ARC_FETCH_INSTRUCTION(LoadImmediate64);
+        ARC_REGISTER(instruction.dst_register()) = static_cast<u64>(instruction.immediate_value());
+        ++instruction_pointer;
+        ARC_DISPATCH();
+    }
+
+    ARC_HANDLER(LogicalAND)
+    {
+        const auto& instruction = ARC_FETCH_INSTRUCTION(LogicalAND);
+        const u64 lhs = ARC_REGISTER(instruction.lhs_register());
+        const u64 rhs = ARC_REGISTER(instruction.rhs_register());
+        ARC_REGISTER(instruction.dst_register()) = IntegerArithmetic::logical_and(lhs, rhs);
+        ++instruction_pointer;
+        ARC_DISPATCH();
+    }
+
+    ARC_HANDLER(LogicalNOT)
+    {
+        const auto& instruction = ARC_FETCH_INSTRUCTION(LogicalNOT);
+        ARC_REGISTER(instruction.dst_register()) = IntegerArithmetic::logical_not(ARC_REGISTER(instruction.src_register()));
+        ++instruction_pointer;
+        ARC_DISPATCH();
+    }
+
+    ARC_HANDLER(LogicalOR)
+    {
+        const auto& instruction = ARC_FETCH_INSTRUCTION(LogicalOR);
+        const u64 lhs = ARC_REGISTER(instruction.lhs_register());
+        const u64 rhs = ARC_REGISTER(instruction.rhs_register());
+        ARC_REGISTER(instruction.dst_register()) = IntegerArithmetic::logical_or(lhs, rhs);
+        ++instruction_pointer;
+        ARC_DISPATCH();
+    }
+
+    ARC_HANDLER(LogicalXOR)
+    {
+        const auto& instruction = ARC_FETCH_INSTRUCTION(LogicalXOR);
+        const u64 lhs = ARC_REGISTER(instruction.lhs_register());
+        const u64 rhs = ARC_REGISTER(instruction.rhs_register());
+        ARC_REGISTER(instruction.dst_register()) = IntegerArithmetic::logical_xor(lhs, rhs);
+        ++instruction_pointer;
+        ARC_DISPATCH();
+    }
+
+    ARC_HANDLER(Move)
+    {
+        const auto& instruction = ARC_FETCH_INSTRUCTION(Move);
+        ARC_REGISTER(instruction.dst_register()) = ARC_REGISTER(instruction.src_register());
+        ++instruction_pointer;
+        ARC_DISPATCH();
+    }
+
+    ARC_HANDLER(Multiply)
+    {
+        const auto& instruction = ARC_FETCH_INSTRUCTION(Multiply);
+        const u64 lhs = ARC_REGISTER(instruction.lhs_register());
+        const u64 rhs = ARC_REGISTER(instruction.rhs_register());
+        ARC_REGISTER(instruction.dst_register()) = IntegerArithmetic::multiply(lhs, rhs);
+        ++instruction_pointer;
+        ARC_DISPATCH();
+    }
+
+    ARC_HANDLER(Negate)
+    {
+        const auto& instruction = ARC_FETCH_INSTRUCTION(Negate);
+        ARC_REGISTER(instruction.dst_register()) = IntegerArithmetic::negate(ARC_REGISTER(instruction.src_register()));
+        ++instruction_pointer;
+        ARC_DISPATCH();
+    }
+
+    ARC_HANDLER(Pop)
+    {
+        const auto& instruction = ARC_FETCH_INSTRUCTION(Pop);
+        ARC_STACK_POP(instruction.pop_byte_count());
+        ++instruction_pointer;
+        ARC_DISPATCH();
+    }
+
+    ARC_HANDLER(PopRegister)
+    {
+        ARC_STACK_POP(sizeof(VirtualMachine::RegisterStorage));
+        ++instruction_pointer;
+        ARC_DISPATCH();
+    }
+
+    ARC_HANDLER(PureFunctionEntry)
+    {
+        ++instruction_pointer;
+        ARC_DISPATCH();
+    }
+
+    ARC_HANDLER(Push)
+    {
+        const auto& instruction = ARC_FETCH_INSTRUCTION(Push);
+        MAYBE_UNUSED const ReadWriteBytes bytes =
+            caches_registers ? cached_state.push(stack, instruction.push_byte_count()) : stack.push(instruction.push_byte_count());
+        ++instruction_pointer;
+        ARC_DISPATCH();
+    }
+
+    ARC_HANDLER(PushImmediate8)
+    {
+        const auto& instruction = ARC_FETCH_INSTRUCTION(PushImmediate8);
+        ARC_STACK_PUSH(u8) = instruction.immediate_value();
+        ++instruction_pointer;
+        ARC_DISPATCH();
+    }
+
+    ARC_HANDLER(PushImmediate16)
+    {
+        const auto& instruction = ARC_FETCH_INSTRUCTION(PushImmediate16);
+        ARC_STACK_PUSH(u16) = instruction.immediate_value();
+        ++instruction_pointer;
+        ARC_DISPATCH();
+    }
+
+    ARC_HANDLER(PushImmediate32)
+    {
+        const auto& instruction = ARC_FETCH_INSTRUCTION(PushImmediate32);
+        ARC_STACK_PUSH(u32) = instruction.immediate_value();
+        ++instruction_pointer;
+        ARC_DISPATCH();
+    }
+
+    ARC_HANDLER(PushImmediate64)
+    {
+        const auto& instruction = ARC_FETCH_INSTRUCTION(PushImmediate64);
+        ARC_STACK_PUSH(u64) = instruction.immediate_value();
+        ++instruction_pointer;
+        ARC_DISPATCH();
+    }
+
+    ARC_HANDLER(PushRegister)
+    {
+        const auto& instruction = ARC_FETCH_INSTRUCTION(PushRegister);
+        ARC_STACK_PUSH(VirtualMachine::RegisterStorage).value = ARC_REGISTER(instruction.src_register());
+        ++instruction_pointer;
+        ARC_DISPATCH();
+    }
+
+    ARC_HANDLER(Return)
+    {
+        if constexpr (caches_registers)
+            cached_state.spill_stack_pointer(stack);
+        const CallFrameHeader last_call_frame = is_checked ? stack.pop_call_frame() : stack.pop_call_frame_unchecked();
+        if constexpr (is_checked)
+            vm.register_file().pop_window();
+        else
+            vm.register_file().pop_window_unchecked();
+        ARC_LOAD_CACHED_STATE();
+        if (last_call_frame.memoization_entry_index != CallFrameHeader::no_memoization_entry_index)
+            complete_memoized_call(last_call_frame, {});
+        instruction_pointer = last_call_frame.return_address;
+        ARC_ON_RETURN(instruction_pointer);
+        ARC_DISPATCH();
+    }
+
+    ARC_HANDLER(ReturnValue)
+    {
+        const auto& instruction = ARC_FETCH_INSTRUCTION(ReturnValue);
+        const u64 return_value = ARC_REGISTER(instruction.src_register());
+        if constexpr (caches_registers)
+            cached_state.spill_stack_pointer(stack);
+        const CallFrameHeader last_call_frame = is_checked ? stack.pop_call_frame() : stack.pop_call_frame_unchecked();
+        if constexpr (is_checked)
+            vm.register_file().pop_window();
+        else
+            vm.register_file().pop_window_unchecked();
+        ARC_LOAD_CACHED_STATE();
+        if (last_call_frame.has_return_value_register)
+            ARC_REGISTER(last_call_frame.return_value_register) = return_value;
+        if (last_call_frame.memoization_entry_index != CallFrameHeader::no_memoization_entry_index)
+            complete_memoized_call(last_call_frame, return_value);
+        instruction_pointer = last_call_frame.return_address;
+        ARC_ON_RETURN(instruction_pointer);
+        ARC_DISPATCH();
+    }
+
+    ARC_HANDLER(SignExtend8)
+    {
+        const auto& instruction = ARC_FETCH_INSTRUCTION(SignExtend8);
+        ARC_REGISTER(instruction.dst_register()) = IntegerArithmetic::sign_extend_8(ARC_REGISTER(instruction.src_register()));
+        ++instruction_pointer;
+        ARC_DISPATCH();
+    }
+
+    ARC_HANDLER(SignExtend16)
+    {
+        const auto& instruction = ARC_FETCH_INSTRUCTION(SignExtend16);
+        ARC_REGISTER(instruction.dst_register()) = IntegerArithmetic::sign_extend_16(ARC_REGISTER(instruction.src_register()));
+        ++instruction_pointer;
+        ARC_DISPATCH();
+    }
+
+    ARC_HANDLER(SignExtend32)
+    {
+        const auto& instruction = ARC_FETCH_INSTRUCTION(SignExtend32);
+        ARC_REGISTER(instruction.dst_register()) = IntegerArithmetic::sign_extend_32(ARC_REGISTER(instruction.src_register()));
+        ++instruction_pointer;
+        ARC_DISPATCH();
+    }
+
+    ARC_HANDLER(StoreToFrame)
+    {
+        const auto& instruction = ARC_FETCH_INSTRUCTION(StoreToFrame);
+        ARC_STACK_AT_FRAME_OFFSET(u64, instruction.dst_frame_offset()) = ARC_REGISTER(instruction.src_register());
+        ++instruction_pointer;
+        ARC_DISPATCH();
+    }
+
+    ARC_HANDLER(StoreToStack)
+    {
+        const auto& instruction = ARC_FETCH_INSTRUCTION(StoreToStack);
+        ARC_STACK_AT_OFFSET(u64, instruction.dst_stack_offset()) = ARC_REGISTER(instruction.src_register());
+        ++instruction_pointer;
+        ARC_DISPATCH();
+    }
+
+    ARC_HANDLER(Store8ToStack)
+    {
+        const auto& instruction = ARC_FETCH_INSTRUCTION(Store8ToStack);
+        ARC_STACK_AT_OFFSET(u8, instruction.dst_stack_offset()) = static_cast<u8>(ARC_REGISTER(instruction.src_register()));
+        ++instruction_pointer;
+        ARC_DISPATCH();
+    }
+
+    ARC_HANDLER(Store16ToStack)
+    {
+        const auto& instruction = ARC_FETCH_INSTRUCTION(Store16ToStack);
+        ARC_STACK_AT_OFFSET(u16, instruction.dst_stack_offset()) = static_cast<u16>(ARC_REGISTER(instruction.src_register()));
+        ++instruction_pointer;
+        ARC_DISPATCH();
+    }
+
+    ARC_HANDLER(Store32ToStack)
+    {
+        const auto& instruction = ARC_FETCH_INSTRUCTION(Store32ToStack);
+        ARC_STACK_AT_OFFSET(u32, instruction.dst_stack_offset()) = static_cast<u32>(ARC_REGISTER(instruction.src_register()));
+        ++instruction_pointer;
+        ARC_DISPATCH();
+    }
+
+    ARC_HANDLER(Sub)
+    {
+        const auto& instruction = ARC_FETCH_INSTRUCTION(Sub);
+        ARC_REGISTER(instruction.dst_register()) = ARC_REGISTER(instruction.lhs_register()) - ARC_REGISTER(instruction.rhs_register());
+        ++instruction_pointer;
+        ARC_DISPATCH();
+    }
+
+    ARC_HANDLER(SubImmediate)
+    {
+        const auto& instruction = ARC_FETCH_INSTRUCTION(SubImmediate);
+        ARC_REGISTER(instruction.dst_register()) = ARC_REGISTER(instruction.lhs_register()) - instruction.immediate_value();
+        ++instruction_pointer;
+        ARC_DISPATCH();
+    }
+
+    ARC_HANDLER(TailCall)
+    {
+        const auto& instruction = ARC_FETCH_INSTRUCTION(TailCall);
+        ARC_SPILL_CACHED_STATE();
+        if constexpr (is_checked)
+            stack.replace_call_frame(instruction.parameters_byte_count(), true);
+        else
+            stack.replace_call_frame_unchecked(instruction.parameters_byte_count(), true);
+        vm.register_file().replace_window_with_arguments(Register::GPR0, 0);
+        ARC_LOAD_CACHED_STATE();
+        instruction_pointer = instruction.callee_address().address();
+        ARC_ON_CALL(instruction_pointer);
+        ARC_CONSUME_FUEL();
+        ARC_DISPATCH();
+    }
+
+    ARC_HANDLER(TailCallWithArguments)
+    {
+        const auto& instruction = ARC_FETCH_INSTRUCTION(TailCallWithArguments);
+        ARC_SPILL_CACHED_STATE();
+        if constexpr (is_checked)
+            stack.replace_call_frame(instruction.parameters_byte_count(), false);
+        else
+            stack.replace_call_frame_unchecked(instruction.parameters_byte_count(), false);
+        vm.register_file().replace_window_with_arguments(instruction.first_argument_register(), instruction.argument_count());
+        ARC_LOAD_CACHED_STATE();
+        instruction_pointer = instruction.callee_address().address();
+        ARC_ON_CALL(instruction_pointer);
+        ARC_CONSUME_FUEL();
+        ARC_DISPATCH();
+    }
+
+#if ARC_DIRECT_THREADED_COMPUTED_GOTO
+dispatch_finished:
+#else
+            default:
+                ARC_ASSERT_NOT_REACHED;
+        }
+    }
+#endif // ARC_DIRECT_THREADED_COMPUTED_GOTO
+
+    ARC_SPILL_CACHED_STATE();
+
+#undef ARC_JUMP
+#undef ARC_CONSUME_FUEL
+#undef ARC_ON_RETURN
+#undef ARC_ON_CALL
+#undef ARC_AFTER_INSTRUCTION
+#undef ARC_BEFORE_INSTRUCTION
+#undef ARC_LOAD_CACHED_STATE
+#undef ARC_SPILL_CACHED_STATE
+#undef ARC_SUSPEND_DISPATCH
+#undef ARC_DISPATCH
+#undef ARC_DISPATCH_NEXT
+#undef ARC_HANDLER
+#undef ARC_STACK_POP
+#undef ARC_STACK_PUSH
+#undef ARC_STACK_AT_FRAME_OFFSET
+#undef ARC_STACK_AT_OFFSET
+#undef ARC_REGISTER
+#undef ARC_FETCH_INSTRUCTION
+
+    m_instruction_pointer = instruction_pointer;
+}
+
+template void Interpreter::execute_direct_threaded(UncheckedInterpreterPolicy&);
+template void Interpreter::execute_direct_threaded(CheckedInterpreterPolicy&);
+template void Interpreter::execute_direct_threaded(RegisterCachingInterpreterPolicy&);
+template void Interpreter::execute_direct_threaded(CountingInterpreterPolicy&);
+template void Interpreter::execute_direct_threaded(TracingInterpreterPolicy&);
+template void Interpreter::execute_direct_threaded(SingleSteppingInterpreterPolicy&);
+template void Interpreter::execute_direct_threaded(MeteredInterpreterPolicy<false>&);
+template void Interpreter::execute_direct_threaded(MeteredInterpreterPolicy<true>&);
+
+#if ARC_DIRECT_THREADED_COMPUTED_GOTO
+    #if ARC_COMPILER_CLANG
+        #pragma clang diagnostic pop
+    #endif // ARC_COMPILER_CLANG
+    #if ARC_COMPILER_GCC
+        #pragma GCC diagnostic pop
+    #endif // ARC_COMPILER_GCC
+#endif // ARC_DIRECT_THREADED_COMPUTED_GOTO
+
+}
@@ -8,7 +8,12 @@
 namespace Arc::Runtime {
 
 class Interpreter;
+class NativeCode;
+class TracingJit;
 class VirtualMachine;
 class VirtualStack;
 
+struct Trace;
+struct TracingJitConfiguration;
+
 }
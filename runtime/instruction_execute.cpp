@@ -4,6 +4,8 @@
  */
 
 #include <bytecode/instruction.h>
+#include <bytecode/package.h>
+#include <runtime/integer_arithmetic.h>
 #include <runtime/interpreter.h>
 #include <runtime/virtual_machine.h>
 
@@ -11,6 +13,23 @@ namespace Arc::Bytecode {
 
 using namespace Arc::Runtime;
 
+void Instruction::execute(Interpreter& interpreter) const
+{
+    switch (m_opcode) {
+#define _ARC_EXECUTE_INSTRUCTION(x)                                      \
+    case OpCode::x:                                                     \
+        static_cast<const x##Instruction&>(*this).execute(interpreter); \
+        return;
+        ARC_ENUMERATE_BYTECODE_OPCODES(_ARC_EXECUTE_INSTRUCTION)
+#undef _ARC_EXECUTE_INSTRUCTION
+
+        default:
+            break;
+    }
+
+    ARC_ASSERT_NOT_REACHED;
+}
+
 void AddInstruction::execute(Interpreter& interpreter) const
 {
     auto& dst = interpreter.vm().register_storage(m_dst_register);
@@ -19,11 +38,87 @@ void AddInstruction::execute(Interpreter& interpreter) const
     dst.value = lhs.value + rhs.value;
 }
 
+void AddImmediateInstruction::execute(Interpreter& interpreter) const
+{
+    auto& dst = interpreter.vm().register_storage(m_dst_register);
+    const auto& lhs = interpreter.vm().register_storage(m_lhs_register);
+    dst.value = lhs.value + m_immediate_value;
+}
+
+void BitwiseANDInstruction::execute(Interpreter& interpreter) const
+{
+    auto& dst = interpreter.vm().register_storage(m_dst_register);
+    const auto& lhs = interpreter.vm().register_storage(m_lhs_register);
+    const auto& rhs = interpreter.vm().register_storage(m_rhs_register);
+    dst.value = IntegerArithmetic::bitwise_and(lhs.value, rhs.value);
+}
+
+void BitwiseLeftShiftInstruction::execute(Interpreter& interpreter) const
+{
+    auto& dst = interpreter.vm().register_storage(m_dst_register);
+    const auto& lhs = interpreter.vm().register_storage(m_lhs_register);
+    const auto& rhs = interpreter.vm().register_storage(m_rhs_register);
+    dst.value = IntegerArithmetic::bitwise_left_shift(lhs.value, rhs.value);
+}
+
+void BitwiseNOTInstruction::execute(Interpreter& interpreter) const
+{
+    auto& dst = interpreter.vm().register_storage(m_dst_register);
+    const auto& src = interpreter.vm().register_storage(m_src_register);
+    dst.value = IntegerArithmetic::bitwise_not(src.value);
+}
+
+void BitwiseORInstruction::execute(Interpreter& interpreter) const
+{
+    auto& dst = interpreter.vm().register_storage(m_dst_register);
+    const auto& lhs = interpreter.vm().register_storage(m_lhs_register);
+    const auto& rhs = interpreter.vm().register_storage(m_rhs_register);
+    dst.value = IntegerArithmetic::bitwise_or(lhs.value, rhs.value);
+}
+
+void BitwiseRightShiftInstruction::execute(Interpreter& interpreter) const
+{
+    auto& dst = interpreter.vm().register_storage(m_dst_register);
+    const auto& lhs = interpreter.vm().register_storage(m_lhs_register);
+    const auto& rhs = interpreter.vm().register_storage(m_rhs_register);
+    dst.value = IntegerArithmetic::bitwise_right_shift(lhs.value, rhs.value);
+}
+
+void BitwiseRightShiftSignedInstruction::execute(Interpreter& interpreter) const
+{
+    auto& dst = interpreter.vm().register_storage(m_dst_register);
+    const auto& lhs = interpreter.vm().register_storage(m_lhs_register);
+    const auto& rhs = interpreter.vm().register_storage(m_rhs_register);
+    dst.value = IntegerArithmetic::bitwise_right_shift_signed(lhs.value, rhs.value);
+}
+
+void BitwiseXORInstruction::execute(Interpreter& interpreter) const
+{
+    auto& dst = interpreter.vm().register_storage(m_dst_register);
+    const auto& lhs = interpreter.vm().register_storage(m_lhs_register);
+    const auto& rhs = interpreter.vm().register_storage(m_rhs_register);
+    dst.value = IntegerArithmetic::bitwise_xor(lhs.value, rhs.value);
+}
+
 void CallInstruction::execute(Runtime::Interpreter& interpreter) const
 {
     interpreter.call(m_callee_address, m_parameters_byte_count);
 }
 
+void CallWithArgumentsInstruction::execute(Runtime::Interpreter& interpreter) const
+{
+    interpreter.call_with_arguments(m_callee_address, m_parameters_byte_count, m_first_argument_register, m_argument_count,
+                                    m_return_value_register);
+}
+
+void CompareEqualInstruction::execute(Interpreter& interpreter) const
+{
+    auto& dst = interpreter.vm().register_storage(m_dst_register);
+    const auto& lhs = interpreter.vm().register_storage(m_lhs_register);
+    const auto& rhs = interpreter.vm().register_storage(m_rhs_register);
+    dst.value = IntegerArithmetic::compare_equal(lhs.value, rhs.value);
+}
+
 void CompareGreaterInstruction::execute(Runtime::Interpreter& interpreter) const
 {
     auto& dst = interpreter.vm().register_storage(m_dst_register);
@@ -32,12 +127,154 @@ void CompareGreaterInstruction::execute(Runtime::Interpreter& interpreter) const
     dst.value = lhs.value > rhs.value;
 }
 
+void CompareGreaterImmediateInstruction::execute(Interpreter& interpreter) const
+{
+    auto& dst = interpreter.vm().register_storage(m_dst_register);
+    const auto& lhs = interpreter.vm().register_storage(m_lhs_register);
+    dst.value = lhs.value > m_immediate_value;
+}
+
+void CompareGreaterOrEqualInstruction::execute(Interpreter& interpreter) const
+{
+    auto& dst = interpreter.vm().register_storage(m_dst_register);
+    const auto& lhs = interpreter.vm().register_storage(m_lhs_register);
+    const auto& rhs = interpreter.vm().register_storage(m_rhs_register);
+    dst.value = IntegerArithmetic::compare_greater_or_equal(lhs.value, rhs.value);
+}
+
+void CompareGreaterOrEqualSignedInstruction::execute(Interpreter& interpreter) const
+{
+    auto& dst = interpreter.vm().register_storage(m_dst_register);
+    const auto& lhs = interpreter.vm().register_storage(m_lhs_register);
+    const auto& rhs = interpreter.vm().register_storage(m_rhs_register);
+    dst.value = IntegerArithmetic::compare_greater_or_equal_signed(lhs.value, rhs.value);
+}
+
+void CompareGreaterSignedInstruction::execute(Interpreter& interpreter) const
+{
+    auto& dst = interpreter.vm().register_storage(m_dst_register);
+    const auto& lhs = interpreter.vm().register_storage(m_lhs_register);
+    const auto& rhs = interpreter.vm().register_storage(m_rhs_register);
+    dst.value = IntegerArithmetic::compare_greater_signed(lhs.value, rhs.value);
+}
+
+void CompareLessInstruction::execute(Interpreter& interpreter) const
+{
+    auto& dst = interpreter.vm().register_storage(m_dst_register);
+    const auto& lhs = interpreter.vm().register_storage(m_lhs_register);
+    const auto& rhs = interpreter.vm().register_storage(m_rhs_register);
+    dst.value = IntegerArithmetic::compare_less(lhs.value, rhs.value);
+}
+
+void CompareLessOrEqualInstruction::execute(Interpreter& interpreter) const
+{
+    auto& dst = interpreter.vm().register_storage(m_dst_register);
+    const auto& lhs = interpreter.vm().register_storage(m_lhs_register);
+    const auto& rhs = interpreter.vm().register_storage(m_rhs_register);
+    dst.value = IntegerArithmetic::compare_less_or_equal(lhs.value, rhs.value);
+}
+
+void CompareLessOrEqualSignedInstruction::execute(Interpreter& interpreter) const
+{
+    auto& dst = interpreter.vm().register_storage(m_dst_register);
+    const auto& lhs = interpreter.vm().register_storage(m_lhs_register);
+    const auto& rhs = interpreter.vm().register_storage(m_rhs_register);
+    dst.value = IntegerArithmetic::compare_less_or_equal_signed(lhs.value, rhs.value);
+}
+
+void CompareLessSignedInstruction::execute(Interpreter& interpreter) const
+{
+    auto& dst = interpreter.vm().register_storage(m_dst_register);
+    const auto& lhs = interpreter.vm().register_storage(m_lhs_register);
+    const auto& rhs = interpreter.vm().register_storage(m_rhs_register);
+    dst.value = IntegerArithmetic::compare_less_signed(lhs.value, rhs.value);
+}
+
+void CompareNotEqualInstruction::execute(Interpreter& interpreter) const
+{
+    auto& dst = interpreter.vm().register_storage(m_dst_register);
+    const auto& lhs = interpreter.vm().register_storage(m_lhs_register);
+    const auto& rhs = interpreter.vm().register_storage(m_rhs_register);
+    dst.value = IntegerArithmetic::compare_not_equal(lhs.value, rhs.value);
+}
+
 void DecrementInstruction::execute(Runtime::Interpreter& interpreter) const
 {
     auto& dst = interpreter.vm().register_storage(m_dst_register);
     --dst.value;
 }
 
+void DivideInstruction::execute(Interpreter& interpreter) const
+{
+    auto& dst = interpreter.vm().register_storage(m_dst_register);
+    const auto& lhs = interpreter.vm().register_storage(m_lhs_register);
+    const auto& rhs = interpreter.vm().register_storage(m_rhs_register);
+    dst.value = IntegerArithmetic::divide(lhs.value, rhs.value);
+}
+
+void DivideSignedInstruction::execute(Interpreter& interpreter) const
+{
+    auto& dst = interpreter.vm().register_storage(m_dst_register);
+    const auto& lhs = interpreter.vm().register_storage(m_lhs_register);
+    const auto& rhs = interpreter.vm().register_storage(m_rhs_register);
+    dst.value = IntegerArithmetic::divide_signed(lhs.value, rhs.value);
+}
+
+void FusedCompareGreaterJumpIfInstruction::execute(Runtime::Interpreter& interpreter) const
+{
+    auto& dst = interpreter.vm().register_storage(m_dst_register);
+    const auto& lhs = interpreter.vm().register_storage(m_lhs_register);
+    const auto& rhs = interpreter.vm().register_storage(m_rhs_register);
+    dst.value = lhs.value > rhs.value;
+    if (dst.value)
+        interpreter.jump(m_jump_address);
+}
+
+void FusedCompareGreaterImmediateJumpIfInstruction::execute(Interpreter& interpreter) const
+{
+    auto& dst = interpreter.vm().register_storage(m_dst_register);
+    const auto& lhs = interpreter.vm().register_storage(m_lhs_register);
+    dst.value = lhs.value > m_immediate_value;
+    if (dst.value)
+        interpreter.jump(m_jump_address);
+}
+
+void FusedLoadAddStoreInstruction::execute(Runtime::Interpreter& interpreter) const
+{
+    VirtualMachine& vm = interpreter.vm();
+    auto& loaded = vm.register_storage(m_loaded_register);
+    loaded.value = vm.stack().at_offset<u64>(m_src_stack_offset);
+
+    auto& dst = vm.register_storage(m_dst_register);
+    const auto& other = vm.register_storage(m_other_register);
+    dst.value = loaded.value + other.value;
+    vm.stack().at_offset<u64>(m_dst_stack_offset) = dst.value;
+}
+
+void FusedLoadIncrementStoreInstruction::execute(Runtime::Interpreter& interpreter) const
+{
+    VirtualMachine& vm = interpreter.vm();
+    auto& dst = vm.register_storage(m_dst_register);
+    u64& stack_value = vm.stack().at_offset<u64>(m_stack_offset);
+    dst.value = stack_value + 1;
+    stack_value = dst.value;
+}
+
+void FusedLoadPairInstruction::execute(Runtime::Interpreter& interpreter) const
+{
+    VirtualMachine& vm = interpreter.vm();
+    vm.register_storage(m_first_dst_register).value = vm.stack().at_offset<u64>(m_first_src_stack_offset);
+    vm.register_storage(m_second_dst_register).value = vm.stack().at_offset<u64>(m_second_src_stack_offset);
+}
+
+void FusedLoadStoreInstruction::execute(Runtime::Interpreter& interpreter) const
+{
+    VirtualMachine& vm = interpreter.vm();
+    auto& dst = vm.register_storage(m_dst_register);
+    dst.value = vm.stack().at_offset<u64>(m_src_stack_offset);
+    vm.stack().at_offset<u64>(m_dst_stack_offset) = dst.value;
+}
+
 void IncrementInstruction::execute(Runtime::Interpreter& interpreter) const
 {
     auto& dst = interpreter.vm().register_storage(m_dst_register);
@@ -56,6 +293,25 @@ void JumpIfInstruction::execute(Runtime::Interpreter& interpreter) const
         interpreter.jump(m_jump_address);
 }
 
+void JumpTableInstruction::execute(Runtime::Interpreter& interpreter) const
+{
+    const auto& index = interpreter.vm().register_storage(m_index_register);
+    if (index.value >= m_entry_count) {
+        interpreter.jump(m_default_address);
+        return;
+    }
+
+    interpreter.jump(interpreter.package().fetch_jump_table_entry(m_first_entry_index + index.value));
+}
+
+void LoadFromFrameInstruction::execute(Interpreter& interpreter) const
+{
+    VirtualMachine& vm = interpreter.vm();
+    auto& dst_register = vm.register_storage(m_dst_register);
+    const auto& src_register = vm.stack().at_frame_offset<VirtualMachine::RegisterStorage>(m_src_frame_offset);
+    dst_register.value = src_register.value;
+}
+
 void LoadFromStackInstruction::execute(Runtime::Interpreter& interpreter) const
 {
     VirtualMachine& vm = interpreter.vm();
@@ -94,6 +350,77 @@ void LoadImmediate8Instruction::execute(Interpreter& interpreter) const
     dst.value = static_cast<u64>(m_immediate_value);
 }
 
+void LoadImmediate16Instruction::execute(Interpreter& interpreter) const
+{
+    auto& dst = interpreter.vm().register_storage(m_dst_register);
+    dst.value = static_cast<u64>(m_immediate_value);
+}
+
+void LoadImmediate32Instruction::execute(Interpreter& interpreter) const
+{
+    auto& dst = interpreter.vm().register_storage(m_dst_register);
+    dst.value = static_cast<u64>(m_immediate_value);
+}
+
+void LoadImmediate64Instruction::execute(Interpreter& interpreter) const
+{
+    auto& dst = interpreter.vm().register_storage(m_dst_register);
+    dst.value = static_cast<u64>(m_immediate_value);
+}
+
+void LogicalANDInstruction::execute(Interpreter& interpreter) const
+{
+    auto& dst = interpreter.vm().register_storage(m_dst_register);
+    const auto& lhs = interpreter.vm().register_storage(m_lhs_register);
+    const auto& rhs = interpreter.vm().register_storage(m_rhs_register);
+    dst.value = IntegerArithmetic::logical_and(lhs.value, rhs.value);
+}
+
+void LogicalNOTInstruction::execute(Interpreter& interpreter) const
+{
+    auto& dst = interpreter.vm().register_storage(m_dst_register);
+    const auto& src = interpreter.vm().register_storage(m_src_register);
+    dst.value = IntegerArithmetic::logical_not(src.value);
+}
+
+void LogicalORInstruction::execute(Interpreter& interpreter) const
+{
+    auto& dst = interpreter.vm().register_storage(m_dst_register);
+    const auto& lhs = interpreter.vm().register_storage(m_lhs_register);
+    const auto& rhs = interpreter.vm().register_storage(m_rhs_register);
+    dst.value = IntegerArithmetic::logical_or(lhs.value, rhs.value);
+}
+
+void LogicalXORInstruction::execute(Interpreter& interpreter) const
+{
+    auto& dst = interpreter.vm().register_storage(m_dst_register);
+    const auto& lhs = interpreter.vm().register_storage(m_lhs_register);
+    const auto& rhs = interpreter.vm().register_storage(m_rhs_register);
+    dst.value = IntegerArithmetic::logical_xor(lhs.value, rhs.value);
+}
+
+void MoveInstruction::execute(Interpreter& interpreter) const
+{
+    auto& dst = interpreter.vm().register_storage(m_dst_register);
+    const auto& src = interpreter.vm().register_storage(m_src_register);
+    dst.value = src.value;
+}
+
+void MultiplyInstruction::execute(Interpreter& interpreter) const
+{
+    auto& dst = interpreter.vm().register_storage(m_dst_register);
+    const auto& lhs = interpreter.vm().register_storage(m_lhs_register);
+    const auto& rhs = interpreter.vm().register_storage(m_rhs_register);
+    dst.value = IntegerArithmetic::multiply(lhs.value, rhs.value);
+}
+
+void NegateInstruction::execute(Interpreter& interpreter) const
+{
+    auto& dst = interpreter.vm().register_storage(m_dst_register);
+    const auto& src = interpreter.vm().register_storage(m_src_register);
+    dst.value = IntegerArithmetic::negate(src.value);
+}
+
 void PopInstruction::execute(Runtime::Interpreter& interpreter) const
 {
     interpreter.vm().stack().pop(m_pop_byte_count);
@@ -105,6 +432,9 @@ void PopRegisterInstruction::execute(Interpreter& interpreter) const
     vm.stack().pop<VirtualMachine::RegisterStorage>();
 }
 
+void PureFunctionEntryInstruction::execute(Interpreter&) const
+{}
+
 void PushInstruction::execute(Runtime::Interpreter& interpreter) const
 {
     interpreter.vm().stack().push(m_push_byte_count);
@@ -151,6 +481,40 @@ void ReturnInstruction::execute(Runtime::Interpreter& interpreter) const
     interpreter.return_from_call();
 }
 
+void ReturnValueInstruction::execute(Runtime::Interpreter& interpreter) const
+{
+    interpreter.return_value_from_call(m_src_register);
+}
+
+void SignExtend8Instruction::execute(Interpreter& interpreter) const
+{
+    auto& dst = interpreter.vm().register_storage(m_dst_register);
+    const auto& src = interpreter.vm().register_storage(m_src_register);
+    dst.value = IntegerArithmetic::sign_extend_8(src.value);
+}
+
+void SignExtend16Instruction::execute(Interpreter& interpreter) const
+{
+    auto& dst = interpreter.vm().register_storage(m_dst_register);
+    const auto& src = interpreter.vm().register_storage(m_src_register);
+    dst.value = IntegerArithmetic::sign_extend_16(src.value);
+}
+
+void SignExtend32Instruction::execute(Interpreter& interpreter) const
+{
+    auto& dst = interpreter.vm().register_storage(m_dst_register);
+    const auto& src = interpreter.vm().register_storage(m_src_register);
+    dst.value = IntegerArithmetic::sign_extend_32(src.value);
+}
+
+void StoreToFrameInstruction::execute(Interpreter& interpreter) const
+{
+    VirtualMachine& vm = interpreter.vm();
+    auto& dst_register = vm.stack().at_frame_offset<VirtualMachine::RegisterStorage>(m_dst_frame_offset);
+    const auto& src_register = vm.register_storage(m_src_register);
+    dst_register.value = src_register.value;
+}
+
 void StoreToStackInstruction::execute(Interpreter& interpreter) const
 {
     VirtualMachine& vm = interpreter.vm();
@@ -191,4 +555,21 @@ void SubInstruction::execute(Runtime::Interpreter& interpreter) const
     dst.value = lhs.value - rhs.value;
 }
 
+void SubImmediateInstruction::execute(Interpreter& interpreter) const
+{
+    auto& dst = interpreter.vm().register_storage(m_dst_register);
+    const auto& lhs = interpreter.vm().register_storage(m_lhs_register);
+    dst.value = lhs.value - m_immediate_value;
+}
+
+void TailCallInstruction::execute(Interpreter& interpreter) const
+{
+    interpreter.tail_call(m_callee_address, m_parameters_byte_count);
+}
+
+void TailCallWithArgumentsInstruction::execute(Interpreter& interpreter) const
+{
+    interpreter.tail_call_with_arguments(m_callee_address, m_parameters_byte_count, m_first_argument_register, m_argument_count);
+}
+
 }
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause.
+ */
+
+#pragma once
+
+#include <core/types.h>
+#include <runtime/trap.h>
+
+namespace Arc::Runtime {
+
+//
+// Semantics of the integer instructions, shared by all execution engines so that they can never disagree.
+// Registers don't carry a type, so every operation receives and produces raw 64-bit values. Operations whose result
+// depends on the signedness of the operands come in two variants, the signed one reinterpreting the values as
+// two's complement integers. Arithmetic always wraps around on overflow.
+//
+class IntegerArithmetic {
+    ARC_MAKE_NAMESPACE_CLASS(IntegerArithmetic)
+
+public:
+    // The shift count is reduced modulo the register width, which matches the behaviour of the hardware.
+    static constexpr u64 shift_count_mask = 63;
+
+public:
+    NODISCARD ALWAYS_INLINE static u64 bitwise_and(u64 lhs, u64 rhs) { return lhs & rhs; }
+    NODISCARD ALWAYS_INLINE static u64 bitwise_or(u64 lhs, u64 rhs) { return lhs | rhs; }
+    NODISCARD ALWAYS_INLINE static u64 bitwise_xor(u64 lhs, u64 rhs) { return lhs ^ rhs; }
+    NODISCARD ALWAYS_INLINE static u64 bitwise_not(u64 value) { return ~value; }
+
+    NODISCARD ALWAYS_INLINE static u64 bitwise_left_shift(u64 lhs, u64 rhs) { return lhs << (rhs & shift_count_mask); }
+    NODISCARD ALWAYS_INLINE static u64 bitwise_right_shift(u64 lhs, u64 rhs) { return lhs >> (rhs & shift_count_mask); }
+    NODISCARD ALWAYS_INLINE static u64 bitwise_right_shift_signed(u64 lhs, u64 rhs)
+    {
+        return static_cast<u64>(static_cast<s64>(lhs) >> (rhs & shift_count_mask));
+    }
+
+    NODISCARD ALWAYS_INLINE static u64 compare_equal(u64 lhs, u64 rhs) { return lhs == rhs; }
+    NODISCARD ALWAYS_INLINE static u64 compare_not_equal(u64 lhs, u64 rhs) { return lhs != rhs; }
+
+    NODISCARD ALWAYS_INLINE static u64 compare_less(u64 lhs, u64 rhs) { return lhs < rhs; }
+    NODISCARD ALWAYS_INLINE static u64 compare_less_or_equal(u64 lhs, u64 rhs) { return lhs <= rhs; }
+    NODISCARD ALWAYS_INLINE static u64 compare_greater(u64 lhs, u64 rhs) { return lhs > rhs; }
+    NODISCARD ALWAYS_INLINE static u64 compare_greater_or_equal(u64 lhs, u64 rhs) { return lhs >= rhs; }
+
+    NODISCARD ALWAYS_INLINE static u64 compare_less_signed(u64 lhs, u64 rhs)
+    {
+        return static_cast<s64>(lhs) < static_cast<s64>(rhs);
+    }
+    NODISCARD ALWAYS_INLINE static u64 compare_less_or_equal_signed(u64 lhs, u64 rhs)
+    {
+        return static_cast<s64>(lhs) <= static_cast<s64>(rhs);
+    }
+    NODISCARD ALWAYS_INLINE static u64 compare_greater_signed(u64 lhs, u64 rhs)
+    {
+        return static_cast<s64>(lhs) > static_cast<s64>(rhs);
+    }
+    NODISCARD ALWAYS_INLINE static u64 compare_greater_or_equal_signed(u64 lhs, u64 rhs)
+    {
+        return static_cast<s64>(lhs) >= static_cast<s64>(rhs);
+    }
+
+    // The lower 64 bits of the product are identical for signed and unsigned operands.
+    NODISCARD ALWAYS_INLINE static u64 multiply(u64 lhs, u64 rhs) { return lhs * rhs; }
+
+    // NOTE: Dividing by zero raises a `Trap::DivisionByZero`, so the divisions must only be executed by a function that
+    //       is run by the trap handler.
+    NODISCARD ALWAYS_INLINE static u64 divide(u64 lhs, u64 rhs)
+    {
+        if (rhs == 0)
+            TrapHandler::raise(Trap::DivisionByZero);
+        return lhs / rhs;
+    }
+
+    NODISCARD ALWAYS_INLINE static u64 divide_signed(u64 lhs, u64 rhs)
+    {
+        if (rhs == 0)
+            TrapHandler::raise(Trap::DivisionByZero);
+        // NOTE: Dividing the smallest representable value by -1 overflows, which is undefined behaviour in C++ and
+        //       raises a hardware exception on x86-64. The result wraps around instead, same as the other operations.
+        if (static_cast<s64>(rhs) == -1)
+            return negate(lhs);
+        return static_cast<u64>(static_cast<s64>(lhs) / static_cast<s64>(rhs));
+    }
+
+    NODISCARD ALWAYS_INLINE static u64 negate(u64 value) { return ~value + 1; }
+
+    NODISCARD ALWAYS_INLINE static u64 logical_and(u64 lhs, u64 rhs) { return (lhs != 0) && (rhs != 0); }
+    NODISCARD ALWAYS_INLINE static u64 logical_or(u64 lhs, u64 rhs) { return (lhs != 0) || (rhs != 0); }
+    NODISCARD ALWAYS_INLINE static u64 logical_xor(u64 lhs, u64 rhs) { return (lhs != 0) != (rhs != 0); }
+    NODISCARD ALWAYS_INLINE static u64 logical_not(u64 value) { return value == 0; }
+
+    NODISCARD ALWAYS_INLINE static u64 sign_extend_8(u64 value) { return static_cast<u64>(static_cast<s64>(static_cast<s8>(value))); }
+    NODISCARD ALWAYS_INLINE static u64 sign_extend_16(u64 value) { return static_cast<u64>(static_cast<s64>(static_cast<s16>(value))); }
+    NODISCARD ALWAYS_INLINE static u64 sign_extend_32(u64 value) { return static_cast<u64>(static_cast<s64>(static_cast<s32>(value))); }
+};
+
+}
@@ -3,15 +3,26 @@
  * SPDX-License-Identifier: BSD-3-Clause.
  */
 
+#include <bytecode/opcode_profile.h>
 #include <bytecode/package.h>
 #include <runtime/interpreter.h>
+#include <runtime/interpreter_policy.h>
+#include <runtime/jit/jit_compiler.h>
+#include <runtime/jit/tracing_jit.h>
+#include <runtime/trap.h>
 
 namespace Arc::Runtime {
 
 Interpreter::Interpreter(VirtualMachine& virtual_machine, const Bytecode::Package& package)
     : m_virtual_machine(virtual_machine)
     , m_package(package)
+    , m_threaded_code_modification_count(0)
     , m_instruction_pointer(0)
+    , m_resumes_unchecked_execution(false)
+    , m_dispatch_mode(DispatchMode::DirectThreaded)
+    , m_opcode_profile(nullptr)
+    , m_native_code(nullptr)
+    , m_tracing_jit(nullptr)
 {
     // Always reset the instruction pointer.
     m_instruction_pointer = 0;
@@ -21,15 +32,140 @@ void Interpreter::set_entry_point(u64 entry_point_instruction_offset)
 {
     // TODO: Ensure that the provided entry point instruction offset is actually valid.
     m_instruction_pointer = entry_point_instruction_offset;
+    m_resumes_unchecked_execution = false;
 }
 
-void Interpreter::execute()
+void Interpreter::set_dispatch_mode(DispatchMode dispatch_mode)
 {
+    m_dispatch_mode = dispatch_mode;
+}
+
+void Interpreter::set_opcode_profile(Bytecode::OpcodeProfile* opcode_profile)
+{
+    m_opcode_profile = opcode_profile;
+}
+
+void Interpreter::set_native_code(const NativeCode* native_code)
+{
+    m_native_code = native_code;
+}
+
+void Interpreter::set_tracing_jit(TracingJit* tracing_jit)
+{
+    m_tracing_jit = tracing_jit;
+}
+
+ErrorOr<void> Interpreter::execute()
+{
+    return run_with_trap_handler(execute_guarded, this);
+}
+
+ErrorOr<void> Interpreter::run_with_trap_handler(TrapHandler::GuardedFunction function, void* user_data)
+{
+    m_last_trap = TrapHandler::run(m_virtual_machine.stack().memory(), m_virtual_machine.register_file().memory(), function, user_data);
+    if (m_last_trap.has_value())
+        return ARC_INTERNAL_ERROR_WITH_MESSAGE(trap_to_string_view(m_last_trap.value()));
+    return {};
+}
+
+ExecutionStatus Interpreter::execute_for(u64 fuel)
+{
+    if (!m_package.instruction_pointer_is_valid(m_instruction_pointer))
+        return ExecutionStatus::Finished;
+    if (fuel == 0)
+        return ExecutionStatus::BudgetExhausted;
+
+    if (m_resumes_unchecked_execution || can_execute_unchecked())
+        return execute_metered<MeteredInterpreterPolicy<false>>(fuel);
+    return execute_metered<MeteredInterpreterPolicy<true>>(fuel);
+}
+
+template<typename Policy>
+ExecutionStatus Interpreter::execute_metered(u64 fuel)
+{
+    Policy policy(fuel);
+    PolicyExecution<Policy> execution = { *this, policy };
+    m_resumes_unchecked_execution = false;
+    m_last_trap = TrapHandler::run(m_virtual_machine.stack().memory(), m_virtual_machine.register_file().memory(),
+                                   execute_with_policy_guarded<Policy>, &execution);
+    if (m_last_trap.has_value())
+        return ExecutionStatus::Trapped;
+
+    if (!m_package.instruction_pointer_is_valid(m_instruction_pointer))
+        return ExecutionStatus::Finished;
+    m_resumes_unchecked_execution = !Policy::is_checked;
+    return ExecutionStatus::BudgetExhausted;
+}
+
+void Interpreter::execute_guarded(void* interpreter)
+{
+    static_cast<Interpreter*>(interpreter)->execute_until_finished();
+}
+
+void Interpreter::execute_until_finished()
+{
+    // NOTE: Profiling is always done instruction by instruction, regardless of the selected dispatch mode.
+    if (m_opcode_profile != nullptr) {
+        execute_with_opcode_profile();
+        return;
+    }
+
+    // NOTE: The native code performs no safety checks, so the same conditions as for the unchecked dispatch apply.
+    if (m_native_code != nullptr && can_execute_unchecked()) {
+        execute_native_code();
+        return;
+    }
+
+    if (m_tracing_jit != nullptr && can_execute_unchecked()) {
+        execute_with_tracing_jit();
+        return;
+    }
+
+    if (m_dispatch_mode == DispatchMode::DirectThreaded || m_dispatch_mode == DispatchMode::RegisterCaching) {
+        if (!can_execute_unchecked()) {
+            CheckedInterpreterPolicy policy;
+            execute_direct_threaded(policy);
+        }
+        else if (m_dispatch_mode == DispatchMode::RegisterCaching) {
+            RegisterCachingInterpreterPolicy policy;
+            execute_direct_threaded(policy);
+        }
+        else {
+            UncheckedInterpreterPolicy policy;
+            execute_direct_threaded(policy);
+        }
+        return;
+    }
+
+    if (m_dispatch_mode == DispatchMode::ThreadedCode) {
+        execute_threaded_code();
+        return;
+    }
+
     while (m_package.instruction_pointer_is_valid(m_instruction_pointer)) {
         fetch_and_execute();
     }
 }
 
+bool Interpreter::can_execute_unchecked() const
+{
+    return m_package.is_verified() && entry_point_is_verified();
+}
+
+bool Interpreter::entry_point_is_verified() const
+{
+    // NOTE: Execution must start with an empty call stack, as the verifier assumes that entry points never return.
+    if (m_virtual_machine.stack().has_call_frames())
+        return false;
+
+    for (const Bytecode::Package::EntryPoint& entry_point : m_package.entry_points()) {
+        if (entry_point.address.address() == m_instruction_pointer)
+            return true;
+    }
+
+    return false;
+}
+
 void Interpreter::jump(Bytecode::JumpAddress jump_address)
 {
     // NOTE: The interpreter is already scheduled to jump. No instruction should be able
@@ -40,29 +176,184 @@ void Interpreter::jump(Bytecode::JumpAddress jump_address)
 
 void Interpreter::call(Bytecode::JumpAddress callee_address, u64 parameters_byte_count)
 {
-    // TODO: Currently, the call instruction doesn't automatically save the current state of the registers
-    //       to the stack, thus extra instructions must be issued in order to preserve the necessary registers.
-    //       While this is the behaviour of the x86 instruction set, the time saved by only preserving the
-    //       used registers might be insignificant compared to the time required to fetch and execute instructions
-    //       in our virtual machine. Automatically saving all registers to stack might provide better performance!
-
+    // NOTE: The callee gets its own register window, so the registers of the caller don't have to be saved
+    //       to the stack around the call.
     // NOTE: When fetching an instruction from the package the instruction pointer is automatically
     //       incremented, thus the instruction pointer represents the next instruction after the `Call`.
     const Bytecode::JumpAddress return_address = Bytecode::JumpAddress(m_instruction_pointer);
-    m_virtual_machine.call_stack().push(return_address, parameters_byte_count);
+    m_virtual_machine.stack().push_call_frame(return_address, parameters_byte_count);
+    m_virtual_machine.register_file().push_window();
+    jump(callee_address);
+}
+
+void Interpreter::call_with_arguments(Bytecode::JumpAddress callee_address, u64 parameters_byte_count,
+                                      Bytecode::Register first_argument_register, u8 argument_count,
+                                      Bytecode::Register return_value_register)
+{
+    u32 memoization_entry_index = CallFrameHeader::no_memoization_entry_index;
+    if (try_resolve_memoized_call(callee_address, first_argument_register, argument_count, return_value_register, parameters_byte_count,
+                                  memoization_entry_index)) {
+        return;
+    }
+
+    const Bytecode::JumpAddress return_address = Bytecode::JumpAddress(m_instruction_pointer);
+    m_virtual_machine.stack().push_call_frame(return_address, parameters_byte_count, return_value_register, memoization_entry_index);
+    m_virtual_machine.register_file().push_window_with_arguments(first_argument_register, argument_count);
     jump(callee_address);
 }
 
 void Interpreter::return_from_call()
 {
-    // Get the last call frame from the virtual machine's call stack.
-    const VirtualCallStack::CallFrame last_call_frame = m_virtual_machine.call_stack().pop();
+    // Pop the last call frame, which restores the frame of the caller and pops the call parameters from the stack.
+    const CallFrameHeader last_call_frame = m_virtual_machine.stack().pop_call_frame();
 
-    // Pop the call parameters from the stack.
-    m_virtual_machine.stack().pop(last_call_frame.parameters_byte_count);
+    // Restore the register window of the caller.
+    m_virtual_machine.register_file().pop_window();
+    if (last_call_frame.memoization_entry_index != CallFrameHeader::no_memoization_entry_index)
+        complete_memoized_call(last_call_frame, {});
 
     // Jump back to the call return address.
-    jump(last_call_frame.return_address);
+    jump(Bytecode::JumpAddress(last_call_frame.return_address));
+}
+
+void Interpreter::return_value_from_call(Bytecode::Register src_register)
+{
+    const u64 return_value = m_virtual_machine.register_storage(src_register).value;
+    const CallFrameHeader last_call_frame = m_virtual_machine.stack().pop_call_frame();
+    m_virtual_machine.register_file().pop_window();
+
+    // NOTE: The return value is written after the caller window is restored, so it lands in the caller's register.
+    if (last_call_frame.has_return_value_register)
+        m_virtual_machine.register_storage(last_call_frame.return_value_register).value = return_value;
+    if (last_call_frame.memoization_entry_index != CallFrameHeader::no_memoization_entry_index)
+        complete_memoized_call(last_call_frame, return_value);
+
+    jump(Bytecode::JumpAddress(last_call_frame.return_address));
+}
+
+void Interpreter::tail_call(Bytecode::JumpAddress callee_address, u64 parameters_byte_count)
+{
+    // NOTE: The callee returns to the caller of the current function, which doesn't expect a value from this call.
+    m_virtual_machine.stack().replace_call_frame(parameters_byte_count, true);
+    m_virtual_machine.register_file().replace_window_with_arguments(Bytecode::Register::GPR0, 0);
+    jump(callee_address);
+}
+
+void Interpreter::tail_call_with_arguments(Bytecode::JumpAddress callee_address, u64 parameters_byte_count,
+                                           Bytecode::Register first_argument_register, u8 argument_count)
+{
+    m_virtual_machine.stack().replace_call_frame(parameters_byte_count, false);
+    m_virtual_machine.register_file().replace_window_with_arguments(first_argument_register, argument_count);
+    jump(callee_address);
+}
+
+bool Interpreter::try_resolve_memoized_call(Bytecode::JumpAddress callee_address, Bytecode::Register first_argument_register,
+                                            u8 argument_count, Bytecode::Register return_value_register, u64 parameters_byte_count,
+                                            u32& memoization_entry_index)
+{
+    MemoizationCache& memoization_cache = m_virtual_machine.memoization_cache();
+    if (!memoization_cache.is_enabled())
+        return false;
+
+    // NOTE: Only the register arguments are part of the memoization key, so calls that pass parameters on the stack
+    //       are never memoized.
+    if (parameters_byte_count > 0 || argument_count > MemoizationKey::max_argument_count)
+        return false;
+    if (!m_package.instruction_pointer_is_valid(callee_address.address()) ||
+        m_package.fetch_instruction(callee_address.address()).opcode() != Bytecode::OpCode::PureFunctionEntry) {
+        return false;
+    }
+
+    MemoizationKey key = {};
+    key.callee_address = callee_address.address();
+    key.argument_count = argument_count;
+    for (u8 argument_index = 0; argument_index < argument_count; ++argument_index) {
+        const auto argument_register = static_cast<Bytecode::Register>(static_cast<u8>(first_argument_register) + argument_index);
+        key.arguments[argument_index] = m_virtual_machine.register_storage(argument_register).value;
+    }
+
+    const Optional<u64> memoized_value = memoization_cache.find(key);
+    if (memoized_value.has_value()) {
+        m_virtual_machine.register_storage(return_value_register).value = memoized_value.value();
+        return true;
+    }
+
+    const Optional<u32> reserved_entry_index = memoization_cache.reserve(key);
+    if (reserved_entry_index.has_value())
+        memoization_entry_index = reserved_entry_index.value();
+    return false;
+}
+
+void Interpreter::complete_memoized_call(const CallFrameHeader& call_frame_header, Optional<u64> return_value)
+{
+    // NOTE: A tail call that discards the returned value clears the return value register of the frame, in which case
+    //       the call has no result that could be memoized.
+    MemoizationCache& memoization_cache = m_virtual_machine.memoization_cache();
+    if (return_value.has_value() && call_frame_header.has_return_value_register)
+        memoization_cache.store(call_frame_header.memoization_entry_index, return_value.value());
+    else
+        memoization_cache.release(call_frame_header.memoization_entry_index);
+}
+
+void Interpreter::execute_with_opcode_profile()
+{
+    m_opcode_profile->break_sequence();
+    usize previous_instruction_pointer = m_instruction_pointer;
+
+    while (m_package.instruction_pointer_is_valid(m_instruction_pointer)) {
+        const Bytecode::OpCode opcode = m_package.fetch_instruction(m_instruction_pointer).opcode();
+        m_opcode_profile->record_instruction(opcode, m_instruction_pointer == previous_instruction_pointer + 1);
+        previous_instruction_pointer = m_instruction_pointer;
+        fetch_and_execute();
+    }
+}
+
+void Interpreter::execute_native_code()
+{
+    while (m_package.instruction_pointer_is_valid(m_instruction_pointer)) {
+        if (m_native_code->has_native_code(m_instruction_pointer))
+            m_instruction_pointer = m_native_code->run(m_virtual_machine, m_instruction_pointer);
+        else
+            fetch_and_execute();
+    }
+}
+
+void Interpreter::execute_with_tracing_jit()
+{
+    // NOTE: A trace that was being recorded when a previous execution was aborted doesn't match this execution.
+    m_tracing_jit->cancel_recording();
+
+    while (m_package.instruction_pointer_is_valid(m_instruction_pointer)) {
+        if (m_tracing_jit->is_recording())
+            m_tracing_jit->record_instruction(m_instruction_pointer);
+
+        // NOTE: The traces are not entered while recording, as the recorded trace would miss their instructions.
+        if (!m_tracing_jit->is_recording()) {
+            if (const NativeCode* trace = m_tracing_jit->find_trace(m_instruction_pointer)) {
+                m_instruction_pointer = trace->run(m_virtual_machine, m_instruction_pointer);
+                continue;
+            }
+        }
+
+        const usize instruction_pointer = m_instruction_pointer;
+        fetch_and_execute();
+        if (m_instruction_pointer <= instruction_pointer)
+            m_tracing_jit->on_backward_jump(instruction_pointer, m_instruction_pointer);
+    }
+}
+
+void Interpreter::execute_threaded_code()
+{
+    if (!m_threaded_code.is_valid() || m_threaded_code_modification_count != m_package.modification_count()) {
+        m_threaded_code = create_own<ThreadedCode>(m_package);
+        m_threaded_code_modification_count = m_package.modification_count();
+    }
+
+    const ThreadedInstruction* instruction = m_threaded_code->resolve(m_instruction_pointer);
+    while (instruction->handler != nullptr)
+        instruction = instruction->handler(*this, *instruction);
+
+    m_instruction_pointer = m_threaded_code->instruction_pointer_of(*instruction);
 }
 
 void Interpreter::fetch_and_execute()
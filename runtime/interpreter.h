@@ -8,10 +8,39 @@
 #include <bytecode/forward.h>
 #include <bytecode/jump_address.h>
 #include <core/containers/optional.h>
+#include <core/containers/own_ptr.h>
+#include <core/error.h>
+#include <runtime/threaded_code.h>
 #include <runtime/virtual_machine.h>
 
 namespace Arc::Runtime {
 
+enum class DispatchMode : u8 {
+    // Each instruction is fetched from the package and executed via `Instruction::execute`. Control flow
+    // instructions schedule a jump through `Interpreter::jump`, which is applied after the instruction returns.
+    InstructionExecute,
+    // All instruction handlers live in a single function and the next handler is reached through a dispatch
+    // table indexed by opcode (computed goto when supported by the compiler, a switch otherwise). Control
+    // flow instructions write the instruction pointer directly.
+    DirectThreaded,
+    // The package is translated once, when the interpreter is constructed, into an array of handlers with their
+    // decoded instruction and resolved jump target bound to them. Each handler returns the next one to execute.
+    ThreadedCode,
+    // Like `DirectThreaded`, but the registers of the current window and the stack pointer live in local variables of
+    // the dispatch loop, and are only written back to the virtual machine around calls, returns and when the execution
+    // finishes. Only used for verified packages, the others are executed like `DirectThreaded` executes them.
+    RegisterCaching,
+};
+
+enum class ExecutionStatus : u8 {
+    // The instruction pointer left the package.
+    Finished,
+    // The fuel ran out before the execution finished. Executing the package again resumes it where it was suspended.
+    BudgetExhausted,
+    // The program was aborted by a trap, see `Interpreter::last_trap`. The state of the virtual machine is unspecified.
+    Trapped,
+};
+
 class Interpreter {
     ARC_MAKE_NONCOPYABLE(Interpreter);
     ARC_MAKE_NONMOVABLE(Interpreter);
@@ -20,24 +49,136 @@ public:
     Interpreter(VirtualMachine&, const Bytecode::Package&);
 
     void set_entry_point(u64 entry_point_instruction_offset);
-    void execute();
+    void set_dispatch_mode(DispatchMode dispatch_mode);
+
+    // When an opcode profile is set, all executed instructions are recorded in it. This is considerably slower than
+    // the regular execution and should only be used for representative runs whose results drive the optimizer.
+    void set_opcode_profile(Bytecode::OpcodeProfile* opcode_profile);
+
+    // When native code is set, the instructions that have a native translation are executed natively and only the
+    // remaining ones are interpreted. The native code is only used for verified packages that are executed from one
+    // of their entry points, and must have been compiled from the same package as the one that is interpreted.
+    void set_native_code(const NativeCode* native_code);
+
+    // When a tracing JIT is set, the hot loops are detected while the package is interpreted and their traces are
+    // compiled to native code. Like the native code, the tracing JIT is only used for verified packages that are
+    // executed from one of their entry points, and it is ignored when native code for the whole package is set.
+    void set_tracing_jit(TracingJit* tracing_jit);
+
+    // Executes the package until the instruction pointer leaves it. When the program is aborted by a trap an error
+    // describing the trap is returned, in which case the state of the virtual machine is unspecified.
+    ErrorOr<void> execute();
+
+    // Executes the package until it finishes, traps, or consumes the given amount of fuel. Every backward jump, call and
+    // tail call consumes one unit of fuel, so that the execution of any program is bounded. The whole state of a
+    // suspended execution lives in the virtual machine and the interpreter, which is resumed by calling this function
+    // again. Like `execute_with_policy`, the selected dispatch mode, opcode profile, native code and tracing JIT are
+    // ignored.
+    // NOTE: A suspended execution that started from an entry point of a verified package is resumed unchecked, as long
+    //       as the entry point isn't changed in the meantime.
+    NODISCARD ExecutionStatus execute_for(u64 fuel);
+
+    // The trap that aborted the last execution, if any.
+    NODISCARD ALWAYS_INLINE Optional<Trap> last_trap() const { return m_last_trap; }
+
+    // Executes the package with the direct-threaded dispatch loop instantiated for the given policy, regardless of the
+    // selected dispatch mode, opcode profile, native code or tracing JIT. Policies that aren't checked can only execute
+    // verified packages from one of their entry points, otherwise an error is returned without executing anything.
+    template<typename Policy>
+    ErrorOr<void> execute_with_policy(Policy& policy)
+    {
+        if constexpr (!Policy::is_checked) {
+            if (!can_execute_unchecked())
+                return ARC_INTERNAL_ERROR_WITH_MESSAGE("Unchecked policies can only execute verified packages from an entry point"sv);
+        }
+
+        PolicyExecution<Policy> execution = { *this, policy };
+        return run_with_trap_handler(execute_with_policy_guarded<Policy>, &execution);
+    }
 
     NODISCARD ALWAYS_INLINE VirtualMachine& vm() { return m_virtual_machine; }
     NODISCARD ALWAYS_INLINE const VirtualMachine& vm() const { return m_virtual_machine; }
+    NODISCARD ALWAYS_INLINE const Bytecode::Package& package() const { return m_package; }
+    // NOTE: The threaded code only exists while the package is executed with `DispatchMode::ThreadedCode`.
+    NODISCARD ALWAYS_INLINE const ThreadedCode& threaded_code() const { return *m_threaded_code; }
+
+    NODISCARD ALWAYS_INLINE DispatchMode dispatch_mode() const { return m_dispatch_mode; }
 
     void jump(Bytecode::JumpAddress jump_address);
 
     void call(Bytecode::JumpAddress callee_address, u64 parameters_byte_count);
+    void call_with_arguments(Bytecode::JumpAddress callee_address, u64 parameters_byte_count, Bytecode::Register first_argument_register,
+                             u8 argument_count, Bytecode::Register return_value_register);
     void return_from_call();
+    void return_value_from_call(Bytecode::Register src_register);
+
+    // NOTE: Tail calls replace the frame of the current function by the frame of the callee, so the callee returns
+    //       directly to the caller of the current function.
+    void tail_call(Bytecode::JumpAddress callee_address, u64 parameters_byte_count);
+    void tail_call_with_arguments(Bytecode::JumpAddress callee_address, u64 parameters_byte_count,
+                                  Bytecode::Register first_argument_register, u8 argument_count);
+
+    // Tries to answer a call to a pure function from the memoization cache of the virtual machine. On a hit, the
+    // cached value is written to the return value register and true is returned, in which case the call must be
+    // skipped. Otherwise `memoization_entry_index` receives the cache entry that awaits the result of the call, if any.
+    NODISCARD bool try_resolve_memoized_call(Bytecode::JumpAddress callee_address, Bytecode::Register first_argument_register,
+                                             u8 argument_count, Bytecode::Register return_value_register, u64 parameters_byte_count,
+                                             u32& memoization_entry_index);
+    // Completes the memoization cache entry of a call frame that was just popped.
+    void complete_memoized_call(const CallFrameHeader& call_frame_header, Optional<u64> return_value);
 
 private:
+    static void execute_guarded(void* interpreter);
+    void execute_until_finished();
+
     void fetch_and_execute();
+    void execute_with_opcode_profile();
+    void execute_native_code();
+    void execute_with_tracing_jit();
+    void execute_threaded_code();
+    NODISCARD bool entry_point_is_verified() const;
+    // NOTE: The verifier only proves the safety of the package when execution starts at one of its entry points.
+    NODISCARD bool can_execute_unchecked() const;
+
+    // NOTE: The policy decides whether the accesses are validated and which hooks are invoked, see `InterpreterPolicy`.
+    //       Only the policies declared in `runtime/interpreter_policy.h` are instantiated.
+    template<typename Policy>
+    void execute_direct_threaded(Policy& policy);
+
+    template<typename Policy>
+    struct PolicyExecution {
+        Interpreter& interpreter;
+        Policy& policy;
+    };
+
+    template<typename Policy>
+    static void execute_with_policy_guarded(void* policy_execution)
+    {
+        const PolicyExecution<Policy>& execution = *static_cast<const PolicyExecution<Policy>*>(policy_execution);
+        execution.interpreter.execute_direct_threaded(execution.policy);
+    }
+
+    NODISCARD ErrorOr<void> run_with_trap_handler(TrapHandler::GuardedFunction function, void* user_data);
+
+    template<typename Policy>
+    NODISCARD ExecutionStatus execute_metered(u64 fuel);
 
 private:
     VirtualMachine& m_virtual_machine;
     const Bytecode::Package& m_package;
+    // NOTE: The threaded code is built the first time the package is executed with `DispatchMode::ThreadedCode`, and
+    //       built again when the package was modified since then, as it refers to the instructions of the package.
+    OwnPtr<ThreadedCode> m_threaded_code;
+    u64 m_threaded_code_modification_count;
     usize m_instruction_pointer;
+    // Whether the execution was suspended by `execute_for` after starting from an entry point of a verified package.
+    bool m_resumes_unchecked_execution;
+    Optional<Trap> m_last_trap;
     Optional<Bytecode::JumpAddress> m_jump_address;
+    DispatchMode m_dispatch_mode;
+    Bytecode::OpcodeProfile* m_opcode_profile;
+    const NativeCode* m_native_code;
+    TracingJit* m_tracing_jit;
 };
 
 }
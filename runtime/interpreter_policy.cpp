@@ -0,0 +1,29 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause.
+ */
+
+#include <bytecode/instruction.h>
+#include <bytecode/package.h>
+#include <runtime/interpreter.h>
+#include <runtime/interpreter_policy.h>
+
+namespace Arc::Runtime {
+
+void TracingInterpreterPolicy::before_instruction(Interpreter& interpreter, usize instruction_pointer)
+{
+    const String instruction = interpreter.package().fetch_instruction(instruction_pointer).to_string();
+    trace_builder.append("[{}] {}\n"sv, instruction_pointer, instruction);
+}
+
+void TracingInterpreterPolicy::on_call(Interpreter&, usize callee_address)
+{
+    trace_builder.append("  -> call {}\n"sv, callee_address);
+}
+
+void TracingInterpreterPolicy::on_return(Interpreter&, usize return_address)
+{
+    trace_builder.append("  <- return to {}\n"sv, return_address);
+}
+
+}
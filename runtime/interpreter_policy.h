@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause.
+ */
+
+#pragma once
+
+#include <core/containers/string_builder.h>
+#include <runtime/forward.h>
+
+namespace Arc::Runtime {
+
+//
+// The direct-threaded dispatch loop is instantiated for a policy type, which decides at compile time which safety
+// checks are performed and which hooks are invoked. Disabled hooks are never referenced by the instantiated loop, so
+// a policy without hooks has no overhead at all. Every policy derives from `InterpreterPolicy` and only overrides the
+// constants and the hooks that it needs.
+//
+// NOTE: The loop is only explicitly instantiated for the policies declared in this file.
+//
+struct InterpreterPolicy {
+    // Whether the register, stack and call stack accesses are validated. Unchecked policies are only used for verified
+    // packages that are executed from one of their entry points.
+    static constexpr bool is_checked = false;
+    // Whether the registers and the stack pointer are kept in local variables of the dispatch loop. The hooks observe
+    // the state of the virtual machine, so such policies can't have any.
+    static constexpr bool caches_registers = false;
+
+    static constexpr bool has_instruction_hooks = false;
+    static constexpr bool has_call_hooks = false;
+    // Whether the backward jumps and the calls consume fuel, in which case the execution is suspended when it runs out.
+    static constexpr bool consumes_fuel = false;
+
+    // Invoked before every instruction is executed.
+    ALWAYS_INLINE void before_instruction(Interpreter&, usize) {}
+    // Invoked after every instruction, with the instruction pointer of the next one.
+    ALWAYS_INLINE void after_instruction(Interpreter&, usize) {}
+
+    // Invoked after a call or tail call entered the callee.
+    ALWAYS_INLINE void on_call(Interpreter&, usize) {}
+    // Invoked after a return restored the frame of the caller.
+    ALWAYS_INLINE void on_return(Interpreter&, usize) {}
+
+    // Invoked after a backward jump, call or tail call. Returns false when the execution must be suspended.
+    NODISCARD ALWAYS_INLINE bool consume_fuel() { return true; }
+};
+
+// The production policy, used for verified packages.
+struct UncheckedInterpreterPolicy : public InterpreterPolicy {};
+
+// Used for the packages that haven't been verified, or that aren't executed from one of their entry points.
+struct CheckedInterpreterPolicy : public InterpreterPolicy {
+    static constexpr bool is_checked = true;
+};
+
+struct RegisterCachingInterpreterPolicy : public InterpreterPolicy {
+    static constexpr bool caches_registers = true;
+};
+
+// Counts the executed instructions, calls and returns.
+struct CountingInterpreterPolicy : public InterpreterPolicy {
+    static constexpr bool is_checked = true;
+    static constexpr bool has_instruction_hooks = true;
+    static constexpr bool has_call_hooks = true;
+
+    ALWAYS_INLINE void before_instruction(Interpreter&, usize) { ++executed_instruction_count; }
+    ALWAYS_INLINE void on_call(Interpreter&, usize) { ++call_count; }
+    ALWAYS_INLINE void on_return(Interpreter&, usize) { ++return_count; }
+
+    u64 executed_instruction_count { 0 };
+    u64 call_count { 0 };
+    u64 return_count { 0 };
+};
+
+// Writes every executed instruction, call and return to a string builder, one per line.
+struct TracingInterpreterPolicy : public InterpreterPolicy {
+    static constexpr bool is_checked = true;
+    static constexpr bool has_instruction_hooks = true;
+    static constexpr bool has_call_hooks = true;
+
+    explicit TracingInterpreterPolicy(StringBuilder& builder)
+        : trace_builder(builder)
+    {}
+
+    void before_instruction(Interpreter&, usize instruction_pointer);
+    void on_call(Interpreter&, usize callee_address);
+    void on_return(Interpreter&, usize return_address);
+
+    StringBuilder& trace_builder;
+};
+
+// Suspends the execution once the given amount of fuel is consumed. Only the backward jumps and the calls consume fuel,
+// as every loop and every recursion passes through one of them, so the straight-line code isn't slowed down at all.
+template<bool IsChecked>
+struct MeteredInterpreterPolicy : public InterpreterPolicy {
+    static constexpr bool is_checked = IsChecked;
+    static constexpr bool consumes_fuel = true;
+
+    explicit MeteredInterpreterPolicy(u64 fuel)
+        : remaining_fuel(fuel)
+    {}
+
+    NODISCARD ALWAYS_INLINE bool consume_fuel() { return --remaining_fuel != 0; }
+
+    u64 remaining_fuel;
+};
+
+// Invokes a callback before every instruction, which can inspect the state of the virtual machine. Used to step
+// through the execution of a program while debugging it.
+struct SingleSteppingInterpreterPolicy : public InterpreterPolicy {
+    using StepCallback = void (*)(Interpreter&, usize instruction_pointer, void* user_data);
+
+    static constexpr bool is_checked = true;
+    static constexpr bool has_instruction_hooks = true;
+
+    SingleSteppingInterpreterPolicy(StepCallback callback, void* user_data)
+        : step_callback(callback)
+        , step_user_data(user_data)
+    {}
+
+    ALWAYS_INLINE void before_instruction(Interpreter& interpreter, usize instruction_pointer)
+    {
+        step_callback(interpreter, instruction_pointer, step_user_data);
+    }
+
+    StepCallback step_callback;
+    void* step_user_data;
+};
+
+}
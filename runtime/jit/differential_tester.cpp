@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause.
+ */
+
+#include <core/containers/string_builder.h>
+#include <runtime/interpreter.h>
+#include <runtime/jit/differential_tester.h>
+#include <runtime/jit/jit_compiler.h>
+#include <runtime/jit/tracing_jit.h>
+
+namespace Arc::Runtime {
+
+ErrorOr<void> DifferentialTester::run(const Bytecode::Package& package, const NativeCode& native_code, Bytecode::JumpAddress entry_point,
+                                      const VirtualMachineConfiguration& virtual_machine_configuration)
+{
+    TRY_ASSIGN(OwnPtr<VirtualMachine> interpreted_virtual_machine, VirtualMachine::create(virtual_machine_configuration));
+    Interpreter interpreter(*interpreted_virtual_machine, package);
+    interpreter.set_entry_point(entry_point.address());
+    ErrorOr<void> interpreted_result = interpreter.execute();
+
+    TRY_ASSIGN(OwnPtr<VirtualMachine> native_virtual_machine, VirtualMachine::create(virtual_machine_configuration));
+    Interpreter native_interpreter(*native_virtual_machine, package);
+    native_interpreter.set_entry_point(entry_point.address());
+    native_interpreter.set_native_code(&native_code);
+    ErrorOr<void> native_result = native_interpreter.execute();
+
+    return compare(interpreted_result, *interpreted_virtual_machine, native_result, *native_virtual_machine);
+}
+
+ErrorOr<void> DifferentialTester::run(const Bytecode::Package& package, const TracingJitConfiguration& tracing_jit_configuration,
+                                      Bytecode::JumpAddress entry_point, const VirtualMachineConfiguration& virtual_machine_configuration)
+{
+    TRY_ASSIGN(OwnPtr<VirtualMachine> interpreted_virtual_machine, VirtualMachine::create(virtual_machine_configuration));
+    Interpreter interpreter(*interpreted_virtual_machine, package);
+    interpreter.set_entry_point(entry_point.address());
+    ErrorOr<void> interpreted_result = interpreter.execute();
+
+    TracingJit tracing_jit(package, tracing_jit_configuration);
+    TRY_ASSIGN(OwnPtr<VirtualMachine> native_virtual_machine, VirtualMachine::create(virtual_machine_configuration));
+    Interpreter native_interpreter(*native_virtual_machine, package);
+    native_interpreter.set_entry_point(entry_point.address());
+    native_interpreter.set_tracing_jit(&tracing_jit);
+    ErrorOr<void> native_result = native_interpreter.execute();
+
+    return compare(interpreted_result, *interpreted_virtual_machine, native_result, *native_virtual_machine);
+}
+
+ErrorOr<void> DifferentialTester::compare(const ErrorOr<void>& interpreted_result, const VirtualMachine& interpreted_virtual_machine,
+                                          const ErrorOr<void>& native_result, const VirtualMachine& native_virtual_machine)
+{
+    if (interpreted_result.is_error() != native_result.is_error())
+        return ARC_INTERNAL_ERROR_WITH_MESSAGE("Only one of the executions was aborted by a trap"sv);
+
+    // NOTE: The state of the virtual machine is unspecified after a trap, so only the outcome can be compared.
+    if (interpreted_result.is_error())
+        return {};
+
+    for (u8 register_index = 0; register_index < static_cast<u8>(Bytecode::Register::Count); ++register_index) {
+        const auto reg = static_cast<Bytecode::Register>(register_index);
+        const VirtualMachine::RegisterStorage& interpreted_value = interpreted_virtual_machine.register_storage(reg);
+        const VirtualMachine::RegisterStorage& native_value = native_virtual_machine.register_storage(reg);
+        if (interpreted_value.value != native_value.value) {
+            return ARC_INTERNAL_ERROR_WITH_MESSAGE(
+                StringBuilder::formatted("Register {} holds {} when interpreted, but {} when executed natively"sv, reg, interpreted_value,
+                                         native_value));
+        }
+    }
+
+    const VirtualStack& interpreted_stack = interpreted_virtual_machine.stack();
+    const VirtualStack& native_stack = native_virtual_machine.stack();
+    if (interpreted_stack.pushed_byte_count() != native_stack.pushed_byte_count())
+        return ARC_INTERNAL_ERROR_WITH_MESSAGE("The executions left a different number of bytes on the stack"sv);
+
+    for (usize byte_offset = 0; byte_offset < interpreted_stack.pushed_byte_count(); ++byte_offset) {
+        if (interpreted_stack.stack_pointer_address()[byte_offset] != native_stack.stack_pointer_address()[byte_offset]) {
+            return ARC_INTERNAL_ERROR_WITH_MESSAGE(
+                StringBuilder::formatted("The stack differs at offset {} from the stack pointer"sv, byte_offset));
+        }
+    }
+
+    return {};
+}
+
+}
@@ -0,0 +1,38 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause.
+ */
+
+#pragma once
+
+#include <bytecode/forward.h>
+#include <bytecode/jump_address.h>
+#include <core/error.h>
+#include <runtime/forward.h>
+#include <runtime/virtual_machine.h>
+
+namespace Arc::Runtime {
+
+//
+// Validates the native code generated by a JIT compiler against the interpreter. The package is executed twice
+// from the same entry point, on two separate virtual machines: once only by the interpreter and once with the native
+// code, or with a tracing JIT that compiles the hot loops of that execution. Both executions must end in the same
+// way, and when neither of them is aborted by a trap the registers of the root window and the contents of the stack
+// must be identical.
+//
+class DifferentialTester {
+    ARC_MAKE_NAMESPACE_CLASS(DifferentialTester)
+
+public:
+    // Returns an error describing the first difference between the two executions, if any.
+    NODISCARD static ErrorOr<void> run(const Bytecode::Package&, const NativeCode&, Bytecode::JumpAddress entry_point,
+                                       const VirtualMachineConfiguration& virtual_machine_configuration);
+    NODISCARD static ErrorOr<void> run(const Bytecode::Package&, const TracingJitConfiguration&, Bytecode::JumpAddress entry_point,
+                                       const VirtualMachineConfiguration& virtual_machine_configuration);
+
+private:
+    NODISCARD static ErrorOr<void> compare(const ErrorOr<void>& interpreted_result, const VirtualMachine& interpreted_virtual_machine,
+                                           const ErrorOr<void>& native_result, const VirtualMachine& native_virtual_machine);
+};
+
+}
@@ -0,0 +1,924 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause.
+ */
+
+#include <bytecode/instruction.h>
+#include <bytecode/package.h>
+#include <core/containers/optional.h>
+#include <core/memory/memory_operations.h>
+#include <runtime/jit/jit_compiler.h>
+#include <runtime/jit/native_frame.h>
+#include <runtime/jit/tracing_jit.h>
+#include <runtime/jit/x64_assembler.h>
+#include <runtime/virtual_machine.h>
+
+#include <cstddef>
+
+namespace Arc::Runtime {
+
+using namespace Arc::Bytecode;
+
+// NOTE: The base registers are callee-saved, so they are preserved by the trampoline.
+static constexpr X64Register registers_base_register = X64Register::R15;
+static constexpr X64Register stack_pointer_base_register = X64Register::R14;
+static constexpr X64Register frame_pointer_base_register = X64Register::R13;
+
+// The host registers that hold the first virtual registers of the current window while the native code executes.
+// The remaining virtual registers are accessed in memory, relative to the registers base.
+static constexpr X64Register mapped_host_registers[] = {
+    X64Register::RBX, X64Register::RBP, X64Register::R12, X64Register::RSI,
+    X64Register::RDI, X64Register::R8,  X64Register::R9,  X64Register::R10,
+};
+static constexpr usize mapped_register_count = sizeof(mapped_host_registers) / sizeof(mapped_host_registers[0]);
+
+// The registers that are pushed by the trampoline, as required by the System V calling convention.
+static constexpr X64Register callee_saved_host_registers[] = {
+    X64Register::RBX, X64Register::RBP, X64Register::R12, X64Register::R13, X64Register::R14, X64Register::R15,
+};
+static constexpr usize callee_saved_register_count = sizeof(callee_saved_host_registers) / sizeof(callee_saved_host_registers[0]);
+
+// NOTE: The scratch registers are never mapped to virtual registers, so they can be clobbered by any instruction.
+static constexpr X64Register first_scratch_register = X64Register::RAX;
+static constexpr X64Register second_scratch_register = X64Register::RCX;
+static constexpr X64Register third_scratch_register = X64Register::RDX;
+
+template<typename... Registers>
+NODISCARD static bool registers_are_valid(Registers... registers)
+{
+    return ((static_cast<u8>(registers) < static_cast<u8>(Register::Count)) && ...);
+}
+
+NODISCARD ALWAYS_INLINE static bool fits_in_s32(s64 value)
+{
+    return value >= -2147483648LL && value <= 2147483647LL;
+}
+
+NODISCARD ALWAYS_INLINE static X64Memory register_memory(Register reg)
+{
+    const s32 displacement = static_cast<s32>(static_cast<u8>(reg) * sizeof(VirtualMachine::RegisterStorage));
+    return { registers_base_register, displacement };
+}
+
+NODISCARD static Optional<X64Memory> stack_memory(u64 stack_offset)
+{
+    if (stack_offset > 2147483647ULL)
+        return {};
+    return X64Memory { stack_pointer_base_register, static_cast<s32>(stack_offset) };
+}
+
+NODISCARD static Optional<X64Memory> frame_memory(s64 frame_offset)
+{
+    if (!fits_in_s32(frame_offset))
+        return {};
+    return X64Memory { frame_pointer_base_register, static_cast<s32>(frame_offset) };
+}
+
+NODISCARD static Optional<X64Condition> comparison_condition(OpCode opcode)
+{
+    switch (opcode) {
+        case OpCode::CompareEqual: return X64Condition::Equal;
+        case OpCode::CompareNotEqual: return X64Condition::NotEqual;
+        case OpCode::CompareGreater: return X64Condition::Above;
+        case OpCode::CompareGreaterOrEqual: return X64Condition::AboveOrEqual;
+        case OpCode::CompareLess: return X64Condition::Below;
+        case OpCode::CompareLessOrEqual: return X64Condition::BelowOrEqual;
+        case OpCode::CompareGreaterSigned: return X64Condition::Greater;
+        case OpCode::CompareGreaterOrEqualSigned: return X64Condition::GreaterOrEqual;
+        case OpCode::CompareLessSigned: return X64Condition::Less;
+        case OpCode::CompareLessOrEqualSigned: return X64Condition::LessOrEqual;
+        default: return {};
+    }
+}
+
+NODISCARD static JumpAddress conditional_jump_address(const Instruction& instruction)
+{
+    switch (instruction.opcode()) {
+        case OpCode::JumpIf: return instruction.as<JumpIfInstruction>().jump_address();
+        case OpCode::FusedCompareGreaterJumpIf: return instruction.as<FusedCompareGreaterJumpIfInstruction>().jump_address();
+        case OpCode::FusedCompareGreaterImmediateJumpIf:
+            return instruction.as<FusedCompareGreaterImmediateJumpIfInstruction>().jump_address();
+        default: ARC_ASSERT_NOT_REACHED;
+    }
+}
+
+class CompilationContext {
+public:
+    explicit CompilationContext(const Package& package)
+        : m_package(package)
+    {}
+
+    // Emits the native code of the whole package. Returns the encoded code and the native code offset of every
+    // instruction, which is `NativeCode::no_native_offset` for instructions that are executed by the interpreter.
+    NODISCARD Vector<u8> compile(Vector<u32>& instruction_native_offsets);
+
+    // Emits the native code of the trace. Returns the encoded code and the native code offset of the trace header, or
+    // nothing when the first instruction of the trace has no native translation.
+    NODISCARD Optional<Vector<u8>> compile_trace(const Trace& trace, u32& header_native_offset);
+
+private:
+    struct PendingJumpTable {
+        X64Label label;
+        u32 first_entry_index;
+        u32 entry_count;
+    };
+
+    struct PendingSideExit {
+        X64Label label;
+        usize instruction_pointer;
+    };
+
+    void emit_trampoline();
+    void emit_epilogue();
+    void emit_exit(usize instruction_pointer);
+
+    // Tries to emit the native translation of the instruction. When false is returned no code has been emitted, as the
+    // instruction is either not supported or its operands can't be encoded.
+    NODISCARD bool emit_instruction(usize instruction_pointer);
+    NODISCARD bool jump_address_is_valid(JumpAddress jump_address) const;
+
+    // Emits the evaluation of the condition of a conditional jump, after which the `NotEqual` condition holds when
+    // the jump is taken. When false is returned no code has been emitted, as the registers can't be encoded.
+    NODISCARD bool emit_jump_condition(const Instruction& instruction);
+
+    // Tries to emit the instruction of a trace, which continues at the next instruction pointer. Conditional jumps
+    // become guards that leave the trace when the jump doesn't go in the recorded direction.
+    NODISCARD bool emit_trace_instruction(usize instruction_pointer, usize next_instruction_pointer);
+    void emit_side_exit_if(X64Condition condition, usize instruction_pointer);
+
+    // Returns the host register that holds the value of the virtual register, which is `scratch_register` when the
+    // virtual register isn't mapped to a host register. In that case, its value is loaded into `scratch_register`.
+    NODISCARD X64Register read_register(Register reg, X64Register scratch_register);
+    void load_register(X64Register dst_register, Register reg);
+    void write_register(Register reg, X64Register src_register);
+
+    // Applies the operation to the host register and the immediate value, using `scratch_register` when the value
+    // can't be encoded as a sign extended 32-bit immediate.
+    void emit_arithmetic_immediate(X64ArithmeticOperation operation, X64Register dst_register, u64 immediate_value,
+                                   X64Register scratch_register);
+
+    NODISCARD ALWAYS_INLINE X64Label label_of(JumpAddress jump_address) const { return m_instruction_labels[jump_address.address()]; }
+
+private:
+    const Package& m_package;
+    X64Assembler m_assembler;
+    Vector<X64Label> m_instruction_labels;
+    X64Label m_epilogue_label { 0 };
+    Vector<PendingJumpTable> m_pending_jump_tables;
+    Vector<PendingSideExit> m_pending_side_exits;
+};
+
+Vector<u8> CompilationContext::compile(Vector<u32>& instruction_native_offsets)
+{
+    const usize instruction_count = m_package.instruction_count();
+    // NOTE: The additional label marks the end of the package, which can be the target of a fall-through.
+    for (usize instruction_pointer = 0; instruction_pointer <= instruction_count; ++instruction_pointer)
+        m_instruction_labels.push_back(m_assembler.create_label());
+    m_epilogue_label = m_assembler.create_label();
+
+    emit_trampoline();
+    emit_epilogue();
+
+    instruction_native_offsets.set_count_defaulted(instruction_count);
+    for (usize instruction_pointer = 0; instruction_pointer < instruction_count; ++instruction_pointer) {
+        m_assembler.bind_label(m_instruction_labels[instruction_pointer]);
+        const u32 native_offset = m_assembler.current_offset();
+        if (emit_instruction(instruction_pointer)) {
+            instruction_native_offsets[instruction_pointer] = native_offset;
+        }
+        else {
+            // NOTE: Jumping to an instruction that has no native translation returns to the interpreter.
+            instruction_native_offsets[instruction_pointer] = NativeCode::no_native_offset;
+            emit_exit(instruction_pointer);
+        }
+    }
+
+    m_assembler.bind_label(m_instruction_labels[instruction_count]);
+    emit_exit(instruction_count);
+
+    // The jump tables store the offsets of their targets relative to the beginning of the table.
+    for (const PendingJumpTable& jump_table : m_pending_jump_tables) {
+        m_assembler.bind_label(jump_table.label);
+        const u32 jump_table_offset = m_assembler.current_offset();
+        for (u32 entry_index = 0; entry_index < jump_table.entry_count; ++entry_index) {
+            const JumpAddress target = m_package.fetch_jump_table_entry(jump_table.first_entry_index + entry_index);
+            m_assembler.emit_label_offset(label_of(target), jump_table_offset);
+        }
+    }
+
+    return m_assembler.finalize();
+}
+
+Optional<Vector<u8>> CompilationContext::compile_trace(const Trace& trace, u32& header_native_offset)
+{
+    m_epilogue_label = m_assembler.create_label();
+    emit_trampoline();
+    emit_epilogue();
+
+    const X64Label header_label = m_assembler.create_label();
+    m_assembler.bind_label(header_label);
+    header_native_offset = m_assembler.current_offset();
+
+    bool is_complete = true;
+    for (usize index = 0; index < trace.instruction_pointers.count(); ++index) {
+        const usize instruction_pointer = trace.instruction_pointers[index];
+        const bool is_last = index + 1 == trace.instruction_pointers.count();
+        const usize next_instruction_pointer = is_last ? trace.exit_instruction_pointer : trace.instruction_pointers[index + 1];
+        if (emit_trace_instruction(instruction_pointer, next_instruction_pointer))
+            continue;
+
+        // NOTE: Entering a trace that immediately exits at its header would never make progress.
+        if (index == 0)
+            return {};
+
+        // The trace is cut at the first instruction that has no native translation.
+        emit_exit(instruction_pointer);
+        is_complete = false;
+        break;
+    }
+
+    if (is_complete) {
+        if (trace.is_loop())
+            m_assembler.jump(header_label);
+        else
+            emit_exit(trace.exit_instruction_pointer);
+    }
+
+    // NOTE: The side exits are placed after the trace, so that the recorded path has no taken jumps.
+    for (const PendingSideExit& side_exit : m_pending_side_exits) {
+        m_assembler.bind_label(side_exit.label);
+        emit_exit(side_exit.instruction_pointer);
+    }
+
+    return m_assembler.finalize();
+}
+
+void CompilationContext::emit_trampoline()
+{
+    for (usize index = 0; index < callee_saved_register_count; ++index)
+        m_assembler.push(callee_saved_host_registers[index]);
+
+    // NOTE: The frame is passed in RDI and the target address in RSI, both of which are mapped registers.
+    m_assembler.load(registers_base_register, { X64Register::RDI, static_cast<s32>(offsetof(NativeFrame, registers)) });
+    m_assembler.load(stack_pointer_base_register, { X64Register::RDI, static_cast<s32>(offsetof(NativeFrame, stack_pointer)) });
+    m_assembler.load(frame_pointer_base_register, { X64Register::RDI, static_cast<s32>(offsetof(NativeFrame, frame_pointer)) });
+    m_assembler.move(first_scratch_register, X64Register::RSI);
+
+    for (usize index = 0; index < mapped_register_count; ++index)
+        m_assembler.load(mapped_host_registers[index], register_memory(static_cast<Register>(index)));
+    m_assembler.jump_to_register(first_scratch_register);
+}
+
+void CompilationContext::emit_epilogue()
+{
+    // NOTE: The instruction pointer at which the interpreter resumes is already in RAX, which is the return register.
+    m_assembler.bind_label(m_epilogue_label);
+    for (usize index = 0; index < mapped_register_count; ++index)
+        m_assembler.store(register_memory(static_cast<Register>(index)), mapped_host_registers[index]);
+
+    for (usize index = callee_saved_register_count; index > 0; --index)
+        m_assembler.pop(callee_saved_host_registers[index - 1]);
+    m_assembler.ret();
+}
+
+void CompilationContext::emit_exit(usize instruction_pointer)
+{
+    m_assembler.move_immediate(first_scratch_register, instruction_pointer);
+    m_assembler.jump(m_epilogue_label);
+}
+
+void CompilationContext::emit_side_exit_if(X64Condition condition, usize instruction_pointer)
+{
+    const X64Label side_exit_label = m_assembler.create_label();
+    m_assembler.jump_if(condition, side_exit_label);
+    m_pending_side_exits.push_back({ side_exit_label, instruction_pointer });
+}
+
+bool CompilationContext::jump_address_is_valid(JumpAddress jump_address) const
+{
+    return jump_address.address() <= m_package.instruction_count();
+}
+
+X64Register CompilationContext::read_register(Register reg, X64Register scratch_register)
+{
+    const u8 register_index = static_cast<u8>(reg);
+    if (register_index < mapped_register_count)
+        return mapped_host_registers[register_index];
+
+    m_assembler.load(scratch_register, register_memory(reg));
+    return scratch_register;
+}
+
+void CompilationContext::load_register(X64Register dst_register, Register reg)
+{
+    const X64Register src_register = read_register(reg, dst_register);
+    if (src_register != dst_register)
+        m_assembler.move(dst_register, src_register);
+}
+
+void CompilationContext::write_register(Register reg, X64Register src_register)
+{
+    const u8 register_index = static_cast<u8>(reg);
+    if (register_index < mapped_register_count) {
+        if (mapped_host_registers[register_index] != src_register)
+            m_assembler.move(mapped_host_registers[register_index], src_register);
+        return;
+    }
+
+    m_assembler.store(register_memory(reg), src_register);
+}
+
+void CompilationContext::emit_arithmetic_immediate(X64ArithmeticOperation operation, X64Register dst_register, u64 immediate_value,
+                                                   X64Register scratch_register)
+{
+    const s64 signed_immediate_value = static_cast<s64>(immediate_value);
+    if (fits_in_s32(signed_immediate_value)) {
+        m_assembler.arithmetic_immediate(operation, dst_register, static_cast<s32>(signed_immediate_value));
+        return;
+    }
+
+    m_assembler.move_immediate(scratch_register, immediate_value);
+    m_assembler.arithmetic(operation, dst_register, scratch_register);
+}
+
+bool CompilationContext::emit_instruction(usize instruction_pointer)
+{
+    const Instruction& instruction = m_package.fetch_instruction(instruction_pointer);
+    const X64Register rax = first_scratch_register;
+    const X64Register rcx = second_scratch_register;
+    const X64Register rdx = third_scratch_register;
+
+    switch (instruction.opcode()) {
+        case OpCode::Add:
+        case OpCode::BitwiseAND:
+        case OpCode::BitwiseOR:
+        case OpCode::BitwiseXOR:
+        case OpCode::Sub: {
+            // NOTE: All three-register instructions share the same layout.
+            const auto& typed_instruction = static_cast<const AddInstruction&>(instruction);
+            if (!registers_are_valid(typed_instruction.dst_register(), typed_instruction.lhs_register(), typed_instruction.rhs_register()))
+                return false;
+
+            X64ArithmeticOperation operation = X64ArithmeticOperation::Add;
+            if (instruction.opcode() == OpCode::BitwiseAND)
+                operation = X64ArithmeticOperation::And;
+            else if (instruction.opcode() == OpCode::BitwiseOR)
+                operation = X64ArithmeticOperation::Or;
+            else if (instruction.opcode() == OpCode::BitwiseXOR)
+                operation = X64ArithmeticOperation::Xor;
+            else if (instruction.opcode() == OpCode::Sub)
+                operation = X64ArithmeticOperation::Sub;
+
+            load_register(rax, typed_instruction.lhs_register());
+            m_assembler.arithmetic(operation, rax, read_register(typed_instruction.rhs_register(), rcx));
+            write_register(typed_instruction.dst_register(), rax);
+            return true;
+        }
+
+        case OpCode::Multiply: {
+            const auto& typed_instruction = instruction.as<MultiplyInstruction>();
+            if (!registers_are_valid(typed_instruction.dst_register(), typed_instruction.lhs_register(), typed_instruction.rhs_register()))
+                return false;
+
+            load_register(rax, typed_instruction.lhs_register());
+            m_assembler.multiply(rax, read_register(typed_instruction.rhs_register(), rcx));
+            write_register(typed_instruction.dst_register(), rax);
+            return true;
+        }
+
+        case OpCode::BitwiseLeftShift:
+        case OpCode::BitwiseRightShift:
+        case OpCode::BitwiseRightShiftSigned: {
+            const auto& typed_instruction = static_cast<const AddInstruction&>(instruction);
+            if (!registers_are_valid(typed_instruction.dst_register(), typed_instruction.lhs_register(), typed_instruction.rhs_register()))
+                return false;
+
+            X64ShiftOperation operation = X64ShiftOperation::ShiftLeft;
+            if (instruction.opcode() == OpCode::BitwiseRightShift)
+                operation = X64ShiftOperation::ShiftRight;
+            else if (instruction.opcode() == OpCode::BitwiseRightShiftSigned)
+                operation = X64ShiftOperation::ShiftRightSigned;
+
+            // NOTE: The processor reduces the shift count modulo 64, which matches `IntegerArithmetic`.
+            load_register(rcx, typed_instruction.rhs_register());
+            load_register(rax, typed_instruction.lhs_register());
+            m_assembler.shift_by_cl(operation, rax);
+            write_register(typed_instruction.dst_register(), rax);
+            return true;
+        }
+
+        case OpCode::CompareEqual:
+        case OpCode::CompareGreater:
+        case OpCode::CompareGreaterOrEqual:
+        case OpCode::CompareGreaterOrEqualSigned:
+        case OpCode::CompareGreaterSigned:
+        case OpCode::CompareLess:
+        case OpCode::CompareLessOrEqual:
+        case OpCode::CompareLessOrEqualSigned:
+        case OpCode::CompareLessSigned:
+        case OpCode::CompareNotEqual: {
+            const auto& typed_instruction = static_cast<const AddInstruction&>(instruction);
+            if (!registers_are_valid(typed_instruction.dst_register(), typed_instruction.lhs_register(), typed_instruction.rhs_register()))
+                return false;
+
+            const X64Register lhs_register = read_register(typed_instruction.lhs_register(), rax);
+            m_assembler.arithmetic(X64ArithmeticOperation::Compare, lhs_register, read_register(typed_instruction.rhs_register(), rcx));
+            m_assembler.set_if(comparison_condition(instruction.opcode()).value(), rax);
+            write_register(typed_instruction.dst_register(), rax);
+            return true;
+        }
+
+        case OpCode::LogicalAND:
+        case OpCode::LogicalOR:
+        case OpCode::LogicalXOR: {
+            const auto& typed_instruction = static_cast<const AddInstruction&>(instruction);
+            if (!registers_are_valid(typed_instruction.dst_register(), typed_instruction.lhs_register(), typed_instruction.rhs_register()))
+                return false;
+
+            X64ArithmeticOperation operation = X64ArithmeticOperation::And;
+            if (instruction.opcode() == OpCode::LogicalOR)
+                operation = X64ArithmeticOperation::Or;
+            else if (instruction.opcode() == OpCode::LogicalXOR)
+                operation = X64ArithmeticOperation::Xor;
+
+            // Both operands are converted to booleans before the bitwise operation is applied.
+            const X64Register lhs_register = read_register(typed_instruction.lhs_register(), rax);
+            m_assembler.test(lhs_register, lhs_register);
+            m_assembler.set_if(X64Condition::NotEqual, rdx);
+            const X64Register rhs_register = read_register(typed_instruction.rhs_register(), rcx);
+            m_assembler.test(rhs_register, rhs_register);
+            m_assembler.set_if(X64Condition::NotEqual, rax);
+            m_assembler.arithmetic(operation, rax, rdx);
+            write_register(typed_instruction.dst_register(), rax);
+            return true;
+        }
+
+        case OpCode::AddImmediate:
+        case OpCode::SubImmediate: {
+            // NOTE: All register-immediate arithmetic instructions share the same layout.
+            const auto& typed_instruction = static_cast<const AddImmediateInstruction&>(instruction);
+            if (!registers_are_valid(typed_instruction.dst_register(), typed_instruction.lhs_register()))
+                return false;
+
+            const X64ArithmeticOperation operation =
+                instruction.opcode() == OpCode::AddImmediate ? X64ArithmeticOperation::Add : X64ArithmeticOperation::Sub;
+            load_register(rax, typed_instruction.lhs_register());
+            emit_arithmetic_immediate(operation, rax, typed_instruction.immediate_value(), rcx);
+            write_register(typed_instruction.dst_register(), rax);
+            return true;
+        }
+
+        case OpCode::CompareGreaterImmediate: {
+            const auto& typed_instruction = instruction.as<CompareGreaterImmediateInstruction>();
+            if (!registers_are_valid(typed_instruction.dst_register(), typed_instruction.lhs_register()))
+                return false;
+
+            const X64Register lhs_register = read_register(typed_instruction.lhs_register(), rax);
+            emit_arithmetic_immediate(X64ArithmeticOperation::Compare, lhs_register, typed_instruction.immediate_value(), rcx);
+            m_assembler.set_if(X64Condition::Above, rax);
+            write_register(typed_instruction.dst_register(), rax);
+            return true;
+        }
+
+        case OpCode::Decrement:
+        case OpCode::Increment: {
+            // NOTE: Both instructions share the same layout.
+            const auto& typed_instruction = static_cast<const IncrementInstruction&>(instruction);
+            if (!registers_are_valid(typed_instruction.dst_register()))
+                return false;
+
+            const X64ArithmeticOperation operation =
+                instruction.opcode() == OpCode::Increment ? X64ArithmeticOperation::Add : X64ArithmeticOperation::Sub;
+            const X64Register dst_register = read_register(typed_instruction.dst_register(), rax);
+            m_assembler.arithmetic_immediate(operation, dst_register, 1);
+            write_register(typed_instruction.dst_register(), dst_register);
+            return true;
+        }
+
+        case OpCode::Move: {
+            const auto& typed_instruction = instruction.as<MoveInstruction>();
+            if (!registers_are_valid(typed_instruction.dst_register(), typed_instruction.src_register()))
+                return false;
+
+            write_register(typed_instruction.dst_register(), read_register(typed_instruction.src_register(), rax));
+            return true;
+        }
+
+        case OpCode::BitwiseNOT:
+        case OpCode::Negate: {
+            const auto& typed_instruction = static_cast<const MoveInstruction&>(instruction);
+            if (!registers_are_valid(typed_instruction.dst_register(), typed_instruction.src_register()))
+                return false;
+
+            load_register(rax, typed_instruction.src_register());
+            if (instruction.opcode() == OpCode::Negate)
+                m_assembler.negate(rax);
+            else
+                m_assembler.bitwise_not(rax);
+            write_register(typed_instruction.dst_register(), rax);
+            return true;
+        }
+
+        case OpCode::LogicalNOT: {
+            const auto& typed_instruction = instruction.as<LogicalNOTInstruction>();
+            if (!registers_are_valid(typed_instruction.dst_register(), typed_instruction.src_register()))
+                return false;
+
+            const X64Register src_register = read_register(typed_instruction.src_register(), rax);
+            m_assembler.test(src_register, src_register);
+            m_assembler.set_if(X64Condition::Equal, rax);
+            write_register(typed_instruction.dst_register(), rax);
+            return true;
+        }
+
+        case OpCode::SignExtend8:
+        case OpCode::SignExtend16:
+        case OpCode::SignExtend32: {
+            const auto& typed_instruction = static_cast<const MoveInstruction&>(instruction);
+            if (!registers_are_valid(typed_instruction.dst_register(), typed_instruction.src_register()))
+                return false;
+
+            const X64Register src_register = read_register(typed_instruction.src_register(), rax);
+            if (instruction.opcode() == OpCode::SignExtend8)
+                m_assembler.sign_extend_8(rax, src_register);
+            else if (instruction.opcode() == OpCode::SignExtend16)
+                m_assembler.sign_extend_16(rax, src_register);
+            else
+                m_assembler.sign_extend_32(rax, src_register);
+            write_register(typed_instruction.dst_register(), rax);
+            return true;
+        }
+
+        case OpCode::LoadImmediate8:
+        case OpCode::LoadImmediate16:
+        case OpCode::LoadImmediate32:
+        case OpCode::LoadImmediate64: {
+            Register dst_register = Register::Count;
+            u64 immediate_value = 0;
+            if (instruction.opcode() == OpCode::LoadImmediate8) {
+                dst_register = instruction.as<LoadImmediate8Instruction>().dst_register();
+                immediate_value = instruction.as<LoadImmediate8Instruction>().immediate_value();
+            }
+            else if (instruction.opcode() == OpCode::LoadImmediate16) {
+                dst_register = instruction.as<LoadImmediate16Instruction>().dst_register();
+                immediate_value = instruction.as<LoadImmediate16Instruction>().immediate_value();
+            }
+            else if (instruction.opcode() == OpCode::LoadImmediate32) {
+                dst_register = instruction.as<LoadImmediate32Instruction>().dst_register();
+                immediate_value = instruction.as<LoadImmediate32Instruction>().immediate_value();
+            }
+            else {
+                dst_register = instruction.as<LoadImmediate64Instruction>().dst_register();
+                immediate_value = instruction.as<LoadImmediate64Instruction>().immediate_value();
+            }
+
+            if (!registers_are_valid(dst_register))
+                return false;
+            m_assembler.move_immediate(rax, immediate_value);
+            write_register(dst_register, rax);
+            return true;
+        }
+
+        case OpCode::LoadFromFrame: {
+            const auto& typed_instruction = instruction.as<LoadFromFrameInstruction>();
+            const Optional<X64Memory> src_memory = frame_memory(typed_instruction.src_frame_offset());
+            if (!registers_are_valid(typed_instruction.dst_register()) || !src_memory.has_value())
+                return false;
+
+            m_assembler.load(rax, src_memory.value());
+            write_register(typed_instruction.dst_register(), rax);
+            return true;
+        }
+
+        case OpCode::LoadFromStack:
+        case OpCode::Load8FromStack:
+        case OpCode::Load16FromStack:
+        case OpCode::Load32FromStack: {
+            // NOTE: All the stack load instructions share the same layout.
+            const auto& typed_instruction = static_cast<const LoadFromStackInstruction&>(instruction);
+            const Optional<X64Memory> src_memory = stack_memory(typed_instruction.src_stack_offset());
+            if (!registers_are_valid(typed_instruction.dst_register()) || !src_memory.has_value())
+                return false;
+
+            if (instruction.opcode() == OpCode::Load8FromStack)
+                m_assembler.load_zero_extended_8(rax, src_memory.value());
+            else if (instruction.opcode() == OpCode::Load16FromStack)
+                m_assembler.load_zero_extended_16(rax, src_memory.value());
+            else if (instruction.opcode() == OpCode::Load32FromStack)
+                m_assembler.load_zero_extended_32(rax, src_memory.value());
+            else
+                m_assembler.load(rax, src_memory.value());
+            write_register(typed_instruction.dst_register(), rax);
+            return true;
+        }
+
+        case OpCode::StoreToFrame: {
+            const auto& typed_instruction = instruction.as<StoreToFrameInstruction>();
+            const Optional<X64Memory> dst_memory = frame_memory(typed_instruction.dst_frame_offset());
+            if (!registers_are_valid(typed_instruction.src_register()) || !dst_memory.has_value())
+                return false;
+
+            m_assembler.store(dst_memory.value(), read_register(typed_instruction.src_register(), rax));
+            return true;
+        }
+
+        case OpCode::StoreToStack:
+        case OpCode::Store8ToStack:
+        case OpCode::Store16ToStack:
+        case OpCode::Store32ToStack: {
+            // NOTE: All the stack store instructions share the same layout.
+            const auto& typed_instruction = static_cast<const StoreToStackInstruction&>(instruction);
+            const Optional<X64Memory> dst_memory = stack_memory(typed_instruction.dst_stack_offset());
+            if (!registers_are_valid(typed_instruction.src_register()) || !dst_memory.has_value())
+                return false;
+
+            const X64Register src_register = read_register(typed_instruction.src_register(), rax);
+            if (instruction.opcode() == OpCode::Store8ToStack)
+                m_assembler.store_8(dst_memory.value(), src_register);
+            else if (instruction.opcode() == OpCode::Store16ToStack)
+                m_assembler.store_16(dst_memory.value(), src_register);
+            else if (instruction.opcode() == OpCode::Store32ToStack)
+                m_assembler.store_32(dst_memory.value(), src_register);
+            else
+                m_assembler.store(dst_memory.value(), src_register);
+            return true;
+        }
+
+        case OpCode::FusedLoadAddStore: {
+            const auto& typed_instruction = instruction.as<FusedLoadAddStoreInstruction>();
+            const Optional<X64Memory> src_memory = stack_memory(typed_instruction.src_stack_offset());
+            const Optional<X64Memory> dst_memory = stack_memory(typed_instruction.dst_stack_offset());
+            if (!registers_are_valid(typed_instruction.dst_register(), typed_instruction.loaded_register(),
+                                     typed_instruction.other_register()) ||
+                !src_memory.has_value() || !dst_memory.has_value()) {
+                return false;
+            }
+
+            // NOTE: The other register is read after the loaded register is written, as they can be the same register.
+            m_assembler.load(rax, src_memory.value());
+            write_register(typed_instruction.loaded_register(), rax);
+            m_assembler.arithmetic(X64ArithmeticOperation::Add, rax, read_register(typed_instruction.other_register(), rcx));
+            write_register(typed_instruction.dst_register(), rax);
+            m_assembler.store(dst_memory.value(), rax);
+            return true;
+        }
+
+        case OpCode::FusedLoadIncrementStore: {
+            const auto& typed_instruction = instruction.as<FusedLoadIncrementStoreInstruction>();
+            const Optional<X64Memory> memory = stack_memory(typed_instruction.stack_offset());
+            if (!registers_are_valid(typed_instruction.dst_register()) || !memory.has_value())
+                return false;
+
+            m_assembler.load(rax, memory.value());
+            m_assembler.arithmetic_immediate(X64ArithmeticOperation::Add, rax, 1);
+            m_assembler.store(memory.value(), rax);
+            write_register(typed_instruction.dst_register(), rax);
+            return true;
+        }
+
+        case OpCode::FusedLoadPair: {
+            const auto& typed_instruction = instruction.as<FusedLoadPairInstruction>();
+            const Optional<X64Memory> first_src_memory = stack_memory(typed_instruction.first_src_stack_offset());
+            const Optional<X64Memory> second_src_memory = stack_memory(typed_instruction.second_src_stack_offset());
+            if (!registers_are_valid(typed_instruction.first_dst_register(), typed_instruction.second_dst_register()) ||
+                !first_src_memory.has_value() || !second_src_memory.has_value()) {
+                return false;
+            }
+
+            m_assembler.load(rax, first_src_memory.value());
+            write_register(typed_instruction.first_dst_register(), rax);
+            m_assembler.load(rax, second_src_memory.value());
+            write_register(typed_instruction.second_dst_register(), rax);
+            return true;
+        }
+
+        case OpCode::FusedLoadStore: {
+            const auto& typed_instruction = instruction.as<FusedLoadStoreInstruction>();
+            const Optional<X64Memory> src_memory = stack_memory(typed_instruction.src_stack_offset());
+            const Optional<X64Memory> dst_memory = stack_memory(typed_instruction.dst_stack_offset());
+            if (!registers_are_valid(typed_instruction.dst_register()) || !src_memory.has_value() || !dst_memory.has_value())
+                return false;
+
+            m_assembler.load(rax, src_memory.value());
+            write_register(typed_instruction.dst_register(), rax);
+            m_assembler.store(dst_memory.value(), rax);
+            return true;
+        }
+
+        case OpCode::Jump: {
+            const auto& typed_instruction = instruction.as<JumpInstruction>();
+            if (!jump_address_is_valid(typed_instruction.jump_address()))
+                return false;
+
+            m_assembler.jump(label_of(typed_instruction.jump_address()));
+            return true;
+        }
+
+        case OpCode::FusedCompareGreaterImmediateJumpIf:
+        case OpCode::FusedCompareGreaterJumpIf:
+        case OpCode::JumpIf: {
+            const JumpAddress jump_address = conditional_jump_address(instruction);
+            if (!jump_address_is_valid(jump_address) || !emit_jump_condition(instruction))
+                return false;
+
+            m_assembler.jump_if(X64Condition::NotEqual, label_of(jump_address));
+            return true;
+        }
+
+        case OpCode::JumpTable: {
+            const auto& typed_instruction = instruction.as<JumpTableInstruction>();
+            if (!registers_are_valid(typed_instruction.index_register()) || !jump_address_is_valid(typed_instruction.default_address()) ||
+                !m_package.jump_table_is_valid(typed_instruction.first_entry_index(), typed_instruction.entry_count()) ||
+                !fits_in_s32(typed_instruction.entry_count())) {
+                return false;
+            }
+            for (u32 entry_index = 0; entry_index < typed_instruction.entry_count(); ++entry_index) {
+                if (!jump_address_is_valid(m_package.fetch_jump_table_entry(typed_instruction.first_entry_index() + entry_index)))
+                    return false;
+            }
+
+            // NOTE: The index is compared as an unsigned value, so negative indices also select the default target.
+            load_register(rax, typed_instruction.index_register());
+            m_assembler.arithmetic_immediate(X64ArithmeticOperation::Compare, rax, static_cast<s32>(typed_instruction.entry_count()));
+            m_assembler.jump_if(X64Condition::AboveOrEqual, label_of(typed_instruction.default_address()));
+
+            const X64Label jump_table_label = m_assembler.create_label();
+            m_assembler.load_label_address(rdx, jump_table_label);
+            m_assembler.load_sign_extended_32_indexed(rcx, rdx, rax);
+            m_assembler.arithmetic(X64ArithmeticOperation::Add, rcx, rdx);
+            m_assembler.jump_to_register(rcx);
+            m_pending_jump_tables.push_back({ jump_table_label, typed_instruction.first_entry_index(), typed_instruction.entry_count() });
+            return true;
+        }
+
+        case OpCode::PureFunctionEntry:
+            // NOTE: Memoization happens when the function is called, which is always done by the interpreter.
+            return true;
+
+        default:
+            // NOTE: Calls, returns, pushes and pops change the call stack or the stack pointer, which are owned by the
+            //       interpreter. Divisions can fault on the host, so they are also left to the interpreter.
+            return false;
+    }
+}
+
+bool CompilationContext::emit_jump_condition(const Instruction& instruction)
+{
+    const X64Register rax = first_scratch_register;
+    const X64Register rcx = second_scratch_register;
+
+    switch (instruction.opcode()) {
+        case OpCode::JumpIf: {
+            const auto& typed_instruction = instruction.as<JumpIfInstruction>();
+            if (!registers_are_valid(typed_instruction.condition_register()))
+                return false;
+
+            const X64Register condition_register = read_register(typed_instruction.condition_register(), rax);
+            m_assembler.test(condition_register, condition_register);
+            return true;
+        }
+
+        case OpCode::FusedCompareGreaterJumpIf: {
+            const auto& typed_instruction = instruction.as<FusedCompareGreaterJumpIfInstruction>();
+            if (!registers_are_valid(typed_instruction.dst_register(), typed_instruction.lhs_register(), typed_instruction.rhs_register()))
+                return false;
+
+            const X64Register lhs_register = read_register(typed_instruction.lhs_register(), rax);
+            m_assembler.arithmetic(X64ArithmeticOperation::Compare, lhs_register, read_register(typed_instruction.rhs_register(), rcx));
+            m_assembler.set_if(X64Condition::Above, rax);
+            write_register(typed_instruction.dst_register(), rax);
+            m_assembler.test(rax, rax);
+            return true;
+        }
+
+        case OpCode::FusedCompareGreaterImmediateJumpIf: {
+            const auto& typed_instruction = instruction.as<FusedCompareGreaterImmediateJumpIfInstruction>();
+            if (!registers_are_valid(typed_instruction.dst_register(), typed_instruction.lhs_register()))
+                return false;
+
+            const X64Register lhs_register = read_register(typed_instruction.lhs_register(), rax);
+            emit_arithmetic_immediate(X64ArithmeticOperation::Compare, lhs_register, typed_instruction.immediate_value(), rcx);
+            m_assembler.set_if(X64Condition::Above, rax);
+            write_register(typed_instruction.dst_register(), rax);
+            m_assembler.test(rax, rax);
+            return true;
+        }
+
+        default: ARC_ASSERT_NOT_REACHED;
+    }
+}
+
+bool CompilationContext::emit_trace_instruction(usize instruction_pointer, usize next_instruction_pointer)
+{
+    const Instruction& instruction = m_package.fetch_instruction(instruction_pointer);
+    const usize fall_through_instruction_pointer = instruction_pointer + 1;
+
+    switch (instruction.opcode()) {
+        case OpCode::Jump:
+            // NOTE: The trace already continues at the target of the jump.
+            return next_instruction_pointer == instruction.as<JumpInstruction>().jump_address().address();
+
+        case OpCode::FusedCompareGreaterImmediateJumpIf:
+        case OpCode::FusedCompareGreaterJumpIf:
+        case OpCode::JumpIf: {
+            const usize jump_instruction_pointer = conditional_jump_address(instruction).address();
+            const bool was_taken = next_instruction_pointer == jump_instruction_pointer;
+            if (!was_taken && next_instruction_pointer != fall_through_instruction_pointer)
+                return false;
+            if (!jump_address_is_valid(JumpAddress(jump_instruction_pointer)) || !emit_jump_condition(instruction))
+                return false;
+
+            // NOTE: When both directions lead to the same instruction, only the registers written by the condition matter.
+            if (jump_instruction_pointer != fall_through_instruction_pointer) {
+                if (was_taken)
+                    emit_side_exit_if(X64Condition::Equal, fall_through_instruction_pointer);
+                else
+                    emit_side_exit_if(X64Condition::NotEqual, jump_instruction_pointer);
+            }
+            return true;
+        }
+
+        case OpCode::JumpTable:
+            // NOTE: The targets of a jump table are only known when the whole package is compiled.
+            return false;
+
+        default:
+            if (next_instruction_pointer != fall_through_instruction_pointer)
+                return false;
+            return emit_instruction(instruction_pointer);
+    }
+}
+
+NativeCode::NativeCode(Badge<JitCompiler>, ExecutableMemory memory, usize code_byte_count, Vector<u32> instruction_native_offsets)
+    : NativeCode(move(memory), code_byte_count, move(instruction_native_offsets))
+{}
+
+NativeCode::NativeCode(Badge<StencilCompiler>, ExecutableMemory memory, usize code_byte_count, Vector<u32> instruction_native_offsets)
+    : NativeCode(move(memory), code_byte_count, move(instruction_native_offsets))
+{}
+
+NativeCode::NativeCode(ExecutableMemory memory, usize code_byte_count, Vector<u32> instruction_native_offsets)
+    : m_memory(move(memory))
+    , m_code_byte_count(code_byte_count)
+    , m_instruction_native_offsets(move(instruction_native_offsets))
+{}
+
+usize NativeCode::run(VirtualMachine& virtual_machine, usize instruction_pointer) const
+{
+    ARC_ASSERT(has_native_code(instruction_pointer));
+
+    NativeFrame frame = {};
+    frame.registers = reinterpret_cast<ReadWriteBytes>(virtual_machine.register_file().window());
+    frame.stack_pointer = virtual_machine.stack().stack_pointer_address();
+    frame.frame_pointer = virtual_machine.stack().frame_pointer_address();
+
+    const auto trampoline = reinterpret_cast<NativeEntryTrampoline>(reinterpret_cast<uintptr>(m_memory.bytes()));
+    const void* target_address = m_memory.bytes() + m_instruction_native_offsets[instruction_pointer];
+    return static_cast<usize>(trampoline(&frame, target_address));
+}
+
+ErrorOr<NativeCode> JitCompiler::compile(const Package& package)
+{
+    if constexpr (!is_supported)
+        return ARC_INTERNAL_ERROR_WITH_MESSAGE("The JIT compiler isn't supported on this platform"sv);
+
+    if (!package.is_verified())
+        return ARC_INTERNAL_ERROR_WITH_MESSAGE("Only verified packages can be compiled to native code"sv);
+
+    Vector<u32> instruction_native_offsets;
+    CompilationContext context(package);
+    const Vector<u8> code = context.compile(instruction_native_offsets);
+
+    TRY_ASSIGN(ExecutableMemory memory, ExecutableMemory::allocate(code.count()));
+    copy_memory(memory.writable_bytes(), code.elements(), code.count());
+    TRY(memory.seal());
+
+    return NativeCode(Badge<JitCompiler>(), move(memory), code.count(), move(instruction_native_offsets));
+}
+
+ErrorOr<NativeCode> JitCompiler::compile_trace(const Package& package, const Trace& trace)
+{
+    if constexpr (!is_supported)
+        return ARC_INTERNAL_ERROR_WITH_MESSAGE("The JIT compiler isn't supported on this platform"sv);
+
+    if (!package.is_verified())
+        return ARC_INTERNAL_ERROR_WITH_MESSAGE("Only verified packages can be compiled to native code"sv);
+
+    u32 header_native_offset = 0;
+    CompilationContext context(package);
+    const Optional<Vector<u8>> code = context.compile_trace(trace, header_native_offset);
+    if (!code.has_value())
+        return ARC_INTERNAL_ERROR_WITH_MESSAGE("The header of the trace has no native translation"sv);
+
+    TRY_ASSIGN(ExecutableMemory memory, ExecutableMemory::allocate(code.value().count()));
+    copy_memory(memory.writable_bytes(), code.value().elements(), code.value().count());
+    TRY(memory.seal());
+
+    // NOTE: The trace can only be entered at its header, which is the last instruction that needs a native offset.
+    Vector<u32> instruction_native_offsets;
+    instruction_native_offsets.set_count(trace.header_instruction_pointer() + 1, NativeCode::no_native_offset);
+    instruction_native_offsets[trace.header_instruction_pointer()] = header_native_offset;
+    return NativeCode(Badge<JitCompiler>(), move(memory), code.value().count(), move(instruction_native_offsets));
+}
+
+}
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause.
+ */
+
+#pragma once
+
+#include <bytecode/forward.h>
+#include <core/badge.h>
+#include <core/containers/vector.h>
+#include <core/error.h>
+#include <core/memory/executable_memory.h>
+#include <runtime/forward.h>
+
+namespace Arc::Runtime {
+
+class JitCompiler;
+class StencilCompiler;
+
+//
+// The machine code generated for a package by the `JitCompiler` or the `StencilCompiler`. Every instruction that has
+// a native translation can be used as an entry point into the code, so that execution can switch between the native
+// code and the interpreter at any instruction boundary. The native code reads and writes the same register window and
+// stack as the interpreter, which means that no state has to be converted when switching.
+//
+class NativeCode {
+    ARC_MAKE_NONCOPYABLE(NativeCode);
+
+public:
+    static constexpr u32 no_native_offset = 0xFFFFFFFF;
+
+public:
+    NativeCode(Badge<JitCompiler>, ExecutableMemory memory, usize code_byte_count, Vector<u32> instruction_native_offsets);
+    NativeCode(Badge<StencilCompiler>, ExecutableMemory memory, usize code_byte_count, Vector<u32> instruction_native_offsets);
+    ~NativeCode() = default;
+
+    NativeCode(NativeCode&&) noexcept = default;
+    NativeCode& operator=(NativeCode&&) noexcept = default;
+
+    NODISCARD ALWAYS_INLINE bool has_native_code(usize instruction_pointer) const
+    {
+        return instruction_pointer < m_instruction_native_offsets.count() &&
+               m_instruction_native_offsets[instruction_pointer] != no_native_offset;
+    }
+
+    NODISCARD ALWAYS_INLINE usize code_byte_count() const { return m_code_byte_count; }
+
+    // Executes the native code starting at the given instruction, until an instruction without a native translation
+    // is reached or the instruction pointer leaves the package. Returns the instruction pointer at which the execution
+    // must be resumed by the interpreter.
+    NODISCARD usize run(VirtualMachine&, usize instruction_pointer) const;
+
+private:
+    NativeCode(ExecutableMemory memory, usize code_byte_count, Vector<u32> instruction_native_offsets);
+
+private:
+    ExecutableMemory m_memory;
+    usize m_code_byte_count;
+    Vector<u32> m_instruction_native_offsets;
+};
+
+//
+// A baseline compiler that translates a verified package into x86-64 machine code, one instruction at a time and
+// without any analysis across instructions. The first virtual registers of the current window are kept in host
+// registers, the others are accessed in memory, and the stack is addressed relative to the stack and frame pointers.
+//
+// Instructions that manipulate the call stack, push or pop values, or can't be expressed as a short sequence of
+// machine instructions have no native translation and are executed by the interpreter instead: the native code
+// returns to the interpreter right before them.
+//
+class JitCompiler {
+    ARC_MAKE_NAMESPACE_CLASS(JitCompiler)
+
+public:
+    // NOTE: The generated code follows the System V calling convention, which isn't used by Windows.
+    static constexpr bool is_supported = ARC_PLATFORM_ARCHITECTURE_X64 && (ARC_PLATFORM_LINUX || ARC_PLATFORM_MACOS);
+
+public:
+    // NOTE: The compiled code performs no safety checks, so only verified packages can be compiled.
+    NODISCARD static ErrorOr<NativeCode> compile(const Bytecode::Package&);
+
+    // Compiles a trace recorded by the `TracingJit` from the given package. The native code can only be entered at the
+    // header of the trace, and returns to the interpreter when a guard fails or the trace ends.
+    NODISCARD static ErrorOr<NativeCode> compile_trace(const Bytecode::Package&, const Trace&);
+};
+
+}
@@ -0,0 +1,25 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause.
+ */
+
+#pragma once
+
+#include <core/types.h>
+
+namespace Arc::Runtime {
+
+// The state of the virtual machine that is passed to the native code, read by the entry trampoline. The registers
+// point to the current register window, which is an array of 64-bit values indexed by the register number.
+struct NativeFrame {
+    ReadWriteBytes registers;
+    ReadWriteBytes stack_pointer;
+    ReadWriteBytes frame_pointer;
+};
+
+// The entry trampoline is always located at the beginning of the native code. It jumps to the native translation of
+// the instruction at which the execution starts, and returns the instruction pointer at which the interpreter must
+// resume the execution.
+using NativeEntryTrampoline = u64 (*)(NativeFrame* frame, const void* target_address);
+
+}
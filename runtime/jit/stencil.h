@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause.
+ */
+
+#pragma once
+
+#include <core/types.h>
+
+namespace Arc::Runtime {
+
+// Identifies the value that is patched into a hole of a stencil. The holes of a stencil are references to the
+// `arc_hole_*` symbols declared by `runtime/jit/stencils.cpp`, which are never defined.
+enum class StencilHoleKind : u8 {
+    // An operand of the instruction that fits in 32 bits, such as the byte offset of a register in the register window
+    // or a stack offset.
+    Operand0,
+    Operand1,
+    Operand2,
+    Operand3,
+    Operand4,
+    // A 64-bit immediate value, or the instruction pointer at which the interpreter resumes the execution.
+    Immediate,
+    // The code of the instruction that follows.
+    Continue,
+    // The code of the instruction that is the target of the jump.
+    Jump,
+};
+
+// How the value of a hole is encoded in the machine code, as described by the relocation emitted by the C++ compiler.
+enum class StencilRelocationKind : u8 {
+    // The value must fit in an unsigned 32-bit integer.
+    Absolute32,
+    // The value must fit in a signed 32-bit integer.
+    Absolute32Signed,
+    Absolute64,
+    // The 32-bit offset of the value from the address of the hole.
+    Relative32,
+};
+
+struct StencilHole {
+    u32 offset;
+    StencilHoleKind kind;
+    StencilRelocationKind relocation_kind;
+    // The constant that the compiler added to the value of the hole.
+    s64 addend;
+};
+
+//
+// The machine code of a single operation, compiled ahead of time from C++ and extracted from the object file by the
+// stencil extractor. All stencils, except the entry trampoline, receive the register window and the stack and frame
+// pointers as arguments and end by tail calling the code of the next instruction, so they can be concatenated.
+//
+struct Stencil {
+    const u8* code;
+    u32 code_byte_count;
+    const StencilHole* holes;
+    u32 hole_count;
+};
+
+}
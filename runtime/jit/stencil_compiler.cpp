@@ -0,0 +1,540 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause.
+ */
+
+#include <bytecode/instruction.h>
+#include <bytecode/package.h>
+#include <core/memory/memory_operations.h>
+#include <runtime/jit/jit_compiler.h>
+#include <runtime/jit/stencil.h>
+#include <runtime/jit/stencil_compiler.h>
+#include <runtime/virtual_machine.h>
+
+#if ARC_STENCILS_AVAILABLE
+    #include <runtime/jit/stencils.generated.h>
+#endif // ARC_STENCILS_AVAILABLE
+
+namespace Arc::Runtime {
+
+using namespace Arc::Bytecode;
+
+#if ARC_STENCILS_AVAILABLE
+
+// The values that are patched into the holes of a stencil.
+struct StencilOperands {
+    static constexpr usize max_operand_count = 5;
+
+    u64 operands[max_operand_count];
+    u64 immediate_value;
+    u64 jump_address;
+};
+
+// The encoding of `jmp rel32`, which most stencils end with to continue with the next instruction.
+static constexpr u8 jump_opcode = 0xE9;
+static constexpr u32 jump_byte_count = 5;
+
+template<typename... Registers>
+NODISCARD static bool set_register_operands(StencilOperands& operands, Registers... registers)
+{
+    if (!((static_cast<u8>(registers) < static_cast<u8>(Register::Count)) && ...))
+        return false;
+
+    // NOTE: The stencils address the registers by their byte offset in the register window.
+    usize operand_index = 0;
+    ((operands.operands[operand_index++] = static_cast<u8>(registers) * sizeof(VirtualMachine::RegisterStorage)), ...);
+    return true;
+}
+
+NODISCARD static bool hole_value_fits(StencilRelocationKind relocation_kind, u64 value)
+{
+    switch (relocation_kind) {
+        case StencilRelocationKind::Absolute32: return value <= 0xFFFFFFFFULL;
+        case StencilRelocationKind::Absolute32Signed:
+            return static_cast<s64>(value) >= -2147483648LL && static_cast<s64>(value) <= 2147483647LL;
+        case StencilRelocationKind::Absolute64: return true;
+        case StencilRelocationKind::Relative32: return true;
+    }
+
+    ARC_ASSERT_NOT_REACHED;
+}
+
+// When the stencil ends by jumping to the next instruction, the jump is removed and the execution falls through into
+// the code of the next instruction instead, which is always emitted right after.
+NODISCARD static bool ends_with_continuation_jump(const Stencil& stencil)
+{
+    if (stencil.code_byte_count < jump_byte_count || stencil.code[stencil.code_byte_count - jump_byte_count] != jump_opcode)
+        return false;
+
+    for (u32 hole_index = 0; hole_index < stencil.hole_count; ++hole_index) {
+        const StencilHole& hole = stencil.holes[hole_index];
+        if (hole.kind == StencilHoleKind::Continue && hole.offset == stencil.code_byte_count - sizeof(u32) &&
+            hole.relocation_kind == StencilRelocationKind::Relative32 && hole.addend == -static_cast<s64>(sizeof(u32))) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+NODISCARD static const Stencil* binary_stencil_of(OpCode opcode)
+{
+    switch (opcode) {
+        case OpCode::Add: return &Stencils::Add;
+        case OpCode::BitwiseAND: return &Stencils::BitwiseAND;
+        case OpCode::BitwiseLeftShift: return &Stencils::BitwiseLeftShift;
+        case OpCode::BitwiseOR: return &Stencils::BitwiseOR;
+        case OpCode::BitwiseRightShift: return &Stencils::BitwiseRightShift;
+        case OpCode::BitwiseRightShiftSigned: return &Stencils::BitwiseRightShiftSigned;
+        case OpCode::BitwiseXOR: return &Stencils::BitwiseXOR;
+        case OpCode::CompareEqual: return &Stencils::CompareEqual;
+        case OpCode::CompareGreater: return &Stencils::CompareGreater;
+        case OpCode::CompareGreaterOrEqual: return &Stencils::CompareGreaterOrEqual;
+        case OpCode::CompareGreaterOrEqualSigned: return &Stencils::CompareGreaterOrEqualSigned;
+        case OpCode::CompareGreaterSigned: return &Stencils::CompareGreaterSigned;
+        case OpCode::CompareLess: return &Stencils::CompareLess;
+        case OpCode::CompareLessOrEqual: return &Stencils::CompareLessOrEqual;
+        case OpCode::CompareLessOrEqualSigned: return &Stencils::CompareLessOrEqualSigned;
+        case OpCode::CompareLessSigned: return &Stencils::CompareLessSigned;
+        case OpCode::CompareNotEqual: return &Stencils::CompareNotEqual;
+        case OpCode::LogicalAND: return &Stencils::LogicalAND;
+        case OpCode::LogicalOR: return &Stencils::LogicalOR;
+        case OpCode::LogicalXOR: return &Stencils::LogicalXOR;
+        case OpCode::Multiply: return &Stencils::Multiply;
+        case OpCode::Sub: return &Stencils::Sub;
+        default: return nullptr;
+    }
+}
+
+NODISCARD static const Stencil* unary_stencil_of(OpCode opcode)
+{
+    switch (opcode) {
+        case OpCode::BitwiseNOT: return &Stencils::BitwiseNOT;
+        case OpCode::LogicalNOT: return &Stencils::LogicalNOT;
+        case OpCode::Move: return &Stencils::Move;
+        case OpCode::Negate: return &Stencils::Negate;
+        case OpCode::SignExtend8: return &Stencils::SignExtend8;
+        case OpCode::SignExtend16: return &Stencils::SignExtend16;
+        case OpCode::SignExtend32: return &Stencils::SignExtend32;
+        default: return nullptr;
+    }
+}
+
+class StencilCompilationContext {
+public:
+    explicit StencilCompilationContext(const Package& package)
+        : m_package(package)
+    {}
+
+    // Concatenates the stencils of the whole package. Returns the patched code and the native code offset of every
+    // instruction, which is `NativeCode::no_native_offset` for instructions that are executed by the interpreter.
+    NODISCARD Vector<u8> compile(Vector<u32>& instruction_native_offsets);
+
+private:
+    struct PendingJump {
+        usize hole_offset;
+        s64 addend;
+        usize target_instruction_pointer;
+    };
+
+    // Returns the stencil that implements the instruction and fills its operands, or null when the instruction has
+    // no stencil or its operands are invalid.
+    NODISCARD const Stencil* select_stencil(const Instruction&, StencilOperands& operands) const;
+
+    // Copies the stencil and patches its holes. When false is returned no code has been emitted, as the value of a
+    // hole can't be encoded by the relocation chosen by the C++ compiler.
+    NODISCARD bool emit_stencil(const Stencil&, const StencilOperands& operands, usize instruction_pointer);
+    void emit_exit(usize instruction_pointer);
+
+    NODISCARD bool jump_address_is_valid(JumpAddress jump_address) const;
+    NODISCARD static u64 hole_value(const StencilHole& hole, const StencilOperands& operands);
+
+private:
+    const Package& m_package;
+    Vector<u8> m_code;
+    // The offset of the code emitted for every instruction, including the ones that return to the interpreter.
+    Vector<u32> m_instruction_code_offsets;
+    Vector<PendingJump> m_pending_jumps;
+};
+
+Vector<u8> StencilCompilationContext::compile(Vector<u32>& instruction_native_offsets)
+{
+    // NOTE: The entry trampoline must always be located at the beginning of the native code.
+    const bool has_emitted_trampoline = emit_stencil(Stencils::Enter, {}, 0);
+    ARC_ASSERT(has_emitted_trampoline);
+
+    const usize instruction_count = m_package.instruction_count();
+    instruction_native_offsets.set_count_defaulted(instruction_count);
+    for (usize instruction_pointer = 0; instruction_pointer < instruction_count; ++instruction_pointer) {
+        const Instruction& instruction = m_package.fetch_instruction(instruction_pointer);
+        const u32 native_offset = static_cast<u32>(m_code.count());
+        m_instruction_code_offsets.push_back(native_offset);
+        instruction_native_offsets[instruction_pointer] = native_offset;
+
+        // NOTE: Memoization happens when the function is called, which is always done by the interpreter.
+        if (instruction.opcode() == OpCode::PureFunctionEntry)
+            continue;
+
+        StencilOperands operands = {};
+        const Stencil* stencil = select_stencil(instruction, operands);
+        if (stencil && emit_stencil(*stencil, operands, instruction_pointer))
+            continue;
+
+        // NOTE: Jumping to an instruction that has no native translation returns to the interpreter.
+        instruction_native_offsets[instruction_pointer] = NativeCode::no_native_offset;
+        emit_exit(instruction_pointer);
+    }
+
+    // NOTE: The additional exit marks the end of the package, which can be the target of a fall-through.
+    m_instruction_code_offsets.push_back(static_cast<u32>(m_code.count()));
+    emit_exit(instruction_count);
+
+    for (const PendingJump& pending_jump : m_pending_jumps) {
+        const s64 target_offset = m_instruction_code_offsets[pending_jump.target_instruction_pointer];
+        const s32 relative_offset = static_cast<s32>(target_offset + pending_jump.addend - static_cast<s64>(pending_jump.hole_offset));
+        copy_memory(m_code.elements() + pending_jump.hole_offset, &relative_offset, sizeof(s32));
+    }
+
+    return move(m_code);
+}
+
+const Stencil* StencilCompilationContext::select_stencil(const Instruction& instruction, StencilOperands& operands) const
+{
+    switch (instruction.opcode()) {
+        case OpCode::Add:
+        case OpCode::BitwiseAND:
+        case OpCode::BitwiseLeftShift:
+        case OpCode::BitwiseOR:
+        case OpCode::BitwiseRightShift:
+        case OpCode::BitwiseRightShiftSigned:
+        case OpCode::BitwiseXOR:
+        case OpCode::CompareEqual:
+        case OpCode::CompareGreater:
+        case OpCode::CompareGreaterOrEqual:
+        case OpCode::CompareGreaterOrEqualSigned:
+        case OpCode::CompareGreaterSigned:
+        case OpCode::CompareLess:
+        case OpCode::CompareLessOrEqual:
+        case OpCode::CompareLessOrEqualSigned:
+        case OpCode::CompareLessSigned:
+        case OpCode::CompareNotEqual:
+        case OpCode::LogicalAND:
+        case OpCode::LogicalOR:
+        case OpCode::LogicalXOR:
+        case OpCode::Multiply:
+        case OpCode::Sub: {
+            // NOTE: All three-register instructions share the same layout.
+            const auto& typed_instruction = static_cast<const AddInstruction&>(instruction);
+            if (!set_register_operands(operands, typed_instruction.dst_register(), typed_instruction.lhs_register(),
+                                       typed_instruction.rhs_register())) {
+                return nullptr;
+            }
+            return binary_stencil_of(instruction.opcode());
+        }
+
+        case OpCode::BitwiseNOT:
+        case OpCode::LogicalNOT:
+        case OpCode::Move:
+        case OpCode::Negate:
+        case OpCode::SignExtend8:
+        case OpCode::SignExtend16:
+        case OpCode::SignExtend32: {
+            // NOTE: All two-register instructions share the same layout.
+            const auto& typed_instruction = static_cast<const MoveInstruction&>(instruction);
+            if (!set_register_operands(operands, typed_instruction.dst_register(), typed_instruction.src_register()))
+                return nullptr;
+            return unary_stencil_of(instruction.opcode());
+        }
+
+        case OpCode::AddImmediate:
+        case OpCode::SubImmediate: {
+            // NOTE: All register-immediate arithmetic instructions share the same layout.
+            const auto& typed_instruction = static_cast<const AddImmediateInstruction&>(instruction);
+            if (!set_register_operands(operands, typed_instruction.dst_register(), typed_instruction.lhs_register()))
+                return nullptr;
+            operands.immediate_value = typed_instruction.immediate_value();
+            return instruction.opcode() == OpCode::AddImmediate ? &Stencils::AddImmediate : &Stencils::SubImmediate;
+        }
+
+        case OpCode::CompareGreaterImmediate: {
+            const auto& typed_instruction = instruction.as<CompareGreaterImmediateInstruction>();
+            if (!set_register_operands(operands, typed_instruction.dst_register(), typed_instruction.lhs_register()))
+                return nullptr;
+            operands.immediate_value = typed_instruction.immediate_value();
+            return &Stencils::CompareGreaterImmediate;
+        }
+
+        case OpCode::Decrement:
+        case OpCode::Increment: {
+            // NOTE: Both instructions share the same layout.
+            const auto& typed_instruction = static_cast<const IncrementInstruction&>(instruction);
+            if (!set_register_operands(operands, typed_instruction.dst_register()))
+                return nullptr;
+            return instruction.opcode() == OpCode::Increment ? &Stencils::Increment : &Stencils::Decrement;
+        }
+
+        case OpCode::LoadImmediate8:
+        case OpCode::LoadImmediate16:
+        case OpCode::LoadImmediate32:
+        case OpCode::LoadImmediate64: {
+            Register dst_register = Register::Count;
+            if (instruction.opcode() == OpCode::LoadImmediate8) {
+                dst_register = instruction.as<LoadImmediate8Instruction>().dst_register();
+                operands.immediate_value = instruction.as<LoadImmediate8Instruction>().immediate_value();
+            }
+            else if (instruction.opcode() == OpCode::LoadImmediate16) {
+                dst_register = instruction.as<LoadImmediate16Instruction>().dst_register();
+                operands.immediate_value = instruction.as<LoadImmediate16Instruction>().immediate_value();
+            }
+            else if (instruction.opcode() == OpCode::LoadImmediate32) {
+                dst_register = instruction.as<LoadImmediate32Instruction>().dst_register();
+                operands.immediate_value = instruction.as<LoadImmediate32Instruction>().immediate_value();
+            }
+            else {
+                dst_register = instruction.as<LoadImmediate64Instruction>().dst_register();
+                operands.immediate_value = instruction.as<LoadImmediate64Instruction>().immediate_value();
+            }
+
+            if (!set_register_operands(operands, dst_register))
+                return nullptr;
+            return &Stencils::LoadImmediate;
+        }
+
+        case OpCode::LoadFromFrame: {
+            const auto& typed_instruction = instruction.as<LoadFromFrameInstruction>();
+            if (!set_register_operands(operands, typed_instruction.dst_register()))
+                return nullptr;
+            operands.operands[1] = static_cast<u64>(typed_instruction.src_frame_offset());
+            return &Stencils::LoadFromFrame;
+        }
+
+        case OpCode::StoreToFrame: {
+            const auto& typed_instruction = instruction.as<StoreToFrameInstruction>();
+            if (!set_register_operands(operands, typed_instruction.src_register()))
+                return nullptr;
+            operands.operands[1] = static_cast<u64>(typed_instruction.dst_frame_offset());
+            return &Stencils::StoreToFrame;
+        }
+
+        case OpCode::LoadFromStack:
+        case OpCode::Load8FromStack:
+        case OpCode::Load16FromStack:
+        case OpCode::Load32FromStack: {
+            // NOTE: All the stack load instructions share the same layout.
+            const auto& typed_instruction = static_cast<const LoadFromStackInstruction&>(instruction);
+            if (!set_register_operands(operands, typed_instruction.dst_register()))
+                return nullptr;
+            operands.operands[1] = typed_instruction.src_stack_offset();
+
+            if (instruction.opcode() == OpCode::Load8FromStack)
+                return &Stencils::Load8FromStack;
+            if (instruction.opcode() == OpCode::Load16FromStack)
+                return &Stencils::Load16FromStack;
+            if (instruction.opcode() == OpCode::Load32FromStack)
+                return &Stencils::Load32FromStack;
+            return &Stencils::LoadFromStack;
+        }
+
+        case OpCode::StoreToStack:
+        case OpCode::Store8ToStack:
+        case OpCode::Store16ToStack:
+        case OpCode::Store32ToStack: {
+            // NOTE: All the stack store instructions share the same layout.
+            const auto& typed_instruction = static_cast<const StoreToStackInstruction&>(instruction);
+            if (!set_register_operands(operands, typed_instruction.src_register()))
+                return nullptr;
+            operands.operands[1] = typed_instruction.dst_stack_offset();
+
+            if (instruction.opcode() == OpCode::Store8ToStack)
+                return &Stencils::Store8ToStack;
+            if (instruction.opcode() == OpCode::Store16ToStack)
+                return &Stencils::Store16ToStack;
+            if (instruction.opcode() == OpCode::Store32ToStack)
+                return &Stencils::Store32ToStack;
+            return &Stencils::StoreToStack;
+        }
+
+        case OpCode::FusedLoadAddStore: {
+            const auto& typed_instruction = instruction.as<FusedLoadAddStoreInstruction>();
+            if (!set_register_operands(operands, typed_instruction.dst_register(), typed_instruction.loaded_register(),
+                                       typed_instruction.other_register())) {
+                return nullptr;
+            }
+            operands.operands[3] = typed_instruction.src_stack_offset();
+            operands.operands[4] = typed_instruction.dst_stack_offset();
+            return &Stencils::FusedLoadAddStore;
+        }
+
+        case OpCode::FusedLoadIncrementStore: {
+            const auto& typed_instruction = instruction.as<FusedLoadIncrementStoreInstruction>();
+            if (!set_register_operands(operands, typed_instruction.dst_register()))
+                return nullptr;
+            operands.operands[1] = typed_instruction.stack_offset();
+            return &Stencils::FusedLoadIncrementStore;
+        }
+
+        case OpCode::FusedLoadPair: {
+            const auto& typed_instruction = instruction.as<FusedLoadPairInstruction>();
+            if (!set_register_operands(operands, typed_instruction.first_dst_register(), typed_instruction.second_dst_register()))
+                return nullptr;
+            operands.operands[2] = typed_instruction.first_src_stack_offset();
+            operands.operands[3] = typed_instruction.second_src_stack_offset();
+            return &Stencils::FusedLoadPair;
+        }
+
+        case OpCode::FusedLoadStore: {
+            const auto& typed_instruction = instruction.as<FusedLoadStoreInstruction>();
+            if (!set_register_operands(operands, typed_instruction.dst_register()))
+                return nullptr;
+            operands.operands[1] = typed_instruction.src_stack_offset();
+            operands.operands[2] = typed_instruction.dst_stack_offset();
+            return &Stencils::FusedLoadStore;
+        }
+
+        case OpCode::Jump: {
+            const auto& typed_instruction = instruction.as<JumpInstruction>();
+            if (!jump_address_is_valid(typed_instruction.jump_address()))
+                return nullptr;
+            operands.jump_address = typed_instruction.jump_address().address();
+            return &Stencils::Jump;
+        }
+
+        case OpCode::JumpIf: {
+            const auto& typed_instruction = instruction.as<JumpIfInstruction>();
+            if (!set_register_operands(operands, typed_instruction.condition_register()) ||
+                !jump_address_is_valid(typed_instruction.jump_address())) {
+                return nullptr;
+            }
+            operands.jump_address = typed_instruction.jump_address().address();
+            return &Stencils::JumpIf;
+        }
+
+        case OpCode::FusedCompareGreaterJumpIf: {
+            const auto& typed_instruction = instruction.as<FusedCompareGreaterJumpIfInstruction>();
+            if (!set_register_operands(operands, typed_instruction.dst_register(), typed_instruction.lhs_register(),
+                                       typed_instruction.rhs_register()) ||
+                !jump_address_is_valid(typed_instruction.jump_address())) {
+                return nullptr;
+            }
+            operands.jump_address = typed_instruction.jump_address().address();
+            return &Stencils::FusedCompareGreaterJumpIf;
+        }
+
+        case OpCode::FusedCompareGreaterImmediateJumpIf: {
+            const auto& typed_instruction = instruction.as<FusedCompareGreaterImmediateJumpIfInstruction>();
+            if (!set_register_operands(operands, typed_instruction.dst_register(), typed_instruction.lhs_register()) ||
+                !jump_address_is_valid(typed_instruction.jump_address())) {
+                return nullptr;
+            }
+            operands.immediate_value = typed_instruction.immediate_value();
+            operands.jump_address = typed_instruction.jump_address().address();
+            return &Stencils::FusedCompareGreaterImmediateJumpIf;
+        }
+
+        default:
+            // NOTE: Calls, returns, pushes and pops change the call stack or the stack pointer, which are owned by the
+            //       interpreter. Divisions can fault on the host and jump tables would need a data section, so they
+            //       are also left to the interpreter.
+            return nullptr;
+    }
+}
+
+bool StencilCompilationContext::emit_stencil(const Stencil& stencil, const StencilOperands& operands, usize instruction_pointer)
+{
+    for (u32 hole_index = 0; hole_index < stencil.hole_count; ++hole_index) {
+        const StencilHole& hole = stencil.holes[hole_index];
+        if (!hole_value_fits(hole.relocation_kind, hole_value(hole, operands)))
+            return false;
+    }
+
+    const u32 code_byte_count = ends_with_continuation_jump(stencil) ? stencil.code_byte_count - jump_byte_count : stencil.code_byte_count;
+    const usize code_offset = m_code.count();
+    m_code.set_count_defaulted(code_offset + code_byte_count);
+    copy_memory(m_code.elements() + code_offset, stencil.code, code_byte_count);
+
+    for (u32 hole_index = 0; hole_index < stencil.hole_count; ++hole_index) {
+        const StencilHole& hole = stencil.holes[hole_index];
+        // NOTE: The hole of the removed continuation jump is located past the end of the copied code.
+        if (hole.offset >= code_byte_count)
+            continue;
+
+        const usize hole_offset = code_offset + hole.offset;
+        const u64 value = hole_value(hole, operands);
+        switch (hole.relocation_kind) {
+            case StencilRelocationKind::Absolute32:
+            case StencilRelocationKind::Absolute32Signed: {
+                const u32 encoded_value = static_cast<u32>(value);
+                copy_memory(m_code.elements() + hole_offset, &encoded_value, sizeof(u32));
+                break;
+            }
+            case StencilRelocationKind::Absolute64: {
+                copy_memory(m_code.elements() + hole_offset, &value, sizeof(u64));
+                break;
+            }
+            case StencilRelocationKind::Relative32: {
+                // NOTE: The continuations are resolved once the code of every instruction has been emitted.
+                const usize target_instruction_pointer =
+                    (hole.kind == StencilHoleKind::Continue) ? instruction_pointer + 1 : operands.jump_address;
+                m_pending_jumps.push_back({ hole_offset, hole.addend, target_instruction_pointer });
+                break;
+            }
+        }
+    }
+
+    return true;
+}
+
+void StencilCompilationContext::emit_exit(usize instruction_pointer)
+{
+    StencilOperands operands = {};
+    operands.immediate_value = instruction_pointer;
+    const bool has_emitted_exit = emit_stencil(Stencils::Exit, operands, instruction_pointer);
+    ARC_ASSERT(has_emitted_exit);
+}
+
+bool StencilCompilationContext::jump_address_is_valid(JumpAddress jump_address) const
+{
+    return jump_address.address() <= m_package.instruction_count();
+}
+
+u64 StencilCompilationContext::hole_value(const StencilHole& hole, const StencilOperands& operands)
+{
+    u64 value = 0;
+    switch (hole.kind) {
+        case StencilHoleKind::Operand0: value = operands.operands[0]; break;
+        case StencilHoleKind::Operand1: value = operands.operands[1]; break;
+        case StencilHoleKind::Operand2: value = operands.operands[2]; break;
+        case StencilHoleKind::Operand3: value = operands.operands[3]; break;
+        case StencilHoleKind::Operand4: value = operands.operands[4]; break;
+        case StencilHoleKind::Immediate: value = operands.immediate_value; break;
+        case StencilHoleKind::Continue:
+        case StencilHoleKind::Jump: return 0;
+    }
+
+    // NOTE: The addend is applied with wrap-around, same as the linker would do for the relocation.
+    return value + static_cast<u64>(hole.addend);
+}
+
+#endif // ARC_STENCILS_AVAILABLE
+
+ErrorOr<NativeCode> StencilCompiler::compile(MAYBE_UNUSED const Package& package)
+{
+#if ARC_STENCILS_AVAILABLE
+    if (!package.is_verified())
+        return ARC_INTERNAL_ERROR_WITH_MESSAGE("Only verified packages can be compiled to native code"sv);
+
+    Vector<u32> instruction_native_offsets;
+    StencilCompilationContext context(package);
+    const Vector<u8> code = context.compile(instruction_native_offsets);
+
+    TRY_ASSIGN(ExecutableMemory memory, ExecutableMemory::allocate(code.count()));
+    copy_memory(memory.writable_bytes(), code.elements(), code.count());
+    TRY(memory.seal());
+
+    return NativeCode(Badge<StencilCompiler>(), move(memory), code.count(), move(instruction_native_offsets));
+#else
+    return ARC_INTERNAL_ERROR_WITH_MESSAGE("The stencils aren't available on this platform"sv);
+#endif // ARC_STENCILS_AVAILABLE
+}
+
+}
@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause.
+ */
+
+#pragma once
+
+#include <bytecode/forward.h>
+#include <core/error.h>
+#include <runtime/forward.h>
+
+// NOTE: Defined by the build system when the stencils have been extracted, which requires GCC or Clang to produce
+//       x86-64 ELF object files.
+#ifndef ARC_STENCILS_AVAILABLE
+    #define ARC_STENCILS_AVAILABLE 0
+#endif // ARC_STENCILS_AVAILABLE
+
+namespace Arc::Runtime {
+
+//
+// A copy-and-patch compiler that translates a verified package into native code by concatenating stencils, which are
+// fragments of machine code compiled ahead of time from C++ (see `runtime/jit/stencils.cpp`). The holes of every
+// stencil are patched with the operands of the instruction and the addresses of the instructions that execute next.
+// Compiling a package is little more than copying bytes, which makes it much cheaper than the `JitCompiler`, at the
+// cost of slower code as every virtual register is accessed in memory.
+//
+// Instructions without a stencil return to the interpreter, same as with the `JitCompiler`, and the generated code
+// uses the same entry trampoline, so the native code of both compilers is executed in the same way.
+//
+class StencilCompiler {
+    ARC_MAKE_NAMESPACE_CLASS(StencilCompiler)
+
+public:
+    static constexpr bool is_supported = ARC_STENCILS_AVAILABLE;
+
+public:
+    // NOTE: The compiled code performs no safety checks, so only verified packages can be compiled.
+    NODISCARD static ErrorOr<NativeCode> compile(const Bytecode::Package&);
+};
+
+}
@@ -0,0 +1,284 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause.
+ */
+
+//
+// The stencils used by the `StencilCompiler`. Every `arc_stencil_<name>` function becomes the stencil `Stencils::<name>`.
+//
+// This file isn't part of the runtime. It is compiled on its own into an object file, from which the stencil extractor
+// copies the machine code of every stencil together with its relocations, which describe the holes that are patched
+// when the stencils are concatenated. See the stencil section of `CMakeLists.txt` for the compilation flags, which
+// guarantee that the calls to `arc_hole_continue` and `arc_hole_jump` are compiled as tail calls, and that the code
+// doesn't reference anything besides the holes.
+//
+
+#include <runtime/jit/native_frame.h>
+#include <runtime/integer_arithmetic.h>
+
+using namespace Arc;
+using namespace Arc::Runtime;
+
+extern "C" {
+
+// NOTE: The holes are never defined, as only their relocations are used. The operands are declared with a known size
+//       so that they are addressed with 32-bit relocations, while the immediate is declared without a size, which
+//       makes the medium code model address it with a 64-bit relocation.
+extern u8 arc_hole_operand_0[1];
+extern u8 arc_hole_operand_1[1];
+extern u8 arc_hole_operand_2[1];
+extern u8 arc_hole_operand_3[1];
+extern u8 arc_hole_operand_4[1];
+extern u8 arc_hole_immediate[];
+
+u64 arc_hole_continue(ReadWriteBytes registers, ReadWriteBytes stack_pointer, ReadWriteBytes frame_pointer);
+u64 arc_hole_jump(ReadWriteBytes registers, ReadWriteBytes stack_pointer, ReadWriteBytes frame_pointer);
+}
+
+using StencilFunction = u64 (*)(ReadWriteBytes registers, ReadWriteBytes stack_pointer, ReadWriteBytes frame_pointer);
+
+#define ARC_STENCIL(stencil_name) \
+    extern "C" u64 arc_stencil_##stencil_name(ReadWriteBytes registers, ReadWriteBytes stack_pointer, ReadWriteBytes frame_pointer)
+
+#define ARC_STENCIL_CONTINUE() return arc_hole_continue(registers, stack_pointer, frame_pointer)
+#define ARC_STENCIL_JUMP()     return arc_hole_jump(registers, stack_pointer, frame_pointer)
+
+NODISCARD ALWAYS_INLINE static u64 immediate_value() { return reinterpret_cast<uintptr>(arc_hole_immediate); }
+
+// The register operands are patched with the byte offset of the register in the register window.
+NODISCARD ALWAYS_INLINE static u64& register_at(ReadWriteBytes registers, const u8* hole)
+{
+    return *reinterpret_cast<u64*>(registers + reinterpret_cast<uintptr>(hole));
+}
+
+template<typename T>
+NODISCARD ALWAYS_INLINE static T& stack_at(ReadWriteBytes stack_pointer, const u8* hole)
+{
+    return *reinterpret_cast<T*>(stack_pointer + reinterpret_cast<uintptr>(hole));
+}
+
+// NOTE: The frame offsets are negative, which is why they must be encoded as sign extended 32-bit values.
+NODISCARD ALWAYS_INLINE static u64& frame_at(ReadWriteBytes frame_pointer, const u8* hole)
+{
+    return *reinterpret_cast<u64*>(frame_pointer + static_cast<s64>(reinterpret_cast<uintptr>(hole)));
+}
+
+extern "C" u64 arc_stencil_Enter(NativeFrame* frame, const void* target_address)
+{
+    const auto target = reinterpret_cast<StencilFunction>(reinterpret_cast<uintptr>(target_address));
+    return target(frame->registers, frame->stack_pointer, frame->frame_pointer);
+}
+
+// Returns the instruction pointer at which the interpreter resumes the execution.
+ARC_STENCIL(Exit)
+{
+    return immediate_value();
+}
+
+#define ARC_BINARY_STENCIL(stencil_name, operation)                                                                                   \
+    ARC_STENCIL(stencil_name)                                                                                                         \
+    {                                                                                                                                 \
+        const u64 lhs = register_at(registers, arc_hole_operand_1);                                                                   \
+        const u64 rhs = register_at(registers, arc_hole_operand_2);                                                                   \
+        register_at(registers, arc_hole_operand_0) = IntegerArithmetic::operation(lhs, rhs);                                          \
+        ARC_STENCIL_CONTINUE();                                                                                                       \
+    }
+
+#define ARC_UNARY_STENCIL(stencil_name, operation)                                                                                    \
+    ARC_STENCIL(stencil_name)                                                                                                         \
+    {                                                                                                                                 \
+        register_at(registers, arc_hole_operand_0) = IntegerArithmetic::operation(register_at(registers, arc_hole_operand_1));       \
+        ARC_STENCIL_CONTINUE();                                                                                                       \
+    }
+
+ARC_BINARY_STENCIL(BitwiseAND, bitwise_and)
+ARC_BINARY_STENCIL(BitwiseLeftShift, bitwise_left_shift)
+ARC_BINARY_STENCIL(BitwiseOR, bitwise_or)
+ARC_BINARY_STENCIL(BitwiseRightShift, bitwise_right_shift)
+ARC_BINARY_STENCIL(BitwiseRightShiftSigned, bitwise_right_shift_signed)
+ARC_BINARY_STENCIL(BitwiseXOR, bitwise_xor)
+ARC_BINARY_STENCIL(CompareEqual, compare_equal)
+ARC_BINARY_STENCIL(CompareGreater, compare_greater)
+ARC_BINARY_STENCIL(CompareGreaterOrEqual, compare_greater_or_equal)
+ARC_BINARY_STENCIL(CompareGreaterOrEqualSigned, compare_greater_or_equal_signed)
+ARC_BINARY_STENCIL(CompareGreaterSigned, compare_greater_signed)
+ARC_BINARY_STENCIL(CompareLess, compare_less)
+ARC_BINARY_STENCIL(CompareLessOrEqual, compare_less_or_equal)
+ARC_BINARY_STENCIL(CompareLessOrEqualSigned, compare_less_or_equal_signed)
+ARC_BINARY_STENCIL(CompareLessSigned, compare_less_signed)
+ARC_BINARY_STENCIL(CompareNotEqual, compare_not_equal)
+ARC_BINARY_STENCIL(LogicalAND, logical_and)
+ARC_BINARY_STENCIL(LogicalOR, logical_or)
+ARC_BINARY_STENCIL(LogicalXOR, logical_xor)
+ARC_BINARY_STENCIL(Multiply, multiply)
+
+ARC_UNARY_STENCIL(BitwiseNOT, bitwise_not)
+ARC_UNARY_STENCIL(LogicalNOT, logical_not)
+ARC_UNARY_STENCIL(Negate, negate)
+ARC_UNARY_STENCIL(SignExtend8, sign_extend_8)
+ARC_UNARY_STENCIL(SignExtend16, sign_extend_16)
+ARC_UNARY_STENCIL(SignExtend32, sign_extend_32)
+
+ARC_STENCIL(Add)
+{
+    register_at(registers, arc_hole_operand_0) = register_at(registers, arc_hole_operand_1) + register_at(registers, arc_hole_operand_2);
+    ARC_STENCIL_CONTINUE();
+}
+
+ARC_STENCIL(Sub)
+{
+    register_at(registers, arc_hole_operand_0) = register_at(registers, arc_hole_operand_1) - register_at(registers, arc_hole_operand_2);
+    ARC_STENCIL_CONTINUE();
+}
+
+ARC_STENCIL(Move)
+{
+    register_at(registers, arc_hole_operand_0) = register_at(registers, arc_hole_operand_1);
+    ARC_STENCIL_CONTINUE();
+}
+
+ARC_STENCIL(AddImmediate)
+{
+    register_at(registers, arc_hole_operand_0) = register_at(registers, arc_hole_operand_1) + immediate_value();
+    ARC_STENCIL_CONTINUE();
+}
+
+ARC_STENCIL(SubImmediate)
+{
+    register_at(registers, arc_hole_operand_0) = register_at(registers, arc_hole_operand_1) - immediate_value();
+    ARC_STENCIL_CONTINUE();
+}
+
+ARC_STENCIL(CompareGreaterImmediate)
+{
+    const u64 lhs = register_at(registers, arc_hole_operand_1);
+    register_at(registers, arc_hole_operand_0) = IntegerArithmetic::compare_greater(lhs, immediate_value());
+    ARC_STENCIL_CONTINUE();
+}
+
+ARC_STENCIL(Increment)
+{
+    ++register_at(registers, arc_hole_operand_0);
+    ARC_STENCIL_CONTINUE();
+}
+
+ARC_STENCIL(Decrement)
+{
+    --register_at(registers, arc_hole_operand_0);
+    ARC_STENCIL_CONTINUE();
+}
+
+ARC_STENCIL(LoadImmediate)
+{
+    register_at(registers, arc_hole_operand_0) = immediate_value();
+    ARC_STENCIL_CONTINUE();
+}
+
+ARC_STENCIL(LoadFromFrame)
+{
+    register_at(registers, arc_hole_operand_0) = frame_at(frame_pointer, arc_hole_operand_1);
+    ARC_STENCIL_CONTINUE();
+}
+
+ARC_STENCIL(StoreToFrame)
+{
+    frame_at(frame_pointer, arc_hole_operand_1) = register_at(registers, arc_hole_operand_0);
+    ARC_STENCIL_CONTINUE();
+}
+
+#define ARC_LOAD_FROM_STACK_STENCIL(stencil_name, value_type)                                                                         \
+    ARC_STENCIL(stencil_name)                                                                                                         \
+    {                                                                                                                                 \
+        register_at(registers, arc_hole_operand_0) = static_cast<u64>(stack_at<value_type>(stack_pointer, arc_hole_operand_1));       \
+        ARC_STENCIL_CONTINUE();                                                                                                       \
+    }
+
+#define ARC_STORE_TO_STACK_STENCIL(stencil_name, value_type)                                                                          \
+    ARC_STENCIL(stencil_name)                                                                                                         \
+    {                                                                                                                                 \
+        stack_at<value_type>(stack_pointer, arc_hole_operand_1) = static_cast<value_type>(register_at(registers, arc_hole_operand_0)); \
+        ARC_STENCIL_CONTINUE();                                                                                                       \
+    }
+
+ARC_LOAD_FROM_STACK_STENCIL(LoadFromStack, u64)
+ARC_LOAD_FROM_STACK_STENCIL(Load8FromStack, u8)
+ARC_LOAD_FROM_STACK_STENCIL(Load16FromStack, u16)
+ARC_LOAD_FROM_STACK_STENCIL(Load32FromStack, u32)
+
+ARC_STORE_TO_STACK_STENCIL(StoreToStack, u64)
+ARC_STORE_TO_STACK_STENCIL(Store8ToStack, u8)
+ARC_STORE_TO_STACK_STENCIL(Store16ToStack, u16)
+ARC_STORE_TO_STACK_STENCIL(Store32ToStack, u32)
+
+// Operands: the destination register, the loaded register, the other register, the source stack offset and the
+// destination stack offset.
+ARC_STENCIL(FusedLoadAddStore)
+{
+    // NOTE: The other register is read after the loaded register is written, as they can be the same register.
+    u64& loaded = register_at(registers, arc_hole_operand_1);
+    loaded = stack_at<u64>(stack_pointer, arc_hole_operand_3);
+    const u64 value = loaded + register_at(registers, arc_hole_operand_2);
+    register_at(registers, arc_hole_operand_0) = value;
+    stack_at<u64>(stack_pointer, arc_hole_operand_4) = value;
+    ARC_STENCIL_CONTINUE();
+}
+
+// Operands: the destination register and the stack offset.
+ARC_STENCIL(FusedLoadIncrementStore)
+{
+    u64& stack_value = stack_at<u64>(stack_pointer, arc_hole_operand_1);
+    const u64 value = stack_value + 1;
+    stack_value = value;
+    register_at(registers, arc_hole_operand_0) = value;
+    ARC_STENCIL_CONTINUE();
+}
+
+// Operands: the first destination register, the second destination register, the first source stack offset and the
+// second source stack offset.
+ARC_STENCIL(FusedLoadPair)
+{
+    register_at(registers, arc_hole_operand_0) = stack_at<u64>(stack_pointer, arc_hole_operand_2);
+    register_at(registers, arc_hole_operand_1) = stack_at<u64>(stack_pointer, arc_hole_operand_3);
+    ARC_STENCIL_CONTINUE();
+}
+
+// Operands: the destination register, the source stack offset and the destination stack offset.
+ARC_STENCIL(FusedLoadStore)
+{
+    const u64 value = stack_at<u64>(stack_pointer, arc_hole_operand_1);
+    register_at(registers, arc_hole_operand_0) = value;
+    stack_at<u64>(stack_pointer, arc_hole_operand_2) = value;
+    ARC_STENCIL_CONTINUE();
+}
+
+ARC_STENCIL(Jump)
+{
+    ARC_STENCIL_JUMP();
+}
+
+ARC_STENCIL(JumpIf)
+{
+    if (register_at(registers, arc_hole_operand_0) != 0)
+        ARC_STENCIL_JUMP();
+    ARC_STENCIL_CONTINUE();
+}
+
+ARC_STENCIL(FusedCompareGreaterJumpIf)
+{
+    const u64 lhs = register_at(registers, arc_hole_operand_1);
+    const u64 rhs = register_at(registers, arc_hole_operand_2);
+    const u64 condition = IntegerArithmetic::compare_greater(lhs, rhs);
+    register_at(registers, arc_hole_operand_0) = condition;
+    if (condition != 0)
+        ARC_STENCIL_JUMP();
+    ARC_STENCIL_CONTINUE();
+}
+
+ARC_STENCIL(FusedCompareGreaterImmediateJumpIf)
+{
+    const u64 condition = IntegerArithmetic::compare_greater(register_at(registers, arc_hole_operand_1), immediate_value());
+    register_at(registers, arc_hole_operand_0) = condition;
+    if (condition != 0)
+        ARC_STENCIL_JUMP();
+    ARC_STENCIL_CONTINUE();
+}
@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause.
+ */
+
+#include <bytecode/instruction.h>
+#include <bytecode/package.h>
+#include <runtime/jit/tracing_jit.h>
+
+namespace Arc::Runtime {
+
+using namespace Arc::Bytecode;
+
+NODISCARD static bool is_jump_opcode(OpCode opcode)
+{
+    switch (opcode) {
+        case OpCode::Jump:
+        case OpCode::JumpIf:
+        case OpCode::FusedCompareGreaterJumpIf:
+        case OpCode::FusedCompareGreaterImmediateJumpIf: return true;
+        default: return false;
+    }
+}
+
+// NOTE: The call stack and the stack pointer are owned by the interpreter, so the instructions that change them can't
+//       be part of a trace. Jump tables are also excluded, as a trace can't guard all of their targets.
+NODISCARD static bool ends_trace(OpCode opcode)
+{
+    switch (opcode) {
+        case OpCode::Call:
+        case OpCode::CallWithArguments:
+        case OpCode::JumpTable:
+        case OpCode::Pop:
+        case OpCode::PopRegister:
+        case OpCode::Push:
+        case OpCode::PushImmediate8:
+        case OpCode::PushImmediate16:
+        case OpCode::PushImmediate32:
+        case OpCode::PushImmediate64:
+        case OpCode::PushRegister:
+        case OpCode::Return:
+        case OpCode::ReturnValue:
+        case OpCode::TailCall:
+        case OpCode::TailCallWithArguments: return true;
+        default: return false;
+    }
+}
+
+TracingJit::TracingJit(const Package& package, const TracingJitConfiguration& configuration)
+    : m_package(package)
+    , m_configuration(configuration)
+{
+    m_backward_jump_counts.set_count(package.instruction_count(), 0);
+    m_trace_indices.set_count(package.instruction_count(), no_trace_index);
+}
+
+void TracingJit::on_backward_jump(usize source_instruction_pointer, usize target_instruction_pointer)
+{
+    // NOTE: While recording, the backward jumps of inner loops are simply followed by the trace.
+    if (is_recording() || !is_jump_opcode(m_package.fetch_instruction(source_instruction_pointer).opcode()))
+        return;
+    if (!m_package.instruction_pointer_is_valid(target_instruction_pointer) || find_trace(target_instruction_pointer) != nullptr)
+        return;
+
+    u32& backward_jump_count = m_backward_jump_counts[target_instruction_pointer];
+    if (backward_jump_count == blacklisted_jump_count)
+        return;
+    if (++backward_jump_count < m_configuration.hot_loop_threshold)
+        return;
+
+    backward_jump_count = 0;
+    m_recorded_trace = Trace();
+}
+
+void TracingJit::record_instruction(usize instruction_pointer)
+{
+    Trace& trace = m_recorded_trace.value();
+    if (trace.instruction_pointers.has_elements()) {
+        const bool closes_loop = instruction_pointer == trace.header_instruction_pointer();
+        const bool enters_trace = find_trace(instruction_pointer) != nullptr;
+        if (closes_loop || enters_trace || trace.instruction_pointers.count() >= m_configuration.max_trace_instruction_count) {
+            finish_recording(instruction_pointer);
+            return;
+        }
+    }
+
+    if (ends_trace(m_package.fetch_instruction(instruction_pointer).opcode())) {
+        finish_recording(instruction_pointer);
+        return;
+    }
+
+    trace.instruction_pointers.push_back(instruction_pointer);
+}
+
+void TracingJit::cancel_recording()
+{
+    m_recorded_trace.clear();
+}
+
+void TracingJit::finish_recording(usize exit_instruction_pointer)
+{
+    Trace& trace = m_recorded_trace.value();
+    if (trace.instruction_pointers.is_empty()) {
+        // NOTE: The header itself can't be traced, so neither can the loop.
+        m_backward_jump_counts[exit_instruction_pointer] = blacklisted_jump_count;
+        m_recorded_trace.clear();
+        return;
+    }
+
+    trace.exit_instruction_pointer = exit_instruction_pointer;
+    const usize header_instruction_pointer = trace.header_instruction_pointer();
+    ErrorOr<NativeCode> compile_result = JitCompiler::compile_trace(m_package, trace);
+    m_recorded_trace.clear();
+
+    if (compile_result.is_error()) {
+        m_backward_jump_counts[header_instruction_pointer] = blacklisted_jump_count;
+        return;
+    }
+
+    m_trace_indices[header_instruction_pointer] = static_cast<u32>(m_compiled_traces.count());
+    m_compiled_traces.push_back(compile_result.release_value());
+}
+
+}
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause.
+ */
+
+#pragma once
+
+#include <bytecode/forward.h>
+#include <core/containers/optional.h>
+#include <core/containers/vector.h>
+#include <runtime/forward.h>
+#include <runtime/jit/jit_compiler.h>
+
+namespace Arc::Runtime {
+
+struct TracingJitConfiguration {
+    // The number of times a backward jump to the same instruction must be taken before the loop it closes is traced.
+    u32 hot_loop_threshold { 64 };
+    // The maximum number of instructions in a trace. Longer traces are ended and exit to the interpreter.
+    u32 max_trace_instruction_count { 512 };
+};
+
+//
+// A linear path through the package, recorded while the interpreter executes it. The first instruction is the header
+// of a hot loop and every following instruction is the one that was executed after the previous one, so conditional
+// branches are recorded together with the direction in which they went. When the exit instruction pointer is the
+// header itself the trace is a loop, otherwise the interpreter resumes at the exit instruction.
+//
+struct Trace {
+    Vector<usize> instruction_pointers;
+    usize exit_instruction_pointer { 0 };
+
+    NODISCARD ALWAYS_INLINE usize header_instruction_pointer() const { return instruction_pointers.first(); }
+    NODISCARD ALWAYS_INLINE bool is_loop() const { return exit_instruction_pointer == header_instruction_pointer(); }
+};
+
+//
+// Detects the hot loops of a package while it is interpreted, by counting how many times every backward jump is
+// taken. Once a loop is hot, the next iteration is recorded as a trace and compiled to native code by the
+// `JitCompiler`, with guards that exit to the interpreter when a branch goes in the other direction than the one that
+// was recorded. Traces end at instructions that change the call stack or the stack pointer, which are owned by the
+// interpreter.
+//
+class TracingJit {
+    ARC_MAKE_NONCOPYABLE(TracingJit);
+    ARC_MAKE_NONMOVABLE(TracingJit);
+
+public:
+    // NOTE: The package must be verified, as the compiled traces perform no safety checks.
+    TracingJit(const Bytecode::Package&, const TracingJitConfiguration&);
+
+    NODISCARD ALWAYS_INLINE bool is_recording() const { return m_recorded_trace.has_value(); }
+    NODISCARD ALWAYS_INLINE usize compiled_trace_count() const { return m_compiled_traces.count(); }
+
+    // Returns the compiled trace whose header is the given instruction, if any.
+    NODISCARD ALWAYS_INLINE const NativeCode* find_trace(usize instruction_pointer) const
+    {
+        const u32 trace_index = m_trace_indices[instruction_pointer];
+        return trace_index != no_trace_index ? &m_compiled_traces[trace_index] : nullptr;
+    }
+
+    // Must be called after the interpreter executed the instruction at the source instruction pointer and continued
+    // at an instruction that isn't after it. Starts recording a trace when the jump closes a hot loop.
+    void on_backward_jump(usize source_instruction_pointer, usize target_instruction_pointer);
+
+    // Must be called while recording, right before the interpreter executes the instruction. The recording might be
+    // finished by this call, in which case the instruction isn't part of the trace.
+    void record_instruction(usize instruction_pointer);
+
+    // Discards the trace that is being recorded, if any.
+    void cancel_recording();
+
+private:
+    static constexpr u32 no_trace_index = 0xFFFFFFFF;
+    // NOTE: Loops whose trace can't be compiled are never recorded again.
+    static constexpr u32 blacklisted_jump_count = 0xFFFFFFFF;
+
+    void finish_recording(usize exit_instruction_pointer);
+
+private:
+    const Bytecode::Package& m_package;
+    TracingJitConfiguration m_configuration;
+    // The number of times a backward jump to every instruction was taken.
+    Vector<u32> m_backward_jump_counts;
+    Vector<u32> m_trace_indices;
+    Vector<NativeCode> m_compiled_traces;
+    Optional<Trace> m_recorded_trace;
+};
+
+}
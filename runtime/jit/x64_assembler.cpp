@@ -0,0 +1,383 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause.
+ */
+
+#include <runtime/jit/x64_assembler.h>
+
+namespace Arc::Runtime {
+
+NODISCARD ALWAYS_INLINE static u8 encoding_of(X64Register reg)
+{
+    return static_cast<u8>(reg);
+}
+
+NODISCARD ALWAYS_INLINE static bool fits_in_s8(s64 value)
+{
+    return value >= -128 && value <= 127;
+}
+
+Vector<u8> X64Assembler::finalize()
+{
+    for (const LabelReference& reference : m_label_references) {
+        const u32 label_offset = m_label_offsets[reference.label.index];
+        ARC_ASSERT(label_offset != unbound_label_offset);
+
+        const u32 relative_offset = label_offset - reference.relative_to_offset;
+        for (u32 byte_index = 0; byte_index < sizeof(u32); ++byte_index)
+            m_code[reference.patch_offset + byte_index] = static_cast<u8>(relative_offset >> (byte_index * 8));
+    }
+
+    m_label_references.clear();
+    return Arc::move(m_code);
+}
+
+X64Label X64Assembler::create_label()
+{
+    m_label_offsets.push_back(unbound_label_offset);
+    return { static_cast<u32>(m_label_offsets.count() - 1) };
+}
+
+void X64Assembler::bind_label(X64Label label)
+{
+    ARC_ASSERT(m_label_offsets[label.index] == unbound_label_offset);
+    m_label_offsets[label.index] = current_offset();
+}
+
+void X64Assembler::jump(X64Label label)
+{
+    // JMP rel32
+    emit_u8(0xE9);
+    emit_label_reference(label);
+}
+
+void X64Assembler::jump_if(X64Condition condition, X64Label label)
+{
+    // Jcc rel32
+    emit_u8(0x0F);
+    emit_u8(0x80 + static_cast<u8>(condition));
+    emit_label_reference(label);
+}
+
+void X64Assembler::jump_to_register(X64Register target_register)
+{
+    // JMP r/m64
+    emit_rex(false, 0, 0, encoding_of(target_register));
+    emit_u8(0xFF);
+    emit_modrm_register(4, encoding_of(target_register));
+}
+
+void X64Assembler::load_label_address(X64Register dst_register, X64Label label)
+{
+    // LEA r64, [RIP + disp32]
+    emit_rex(true, encoding_of(dst_register), 0, 0);
+    emit_u8(0x8D);
+    emit_u8(((encoding_of(dst_register) & 7) << 3) | 0x05);
+    emit_label_reference(label);
+}
+
+void X64Assembler::emit_label_offset(X64Label label, u32 relative_to_offset)
+{
+    m_label_references.push_back({ label, current_offset(), relative_to_offset });
+    emit_u32(0);
+}
+
+void X64Assembler::move(X64Register dst_register, X64Register src_register)
+{
+    // MOV r/m64, r64
+    emit_rex(true, encoding_of(src_register), 0, encoding_of(dst_register));
+    emit_u8(0x89);
+    emit_modrm_register(encoding_of(src_register), encoding_of(dst_register));
+}
+
+void X64Assembler::move_immediate(X64Register dst_register, u64 immediate_value)
+{
+    const u8 dst = encoding_of(dst_register);
+    if (immediate_value <= 0xFFFFFFFF) {
+        // MOV r32, imm32 (the upper half of the register is cleared)
+        emit_rex(false, 0, 0, dst);
+        emit_u8(0xB8 + (dst & 7));
+        emit_u32(static_cast<u32>(immediate_value));
+        return;
+    }
+
+    const s64 signed_value = static_cast<s64>(immediate_value);
+    if (signed_value >= -2147483648LL && signed_value < 0) {
+        // MOV r/m64, imm32 (sign extended)
+        emit_rex(true, 0, 0, dst);
+        emit_u8(0xC7);
+        emit_modrm_register(0, dst);
+        emit_u32(static_cast<u32>(immediate_value));
+        return;
+    }
+
+    // MOV r64, imm64
+    emit_rex(true, 0, 0, dst);
+    emit_u8(0xB8 + (dst & 7));
+    emit_u64(immediate_value);
+}
+
+void X64Assembler::load(X64Register dst_register, X64Memory src_memory)
+{
+    // MOV r64, r/m64
+    emit_rex(true, encoding_of(dst_register), 0, encoding_of(src_memory.base));
+    emit_u8(0x8B);
+    emit_modrm_memory(encoding_of(dst_register), src_memory);
+}
+
+void X64Assembler::load_zero_extended_8(X64Register dst_register, X64Memory src_memory)
+{
+    // MOVZX r32, r/m8
+    emit_rex(false, encoding_of(dst_register), 0, encoding_of(src_memory.base));
+    emit_u8(0x0F);
+    emit_u8(0xB6);
+    emit_modrm_memory(encoding_of(dst_register), src_memory);
+}
+
+void X64Assembler::load_zero_extended_16(X64Register dst_register, X64Memory src_memory)
+{
+    // MOVZX r32, r/m16
+    emit_rex(false, encoding_of(dst_register), 0, encoding_of(src_memory.base));
+    emit_u8(0x0F);
+    emit_u8(0xB7);
+    emit_modrm_memory(encoding_of(dst_register), src_memory);
+}
+
+void X64Assembler::load_zero_extended_32(X64Register dst_register, X64Memory src_memory)
+{
+    // MOV r32, r/m32 (the upper half of the register is cleared)
+    emit_rex(false, encoding_of(dst_register), 0, encoding_of(src_memory.base));
+    emit_u8(0x8B);
+    emit_modrm_memory(encoding_of(dst_register), src_memory);
+}
+
+void X64Assembler::load_sign_extended_32_indexed(X64Register dst_register, X64Register base_register, X64Register index_register)
+{
+    // NOTE: An index encoded as `RSP` means that there is no index at all.
+    ARC_ASSERT(index_register != X64Register::RSP);
+    const u8 dst = encoding_of(dst_register);
+    const u8 base = encoding_of(base_register);
+    const u8 index = encoding_of(index_register);
+
+    // MOVSXD r64, r/m32
+    emit_rex(true, dst, index, base);
+    emit_u8(0x63);
+    // NOTE: A base encoded as `RBP` or `R13` without a displacement means that there is no base at all, so an explicit
+    //       zero displacement is used for them.
+    const bool requires_displacement = (base & 7) == 5;
+    emit_u8((requires_displacement ? 0x40 : 0x00) | ((dst & 7) << 3) | 0x04);
+    emit_u8((2 << 6) | ((index & 7) << 3) | (base & 7));
+    if (requires_displacement)
+        emit_u8(0);
+}
+
+void X64Assembler::store(X64Memory dst_memory, X64Register src_register)
+{
+    // MOV r/m64, r64
+    emit_rex(true, encoding_of(src_register), 0, encoding_of(dst_memory.base));
+    emit_u8(0x89);
+    emit_modrm_memory(encoding_of(src_register), dst_memory);
+}
+
+void X64Assembler::store_8(X64Memory dst_memory, X64Register src_register)
+{
+    // MOV r/m8, r8
+    const u8 src = encoding_of(src_register);
+    emit_rex(false, src, 0, encoding_of(dst_memory.base), src >= 4);
+    emit_u8(0x88);
+    emit_modrm_memory(src, dst_memory);
+}
+
+void X64Assembler::store_16(X64Memory dst_memory, X64Register src_register)
+{
+    // MOV r/m16, r16
+    emit_u8(0x66);
+    emit_rex(false, encoding_of(src_register), 0, encoding_of(dst_memory.base));
+    emit_u8(0x89);
+    emit_modrm_memory(encoding_of(src_register), dst_memory);
+}
+
+void X64Assembler::store_32(X64Memory dst_memory, X64Register src_register)
+{
+    // MOV r/m32, r32
+    emit_rex(false, encoding_of(src_register), 0, encoding_of(dst_memory.base));
+    emit_u8(0x89);
+    emit_modrm_memory(encoding_of(src_register), dst_memory);
+}
+
+void X64Assembler::arithmetic(X64ArithmeticOperation operation, X64Register dst_register, X64Register src_register)
+{
+    // ADD/OR/AND/SUB/XOR/CMP r/m64, r64
+    emit_rex(true, encoding_of(src_register), 0, encoding_of(dst_register));
+    emit_u8((static_cast<u8>(operation) << 3) | 0x01);
+    emit_modrm_register(encoding_of(src_register), encoding_of(dst_register));
+}
+
+void X64Assembler::arithmetic_immediate(X64ArithmeticOperation operation, X64Register dst_register, s32 immediate_value)
+{
+    emit_rex(true, 0, 0, encoding_of(dst_register));
+    if (fits_in_s8(immediate_value)) {
+        // ADD/OR/AND/SUB/XOR/CMP r/m64, imm8
+        emit_u8(0x83);
+        emit_modrm_register(static_cast<u8>(operation), encoding_of(dst_register));
+        emit_u8(static_cast<u8>(immediate_value));
+        return;
+    }
+
+    // ADD/OR/AND/SUB/XOR/CMP r/m64, imm32
+    emit_u8(0x81);
+    emit_modrm_register(static_cast<u8>(operation), encoding_of(dst_register));
+    emit_u32(static_cast<u32>(immediate_value));
+}
+
+void X64Assembler::multiply(X64Register dst_register, X64Register src_register)
+{
+    // IMUL r64, r/m64
+    emit_rex(true, encoding_of(dst_register), 0, encoding_of(src_register));
+    emit_u8(0x0F);
+    emit_u8(0xAF);
+    emit_modrm_register(encoding_of(dst_register), encoding_of(src_register));
+}
+
+void X64Assembler::shift_by_cl(X64ShiftOperation operation, X64Register dst_register)
+{
+    // SHL/SHR/SAR r/m64, CL
+    emit_rex(true, 0, 0, encoding_of(dst_register));
+    emit_u8(0xD3);
+    emit_modrm_register(static_cast<u8>(operation), encoding_of(dst_register));
+}
+
+void X64Assembler::test(X64Register lhs_register, X64Register rhs_register)
+{
+    // TEST r/m64, r64
+    emit_rex(true, encoding_of(rhs_register), 0, encoding_of(lhs_register));
+    emit_u8(0x85);
+    emit_modrm_register(encoding_of(rhs_register), encoding_of(lhs_register));
+}
+
+void X64Assembler::negate(X64Register dst_register)
+{
+    // NEG r/m64
+    emit_rex(true, 0, 0, encoding_of(dst_register));
+    emit_u8(0xF7);
+    emit_modrm_register(3, encoding_of(dst_register));
+}
+
+void X64Assembler::bitwise_not(X64Register dst_register)
+{
+    // NOT r/m64
+    emit_rex(true, 0, 0, encoding_of(dst_register));
+    emit_u8(0xF7);
+    emit_modrm_register(2, encoding_of(dst_register));
+}
+
+void X64Assembler::set_if(X64Condition condition, X64Register dst_register)
+{
+    const u8 dst = encoding_of(dst_register);
+
+    // SETcc r/m8
+    emit_rex(false, 0, 0, dst, dst >= 4);
+    emit_u8(0x0F);
+    emit_u8(0x90 + static_cast<u8>(condition));
+    emit_modrm_register(0, dst);
+
+    // MOVZX r32, r/m8
+    emit_rex(false, dst, 0, dst, dst >= 4);
+    emit_u8(0x0F);
+    emit_u8(0xB6);
+    emit_modrm_register(dst, dst);
+}
+
+void X64Assembler::sign_extend_8(X64Register dst_register, X64Register src_register)
+{
+    // MOVSX r64, r/m8
+    emit_rex(true, encoding_of(dst_register), 0, encoding_of(src_register));
+    emit_u8(0x0F);
+    emit_u8(0xBE);
+    emit_modrm_register(encoding_of(dst_register), encoding_of(src_register));
+}
+
+void X64Assembler::sign_extend_16(X64Register dst_register, X64Register src_register)
+{
+    // MOVSX r64, r/m16
+    emit_rex(true, encoding_of(dst_register), 0, encoding_of(src_register));
+    emit_u8(0x0F);
+    emit_u8(0xBF);
+    emit_modrm_register(encoding_of(dst_register), encoding_of(src_register));
+}
+
+void X64Assembler::sign_extend_32(X64Register dst_register, X64Register src_register)
+{
+    // MOVSXD r64, r/m32
+    emit_rex(true, encoding_of(dst_register), 0, encoding_of(src_register));
+    emit_u8(0x63);
+    emit_modrm_register(encoding_of(dst_register), encoding_of(src_register));
+}
+
+void X64Assembler::push(X64Register src_register)
+{
+    // PUSH r64
+    emit_rex(false, 0, 0, encoding_of(src_register));
+    emit_u8(0x50 + (encoding_of(src_register) & 7));
+}
+
+void X64Assembler::pop(X64Register dst_register)
+{
+    // POP r64
+    emit_rex(false, 0, 0, encoding_of(dst_register));
+    emit_u8(0x58 + (encoding_of(dst_register) & 7));
+}
+
+void X64Assembler::ret()
+{
+    emit_u8(0xC3);
+}
+
+void X64Assembler::emit_u8(u8 value)
+{
+    m_code.push_back(value);
+}
+
+void X64Assembler::emit_u32(u32 value)
+{
+    for (u32 byte_index = 0; byte_index < sizeof(u32); ++byte_index)
+        emit_u8(static_cast<u8>(value >> (byte_index * 8)));
+}
+
+void X64Assembler::emit_u64(u64 value)
+{
+    for (u32 byte_index = 0; byte_index < sizeof(u64); ++byte_index)
+        emit_u8(static_cast<u8>(value >> (byte_index * 8)));
+}
+
+void X64Assembler::emit_rex(bool is_64_bit, u8 reg, u8 index, u8 base, bool is_forced)
+{
+    const u8 rex = 0x40 | (is_64_bit ? 0x08 : 0x00) | ((reg >> 3) << 2) | ((index >> 3) << 1) | (base >> 3);
+    if (rex != 0x40 || is_forced)
+        emit_u8(rex);
+}
+
+void X64Assembler::emit_modrm_register(u8 reg, u8 rm)
+{
+    emit_u8(0xC0 | ((reg & 7) << 3) | (rm & 7));
+}
+
+void X64Assembler::emit_modrm_memory(u8 reg, X64Memory memory)
+{
+    // NOTE: The displacement is always encoded on 32 bits, which keeps the encoding independent of its value.
+    const u8 base = encoding_of(memory.base);
+    emit_u8(0x80 | ((reg & 7) << 3) | (base & 7));
+    // NOTE: A base encoded as `RSP` or `R12` requires a SIB byte, which is the way to address them without an index.
+    if ((base & 7) == 4)
+        emit_u8(0x24);
+    emit_u32(static_cast<u32>(memory.displacement));
+}
+
+void X64Assembler::emit_label_reference(X64Label label)
+{
+    // NOTE: Branch displacements are relative to the end of the instruction, which always ends with the displacement.
+    m_label_references.push_back({ label, current_offset(), current_offset() + static_cast<u32>(sizeof(u32)) });
+    emit_u32(0);
+}
+
+}
@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause.
+ */
+
+#pragma once
+
+#include <core/containers/vector.h>
+#include <core/types.h>
+
+namespace Arc::Runtime {
+
+// The general purpose registers of the x86-64 architecture, numbered as they are encoded in instructions.
+enum class X64Register : u8 {
+    RAX = 0,
+    RCX,
+    RDX,
+    RBX,
+    RSP,
+    RBP,
+    RSI,
+    RDI,
+    R8,
+    R9,
+    R10,
+    R11,
+    R12,
+    R13,
+    R14,
+    R15,
+};
+
+// The condition codes of the `Jcc` and `SETcc` instructions.
+enum class X64Condition : u8 {
+    Below = 0x2,
+    AboveOrEqual = 0x3,
+    Equal = 0x4,
+    NotEqual = 0x5,
+    BelowOrEqual = 0x6,
+    Above = 0x7,
+    Less = 0xC,
+    GreaterOrEqual = 0xD,
+    LessOrEqual = 0xE,
+    Greater = 0xF,
+};
+
+// The arithmetic instructions that share the same encodings, numbered by their opcode extension.
+enum class X64ArithmeticOperation : u8 {
+    Add = 0,
+    Or = 1,
+    And = 4,
+    Sub = 5,
+    Xor = 6,
+    Compare = 7,
+};
+
+// The shift instructions, numbered by their opcode extension.
+enum class X64ShiftOperation : u8 {
+    ShiftLeft = 4,
+    ShiftRight = 5,
+    ShiftRightSigned = 7,
+};
+
+// A memory operand of the form `[base + displacement]`.
+struct X64Memory {
+    X64Register base;
+    s32 displacement;
+};
+
+struct X64Label {
+    u32 index;
+};
+
+//
+// Encodes x86-64 instructions into a position-independent code buffer. Only the instructions (and the operand forms)
+// that are needed by the JIT compiler are supported. All operations act on the full 64-bit registers, unless stated
+// otherwise by their name. Branches reference labels, which are resolved when the code is finalized.
+//
+class X64Assembler {
+    ARC_MAKE_NONCOPYABLE(X64Assembler);
+    ARC_MAKE_NONMOVABLE(X64Assembler);
+
+public:
+    X64Assembler() = default;
+    ~X64Assembler() = default;
+
+    NODISCARD ALWAYS_INLINE u32 current_offset() const { return static_cast<u32>(m_code.count()); }
+
+    // Resolves all label references and returns the encoded code. All the referenced labels must be bound.
+    NODISCARD Vector<u8> finalize();
+
+public:
+    NODISCARD X64Label create_label();
+    void bind_label(X64Label label);
+
+    void jump(X64Label label);
+    void jump_if(X64Condition condition, X64Label label);
+    void jump_to_register(X64Register target_register);
+
+    // Loads the address of the label, relative to the instruction pointer, into the register.
+    void load_label_address(X64Register dst_register, X64Label label);
+    // Emits a 32-bit value equal to the offset of the label relative to the given code offset, for use in jump tables.
+    void emit_label_offset(X64Label label, u32 relative_to_offset);
+
+public:
+    void move(X64Register dst_register, X64Register src_register);
+    void move_immediate(X64Register dst_register, u64 immediate_value);
+
+    void load(X64Register dst_register, X64Memory src_memory);
+    void load_zero_extended_8(X64Register dst_register, X64Memory src_memory);
+    void load_zero_extended_16(X64Register dst_register, X64Memory src_memory);
+    void load_zero_extended_32(X64Register dst_register, X64Memory src_memory);
+    // Loads the 32-bit value at `[base + index * 4]`, sign extended to 64 bits.
+    void load_sign_extended_32_indexed(X64Register dst_register, X64Register base_register, X64Register index_register);
+
+    void store(X64Memory dst_memory, X64Register src_register);
+    void store_8(X64Memory dst_memory, X64Register src_register);
+    void store_16(X64Memory dst_memory, X64Register src_register);
+    void store_32(X64Memory dst_memory, X64Register src_register);
+
+    void arithmetic(X64ArithmeticOperation operation, X64Register dst_register, X64Register src_register);
+    // NOTE: The immediate value is sign extended to 64 bits by the processor.
+    void arithmetic_immediate(X64ArithmeticOperation operation, X64Register dst_register, s32 immediate_value);
+    void multiply(X64Register dst_register, X64Register src_register);
+    void shift_by_cl(X64ShiftOperation operation, X64Register dst_register);
+    void test(X64Register lhs_register, X64Register rhs_register);
+    void negate(X64Register dst_register);
+    void bitwise_not(X64Register dst_register);
+
+    // Sets the register to one if the condition holds, and to zero otherwise.
+    void set_if(X64Condition condition, X64Register dst_register);
+
+    void sign_extend_8(X64Register dst_register, X64Register src_register);
+    void sign_extend_16(X64Register dst_register, X64Register src_register);
+    void sign_extend_32(X64Register dst_register, X64Register src_register);
+
+    void push(X64Register src_register);
+    void pop(X64Register dst_register);
+    void ret();
+
+private:
+    void emit_u8(u8 value);
+    void emit_u32(u32 value);
+    void emit_u64(u64 value);
+
+    // Emits the REX prefix, if it is required by the operands. The byte registers `SPL`, `BPL`, `SIL` and `DIL` can
+    // only be addressed when a REX prefix is present, in which case it must be forced.
+    void emit_rex(bool is_64_bit, u8 reg, u8 index, u8 base, bool is_forced = false);
+    void emit_modrm_register(u8 reg, u8 rm);
+    void emit_modrm_memory(u8 reg, X64Memory memory);
+
+    void emit_label_reference(X64Label label);
+
+private:
+    struct LabelReference {
+        X64Label label;
+        u32 patch_offset;
+        u32 relative_to_offset;
+    };
+
+    static constexpr u32 unbound_label_offset = 0xFFFFFFFF;
+
+    Vector<u8> m_code;
+    Vector<u32> m_label_offsets;
+    Vector<LabelReference> m_label_references;
+};
+
+}
@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause.
+ */
+
+#include <runtime/memoization_cache.h>
+
+namespace Arc::Runtime {
+
+NODISCARD static usize round_down_to_power_of_two(usize value)
+{
+    usize power_of_two = 1;
+    while (power_of_two <= value / 2)
+        power_of_two *= 2;
+    return power_of_two;
+}
+
+NODISCARD static bool keys_are_equal(const MemoizationKey& lhs, const MemoizationKey& rhs)
+{
+    if (lhs.callee_address != rhs.callee_address || lhs.argument_count != rhs.argument_count)
+        return false;
+    for (u8 argument_index = 0; argument_index < lhs.argument_count; ++argument_index) {
+        if (lhs.arguments[argument_index] != rhs.arguments[argument_index])
+            return false;
+    }
+    return true;
+}
+
+NODISCARD static u64 hash_key(const MemoizationKey& key)
+{
+    // NOTE: Multiplicative hashing with the 64-bit golden ratio, which spreads consecutive argument values (the most
+    //       common case for numeric kernels) over all the sets.
+    constexpr u64 hash_multiplier = 0x9E3779B97F4A7C15;
+    u64 hash = (key.callee_address + 1) * hash_multiplier;
+    for (u8 argument_index = 0; argument_index < key.argument_count; ++argument_index)
+        hash = (hash ^ key.arguments[argument_index]) * hash_multiplier;
+    return hash ^ (hash >> 32);
+}
+
+MemoizationCache::MemoizationCache(Badge<VirtualMachine>, const MemoizationCacheConfiguration& configuration)
+    : m_set_entry_count(0)
+    , m_set_count(0)
+    , m_eviction_policy(configuration.eviction_policy)
+    , m_use_tick(0)
+{
+    if (configuration.entry_count == 0)
+        return;
+
+    // NOTE: The number of sets is a power of two, so that the set of a key is selected by masking its hash.
+    m_set_entry_count = round_down_to_power_of_two(configuration.set_entry_count > 0 ? configuration.set_entry_count : 1);
+    if (m_set_entry_count > configuration.entry_count)
+        m_set_entry_count = round_down_to_power_of_two(configuration.entry_count);
+    m_set_count = round_down_to_power_of_two(configuration.entry_count / m_set_entry_count);
+    m_entries.set_count_defaulted(m_set_count * m_set_entry_count);
+}
+
+Optional<u64> MemoizationCache::find(const MemoizationKey& key)
+{
+    if (!is_enabled())
+        return {};
+
+    const usize first_entry_index = first_entry_index_of_set(key);
+    for (usize entry_index = first_entry_index; entry_index < first_entry_index + m_set_entry_count; ++entry_index) {
+        Entry& entry = m_entries[entry_index];
+        if (entry.state == EntryState::Occupied && keys_are_equal(entry.key, key)) {
+            entry.last_use_tick = ++m_use_tick;
+            return entry.value;
+        }
+    }
+
+    return {};
+}
+
+Optional<u32> MemoizationCache::reserve(const MemoizationKey& key)
+{
+    if (!is_enabled())
+        return {};
+
+    // Prefer an empty entry. Otherwise, pick the least recently used entry that isn't reserved by another call.
+    const usize first_entry_index = first_entry_index_of_set(key);
+    Optional<usize> victim_entry_index;
+    for (usize entry_index = first_entry_index; entry_index < first_entry_index + m_set_entry_count; ++entry_index) {
+        const Entry& entry = m_entries[entry_index];
+        if (entry.state == EntryState::Empty) {
+            victim_entry_index = entry_index;
+            break;
+        }
+
+        if (entry.state == EntryState::Reserved || m_eviction_policy == MemoizationEvictionPolicy::KeepExisting)
+            continue;
+        if (!victim_entry_index.has_value() || entry.last_use_tick < m_entries[victim_entry_index.value()].last_use_tick)
+            victim_entry_index = entry_index;
+    }
+
+    if (!victim_entry_index.has_value())
+        return {};
+
+    Entry& entry = m_entries[victim_entry_index.value()];
+    entry.key = key;
+    entry.state = EntryState::Reserved;
+    return static_cast<u32>(victim_entry_index.value());
+}
+
+void MemoizationCache::store(u32 entry_index, u64 value)
+{
+    Entry& entry = m_entries[entry_index];
+    ARC_ASSERT(entry.state == EntryState::Reserved);
+    entry.value = value;
+    entry.last_use_tick = ++m_use_tick;
+    entry.state = EntryState::Occupied;
+}
+
+void MemoizationCache::release(u32 entry_index)
+{
+    Entry& entry = m_entries[entry_index];
+    ARC_ASSERT(entry.state == EntryState::Reserved);
+    entry.state = EntryState::Empty;
+}
+
+void MemoizationCache::clear()
+{
+    for (Entry& entry : m_entries)
+        entry.state = EntryState::Empty;
+    m_use_tick = 0;
+}
+
+usize MemoizationCache::first_entry_index_of_set(const MemoizationKey& key) const
+{
+    const usize set_index = hash_key(key) & (m_set_count - 1);
+    return set_index * m_set_entry_count;
+}
+
+}
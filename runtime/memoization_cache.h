@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause.
+ */
+
+#pragma once
+
+#include <core/badge.h>
+#include <core/containers/array.h>
+#include <core/containers/optional.h>
+#include <core/containers/vector.h>
+#include <runtime/forward.h>
+
+namespace Arc::Runtime {
+
+enum class MemoizationEvictionPolicy : u8 {
+    // When all the entries a result can be stored in are occupied, the least recently used one is replaced.
+    LeastRecentlyUsed,
+    // Results are only stored while there are free entries, so the results computed first are never evicted.
+    KeepExisting,
+};
+
+struct MemoizationCacheConfiguration {
+    // The maximum number of results that are stored. Zero disables memoization.
+    usize entry_count { 0 };
+    // The number of entries a result can be stored in, which is rounded down to a power of two. Higher values reduce
+    // the number of evictions caused by hash collisions, but make every lookup slower.
+    usize set_entry_count { 4 };
+    MemoizationEvictionPolicy eviction_policy { MemoizationEvictionPolicy::LeastRecentlyUsed };
+};
+
+// Identifies a call to a pure function. Only calls whose arguments are all passed in registers can be memoized.
+struct MemoizationKey {
+    static constexpr u8 max_argument_count = 4;
+
+    u64 callee_address { 0 };
+    u8 argument_count { 0 };
+    Array<u64, max_argument_count> arguments {};
+};
+
+//
+// Bounded, set-associative cache that maps calls to pure functions to the values they return. The result of a call
+// is only known once the callee returns, so a missed lookup reserves an entry that is completed when the call frame
+// is popped. Reserved entries are never evicted, which keeps them valid for the whole duration of the call.
+//
+class MemoizationCache {
+    ARC_MAKE_NONCOPYABLE(MemoizationCache);
+    ARC_MAKE_NONMOVABLE(MemoizationCache);
+
+public:
+    MemoizationCache(Badge<VirtualMachine>, const MemoizationCacheConfiguration& configuration);
+    ~MemoizationCache() = default;
+
+    NODISCARD ALWAYS_INLINE bool is_enabled() const { return m_entries.has_elements(); }
+
+    // Returns the value that was returned by a previous call with the same key, if it is still cached.
+    NODISCARD Optional<u64> find(const MemoizationKey& key);
+
+    // Reserves an entry for the result of a call with the given key. Fails when all candidate entries are reserved,
+    // or when they are all occupied and the eviction policy doesn't allow replacing them.
+    NODISCARD Optional<u32> reserve(const MemoizationKey& key);
+
+    // Completes a reserved entry with the value returned by the call.
+    void store(u32 entry_index, u64 value);
+    // Frees a reserved entry, for calls that returned without a value.
+    void release(u32 entry_index);
+
+    void clear();
+
+private:
+    enum class EntryState : u8 {
+        Empty,
+        Reserved,
+        Occupied,
+    };
+
+    struct Entry {
+        MemoizationKey key;
+        u64 value { 0 };
+        u64 last_use_tick { 0 };
+        EntryState state { EntryState::Empty };
+    };
+
+    NODISCARD usize first_entry_index_of_set(const MemoizationKey& key) const;
+
+private:
+    Vector<Entry> m_entries;
+    usize m_set_entry_count;
+    usize m_set_count;
+    MemoizationEvictionPolicy m_eviction_policy;
+    u64 m_use_tick;
+};
+
+}
@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause.
+ */
+
+#include <bytecode/instruction.h>
+#include <bytecode/package.h>
+#include <runtime/interpreter.h>
+#include <runtime/threaded_code.h>
+
+namespace Arc::Runtime {
+
+using namespace Arc::Bytecode;
+
+// NOTE: The instructions that don't change the control flow are executed exactly like the interpreter executes them
+//       when fetching them from the package, and always continue with the next instruction.
+template<typename InstructionType>
+static const ThreadedInstruction* execute_instruction(Interpreter& interpreter, const ThreadedInstruction& instruction)
+{
+    static_cast<const InstructionType&>(*instruction.instruction).execute(interpreter);
+    return &instruction + 1;
+}
+
+static const ThreadedInstruction* execute_jump(Interpreter&, const ThreadedInstruction& instruction)
+{
+    return instruction.jump_target;
+}
+
+static const ThreadedInstruction* execute_jump_if(Interpreter& interpreter, const ThreadedInstruction& instruction)
+{
+    const auto& typed_instruction = instruction.instruction->as<JumpIfInstruction>();
+    if (interpreter.vm().register_storage(typed_instruction.condition_register()).value)
+        return instruction.jump_target;
+    return &instruction + 1;
+}
+
+static const ThreadedInstruction* execute_fused_compare_greater_jump_if(Interpreter& interpreter, const ThreadedInstruction& instruction)
+{
+    const auto& typed_instruction = instruction.instruction->as<FusedCompareGreaterJumpIfInstruction>();
+    VirtualMachine& vm = interpreter.vm();
+    const u64 lhs = vm.register_storage(typed_instruction.lhs_register()).value;
+    const u64 rhs = vm.register_storage(typed_instruction.rhs_register()).value;
+    const u64 condition = lhs > rhs;
+    vm.register_storage(typed_instruction.dst_register()).value = condition;
+    return condition ? instruction.jump_target : &instruction + 1;
+}
+
+static const ThreadedInstruction* execute_fused_compare_greater_immediate_jump_if(Interpreter& interpreter,
+                                                                                  const ThreadedInstruction& instruction)
+{
+    const auto& typed_instruction = instruction.instruction->as<FusedCompareGreaterImmediateJumpIfInstruction>();
+    VirtualMachine& vm = interpreter.vm();
+    const u64 condition = vm.register_storage(typed_instruction.lhs_register()).value > typed_instruction.immediate_value();
+    vm.register_storage(typed_instruction.dst_register()).value = condition;
+    return condition ? instruction.jump_target : &instruction + 1;
+}
+
+static const ThreadedInstruction* execute_jump_table(Interpreter& interpreter, const ThreadedInstruction& instruction)
+{
+    const auto& typed_instruction = instruction.instruction->as<JumpTableInstruction>();
+    const u64 index = interpreter.vm().register_storage(typed_instruction.index_register()).value;
+    if (index >= typed_instruction.entry_count())
+        return instruction.jump_target;
+    return interpreter.threaded_code().jump_table_target(typed_instruction.first_entry_index() + index);
+}
+
+static const ThreadedInstruction* execute_call(Interpreter& interpreter, const ThreadedInstruction& instruction)
+{
+    const auto& typed_instruction = instruction.instruction->as<CallInstruction>();
+    VirtualMachine& vm = interpreter.vm();
+    const JumpAddress return_address = JumpAddress(interpreter.threaded_code().instruction_pointer_of(instruction) + 1);
+    vm.stack().push_call_frame(return_address, typed_instruction.parameters_byte_count());
+    vm.register_file().push_window();
+    return instruction.jump_target;
+}
+
+static const ThreadedInstruction* execute_call_with_arguments(Interpreter& interpreter, const ThreadedInstruction& instruction)
+{
+    const auto& typed_instruction = instruction.instruction->as<CallWithArgumentsInstruction>();
+    VirtualMachine& vm = interpreter.vm();
+    u32 memoization_entry_index = CallFrameHeader::no_memoization_entry_index;
+    if (vm.memoization_cache().is_enabled() &&
+        interpreter.try_resolve_memoized_call(typed_instruction.callee_address(), typed_instruction.first_argument_register(),
+                                              typed_instruction.argument_count(), typed_instruction.return_value_register(),
+                                              typed_instruction.parameters_byte_count(), memoization_entry_index)) {
+        return &instruction + 1;
+    }
+
+    const JumpAddress return_address = JumpAddress(interpreter.threaded_code().instruction_pointer_of(instruction) + 1);
+    vm.stack().push_call_frame(return_address, typed_instruction.parameters_byte_count(), typed_instruction.return_value_register(),
+                               memoization_entry_index);
+    vm.register_file().push_window_with_arguments(typed_instruction.first_argument_register(), typed_instruction.argument_count());
+    return instruction.jump_target;
+}
+
+static const ThreadedInstruction* execute_return(Interpreter& interpreter, const ThreadedInstruction&)
+{
+    VirtualMachine& vm = interpreter.vm();
+    const CallFrameHeader last_call_frame = vm.stack().pop_call_frame();
+    vm.register_file().pop_window();
+    if (last_call_frame.memoization_entry_index != CallFrameHeader::no_memoization_entry_index)
+        interpreter.complete_memoized_call(last_call_frame, {});
+
+    // NOTE: The return addresses live on the stack, so they are the only jump addresses resolved during execution.
+    return interpreter.threaded_code().resolve(last_call_frame.return_address);
+}
+
+static const ThreadedInstruction* execute_return_value(Interpreter& interpreter, const ThreadedInstruction& instruction)
+{
+    const auto& typed_instruction = instruction.instruction->as<ReturnValueInstruction>();
+    VirtualMachine& vm = interpreter.vm();
+    const u64 return_value = vm.register_storage(typed_instruction.src_register()).value;
+    const CallFrameHeader last_call_frame = vm.stack().pop_call_frame();
+    vm.register_file().pop_window();
+
+    if (last_call_frame.has_return_value_register)
+        vm.register_storage(last_call_frame.return_value_register).value = return_value;
+    if (last_call_frame.memoization_entry_index != CallFrameHeader::no_memoization_entry_index)
+        interpreter.complete_memoized_call(last_call_frame, return_value);
+
+    return interpreter.threaded_code().resolve(last_call_frame.return_address);
+}
+
+static const ThreadedInstruction* execute_tail_call(Interpreter& interpreter, const ThreadedInstruction& instruction)
+{
+    const auto& typed_instruction = instruction.instruction->as<TailCallInstruction>();
+    VirtualMachine& vm = interpreter.vm();
+    vm.stack().replace_call_frame(typed_instruction.parameters_byte_count(), true);
+    vm.register_file().replace_window_with_arguments(Register::GPR0, 0);
+    return instruction.jump_target;
+}
+
+static const ThreadedInstruction* execute_tail_call_with_arguments(Interpreter& interpreter, const ThreadedInstruction& instruction)
+{
+    const auto& typed_instruction = instruction.instruction->as<TailCallWithArgumentsInstruction>();
+    VirtualMachine& vm = interpreter.vm();
+    vm.stack().replace_call_frame(typed_instruction.parameters_byte_count(), false);
+    vm.register_file().replace_window_with_arguments(typed_instruction.first_argument_register(), typed_instruction.argument_count());
+    return instruction.jump_target;
+}
+
+NODISCARD static ThreadedHandler handler_for(OpCode opcode)
+{
+    switch (opcode) {
+        case OpCode::Call: return execute_call;
+        case OpCode::CallWithArguments: return execute_call_with_arguments;
+        case OpCode::FusedCompareGreaterImmediateJumpIf: return execute_fused_compare_greater_immediate_jump_if;
+        case OpCode::FusedCompareGreaterJumpIf: return execute_fused_compare_greater_jump_if;
+        case OpCode::Jump: return execute_jump;
+        case OpCode::JumpIf: return execute_jump_if;
+        case OpCode::JumpTable: return execute_jump_table;
+        case OpCode::Return: return execute_return;
+        case OpCode::ReturnValue: return execute_return_value;
+        case OpCode::TailCall: return execute_tail_call;
+        case OpCode::TailCallWithArguments: return execute_tail_call_with_arguments;
+        default: break;
+    }
+
+    switch (opcode) {
+#define _ARC_HANDLER_FOR(x) \
+    case OpCode::x: return execute_instruction<x##Instruction>;
+        ARC_ENUMERATE_BYTECODE_OPCODES(_ARC_HANDLER_FOR)
+#undef _ARC_HANDLER_FOR
+
+        // NOTE: Invalid opcodes are reported by the generic dispatch when (and if) they are executed.
+        default: return execute_instruction<Instruction>;
+    }
+}
+
+// Returns the address that the control flow instruction transfers the execution to. The default address is used for
+// jump tables, whose entries are resolved separately.
+NODISCARD static Optional<JumpAddress> jump_target_address(const Instruction& instruction)
+{
+    switch (instruction.opcode()) {
+        case OpCode::Call: return instruction.as<CallInstruction>().callee_address();
+        case OpCode::CallWithArguments: return instruction.as<CallWithArgumentsInstruction>().callee_address();
+        case OpCode::FusedCompareGreaterImmediateJumpIf:
+            return instruction.as<FusedCompareGreaterImmediateJumpIfInstruction>().jump_address();
+        case OpCode::FusedCompareGreaterJumpIf: return instruction.as<FusedCompareGreaterJumpIfInstruction>().jump_address();
+        case OpCode::Jump: return instruction.as<JumpInstruction>().jump_address();
+        case OpCode::JumpIf: return instruction.as<JumpIfInstruction>().jump_address();
+        case OpCode::JumpTable: return instruction.as<JumpTableInstruction>().default_address();
+        case OpCode::TailCall: return instruction.as<TailCallInstruction>().callee_address();
+        case OpCode::TailCallWithArguments: return instruction.as<TailCallWithArgumentsInstruction>().callee_address();
+        default: return {};
+    }
+}
+
+ThreadedCode::ThreadedCode(const Package& package)
+    : m_instruction_count(package.instruction_count())
+{
+    m_instructions.set_count(m_instruction_count + 1, { nullptr, nullptr, nullptr });
+    for (usize instruction_pointer = 0; instruction_pointer < m_instruction_count; ++instruction_pointer) {
+        const Instruction& instruction = package.instruction_records()[instruction_pointer].instruction();
+        ThreadedInstruction& threaded_instruction = m_instructions[instruction_pointer];
+        threaded_instruction.handler = handler_for(instruction.opcode());
+        threaded_instruction.instruction = &instruction;
+
+        const Optional<JumpAddress> jump_address = jump_target_address(instruction);
+        if (jump_address.has_value())
+            threaded_instruction.jump_target = resolve(jump_address.value().address());
+    }
+
+    m_jump_table_targets.set_count(package.jump_table_entry_count(), nullptr);
+    for (usize entry_index = 0; entry_index < package.jump_table_entry_count(); ++entry_index)
+        m_jump_table_targets[entry_index] = resolve(package.jump_table_entries()[entry_index].address());
+}
+
+}
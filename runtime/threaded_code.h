@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause.
+ */
+
+#pragma once
+
+#include <bytecode/forward.h>
+#include <core/containers/vector.h>
+#include <runtime/forward.h>
+
+namespace Arc::Runtime {
+
+struct ThreadedInstruction;
+
+// Executes a threaded instruction and returns the one that must be executed next.
+using ThreadedHandler = const ThreadedInstruction* (*)(Interpreter&, const ThreadedInstruction&);
+
+struct ThreadedInstruction {
+    // The handler of the instruction, or null for the sentinel that follows the last instruction of the package.
+    ThreadedHandler handler;
+    // The decoded instruction, from which the handler reads the operands.
+    const Bytecode::Instruction* instruction;
+    // The resolved jump or callee address of control flow instructions, which is the sentinel for addresses that
+    // are outside of the package.
+    const ThreadedInstruction* jump_target;
+};
+
+//
+// The instructions of a package translated once into an array of handlers, with the decoded instruction and the
+// resolved jump target bound to each of them. Executing the threaded code doesn't fetch anything from the package and
+// doesn't convert any jump address into an instruction, except for the return addresses that are stored on the stack.
+//
+// NOTE: The threaded code refers to the instructions of the package, so the package must not be modified while the
+//       threaded code is alive.
+//
+class ThreadedCode {
+    ARC_MAKE_NONCOPYABLE(ThreadedCode);
+    ARC_MAKE_NONMOVABLE(ThreadedCode);
+
+public:
+    explicit ThreadedCode(const Bytecode::Package&);
+
+    // Returns the threaded instruction at the given instruction pointer, or the sentinel if it is outside the package.
+    NODISCARD ALWAYS_INLINE const ThreadedInstruction* resolve(u64 instruction_pointer) const
+    {
+        return &m_instructions[instruction_pointer < m_instruction_count ? instruction_pointer : m_instruction_count];
+    }
+
+    NODISCARD ALWAYS_INLINE usize instruction_pointer_of(const ThreadedInstruction& instruction) const
+    {
+        return static_cast<usize>(&instruction - m_instructions.elements());
+    }
+
+    NODISCARD ALWAYS_INLINE const ThreadedInstruction* jump_table_target(u64 entry_index) const
+    {
+        ARC_ASSERT(entry_index < m_jump_table_targets.count());
+        return m_jump_table_targets[entry_index];
+    }
+
+private:
+    // NOTE: The instructions are followed by a sentinel, so that falling through the last instruction of the package
+    //       doesn't require a separate check.
+    Vector<ThreadedInstruction> m_instructions;
+    usize m_instruction_count;
+    Vector<const ThreadedInstruction*> m_jump_table_targets;
+};
+
+}
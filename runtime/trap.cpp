@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause.
+ */
+
+#include <runtime/trap.h>
+
+#include <setjmp.h>
+
+#if ARC_PLATFORM_LINUX || ARC_PLATFORM_MACOS
+    #include <signal.h>
+#endif // ARC_PLATFORM_LINUX || ARC_PLATFORM_MACOS
+
+namespace Arc::Runtime {
+
+StringView trap_to_string_view(Trap trap)
+{
+    switch (trap) {
+        case Trap::StackOverflow: return "StackOverflow"sv;
+        case Trap::CallDepthExceeded: return "CallDepthExceeded"sv;
+        case Trap::DivisionByZero: return "DivisionByZero"sv;
+        case Trap::StackAccessViolation: return "StackAccessViolation"sv;
+
+        default:
+            ARC_ASSERT_NOT_REACHED;
+    }
+}
+
+struct TrapContext {
+#if ARC_PLATFORM_LINUX || ARC_PLATFORM_MACOS
+    sigjmp_buf jump_buffer;
+#else
+    jmp_buf jump_buffer;
+#endif // ARC_PLATFORM_LINUX || ARC_PLATFORM_MACOS
+    const GuardedMemoryRegion* stack_memory;
+    const GuardedMemoryRegion* register_file_memory;
+    TrapContext* previous_context;
+};
+
+// NOTE: The raised trap is stored in a thread-local variable instead of the context, as the values of local variables
+//       that are modified after `setjmp` are indeterminate once `longjmp` returns to it.
+static thread_local TrapContext* s_active_trap_context = nullptr;
+static thread_local Trap s_raised_trap = Trap::StackOverflow;
+
+#if ARC_PLATFORM_LINUX || ARC_PLATFORM_MACOS
+static struct sigaction s_previous_segmentation_fault_action;
+static struct sigaction s_previous_bus_error_action;
+
+// Delivers the fault to the handler that was installed before the trap handler, as if the trap handler wasn't there.
+static void forward_memory_fault(const struct sigaction& previous_action, int signal_number, siginfo_t* signal_info, void* context)
+{
+    if ((previous_action.sa_flags & SA_SIGINFO) != 0) {
+        previous_action.sa_sigaction(signal_number, signal_info, context);
+        return;
+    }
+
+    // NOTE: Ignoring a signal that was sent by another process is fine, but a fault would just be raised again by the
+    //       faulting instruction, so it receives the default action instead. The kernel does the same.
+    if (previous_action.sa_handler == SIG_IGN && signal_info->si_code <= 0)
+        return;
+
+    if (previous_action.sa_handler != SIG_DFL && previous_action.sa_handler != SIG_IGN) {
+        previous_action.sa_handler(signal_number);
+        return;
+    }
+
+    // NOTE: The default action of both signals terminates the process. The signal is blocked while it's handled, so it
+    //       is delivered again with the default action right after the handler returns.
+    struct sigaction default_action = {};
+    default_action.sa_handler = SIG_DFL;
+    sigemptyset(&default_action.sa_mask);
+    sigaction(signal_number, &default_action, nullptr);
+    raise(signal_number);
+}
+
+static void handle_memory_fault(int signal_number, siginfo_t* signal_info, void* context)
+{
+    TrapContext* trap_context = s_active_trap_context;
+    if (trap_context != nullptr) {
+        if (trap_context->stack_memory->guard_page_contains(signal_info->si_addr)) {
+            s_raised_trap = Trap::StackOverflow;
+            siglongjmp(trap_context->jump_buffer, 1);
+        }
+        if (trap_context->register_file_memory->guard_page_contains(signal_info->si_addr)) {
+            s_raised_trap = Trap::CallDepthExceeded;
+            siglongjmp(trap_context->jump_buffer, 1);
+        }
+    }
+
+    // NOTE: The fault wasn't caused by a virtual machine. The trap handler stays installed, so that the guard pages of
+    //       the virtual machines keep working when the host recovers from the fault.
+    if (signal_number == SIGSEGV)
+        forward_memory_fault(s_previous_segmentation_fault_action, signal_number, signal_info, context);
+    else
+        forward_memory_fault(s_previous_bus_error_action, signal_number, signal_info, context);
+}
+
+static bool install_memory_fault_handlers()
+{
+    struct sigaction action = {};
+    action.sa_sigaction = handle_memory_fault;
+    action.sa_flags = SA_SIGINFO;
+    sigemptyset(&action.sa_mask);
+
+    // NOTE: Depending on the platform, accessing a protected page raises either of the signals.
+    sigaction(SIGSEGV, &action, &s_previous_segmentation_fault_action);
+    sigaction(SIGBUS, &action, &s_previous_bus_error_action);
+    return true;
+}
+#endif // ARC_PLATFORM_LINUX || ARC_PLATFORM_MACOS
+
+Optional<Trap> TrapHandler::run(const GuardedMemoryRegion& stack_memory, const GuardedMemoryRegion& register_file_memory,
+                                GuardedFunction function, void* user_data)
+{
+#if ARC_PLATFORM_LINUX || ARC_PLATFORM_MACOS
+    // NOTE: The handlers are installed only once per process, the first time any program is executed.
+    MAYBE_UNUSED static const bool s_memory_fault_handlers_are_installed = install_memory_fault_handlers();
+#endif // ARC_PLATFORM_LINUX || ARC_PLATFORM_MACOS
+
+    TrapContext trap_context;
+    trap_context.stack_memory = &stack_memory;
+    trap_context.register_file_memory = &register_file_memory;
+    trap_context.previous_context = s_active_trap_context;
+    s_active_trap_context = &trap_context;
+
+#if ARC_PLATFORM_LINUX || ARC_PLATFORM_MACOS
+    // NOTE: The signal mask must be restored, as jumping out of the signal handler leaves the signal blocked.
+    const int jump_result = sigsetjmp(trap_context.jump_buffer, 1);
+#else
+    const int jump_result = setjmp(trap_context.jump_buffer);
+#endif // ARC_PLATFORM_LINUX || ARC_PLATFORM_MACOS
+
+    if (jump_result != 0) {
+        s_active_trap_context = trap_context.previous_context;
+        return s_raised_trap;
+    }
+
+    function(user_data);
+    s_active_trap_context = trap_context.previous_context;
+    return {};
+}
+
+void TrapHandler::raise(Trap trap)
+{
+    // NOTE: Traps can only be raised while a function is executed by `run` on the current thread.
+    TrapContext* trap_context = s_active_trap_context;
+    ARC_ASSERT(trap_context != nullptr);
+
+    s_raised_trap = trap;
+#if ARC_PLATFORM_LINUX || ARC_PLATFORM_MACOS
+    siglongjmp(trap_context->jump_buffer, 1);
+#else
+    longjmp(trap_context->jump_buffer, 1);
+#endif // ARC_PLATFORM_LINUX || ARC_PLATFORM_MACOS
+}
+
+}
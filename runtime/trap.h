@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause.
+ */
+
+#pragma once
+
+#include <core/containers/optional.h>
+#include <core/containers/string_view.h>
+#include <core/memory/guarded_memory_region.h>
+
+namespace Arc::Runtime {
+
+enum class Trap : u8 {
+    // The virtual stack ran out of space.
+    StackOverflow,
+    // The register file ran out of register windows.
+    CallDepthExceeded,
+    // An integer division instruction was executed with a zero divisor.
+    DivisionByZero,
+    // The program accessed stack memory that doesn't belong to the current function, such as a call frame header.
+    // Only detected when executing packages that weren't verified.
+    StackAccessViolation,
+};
+
+StringView trap_to_string_view(Trap trap);
+
+//
+// Traps abort the execution of a program cleanly, without crashing the host process. They are raised either
+// explicitly, through `TrapHandler::raise`, or by the hardware when the program accesses the guard page of its
+// virtual stack or register file. The latter allows the interpreter to push values and register windows without
+// checking for overflow.
+//
+// NOTE: Raising a trap unwinds the native stack without running any destructors, so code that can trap must never
+//       own resources. After a trap the state of the virtual machine is unspecified.
+//
+class TrapHandler {
+    ARC_MAKE_NAMESPACE_CLASS(TrapHandler)
+
+public:
+    // Whether faults inside the guard page are converted into traps on this platform. When they aren't, every push
+    // must explicitly check for overflow.
+    static constexpr bool catches_guard_page_faults = ARC_PLATFORM_LINUX || ARC_PLATFORM_MACOS;
+
+    using GuardedFunction = void (*)(void* user_data);
+
+    // Runs the function on the current thread and returns the trap that aborted it, if any. Faults inside the guard
+    // page of the given stack memory are converted into a `Trap::StackOverflow`, and faults inside the guard page of
+    // the register file memory into a `Trap::CallDepthExceeded`.
+    NODISCARD static Optional<Trap> run(const GuardedMemoryRegion& stack_memory, const GuardedMemoryRegion& register_file_memory,
+                                        GuardedFunction function, void* user_data);
+
+    // Aborts the function that is currently executed by `run` on this thread.
+    ARC_NORETURN static void raise(Trap trap);
+};
+
+}
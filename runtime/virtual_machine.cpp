@@ -8,89 +8,250 @@
 
 namespace Arc::Runtime {
 
-VirtualStack::VirtualStack(Badge<VirtualMachine>)
-    : m_stack_pointer(0)
-{
-    // Initialize the stack buffer with 16KiB of space.
-    m_buffer.allocate_new(16 * 1024);
-    m_stack_pointer = m_buffer.byte_count();
-}
+VirtualStack::VirtualStack(Badge<VirtualMachine>, GuardedMemoryRegion&& memory)
+    : m_memory(move(memory))
+    , m_stack_pointer(m_memory.byte_count())
+    , m_frame_pointer(m_memory.byte_count())
+{}
 
 ReadWriteBytes VirtualStack::push(usize push_byte_count)
 {
-    ARC_ASSERT(m_stack_pointer >= push_byte_count);
+    if (m_stack_pointer < push_byte_count)
+        TrapHandler::raise(Trap::StackOverflow);
+
     m_stack_pointer -= push_byte_count;
-    return m_buffer.bytes() + m_stack_pointer;
+    return m_memory.bytes() + m_stack_pointer;
 }
 
 void VirtualStack::pop(usize pop_byte_count)
 {
-    ARC_ASSERT(m_stack_pointer + pop_byte_count <= m_buffer.byte_count());
+    // NOTE: The current function can't pop its call frame header, nor anything that was pushed by its caller.
+    if (pop_byte_count > m_frame_pointer - m_stack_pointer)
+        TrapHandler::raise(Trap::StackAccessViolation);
 
     // NOTE: Ensure that the stack region that was popped contains no valid data.
-    zero_memory(m_buffer.bytes() + m_stack_pointer, pop_byte_count);
+    zero_memory(m_memory.bytes() + m_stack_pointer, pop_byte_count);
     m_stack_pointer += pop_byte_count;
 }
 
+bool VirtualStack::is_accessible(usize offset, usize byte_count) const
+{
+    // NOTE: The offsets are read from the instructions, so computing the end of the accessed bytes must not overflow.
+    const u64 pushed_byte_count = m_memory.byte_count() - m_stack_pointer;
+    if (offset > pushed_byte_count || byte_count > pushed_byte_count - offset)
+        return false;
+
+    const u64 access_begin = m_stack_pointer + offset;
+    const u64 access_end = access_begin + byte_count;
+    if (access_end <= m_frame_pointer)
+        return true;
+
+    // NOTE: Besides the values it pushed itself, a function can only access the values pushed by its caller, which lie
+    //       between its call frame header and the call frame header of the caller. Both headers are owned by the runtime.
+    //       Without any call frame the frame pointer is the end of the stack, so the access was already accepted.
+    const CallFrameHeader& call_frame_header = *reinterpret_cast<const CallFrameHeader*>(m_memory.bytes() + m_frame_pointer);
+    return access_begin >= m_frame_pointer + sizeof(CallFrameHeader) && access_end <= call_frame_header.frame_pointer;
+}
+
 ReadWriteBytes VirtualStack::at_offset(usize offset, usize byte_count)
 {
-    if (m_stack_pointer + offset + byte_count > m_buffer.byte_count()) {
-        // TODO: Throw a memory violation error instead of just crashing the runtime!
-        ARC_ASSERT_NOT_REACHED;
-    }
+    if (!is_accessible(offset, byte_count))
+        TrapHandler::raise(Trap::StackAccessViolation);
 
-    return m_buffer.bytes() + m_stack_pointer + offset;
+    return m_memory.bytes() + m_stack_pointer + offset;
 }
 
 ReadonlyBytes VirtualStack::at_offset(usize offset, usize byte_count) const
 {
-    if (m_stack_pointer + offset + byte_count > m_buffer.byte_count()) {
-        // TODO: Throw a memory violation error instead of just crashing the runtime!
-        ARC_ASSERT_NOT_REACHED;
-    }
+    if (!is_accessible(offset, byte_count))
+        TrapHandler::raise(Trap::StackAccessViolation);
 
-    return m_buffer.bytes() + m_stack_pointer + offset;
+    return m_memory.bytes() + m_stack_pointer + offset;
 }
 
-VirtualCallStack::VirtualCallStack()
-{}
+ReadWriteBytes VirtualStack::at_frame_offset(s64 frame_offset, usize byte_count)
+{
+    // NOTE: Only the bytes between the stack pointer and the bottom of the stack are live.
+    const u64 frame_byte_count = m_frame_pointer - m_stack_pointer;
+    if (frame_offset < 0 && 0 - static_cast<u64>(frame_offset) > frame_byte_count)
+        TrapHandler::raise(Trap::StackAccessViolation);
+
+    // NOTE: Non-negative frame offsets below the size of the header address the call frame header itself, which is
+    //       rejected together with everything else the function doesn't own.
+    return at_offset(frame_byte_count + static_cast<u64>(frame_offset), byte_count);
+}
+
+ReadonlyBytes VirtualStack::at_frame_offset(s64 frame_offset, usize byte_count) const
+{
+    const u64 frame_byte_count = m_frame_pointer - m_stack_pointer;
+    if (frame_offset < 0 && 0 - static_cast<u64>(frame_offset) > frame_byte_count)
+        TrapHandler::raise(Trap::StackAccessViolation);
+
+    return at_offset(frame_byte_count + static_cast<u64>(frame_offset), byte_count);
+}
+
+void VirtualStack::validate_call_frame_header() const
+{
+    if (!has_call_frames())
+        TrapHandler::raise(Trap::StackAccessViolation);
+
+    // NOTE: The parameters of the current frame are followed by the values pushed by the caller, so the frame pointer of
+    //       the caller must lie between the end of the parameters and the bottom of the stack. The parameters byte count
+    //       is compared first, so that computing the end of the parameters doesn't overflow.
+    const CallFrameHeader& call_frame_header = *reinterpret_cast<const CallFrameHeader*>(m_memory.bytes() + m_frame_pointer);
+    const u64 caller_byte_count = m_memory.byte_count() - m_frame_pointer - sizeof(CallFrameHeader);
+    if (call_frame_header.parameters_byte_count > caller_byte_count)
+        TrapHandler::raise(Trap::StackAccessViolation);
+
+    const u64 caller_stack_pointer = m_frame_pointer + sizeof(CallFrameHeader) + call_frame_header.parameters_byte_count;
+    if (call_frame_header.frame_pointer < caller_stack_pointer || call_frame_header.frame_pointer > m_memory.byte_count())
+        TrapHandler::raise(Trap::StackAccessViolation);
+}
+
+CallFrameHeader VirtualStack::pop_call_frame()
+{
+    validate_call_frame_header();
+    return pop_call_frame_unchecked();
+}
+
+void VirtualStack::replace_call_frame(u64 parameters_byte_count, bool discards_return_value)
+{
+    validate_call_frame_header();
+
+    // NOTE: The new parameters must have been pushed by the current function.
+    if (parameters_byte_count > m_frame_pointer - m_stack_pointer)
+        TrapHandler::raise(Trap::StackAccessViolation);
+    replace_call_frame_unchecked(parameters_byte_count, discards_return_value);
+}
+
+void VirtualStack::reset()
+{
+    zero_memory(m_memory.bytes() + m_stack_pointer, m_memory.byte_count() - m_stack_pointer);
+    m_stack_pointer = m_memory.byte_count();
+    m_frame_pointer = m_stack_pointer;
+}
 
-void VirtualCallStack::push(Bytecode::JumpAddress return_address, u64 parameters_byte_count)
+ErrorOr<void> VirtualStack::reset_after_trap()
 {
-    CallFrame call_frame = {};
-    call_frame.return_address = return_address;
-    call_frame.parameters_byte_count = parameters_byte_count;
-    m_call_stack.push_back(call_frame);
+    TRY(m_memory.discard());
+    m_stack_pointer = m_memory.byte_count();
+    m_frame_pointer = m_stack_pointer;
+    return {};
 }
 
-VirtualCallStack::CallFrame VirtualCallStack::pop()
+VirtualRegisterFile::VirtualRegisterFile(Badge<VirtualMachine>, GuardedMemoryRegion&& memory)
+    : m_memory(move(memory))
+    , m_window(nullptr)
 {
-    if (m_call_stack.is_empty()) {
-        // TODO: Provide more debug information before crashing the runtime.
-        ARC_ASSERT_NOT_REACHED;
+    // NOTE: The memory is freshly reserved, so the window of the entry point already reads as zero.
+    m_window = root_window();
+}
+
+void VirtualRegisterFile::push_window()
+{
+    RegisterStorage* window = m_window - window_register_count;
+    // NOTE: Clearing a window inside the guard page faults, which is converted into the same trap.
+    if constexpr (!TrapHandler::catches_guard_page_faults) {
+        if (reinterpret_cast<ReadWriteBytes>(window) < m_memory.bytes())
+            TrapHandler::raise(Trap::CallDepthExceeded);
     }
 
-    const CallFrame last_call_frame = m_call_stack.last();
-    m_call_stack.pop_back();
-    return last_call_frame;
+    // NOTE: The window only becomes the current one once it was cleared, so a trap leaves the register file consistent.
+    zero_memory(window, window_byte_count);
+    m_window = window;
 }
 
-VirtualMachine::VirtualMachine()
-    : m_stack({})
-{}
+void VirtualRegisterFile::push_window_with_arguments(Bytecode::Register first_argument_register, u8 argument_count)
+{
+    const u8 first_argument_index = static_cast<u8>(first_argument_register);
+    ARC_ASSERT(first_argument_index + argument_count <= window_register_count);
+
+    push_window();
+    const RegisterStorage* caller_window = m_window + window_register_count;
+    for (u8 argument_index = 0; argument_index < argument_count; ++argument_index)
+        m_window[argument_index] = caller_window[first_argument_index + argument_index];
+}
+
+void VirtualRegisterFile::replace_window_with_arguments(Bytecode::Register first_argument_register, u8 argument_count)
+{
+    const u8 first_argument_index = static_cast<u8>(first_argument_register);
+    ARC_ASSERT(first_argument_index + argument_count <= window_register_count);
+
+    // NOTE: The arguments only ever move towards the beginning of the window, so copying them in order never
+    //       overwrites an argument that wasn't copied yet.
+    for (u8 argument_index = 0; argument_index < argument_count; ++argument_index)
+        m_window[argument_index] = m_window[first_argument_index + argument_index];
+    zero_memory(m_window + argument_count, (window_register_count - argument_count) * sizeof(RegisterStorage));
+}
+
+void VirtualRegisterFile::pop_window()
+{
+    ARC_ASSERT(m_window < root_window());
+    m_window += window_register_count;
+}
+
+void VirtualRegisterFile::reset()
+{
+    RegisterStorage* const end_of_windows = root_window() + window_register_count;
+    zero_memory(m_window, static_cast<usize>(end_of_windows - m_window) * sizeof(RegisterStorage));
+    m_window = root_window();
+}
 
-VirtualMachine::RegisterStorage& VirtualMachine::register_storage(Bytecode::Register reg)
+ErrorOr<void> VirtualRegisterFile::reset_after_trap()
+{
+    // NOTE: A trap may leave the register file arbitrarily deep, so the windows are discarded instead of cleared.
+    TRY(m_memory.discard());
+    m_window = root_window();
+    return {};
+}
+
+VirtualRegisterFile::RegisterStorage& VirtualRegisterFile::at(Bytecode::Register reg)
 {
     const u8 register_index = static_cast<u8>(reg);
-    ARC_ASSERT(register_index < m_registers.count());
-    return m_registers[register_index];
+    ARC_ASSERT(register_index < window_register_count);
+    return m_window[register_index];
 }
 
-const VirtualMachine::RegisterStorage& VirtualMachine::register_storage(Bytecode::Register reg) const
+const VirtualRegisterFile::RegisterStorage& VirtualRegisterFile::at(Bytecode::Register reg) const
 {
     const u8 register_index = static_cast<u8>(reg);
-    ARC_ASSERT(register_index < m_registers.count());
-    return m_registers[register_index];
+    ARC_ASSERT(register_index < window_register_count);
+    return m_window[register_index];
+}
+
+ErrorOr<OwnPtr<VirtualMachine>> VirtualMachine::create()
+{
+    return create(VirtualMachineConfiguration());
+}
+
+ErrorOr<OwnPtr<VirtualMachine>> VirtualMachine::create(const VirtualMachineConfiguration& configuration)
+{
+    TRY_ASSIGN(GuardedMemoryRegion register_file_memory, GuardedMemoryRegion::reserve(configuration.register_file.reserved_byte_count, false));
+    TRY_ASSIGN(GuardedMemoryRegion stack_memory,
+               GuardedMemoryRegion::reserve(configuration.stack.reserved_byte_count, configuration.stack.use_huge_pages));
+    return adopt_own(new VirtualMachine(move(register_file_memory), move(stack_memory), configuration));
+}
+
+VirtualMachine::VirtualMachine(GuardedMemoryRegion&& register_file_memory, GuardedMemoryRegion&& stack_memory,
+                               const VirtualMachineConfiguration& configuration)
+    : m_register_file({}, move(register_file_memory))
+    , m_stack({}, move(stack_memory))
+    , m_memoization_cache({}, configuration.memoization_cache)
+{}
+
+void VirtualMachine::reset()
+{
+    m_register_file.reset();
+    m_stack.reset();
+    m_memoization_cache.clear();
+}
+
+ErrorOr<void> VirtualMachine::reset_after_trap()
+{
+    TRY(m_register_file.reset_after_trap());
+    TRY(m_stack.reset_after_trap());
+    m_memoization_cache.clear();
+    return {};
 }
 
 }
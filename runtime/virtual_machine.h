@@ -5,37 +5,214 @@
 
 #pragma once
 
+#include <bytecode/instruction.h>
 #include <bytecode/jump_address.h>
 #include <bytecode/register.h>
 #include <core/badge.h>
 #include <core/containers/array.h>
 #include <core/containers/format.h>
+#include <core/containers/own_ptr.h>
 #include <core/containers/vector.h>
+#include <core/memory/guarded_memory_region.h>
+#include <core/memory/memory_operations.h>
 #include <runtime/forward.h>
+#include <runtime/memoization_cache.h>
+#include <runtime/trap.h>
 
 namespace Arc::Runtime {
 
+struct VirtualStackConfiguration {
+    // The number of bytes reserved for the stack. Only the pages that are actually touched by the program are backed
+    // by physical memory, so a large reservation is cheap.
+    usize reserved_byte_count { 8 * 1024 * 1024 };
+    // Advises the operating system to back the stack with huge pages. Ignored on platforms that don't support it.
+    bool use_huge_pages { false };
+};
+
+// The header that is pushed on top of the call parameters by every call. See `Bytecode::call_frame_header_byte_count`.
+struct CallFrameHeader {
+    u64 return_address;
+    u64 parameters_byte_count;
+    // The frame pointer of the caller, restored when returning from the call.
+    u64 frame_pointer;
+    // The caller register that receives the value returned by `ReturnValue`. Calls that don't use the register
+    // calling convention don't set it, in which case the returned value is discarded.
+    Bytecode::Register return_value_register;
+    bool has_return_value_register;
+    // The memoization cache entry that receives the returned value, for calls to pure functions whose result wasn't
+    // cached yet. Set to `no_memoization_entry_index` for all other calls.
+    u32 memoization_entry_index;
+
+    static constexpr u32 no_memoization_entry_index = 0xFFFFFFFF;
+};
+
+static_assert(sizeof(CallFrameHeader) == Bytecode::call_frame_header_byte_count);
+
+//
+// The stack grows downwards, from the end of a lazily committed memory region towards its guard page. Overflowing it
+// raises a `Trap::StackOverflow`, either explicitly or through the fault caused by writing into the guard page.
+//
 class VirtualStack {
     ARC_MAKE_NONCOPYABLE(VirtualStack);
     ARC_MAKE_NONMOVABLE(VirtualStack);
 
 public:
-    VirtualStack(Badge<VirtualMachine>);
+    // NOTE: The memory is reserved by `VirtualMachine::create`, so that failing to reserve it can be reported.
+    VirtualStack(Badge<VirtualMachine>, GuardedMemoryRegion&& memory);
     ~VirtualStack() = default;
 
+    // NOTE: Only the number of bytes is checked against the remaining space, as the pushed bytes aren't written.
     ReadWriteBytes push(usize push_byte_count);
     void pop(usize pop_byte_count);
 
+    // The checked accessors raise a `Trap::StackAccessViolation` when the bytes don't belong to the current function:
+    // it can access the values it pushed and the values pushed by its caller, but never a call frame header.
     NODISCARD ReadWriteBytes at_offset(usize offset, usize byte_count);
     NODISCARD ReadonlyBytes at_offset(usize offset, usize byte_count) const;
 
+    // The frame pointer is the value of the stack pointer at the moment the current function was entered. Slots
+    // addressed relative to it don't move when the function pushes or pops values. Negative offsets address the
+    // values pushed by the current function, while non-negative offsets address its call frame header followed by
+    // the values pushed by its caller.
+    NODISCARD ReadWriteBytes at_frame_offset(s64 frame_offset, usize byte_count);
+    NODISCARD ReadonlyBytes at_frame_offset(s64 frame_offset, usize byte_count) const;
+
+    // Pushes the header of a new call frame and makes it the current frame. Called when entering a function.
+    ALWAYS_INLINE void push_call_frame(Bytecode::JumpAddress return_address, u64 parameters_byte_count)
+    {
+        CallFrameHeader& call_frame_header = push<CallFrameHeader>();
+        call_frame_header.return_address = return_address.address();
+        call_frame_header.parameters_byte_count = parameters_byte_count;
+        call_frame_header.frame_pointer = m_frame_pointer;
+        call_frame_header.has_return_value_register = false;
+        call_frame_header.memoization_entry_index = CallFrameHeader::no_memoization_entry_index;
+        m_frame_pointer = m_stack_pointer;
+    }
+
+    ALWAYS_INLINE void push_call_frame(Bytecode::JumpAddress return_address, u64 parameters_byte_count,
+                                       Bytecode::Register return_value_register, u32 memoization_entry_index)
+    {
+        push_call_frame(return_address, parameters_byte_count);
+        CallFrameHeader& call_frame_header = at_frame_offset_unchecked<CallFrameHeader>(0);
+        call_frame_header.return_value_register = return_value_register;
+        call_frame_header.has_return_value_register = true;
+        call_frame_header.memoization_entry_index = memoization_entry_index;
+    }
+
+    // Pops the current call frame, together with everything that was pushed after it and the call parameters, and
+    // makes the frame of the caller the current one again. Called when returning from a function. Raises a
+    // `Trap::StackAccessViolation` when there is no call frame or when its header doesn't describe a valid frame.
+    NODISCARD CallFrameHeader pop_call_frame();
+
+    // Replaces the current call frame by the frame of a tail callee. The `parameters_byte_count` bytes on top of the
+    // stack become the parameters of the new frame and take the place of the parameters of the current frame, while
+    // its return address and the frame pointer of the caller are kept. When `discards_return_value` is set, the value
+    // returned by the tail callee isn't written to the return value register of the caller.
+    void replace_call_frame(u64 parameters_byte_count, bool discards_return_value);
+
+    NODISCARD ALWAYS_INLINE bool has_call_frames() const { return m_frame_pointer != m_memory.byte_count(); }
+
+    // Pops everything that was pushed, including the call frames. The popped bytes are always zeroed, so only the bytes
+    // that are still pushed have to be cleared.
+    void reset();
+    // Like `reset`, but also valid after a trap, when the stack pointer no longer delimits the bytes that were written.
+    // The memory of the stack is discarded instead of being cleared.
+    NODISCARD ErrorOr<void> reset_after_trap();
+
+    // The number of bytes that are currently pushed on the stack, including the call frame headers.
+    NODISCARD ALWAYS_INLINE usize pushed_byte_count() const { return m_memory.byte_count() - m_stack_pointer; }
+
+    // NOTE: The addresses are only valid until the stack pointer or the frame pointer changes.
+    NODISCARD ALWAYS_INLINE ReadWriteBytes stack_pointer_address() { return m_memory.bytes() + m_stack_pointer; }
+    NODISCARD ALWAYS_INLINE ReadonlyBytes stack_pointer_address() const { return m_memory.bytes() + m_stack_pointer; }
+    NODISCARD ALWAYS_INLINE ReadWriteBytes frame_pointer_address() { return m_memory.bytes() + m_frame_pointer; }
+
+    NODISCARD ALWAYS_INLINE const GuardedMemoryRegion& memory() const { return m_memory; }
+
+    // The smallest page size of all supported platforms.
+    static constexpr usize minimum_guard_page_byte_count = 4096;
+
+    // Whether pushing a value of the given type relies on the fault caused by writing into the guard page, instead of
+    // explicitly checking the remaining space.
+    template<typename T>
+    static constexpr bool push_faults_on_overflow = TrapHandler::catches_guard_page_faults && sizeof(T) <= minimum_guard_page_byte_count;
+
+public:
+    // NOTE: The unchecked accessors don't validate that the accessed bytes are inside the stack. They must only be
+    //       used when executing packages that have been proven safe by the bytecode verifier.
+    ALWAYS_INLINE void pop_unchecked(usize pop_byte_count)
+    {
+        zero_memory(m_memory.bytes() + m_stack_pointer, pop_byte_count);
+        m_stack_pointer += pop_byte_count;
+    }
+
+    // NOTE: Only valid when the stack is known to contain at least one call frame.
+    NODISCARD ALWAYS_INLINE CallFrameHeader pop_call_frame_unchecked()
+    {
+        const CallFrameHeader call_frame_header = at_frame_offset_unchecked<CallFrameHeader>(0);
+        const u64 caller_stack_pointer = m_frame_pointer + sizeof(CallFrameHeader) + call_frame_header.parameters_byte_count;
+        zero_memory(m_memory.bytes() + m_stack_pointer, caller_stack_pointer - m_stack_pointer);
+        m_stack_pointer = caller_stack_pointer;
+        m_frame_pointer = call_frame_header.frame_pointer;
+        return call_frame_header;
+    }
+
+    // NOTE: Only valid when the stack is known to contain at least one call frame, and when the current function has
+    //       pushed at least `parameters_byte_count` bytes.
+    ALWAYS_INLINE void replace_call_frame_unchecked(u64 parameters_byte_count, bool discards_return_value)
+    {
+        CallFrameHeader call_frame_header = at_frame_offset_unchecked<CallFrameHeader>(0);
+        const u64 caller_stack_pointer = m_frame_pointer + sizeof(CallFrameHeader) + call_frame_header.parameters_byte_count;
+        const u64 frame_pointer = caller_stack_pointer - parameters_byte_count - sizeof(CallFrameHeader);
+
+        // NOTE: The new parameters can overlap the parameters of the current frame, so they must be moved.
+        move_memory(m_memory.bytes() + frame_pointer + sizeof(CallFrameHeader), m_memory.bytes() + m_stack_pointer, parameters_byte_count);
+        zero_memory(m_memory.bytes() + m_stack_pointer, frame_pointer - m_stack_pointer);
+
+        call_frame_header.parameters_byte_count = parameters_byte_count;
+        if (discards_return_value)
+            call_frame_header.has_return_value_register = false;
+
+        m_stack_pointer = frame_pointer;
+        m_frame_pointer = frame_pointer;
+        at_frame_offset_unchecked<CallFrameHeader>(0) = call_frame_header;
+    }
+
+    // NOTE: Used by the dispatch loops that keep the stack pointer in a local variable, to write it back before the
+    //       stack is accessed in any other way.
+    ALWAYS_INLINE void set_stack_pointer_address_unchecked(ReadWriteBytes stack_pointer_address)
+    {
+        m_stack_pointer = static_cast<u64>(stack_pointer_address - m_memory.bytes());
+    }
+
+    template<typename T>
+    NODISCARD ALWAYS_INLINE T& at_offset_unchecked(usize offset)
+    {
+        return *reinterpret_cast<T*>(m_memory.bytes() + m_stack_pointer + offset);
+    }
+
+    template<typename T>
+    NODISCARD ALWAYS_INLINE T& at_frame_offset_unchecked(s64 frame_offset)
+    {
+        return *reinterpret_cast<T*>(m_memory.bytes() + m_frame_pointer + frame_offset);
+    }
+
 public:
     template<typename T>
     requires (is_trivially_destructible<T>)
     ALWAYS_INLINE T& push()
     {
-        const ReadWriteBytes bytes = push(sizeof(T));
-        return *reinterpret_cast<T*>(bytes);
+        // NOTE: Values that are smaller than the guard page are always written right after being pushed, so running
+        //       past the beginning of the stack faults inside the guard page and no explicit check is required.
+        if constexpr (push_faults_on_overflow<T>) {
+            T* value = reinterpret_cast<T*>(m_memory.bytes() + m_stack_pointer) - 1;
+            m_stack_pointer -= sizeof(T);
+            return *value;
+        }
+        else {
+            const ReadWriteBytes bytes = push(sizeof(T));
+            return *reinterpret_cast<T*>(bytes);
+        }
     }
 
     template<typename T>
@@ -59,29 +236,118 @@ public:
         return *reinterpret_cast<const T*>(bytes);
     }
 
+    template<typename T>
+    NODISCARD ALWAYS_INLINE T& at_frame_offset(s64 frame_offset)
+    {
+        const ReadWriteBytes bytes = at_frame_offset(frame_offset, sizeof(T));
+        return *reinterpret_cast<T*>(bytes);
+    }
+
+    template<typename T>
+    NODISCARD ALWAYS_INLINE const T& at_frame_offset(s64 frame_offset) const
+    {
+        const ReadonlyBytes bytes = at_frame_offset(frame_offset, sizeof(T));
+        return *reinterpret_cast<const T*>(bytes);
+    }
+
+private:
+    NODISCARD bool is_accessible(usize offset, usize byte_count) const;
+    void validate_call_frame_header() const;
+
 private:
-    ByteBuffer m_buffer;
+    GuardedMemoryRegion m_memory;
     u64 m_stack_pointer;
+    u64 m_frame_pointer;
 };
 
-class VirtualCallStack {
-    ARC_MAKE_NONCOPYABLE(VirtualCallStack);
-    ARC_MAKE_NONMOVABLE(VirtualCallStack);
+struct VirtualRegisterFileConfiguration {
+    // The number of bytes reserved for the register windows, which limits the call depth of the virtual machine to
+    // one call per 128 bytes, minus the window of the entry point. Like the stack, only the windows that are actually
+    // used are backed by physical memory. The default allows 8192 nested calls.
+    // NOTE: Generated entry points keep their registers on the host stack, which must be large enough for the limit.
+    usize reserved_byte_count { 1024 * 1024 };
+};
+
+//
+// The register windows grow downwards, from the end of a lazily committed memory region towards its guard page, just
+// like the stack. Pushing a window past the last one raises a `Trap::CallDepthExceeded`, either explicitly or through
+// the fault caused by clearing the new window inside the guard page.
+//
+class VirtualRegisterFile {
+    ARC_MAKE_NONCOPYABLE(VirtualRegisterFile);
+    ARC_MAKE_NONMOVABLE(VirtualRegisterFile);
 
 public:
-    struct CallFrame {
-        Bytecode::JumpAddress return_address { 0 };
-        u64 parameters_byte_count { 0 };
+    struct RegisterStorage {
+        u64 value { 0 };
     };
 
+    // The number of registers that are visible to a single call frame.
+    static constexpr usize window_register_count = static_cast<u8>(Bytecode::Register::Count);
+    static constexpr usize window_byte_count = window_register_count * sizeof(RegisterStorage);
+
+    // NOTE: A window that starts below the usable bytes lies entirely inside the guard page, as the memory ends on a page
+    //       boundary and a window is smaller than a page, so clearing it always faults before anything else is written.
+    static_assert(VirtualStack::minimum_guard_page_byte_count % window_byte_count == 0);
+
 public:
-    VirtualCallStack();
+    // NOTE: The memory is reserved by `VirtualMachine::create`, so that failing to reserve it can be reported.
+    VirtualRegisterFile(Badge<VirtualMachine>, GuardedMemoryRegion&& memory);
+    ~VirtualRegisterFile() = default;
+
+    // Makes a fresh window, with all registers set to zero, the current one. Called when entering a function. Raises
+    // a `Trap::CallDepthExceeded` when all windows are already in use.
+    void push_window();
+    // Like `push_window`, but the first `argument_count` registers of the new window are initialized with the values
+    // of the caller registers starting at `first_argument_register`.
+    void push_window_with_arguments(Bytecode::Register first_argument_register, u8 argument_count);
+    // Reinitializes the current window like `push_window_with_arguments` does for a fresh one, except that the
+    // arguments are taken from the current window itself. Called when a function tail calls another.
+    void replace_window_with_arguments(Bytecode::Register first_argument_register, u8 argument_count);
+    // Makes the window of the caller the current one again. Called when returning from a function.
+    void pop_window();
+
+    // Makes the first window the current one again, with all registers set to zero. Only the windows up to the current
+    // one have to be cleared, as the other ones are cleared when they are pushed.
+    void reset();
+    // Like `reset`, but also valid after a trap. The memory of the windows is discarded instead of being cleared.
+    NODISCARD ErrorOr<void> reset_after_trap();
 
-    void push(Bytecode::JumpAddress return_address, u64 parameters_byte_count);
-    NODISCARD CallFrame pop();
+    NODISCARD RegisterStorage& at(Bytecode::Register);
+    NODISCARD const RegisterStorage& at(Bytecode::Register) const;
+
+    // The registers of the currently executing call frame, indexed by the register number.
+    NODISCARD ALWAYS_INLINE RegisterStorage* window() { return m_window; }
+
+    // The maximum number of register windows, including the window of the entry point.
+    NODISCARD ALWAYS_INLINE usize window_count() const { return m_memory.byte_count() / window_byte_count; }
+
+    NODISCARD ALWAYS_INLINE const GuardedMemoryRegion& memory() const { return m_memory; }
+
+public:
+    // NOTE: The unchecked functions don't validate the register index or the window depth. They must only be used
+    //       when executing packages that have been proven safe by the bytecode verifier.
+    ALWAYS_INLINE void pop_window_unchecked() { m_window += window_register_count; }
+
+    NODISCARD ALWAYS_INLINE RegisterStorage& at_unchecked(Bytecode::Register reg) { return m_window[static_cast<u8>(reg)]; }
 
 private:
-    Vector<CallFrame> m_call_stack;
+    // The window of the entry point, which is the last one of the memory.
+    NODISCARD ALWAYS_INLINE RegisterStorage* root_window()
+    {
+        return reinterpret_cast<RegisterStorage*>(m_memory.bytes() + m_memory.byte_count()) - window_register_count;
+    }
+
+private:
+    GuardedMemoryRegion m_memory;
+    // Points to the first register of the window that belongs to the currently executing call frame.
+    RegisterStorage* m_window;
+};
+
+struct VirtualMachineConfiguration {
+    VirtualStackConfiguration stack;
+    VirtualRegisterFileConfiguration register_file;
+    MemoizationCacheConfiguration memoization_cache;
 };
 
 class VirtualMachine {
@@ -89,26 +355,49 @@ class VirtualMachine {
     ARC_MAKE_NONMOVABLE(VirtualMachine);
 
 public:
-    struct RegisterStorage {
-        u64 value { 0 };
-    };
+    using RegisterStorage = VirtualRegisterFile::RegisterStorage;
 
 public:
-    VirtualMachine();
+    // Reserves the memory of the virtual machine, which fails when the configured stack or register file is too large
+    // for the address space of the process.
+    NODISCARD static ErrorOr<OwnPtr<VirtualMachine>> create();
+    NODISCARD static ErrorOr<OwnPtr<VirtualMachine>> create(const VirtualMachineConfiguration& configuration);
+
+    // Restores the state of a newly constructed virtual machine without reallocating anything, which only costs as much
+    // as the state that the last program left behind. The memoization cache is emptied, as the results it holds are
+    // specific to the executed package.
+    void reset();
+    // Like `reset`, but also valid after the program was aborted by a trap. Fails when the memory of the stack or the
+    // register file can't be discarded, in which case the virtual machine must not be used anymore.
+    NODISCARD ErrorOr<void> reset_after_trap();
 
-    NODISCARD RegisterStorage& register_storage(Bytecode::Register);
-    NODISCARD const RegisterStorage& register_storage(Bytecode::Register) const;
+    // NOTE: Registers are always resolved relative to the register window of the currently executing call frame.
+    NODISCARD ALWAYS_INLINE RegisterStorage& register_storage(Bytecode::Register reg) { return m_register_file.at(reg); }
+    NODISCARD ALWAYS_INLINE const RegisterStorage& register_storage(Bytecode::Register reg) const { return m_register_file.at(reg); }
+
+    // NOTE: Only valid when the register is known to be valid, for example after the package has been verified.
+    NODISCARD ALWAYS_INLINE RegisterStorage& register_storage_unchecked(Bytecode::Register reg)
+    {
+        return m_register_file.at_unchecked(reg);
+    }
+
+    NODISCARD ALWAYS_INLINE VirtualRegisterFile& register_file() { return m_register_file; }
+    NODISCARD ALWAYS_INLINE const VirtualRegisterFile& register_file() const { return m_register_file; }
 
     NODISCARD ALWAYS_INLINE VirtualStack& stack() { return m_stack; }
     NODISCARD ALWAYS_INLINE const VirtualStack& stack() const { return m_stack; }
 
-    NODISCARD ALWAYS_INLINE VirtualCallStack& call_stack() { return m_call_stack; }
-    NODISCARD ALWAYS_INLINE const VirtualCallStack& call_stack() const { return m_call_stack; }
+    NODISCARD ALWAYS_INLINE MemoizationCache& memoization_cache() { return m_memoization_cache; }
+    NODISCARD ALWAYS_INLINE const MemoizationCache& memoization_cache() const { return m_memoization_cache; }
+
+private:
+    VirtualMachine(GuardedMemoryRegion&& register_file_memory, GuardedMemoryRegion&& stack_memory,
+                   const VirtualMachineConfiguration& configuration);
 
 private:
-    Array<RegisterStorage, static_cast<u8>(Bytecode::Register::Count)> m_registers;
+    VirtualRegisterFile m_register_file;
     VirtualStack m_stack;
-    VirtualCallStack m_call_stack;
+    MemoizationCache m_memoization_cache;
 };
 
 }
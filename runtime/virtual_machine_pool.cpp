@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause.
+ */
+
+#include <bytecode/package.h>
+#include <core/thread.h>
+#include <runtime/interpreter.h>
+#include <runtime/virtual_machine_pool.h>
+
+namespace Arc::Runtime {
+
+using namespace Arc::Bytecode;
+
+// The contiguous range of argument sets that is executed by a single thread, on its own virtual machine.
+struct BatchWorker {
+    VirtualMachine* virtual_machine { nullptr };
+    const Package* package { nullptr };
+    JumpAddress entry_point { 0 };
+    u8 argument_count { 0 };
+    Span<const u64> argument_sets;
+    Span<BatchExecutionResult> results;
+    Thread thread;
+    // Set when the virtual machine couldn't be reset after a trap, which aborts the rest of the range.
+    bool has_failed_to_reset { false };
+};
+
+static void execute_batch_range(void* batch_worker)
+{
+    BatchWorker& worker = *static_cast<BatchWorker*>(batch_worker);
+    VirtualMachine& virtual_machine = *worker.virtual_machine;
+    Interpreter interpreter(virtual_machine, *worker.package);
+
+    for (usize set_index = 0; set_index < worker.results.count(); ++set_index) {
+        for (u8 argument_index = 0; argument_index < worker.argument_count; ++argument_index) {
+            const u64 argument = worker.argument_sets[set_index * worker.argument_count + argument_index];
+            virtual_machine.register_storage(static_cast<Register>(static_cast<u8>(Register::GPR0) + argument_index)).value = argument;
+        }
+
+        interpreter.set_entry_point(worker.entry_point.address());
+        MAYBE_UNUSED ErrorOr<void> execute_result = interpreter.execute();
+
+        // NOTE: The virtual machine is reset right away, so that it is ready to be released once the range is finished.
+        BatchExecutionResult& result = worker.results[set_index];
+        result.trap = interpreter.last_trap();
+        if (result.trap.has_value()) {
+            ErrorOr<void> reset_result = virtual_machine.reset_after_trap();
+            if (reset_result.is_error()) {
+                worker.has_failed_to_reset = true;
+                return;
+            }
+            continue;
+        }
+
+        result.return_value = virtual_machine.register_storage(Register::GPR0).value;
+        virtual_machine.reset();
+    }
+}
+
+ErrorOr<OwnPtr<VirtualMachinePool>> VirtualMachinePool::create(usize virtual_machine_count,
+                                                              const VirtualMachineConfiguration& configuration)
+{
+    OwnPtr<VirtualMachinePool> pool = adopt_own(new VirtualMachinePool());
+    pool->m_virtual_machines.ensure_capacity(virtual_machine_count);
+    pool->m_available_virtual_machines.ensure_capacity(virtual_machine_count);
+    for (usize virtual_machine_index = 0; virtual_machine_index < virtual_machine_count; ++virtual_machine_index) {
+        TRY_ASSIGN(OwnPtr<VirtualMachine> virtual_machine, VirtualMachine::create(configuration));
+        pool->m_available_virtual_machines.push_back(virtual_machine.get());
+        pool->m_virtual_machines.push_back(move(virtual_machine));
+    }
+    return pool;
+}
+
+VirtualMachine* VirtualMachinePool::acquire()
+{
+    if (m_available_virtual_machines.is_empty())
+        return nullptr;
+
+    VirtualMachine* virtual_machine = m_available_virtual_machines.last();
+    m_available_virtual_machines.pop_back();
+    return virtual_machine;
+}
+
+void VirtualMachinePool::release(VirtualMachine& virtual_machine)
+{
+    virtual_machine.reset();
+    m_available_virtual_machines.push_back(&virtual_machine);
+}
+
+ErrorOr<void> VirtualMachinePool::release_after_trap(VirtualMachine& virtual_machine)
+{
+    TRY(virtual_machine.reset_after_trap());
+    m_available_virtual_machines.push_back(&virtual_machine);
+    return {};
+}
+
+ErrorOr<Vector<BatchExecutionResult>> VirtualMachinePool::execute_batch(const Package& package, JumpAddress entry_point, u8 argument_count,
+                                                                       Span<const u64> argument_sets)
+{
+    if (argument_count == 0 || argument_count > VirtualRegisterFile::window_register_count)
+        return ARC_INTERNAL_ERROR_WITH_MESSAGE("The argument count of a batch must be between one and the register count"sv);
+    if (argument_sets.count() % argument_count != 0)
+        return ARC_INTERNAL_ERROR_WITH_MESSAGE("The argument sets of a batch must all have the same argument count"sv);
+    if (m_available_virtual_machines.is_empty())
+        return ARC_INTERNAL_ERROR_WITH_MESSAGE("All the virtual machines of the pool are in use"sv);
+
+    const usize set_count = argument_sets.count() / argument_count;
+    Vector<BatchExecutionResult> results;
+    results.set_count_defaulted(set_count);
+    if (set_count == 0)
+        return results;
+
+    // NOTE: The first ranges receive one more argument set each when the sets can't be split evenly.
+    const usize worker_count = set_count < m_available_virtual_machines.count() ? set_count : m_available_virtual_machines.count();
+    const usize minimum_range_set_count = set_count / worker_count;
+    const usize extended_range_count = set_count % worker_count;
+
+    Vector<BatchWorker> workers;
+    workers.set_count_defaulted(worker_count);
+    usize first_set_index = 0;
+    for (usize worker_index = 0; worker_index < worker_count; ++worker_index) {
+        const usize range_set_count = minimum_range_set_count + (worker_index < extended_range_count ? 1 : 0);
+        BatchWorker& worker = workers[worker_index];
+        worker.virtual_machine = acquire();
+        worker.package = &package;
+        worker.entry_point = entry_point;
+        worker.argument_count = argument_count;
+        worker.argument_sets = argument_sets.slice(first_set_index * argument_count, range_set_count * argument_count);
+        worker.results = Span<BatchExecutionResult>(results.elements() + first_set_index, range_set_count);
+        first_set_index += range_set_count;
+    }
+
+    // NOTE: The calling thread executes the first range itself. The ranges whose thread couldn't be created are also
+    //       executed by the calling thread, after its own range.
+    for (usize worker_index = 1; worker_index < worker_count; ++worker_index) {
+        ErrorOr<Thread> spawn_result = Thread::spawn(execute_batch_range, &workers[worker_index]);
+        if (!spawn_result.is_error())
+            workers[worker_index].thread = spawn_result.release_value();
+    }
+
+    for (BatchWorker& worker : workers) {
+        if (worker.thread.is_joinable())
+            continue;
+        execute_batch_range(&worker);
+    }
+
+    bool has_failed_to_reset = false;
+    for (BatchWorker& worker : workers) {
+        if (worker.thread.is_joinable())
+            worker.thread.join();
+        // NOTE: The workers reset their virtual machine after every execution, unless resetting it failed.
+        if (worker.has_failed_to_reset) {
+            has_failed_to_reset = true;
+            continue;
+        }
+        m_available_virtual_machines.push_back(worker.virtual_machine);
+    }
+
+    if (has_failed_to_reset)
+        return ARC_INTERNAL_ERROR_WITH_MESSAGE("Failed to reset a virtual machine after a trap"sv);
+    return results;
+}
+
+}
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause.
+ */
+
+#pragma once
+
+#include <bytecode/forward.h>
+#include <bytecode/jump_address.h>
+#include <core/containers/own_ptr.h>
+#include <core/containers/span.h>
+#include <runtime/virtual_machine.h>
+
+namespace Arc::Runtime {
+
+struct BatchExecutionResult {
+    // The value of GPR0 when the entry point finished, which is zero when the execution was aborted by a trap.
+    u64 return_value { 0 };
+    Optional<Trap> trap;
+};
+
+//
+// A fixed set of virtual machines that are allocated once and reused by many executions. A released virtual machine is
+// reset instead of being destroyed, which doesn't reallocate its stack or its register file and only clears the state
+// that the last program left behind.
+//
+// NOTE: Acquiring and releasing virtual machines isn't synchronized, so the pool itself must only be used by a single
+//       thread. An acquired virtual machine can be used by any thread, but only by one at a time.
+//
+class VirtualMachinePool {
+    ARC_MAKE_NONCOPYABLE(VirtualMachinePool);
+    ARC_MAKE_NONMOVABLE(VirtualMachinePool);
+
+public:
+    // Fails when the memory of any of the virtual machines can't be reserved.
+    NODISCARD static ErrorOr<OwnPtr<VirtualMachinePool>> create(usize virtual_machine_count,
+                                                                const VirtualMachineConfiguration& configuration);
+
+public:
+    ~VirtualMachinePool() = default;
+
+    NODISCARD ALWAYS_INLINE usize virtual_machine_count() const { return m_virtual_machines.count(); }
+    NODISCARD ALWAYS_INLINE usize available_virtual_machine_count() const { return m_available_virtual_machines.count(); }
+
+    // Returns a virtual machine in the state of a newly constructed one, or null when all of them are in use.
+    NODISCARD VirtualMachine* acquire();
+    // Resets the virtual machine and makes it available again. Use `release_after_trap` when the last program executed
+    // by the virtual machine was aborted by a trap, which fails when the virtual machine can't be reset. The virtual
+    // machine is then never made available again.
+    void release(VirtualMachine& virtual_machine);
+    NODISCARD ErrorOr<void> release_after_trap(VirtualMachine& virtual_machine);
+
+    //
+    // Executes the entry point once for every argument set, in parallel on one thread per available virtual machine.
+    // The arguments of a set are written to the first registers before the execution starts, and the results are
+    // returned in the order of the argument sets. The argument sets are split into contiguous ranges of equal size,
+    // one per thread, so the executions should take roughly the same time.
+    //
+    // NOTE: All threads execute the same package, which is safe as long as it isn't modified until the batch finishes.
+    //       Executing a package never writes to it, and all the state of an execution lives in its virtual machine
+    //       and its interpreter, which every thread owns exclusively.
+    //
+    NODISCARD ErrorOr<Vector<BatchExecutionResult>> execute_batch(const Bytecode::Package& package, Bytecode::JumpAddress entry_point,
+                                                                  u8 argument_count, Span<const u64> argument_sets);
+
+private:
+    VirtualMachinePool() = default;
+
+private:
+    Vector<OwnPtr<VirtualMachine>> m_virtual_machines;
+    Vector<VirtualMachine*> m_available_virtual_machines;
+};
+
+}
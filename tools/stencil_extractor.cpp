@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause.
+ */
+
+//
+// Build tool that extracts the stencils used by the `StencilCompiler` from the ELF object file compiled from
+// `runtime/jit/stencils.cpp`, and writes them to a C++ header.
+//
+// Every stencil is compiled into its own `.text.arc_stencil_<name>` section. The machine code of the section is copied
+// verbatim, and every relocation that references an `arc_hole_*` symbol becomes a hole that is patched when the
+// stencil is used. Any other relocation means that the stencil depends on code or data that isn't copied along with
+// it, which is reported as an error.
+//
+// Usage: arc_stencil_extractor <object file> <output header>
+//
+
+#include <core/types.h>
+
+#include <elf.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace Arc::Tools {
+
+static constexpr const char* stencil_section_prefix = ".text.arc_stencil_";
+
+struct HoleSymbol {
+    const char* symbol_name;
+    const char* kind_name;
+    bool is_continuation;
+};
+
+static constexpr HoleSymbol hole_symbols[] = {
+    { "arc_hole_operand_0", "Operand0", false }, { "arc_hole_operand_1", "Operand1", false },
+    { "arc_hole_operand_2", "Operand2", false }, { "arc_hole_operand_3", "Operand3", false },
+    { "arc_hole_operand_4", "Operand4", false }, { "arc_hole_immediate", "Immediate", false },
+    { "arc_hole_continue", "Continue", true },   { "arc_hole_jump", "Jump", true },
+};
+
+struct ObjectFile {
+    u8* bytes;
+    usize byte_count;
+    const Elf64_Shdr* section_headers;
+    usize section_count;
+    const char* section_names;
+    const Elf64_Sym* symbols;
+    usize symbol_count;
+    const char* symbol_names;
+};
+
+[[noreturn]] static void fail(const char* message, const char* detail)
+{
+    fprintf(stderr, "arc_stencil_extractor: %s: %s\n", message, detail);
+    exit(1);
+}
+
+static ObjectFile read_object_file(const char* object_file_path)
+{
+    FILE* file = fopen(object_file_path, "rb");
+    if (!file)
+        fail("Failed to open the object file", object_file_path);
+
+    ObjectFile object_file = {};
+    fseek(file, 0, SEEK_END);
+    object_file.byte_count = static_cast<usize>(ftell(file));
+    fseek(file, 0, SEEK_SET);
+    object_file.bytes = static_cast<u8*>(malloc(object_file.byte_count));
+    if (fread(object_file.bytes, 1, object_file.byte_count, file) != object_file.byte_count)
+        fail("Failed to read the object file", object_file_path);
+    fclose(file);
+
+    const auto* header = reinterpret_cast<const Elf64_Ehdr*>(object_file.bytes);
+    if (object_file.byte_count < sizeof(Elf64_Ehdr) || memcmp(header->e_ident, ELFMAG, SELFMAG) != 0 ||
+        header->e_ident[EI_CLASS] != ELFCLASS64 || header->e_machine != EM_X86_64 || header->e_type != ET_REL) {
+        fail("Not an x86-64 ELF relocatable object file", object_file_path);
+    }
+
+    object_file.section_headers = reinterpret_cast<const Elf64_Shdr*>(object_file.bytes + header->e_shoff);
+    object_file.section_count = header->e_shnum;
+    const Elf64_Shdr& section_names_section = object_file.section_headers[header->e_shstrndx];
+    object_file.section_names = reinterpret_cast<const char*>(object_file.bytes + section_names_section.sh_offset);
+
+    for (usize section_index = 0; section_index < object_file.section_count; ++section_index) {
+        const Elf64_Shdr& section = object_file.section_headers[section_index];
+        if (section.sh_type != SHT_SYMTAB)
+            continue;
+        object_file.symbols = reinterpret_cast<const Elf64_Sym*>(object_file.bytes + section.sh_offset);
+        object_file.symbol_count = section.sh_size / sizeof(Elf64_Sym);
+        const Elf64_Shdr& symbol_names_section = object_file.section_headers[section.sh_link];
+        object_file.symbol_names = reinterpret_cast<const char*>(object_file.bytes + symbol_names_section.sh_offset);
+    }
+
+    if (!object_file.symbols)
+        fail("The object file has no symbol table", object_file_path);
+    return object_file;
+}
+
+static const HoleSymbol& hole_symbol_of(const ObjectFile& object_file, const Elf64_Rela& relocation, const char* stencil_name)
+{
+    const usize symbol_index = ELF64_R_SYM(relocation.r_info);
+    if (symbol_index >= object_file.symbol_count)
+        fail("Invalid relocation symbol in stencil", stencil_name);
+
+    const Elf64_Sym& symbol = object_file.symbols[symbol_index];
+    const char* symbol_name = object_file.symbol_names + symbol.st_name;
+    for (const HoleSymbol& hole_symbol : hole_symbols) {
+        if (strcmp(symbol_name, hole_symbol.symbol_name) == 0)
+            return hole_symbol;
+    }
+
+    fprintf(stderr, "arc_stencil_extractor: The stencil '%s' references the symbol '%s'\n", stencil_name, symbol_name);
+    exit(1);
+}
+
+static const char* relocation_kind_name_of(const Elf64_Rela& relocation, const HoleSymbol& hole_symbol, const char* stencil_name)
+{
+    const u32 relocation_type = ELF64_R_TYPE(relocation.r_info);
+    if (hole_symbol.is_continuation) {
+        if (relocation_type == R_X86_64_PC32 || relocation_type == R_X86_64_PLT32)
+            return "Relative32";
+    }
+    else {
+        if (relocation_type == R_X86_64_32)
+            return "Absolute32";
+        if (relocation_type == R_X86_64_32S)
+            return "Absolute32Signed";
+        if (relocation_type == R_X86_64_64)
+            return "Absolute64";
+    }
+
+    fail("Unsupported relocation type in stencil", stencil_name);
+}
+
+// The continuations must be reached with a jump, as calling them would grow the host stack with every instruction.
+static bool is_tail_call(const u8* code, u64 hole_offset)
+{
+    if (hole_offset >= 1 && code[hole_offset - 1] == 0xE9)
+        return true;
+    return hole_offset >= 2 && code[hole_offset - 2] == 0x0F && (code[hole_offset - 1] & 0xF0) == 0x80;
+}
+
+static void write_stencil(FILE* output_file, const ObjectFile& object_file, usize section_index, const char* stencil_name)
+{
+    const Elf64_Shdr& section = object_file.section_headers[section_index];
+    const u8* code = object_file.bytes + section.sh_offset;
+
+    const Elf64_Rela* relocations = nullptr;
+    usize relocation_count = 0;
+    for (usize relocation_section_index = 0; relocation_section_index < object_file.section_count; ++relocation_section_index) {
+        const Elf64_Shdr& relocation_section = object_file.section_headers[relocation_section_index];
+        if (relocation_section.sh_info != section_index)
+            continue;
+        if (relocation_section.sh_type == SHT_REL)
+            fail("Relocations without addends aren't supported", stencil_name);
+        if (relocation_section.sh_type == SHT_RELA) {
+            relocations = reinterpret_cast<const Elf64_Rela*>(object_file.bytes + relocation_section.sh_offset);
+            relocation_count = relocation_section.sh_size / sizeof(Elf64_Rela);
+        }
+    }
+
+    fprintf(output_file, "static constexpr u8 %s_code[] = {", stencil_name);
+    for (u64 byte_offset = 0; byte_offset < section.sh_size; ++byte_offset)
+        fprintf(output_file, "%s0x%02X,", (byte_offset % 16 == 0) ? "\n    " : " ", code[byte_offset]);
+    fprintf(output_file, "\n};\n");
+
+    if (relocation_count > 0) {
+        fprintf(output_file, "static constexpr StencilHole %s_holes[] = {\n", stencil_name);
+        for (usize relocation_index = 0; relocation_index < relocation_count; ++relocation_index) {
+            const Elf64_Rela& relocation = relocations[relocation_index];
+            const HoleSymbol& hole_symbol = hole_symbol_of(object_file, relocation, stencil_name);
+            if (hole_symbol.is_continuation && !is_tail_call(code, relocation.r_offset))
+                fail("A continuation isn't reached by a tail call in stencil", stencil_name);
+
+            fprintf(output_file, "    { %llu, StencilHoleKind::%s, StencilRelocationKind::%s, %lld },\n",
+                    static_cast<unsigned long long>(relocation.r_offset), hole_symbol.kind_name,
+                    relocation_kind_name_of(relocation, hole_symbol, stencil_name), static_cast<long long>(relocation.r_addend));
+        }
+        fprintf(output_file, "};\n");
+        fprintf(output_file, "static constexpr Stencil %s = { %s_code, sizeof(%s_code), %s_holes, %zu };\n\n", stencil_name, stencil_name,
+                stencil_name, stencil_name, static_cast<size_t>(relocation_count));
+    }
+    else {
+        fprintf(output_file, "static constexpr Stencil %s = { %s_code, sizeof(%s_code), nullptr, 0 };\n\n", stencil_name, stencil_name,
+                stencil_name);
+    }
+}
+
+}
+
+int main(int argument_count, char** arguments)
+{
+    using namespace Arc;
+    using namespace Arc::Tools;
+
+    if (argument_count != 3) {
+        fprintf(stderr, "Usage: arc_stencil_extractor <object file> <output header>\n");
+        return 1;
+    }
+
+    const ObjectFile object_file = read_object_file(arguments[1]);
+    FILE* output_file = fopen(arguments[2], "w");
+    if (!output_file)
+        fail("Failed to open the output header", arguments[2]);
+
+    fprintf(output_file, "// Generated by the stencil extractor from `runtime/jit/stencils.cpp`. Do not edit.\n\n");
+    fprintf(output_file, "#pragma once\n\n#include <runtime/jit/stencil.h>\n\nnamespace Arc::Runtime::Stencils {\n\n");
+
+    const usize stencil_section_prefix_length = strlen(stencil_section_prefix);
+    for (usize section_index = 0; section_index < object_file.section_count; ++section_index) {
+        const Elf64_Shdr& section = object_file.section_headers[section_index];
+        const char* section_name = object_file.section_names + section.sh_name;
+        if (section.sh_type != SHT_PROGBITS || strncmp(section_name, stencil_section_prefix, stencil_section_prefix_length) != 0)
+            continue;
+        write_stencil(output_file, object_file, section_index, section_name + stencil_section_prefix_length);
+    }
+
+    fprintf(output_file, "}\n");
+    if (fclose(output_file) != 0)
+        fail("Failed to write the output header", arguments[2]);
+
+    free(object_file.bytes);
+    return 0;
+}